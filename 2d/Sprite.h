@@ -186,6 +186,17 @@ public: // メンバ関数
 	/// <param name="texSize">テクスチャサイズ</param>
 	void SetTextureRect(const Vector2& texBase, const Vector2& texSize);
 
+	/// <summary>
+	/// 画像名でテクスチャとテクスチャ範囲を設定（アトラスに詰めた画像ならページ内の矩形）
+	/// サイズも画像の大きさに合わせる
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	void SetTextureRect(const std::string& fileName);
+
+	const Vector2& GetTextureBase() const { return texBase_; }
+
+	const Vector2& GetTextureSize() const { return texSize_; }
+
 	/// <summary>
 	/// 描画
 	/// </summary>
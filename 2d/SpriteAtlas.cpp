@@ -0,0 +1,18 @@
+#include "Sprite.h"
+#include "TextureManager.h"
+
+// Sprite の本体はエンジンライブラリ側にあるので、アトラス対応の追加分だけをここで定義する
+
+void Sprite::SetTextureRect(const std::string& fileName) {
+	SetTextureHandle(TextureManager::Load(fileName));
+
+	// アトラスに無い画像はテクスチャ全体
+	AtlasRect rect;
+	if (!TextureManager::GetAtlasRect(fileName, &rect)) {
+		D3D12_RESOURCE_DESC desc = TextureManager::GetInstance()->GetResoureDesc(textureHandle_);
+		rect = AtlasRect{0, 0, static_cast<uint32_t>(desc.Width), desc.Height};
+	}
+	Vector2 texSize = {static_cast<float>(rect.width), static_cast<float>(rect.height)};
+	SetTextureRect({static_cast<float>(rect.x), static_cast<float>(rect.y)}, texSize);
+	SetSize(texSize);
+}
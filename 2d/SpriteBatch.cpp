@@ -0,0 +1,327 @@
+#include "SpriteBatch.h"
+#include "DirectXCommon.h"
+#include "ShaderCompiler.h"
+#include "TextureManager.h"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <utility>
+
+using namespace Microsoft::WRL;
+
+namespace {
+
+/// <summary>
+/// ルートパラメータ番号
+/// </summary>
+enum class RoomParameter {
+	kScreenTransform, // ピクセル座標から正規化デバイス座標への変換（ルート定数）
+	kTexture,         // テクスチャ
+};
+
+// ルート定数の数（拡大 xy、平行移動 xy）
+constexpr UINT kScreenTransformCount = 4;
+
+/// <summary>
+/// ブレンドモードごとのブレンド設定（Sprite と同じ式）
+/// </summary>
+D3D12_RENDER_TARGET_BLEND_DESC MakeBlendDesc(Sprite::BlendMode blendMode) {
+	D3D12_RENDER_TARGET_BLEND_DESC blenddesc{};
+	blenddesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	blenddesc.BlendEnable = true;
+	blenddesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blenddesc.DestBlendAlpha = D3D12_BLEND_ZERO;
+
+	switch (blendMode) {
+	case Sprite::BlendMode::kNone:
+		blenddesc.BlendEnable = false;
+		break;
+	case Sprite::BlendMode::kNormal:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blenddesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+		break;
+	case Sprite::BlendMode::kAdd:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blenddesc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case Sprite::BlendMode::kSubtract:
+		blenddesc.BlendOp = D3D12_BLEND_OP_REV_SUBTRACT;
+		blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+		blenddesc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	case Sprite::BlendMode::kMultily:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_ZERO;
+		blenddesc.DestBlend = D3D12_BLEND_SRC_COLOR;
+		break;
+	case Sprite::BlendMode::kScreen:
+		blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+		blenddesc.SrcBlend = D3D12_BLEND_INV_DEST_COLOR;
+		blenddesc.DestBlend = D3D12_BLEND_ONE;
+		break;
+	default:
+		assert(false);
+		break;
+	}
+	return blenddesc;
+}
+
+} // namespace
+
+void SpriteBatch::Initialize(int windowWidth, int windowHeight) {
+	assert(0 < windowWidth && 0 < windowHeight);
+	// 左上原点・下向きY のピクセル座標を -1～1 に写す
+	screenTransform_[0] = 2.0f / static_cast<float>(windowWidth);
+	screenTransform_[1] = -2.0f / static_cast<float>(windowHeight);
+	screenTransform_[2] = -1.0f;
+	screenTransform_[3] = 1.0f;
+
+	CreatePipelines();
+	CreateIndexBuffer();
+	quads_.clear();
+	statistics_ = {};
+}
+
+void SpriteBatch::Begin(ID3D12GraphicsCommandList* commandList, SortMode sortMode) {
+	assert(commandList);
+	// End を呼ばずに Begin しない
+	assert(!commandList_);
+	commandList_ = commandList;
+	sortMode_ = sortMode;
+	quads_.clear();
+}
+
+void SpriteBatch::Draw(const Sprite& sprite, Sprite::BlendMode blendMode) {
+	SpriteQuad quad;
+	quad.textureHandle = sprite.GetTextureHandle();
+	quad.blendMode = static_cast<uint32_t>(blendMode);
+	quad.position = sprite.GetPosition();
+	quad.size = sprite.GetSize();
+	quad.anchorPoint = sprite.GetAnchorPoint();
+	quad.rotation = sprite.GetRotation();
+	quad.color = sprite.GetColor();
+
+	// テクスチャ範囲をuvに直す
+	D3D12_RESOURCE_DESC resourceDesc =
+	    TextureManager::GetInstance()->GetResoureDesc(quad.textureHandle);
+	float textureWidth = static_cast<float>(resourceDesc.Width);
+	float textureHeight = static_cast<float>(resourceDesc.Height);
+	const Vector2& texBase = sprite.GetTextureBase();
+	const Vector2& texSize = sprite.GetTextureSize();
+	quad.uvMin = {texBase.x / textureWidth, texBase.y / textureHeight};
+	quad.uvMax = {(texBase.x + texSize.x) / textureWidth, (texBase.y + texSize.y) / textureHeight};
+	if (sprite.GetIsFlipX()) {
+		std::swap(quad.uvMin.x, quad.uvMax.x);
+	}
+	if (sprite.GetIsFlipY()) {
+		std::swap(quad.uvMin.y, quad.uvMax.y);
+	}
+	Draw(quad);
+}
+
+void SpriteBatch::Draw(const SpriteQuad& quad) {
+	assert(commandList_);
+	assert(quad.blendMode < kBlendModeCount);
+	quads_.push_back(quad);
+}
+
+void SpriteBatch::End() {
+	assert(commandList_);
+	statistics_ = {};
+	if (quads_.empty()) {
+		commandList_ = nullptr;
+		return;
+	}
+
+	// 描画順
+	if (sortMode_ == SortMode::kTexture) {
+		SortSpriteQuads(quads_, order_, scratch_);
+	} else {
+		order_.resize(quads_.size());
+		for (size_t i = 0; i < order_.size(); i++) {
+			order_[i] = static_cast<uint32_t>(i);
+		}
+	}
+
+	// 全チャンク共通の設定
+	commandList_->SetGraphicsRootSignature(rootSignature_.Get());
+	commandList_->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandList_->IASetIndexBuffer(&ibView_);
+	commandList_->SetGraphicsRoot32BitConstants(
+	    static_cast<UINT>(RoomParameter::kScreenTransform), kScreenTransformCount,
+	    screenTransform_, 0);
+
+	ConstantBufferAllocator* allocator = DirectXCommon::GetInstance()->GetConstantBufferAllocator();
+	constexpr uint32_t kNone = UINT32_MAX;
+	uint32_t blendMode = kNone;
+	uint32_t textureHandle = kNone;
+	for (size_t first = 0; first < order_.size(); first += kMaxQuadsPerChunk) {
+		size_t count = std::min(kMaxQuadsPerChunk, order_.size() - first);
+		std::span<const uint32_t> chunk = std::span<const uint32_t>(order_).subspan(first, count);
+
+		// 頂点は今フレームのページに直接書き出す
+		size_t size = sizeof(SpriteVertex) * 4 * count;
+		ConstantBufferAllocator::Allocation allocation = allocator->Allocate(size);
+		if (!allocation.cpuAddress) {
+			// 書き込み先が無ければ残りは描かない
+			break;
+		}
+		WriteSpriteVertices(quads_, chunk, static_cast<SpriteVertex*>(allocation.cpuAddress));
+		D3D12_VERTEX_BUFFER_VIEW vbView{};
+		vbView.BufferLocation = allocation.gpuAddress;
+		vbView.SizeInBytes = static_cast<UINT>(size);
+		vbView.StrideInBytes = sizeof(SpriteVertex);
+		commandList_->IASetVertexBuffers(0, 1, &vbView);
+		statistics_.vertexBytes += size;
+
+		// 状態が同じ間は1回の描画コールにまとめる
+		size_t begin = 0;
+		while (begin < count) {
+			const SpriteQuad& quad = quads_[chunk[begin]];
+			size_t end = begin + 1;
+			while (end < count && quads_[chunk[end]].blendMode == quad.blendMode &&
+			       quads_[chunk[end]].textureHandle == quad.textureHandle) {
+				end++;
+			}
+			if (blendMode != quad.blendMode) {
+				blendMode = quad.blendMode;
+				commandList_->SetPipelineState(pipelineStates_[blendMode].Get());
+				statistics_.pipelineChangeCount++;
+			}
+			if (textureHandle != quad.textureHandle) {
+				textureHandle = quad.textureHandle;
+				TextureManager::GetInstance()->SetGraphicsRootDescriptorTable(
+				    commandList_, static_cast<UINT>(RoomParameter::kTexture), textureHandle);
+				statistics_.textureChangeCount++;
+			}
+			commandList_->DrawIndexedInstanced(
+			    static_cast<UINT>((end - begin) * 6), 1, static_cast<UINT>(begin * 6), 0, 0);
+			statistics_.drawCallCount++;
+			begin = end;
+		}
+	}
+	statistics_.spriteCount = static_cast<uint32_t>(quads_.size());
+
+	quads_.clear();
+	commandList_ = nullptr;
+}
+
+void SpriteBatch::CreatePipelines() {
+	HRESULT result = S_FALSE;
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	ComPtr<ID3DBlob> vsBlob = CompileShader(L"Resources/shaders/SpriteBatchVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = CompileShader(L"Resources/shaders/SpriteBatchPS.hlsl", "ps_5_0");
+
+	// 頂点レイアウト（SpriteVertex）
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {// xyz座標
+	     "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {// uv座標
+	     "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {// 色
+	     "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// グラフィックスパイプラインの流れを設定
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC gpipeline{};
+	gpipeline.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	gpipeline.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	// サンプルマスク
+	gpipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	// ラスタライザステート（反転したスプライトも描くのでカリングしない）
+	gpipeline.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	gpipeline.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	// デプスステンシルステート（常に上書き）
+	gpipeline.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+	gpipeline.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_ALWAYS;
+
+	// 深度バッファのフォーマット
+	gpipeline.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	// 頂点レイアウトの設定
+	gpipeline.InputLayout.pInputElementDescs = inputLayout;
+	gpipeline.InputLayout.NumElements = _countof(inputLayout);
+	// 図形の形状設定（三角形）
+	gpipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	gpipeline.NumRenderTargets = 1;                            // 描画対象は1つ
+	gpipeline.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB; // 0～255指定のRGBA
+	gpipeline.SampleDesc.Count = 1; // 1ピクセルにつき1回サンプリング
+
+	// デスクリプタレンジ
+	CD3DX12_DESCRIPTOR_RANGE descRangeSRV;
+	descRangeSRV.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); // t0 レジスタ
+
+	// ルートパラメータ
+	CD3DX12_ROOT_PARAMETER rootparams[2];
+	rootparams[static_cast<size_t>(RoomParameter::kScreenTransform)].InitAsConstants(
+	    kScreenTransformCount, 0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+	rootparams[static_cast<size_t>(RoomParameter::kTexture)].InitAsDescriptorTable(
+	    1, &descRangeSRV, D3D12_SHADER_VISIBILITY_ALL);
+
+	// スタティックサンプラー
+	CD3DX12_STATIC_SAMPLER_DESC samplerDesc =
+	    CD3DX12_STATIC_SAMPLER_DESC(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR);
+
+	// ルートシグネチャの設定
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(
+	    _countof(rootparams), rootparams, 1, &samplerDesc,
+	    D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	// バージョン自動判定のシリアライズ
+	result = D3DX12SerializeVersionedRootSignature(
+	    &rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	// ルートシグネチャの生成
+	result = device->CreateRootSignature(
+	    0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(),
+	    IID_PPV_ARGS(&rootSignature_));
+	assert(SUCCEEDED(result));
+
+	gpipeline.pRootSignature = rootSignature_.Get();
+
+	// ブレンドモードごとにグラフィックスパイプラインを生成
+	for (size_t i = 0; i < kBlendModeCount; i++) {
+		gpipeline.BlendState.RenderTarget[0] = MakeBlendDesc(static_cast<Sprite::BlendMode>(i));
+		result = device->CreateGraphicsPipelineState(&gpipeline, IID_PPV_ARGS(&pipelineStates_[i]));
+		assert(SUCCEEDED(result));
+	}
+}
+
+void SpriteBatch::CreateIndexBuffer() {
+	HRESULT result = S_FALSE;
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	// 四角形ごとに 左下・左上・右下 と 右下・左上・右上 の2枚
+	const UINT sizeIB = static_cast<UINT>(sizeof(uint16_t) * 6 * kMaxQuadsPerChunk);
+	CD3DX12_HEAP_PROPERTIES heapProps(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeIB);
+	result = device->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
+	    nullptr, IID_PPV_ARGS(&indexBuff_));
+	assert(SUCCEEDED(result));
+
+	uint16_t* indexMap = nullptr;
+	result = indexBuff_->Map(0, nullptr, reinterpret_cast<void**>(&indexMap));
+	assert(SUCCEEDED(result));
+	for (size_t i = 0; i < kMaxQuadsPerChunk; i++) {
+		uint16_t base = static_cast<uint16_t>(i * 4);
+		const uint16_t quad[] = {
+		    base, uint16_t(base + 1), uint16_t(base + 2), uint16_t(base + 2), uint16_t(base + 1),
+		    uint16_t(base + 3)};
+		std::copy(std::begin(quad), std::end(quad), indexMap + i * 6);
+	}
+	indexBuff_->Unmap(0, nullptr);
+
+	ibView_.BufferLocation = indexBuff_->GetGPUVirtualAddress();
+	ibView_.Format = DXGI_FORMAT_R16_UINT;
+	ibView_.SizeInBytes = sizeIB;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Sprite.h"
+#include "SpriteQuad.h"
+#include <array>
+#include <d3d12.h>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// スプライトバッチ
+/// 1フレーム分のスプライトを1本の頂点バッファ（フレーム単位のアップロードページ）に書き出し、
+/// ブレンドモードとテクスチャが同じものをまとめて1回の描画コールで描く
+/// </summary>
+class SpriteBatch {
+public: // 定数
+	// 1回の頂点書き出しで扱う最大枚数（頂点番号が16bitに収まり、1ページに収まる数）
+	static constexpr size_t kMaxQuadsPerChunk = 8192;
+	// ブレンドモード数
+	static constexpr size_t kBlendModeCount = size_t(Sprite::BlendMode::kCountOfBlendMode);
+
+public: // 列挙子
+	/// <summary>
+	/// 描画順
+	/// </summary>
+	enum class SortMode {
+		kTexture,  // ブレンドモードとテクスチャでまとめる（描画コールが最も少ない）
+		kDeferred, // 積んだ順に描く（重なり順が大事なとき。連続する同じ状態だけまとめる）
+	};
+
+public: // サブクラス
+	/// <summary>
+	/// 直前の End の統計
+	/// </summary>
+	struct Statistics {
+		// 描いたスプライト数
+		uint32_t spriteCount = 0;
+		// 描画コール数
+		uint32_t drawCallCount = 0;
+		// パイプライン（ブレンドモード）切り替え数
+		uint32_t pipelineChangeCount = 0;
+		// テクスチャ切り替え数
+		uint32_t textureChangeCount = 0;
+		// 書き出した頂点のバイト数
+		size_t vertexBytes = 0;
+	};
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="windowWidth">画面幅</param>
+	/// <param name="windowHeight">画面高さ</param>
+	void Initialize(int windowWidth, int windowHeight);
+
+	/// <summary>
+	/// 描画開始
+	/// </summary>
+	/// <param name="commandList">描画コマンドリスト</param>
+	/// <param name="sortMode">描画順</param>
+	void Begin(ID3D12GraphicsCommandList* commandList, SortMode sortMode = SortMode::kTexture);
+
+	/// <summary>
+	/// スプライトを積む（Sprite の頂点・定数バッファは使わない）
+	/// </summary>
+	/// <param name="sprite">スプライト</param>
+	/// <param name="blendMode">ブレンドモード</param>
+	void Draw(const Sprite& sprite, Sprite::BlendMode blendMode = Sprite::BlendMode::kNormal);
+
+	/// <summary>
+	/// 描画要求をそのまま積む
+	/// </summary>
+	/// <param name="quad">描画要求</param>
+	void Draw(const SpriteQuad& quad);
+
+	/// <summary>
+	/// 描画終了。積んだスプライトをまとめて描く
+	/// </summary>
+	void End();
+
+	/// <summary>
+	/// 統計の取得
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private: // メンバ関数
+	/// <summary>
+	/// パイプライン生成
+	/// </summary>
+	void CreatePipelines();
+
+	/// <summary>
+	/// 四角形の並びを表すインデックスバッファの生成
+	/// </summary>
+	void CreateIndexBuffer();
+
+private: // メンバ変数
+	// ルートシグネチャ
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> rootSignature_;
+	// ブレンドモードごとのパイプラインステートオブジェクト
+	std::array<Microsoft::WRL::ComPtr<ID3D12PipelineState>, kBlendModeCount> pipelineStates_;
+	// インデックスバッファ（全チャンク共通）
+	Microsoft::WRL::ComPtr<ID3D12Resource> indexBuff_;
+	// インデックスバッファビュー
+	D3D12_INDEX_BUFFER_VIEW ibView_{};
+	// ピクセル座標から正規化デバイス座標への変換（拡大 xy、平行移動 xy）
+	float screenTransform_[4] = {};
+	// コマンドリスト
+	ID3D12GraphicsCommandList* commandList_ = nullptr;
+	// 描画順
+	SortMode sortMode_ = SortMode::kTexture;
+	// 描画要求
+	std::vector<SpriteQuad> quads_;
+	// 描画順（quads_ の添字）
+	std::vector<uint32_t> order_;
+	// 並べ替えの作業領域
+	std::vector<uint32_t> scratch_;
+	// 統計
+	Statistics statistics_;
+};
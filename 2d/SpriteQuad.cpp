@@ -0,0 +1,95 @@
+#include "SpriteQuad.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+// 並べ替えキー（上位がブレンドモード、下位がテクスチャハンドル）
+uint32_t SortKey(const SpriteQuad& quad) {
+	return (quad.blendMode << 24) | (quad.textureHandle & 0xFFFFFF);
+}
+
+} // namespace
+
+uint32_t PackSpriteColor(const Vector4& color) {
+	auto channel = [](float value) {
+		return static_cast<uint32_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	};
+	return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) |
+	       (channel(color.w) << 24);
+}
+
+void SortSpriteQuads(
+    std::span<const SpriteQuad> quads, std::vector<uint32_t>& order,
+    std::vector<uint32_t>& scratch) {
+	const size_t count = quads.size();
+	order.resize(count);
+	for (size_t i = 0; i < count; i++) {
+		order[i] = static_cast<uint32_t>(i);
+	}
+	if (count <= 1) {
+		return;
+	}
+	scratch.resize(count);
+
+	// 8bitずつの安定な計数ソート。全桁のヒストグラムを1回の走査で作り、全要素で同じ桁は飛ばす
+	constexpr uint32_t kDigitBits = 8;
+	constexpr size_t kDigitSize = size_t(1) << kDigitBits;
+	constexpr uint32_t kPassCount = 32 / kDigitBits;
+	uint32_t histograms[kPassCount][kDigitSize] = {};
+	for (const SpriteQuad& quad : quads) {
+		uint32_t key = SortKey(quad);
+		for (uint32_t pass = 0; pass < kPassCount; pass++) {
+			histograms[pass][(key >> (pass * kDigitBits)) & (kDigitSize - 1)]++;
+		}
+	}
+	for (uint32_t pass = 0; pass < kPassCount; pass++) {
+		const uint32_t shift = pass * kDigitBits;
+		uint32_t* histogram = histograms[pass];
+		if (histogram[(SortKey(quads[0]) >> shift) & (kDigitSize - 1)] == count) {
+			continue;
+		}
+		uint32_t offset = 0;
+		for (size_t digit = 0; digit < kDigitSize; digit++) {
+			uint32_t next = offset + histogram[digit];
+			histogram[digit] = offset;
+			offset = next;
+		}
+		for (uint32_t index : order) {
+			scratch[histogram[(SortKey(quads[index]) >> shift) & (kDigitSize - 1)]++] = index;
+		}
+		order.swap(scratch);
+	}
+}
+
+void WriteSpriteVertices(
+    std::span<const SpriteQuad> quads, std::span<const uint32_t> order, SpriteVertex* dst) {
+	for (uint32_t index : order) {
+		const SpriteQuad& quad = quads[index];
+		// アンカーポイントを原点とした四隅
+		float left = -quad.anchorPoint.x * quad.size.x;
+		float right = (1.0f - quad.anchorPoint.x) * quad.size.x;
+		float top = -quad.anchorPoint.y * quad.size.y;
+		float bottom = (1.0f - quad.anchorPoint.y) * quad.size.y;
+
+		// 回転してから平行移動（Sprite の行列と同じ順）。回転しないものは三角関数を省く
+		float c = 1.0f;
+		float s = 0.0f;
+		if (quad.rotation != 0.0f) {
+			c = std::cos(quad.rotation);
+			s = std::sin(quad.rotation);
+		}
+		auto transform = [&](float x, float y) {
+			return Vector3{
+			    x * c - y * s + quad.position.x, x * s + y * c + quad.position.y, 0.0f};
+		};
+		uint32_t color = PackSpriteColor(quad.color);
+
+		dst[0] = SpriteVertex{transform(left, bottom), {quad.uvMin.x, quad.uvMax.y}, color};
+		dst[1] = SpriteVertex{transform(left, top), {quad.uvMin.x, quad.uvMin.y}, color};
+		dst[2] = SpriteVertex{transform(right, bottom), {quad.uvMax.x, quad.uvMax.y}, color};
+		dst[3] = SpriteVertex{transform(right, top), {quad.uvMax.x, quad.uvMin.y}, color};
+		dst += 4;
+	}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/// <summary>
+/// スプライトバッチの頂点（SpriteBatchVS.hlsl の入力と同じ並び）
+/// </summary>
+struct SpriteVertex {
+	Vector3 pos;    // スクリーン座標（ピクセル）
+	Vector2 uv;     // uv座標
+	uint32_t color; // 色 (RGBA8)
+};
+static_assert(sizeof(SpriteVertex) == 24);
+
+/// <summary>
+/// スプライト1枚分の描画要求
+/// </summary>
+struct SpriteQuad {
+	// テクスチャハンドル
+	uint32_t textureHandle = 0;
+	// ブレンドモード（Sprite::BlendMode）
+	uint32_t blendMode = 0;
+	// 座標（アンカーポイントの位置）
+	Vector2 position{};
+	// 幅、高さ
+	Vector2 size{};
+	// アンカーポイント（0～1）
+	Vector2 anchorPoint{};
+	// Z軸回りの回転角
+	float rotation = 0.0f;
+	// テクスチャ左上のuv
+	Vector2 uvMin{0.0f, 0.0f};
+	// テクスチャ右下のuv（反転するときは uvMin と入れ替える）
+	Vector2 uvMax{1.0f, 1.0f};
+	// 色
+	Vector4 color{1.0f, 1.0f, 1.0f, 1.0f};
+};
+
+/// <summary>
+/// 色を RGBA8 に詰める
+/// </summary>
+uint32_t PackSpriteColor(const Vector4& color);
+
+/// <summary>
+/// ブレンドモードとテクスチャが同じものが続くように描画順を作る（同じもの同士は積んだ順を保つ）
+/// </summary>
+/// <param name="quads">描画要求</param>
+/// <param name="order">描画順の出力先（quads の添字）</param>
+/// <param name="scratch">作業領域</param>
+void SortSpriteQuads(
+    std::span<const SpriteQuad> quads, std::vector<uint32_t>& order,
+    std::vector<uint32_t>& scratch);
+
+/// <summary>
+/// 頂点を書き出す（1枚につき 左下・左上・右下・右上 の4頂点）
+/// 書き込み先はアップロードヒープ（書き込み結合メモリ）を想定し、前から順に書くだけで読み戻さない
+/// </summary>
+/// <param name="quads">描画要求</param>
+/// <param name="order">書き出す順（quads の添字）</param>
+/// <param name="dst">書き込み先（order.size() * 4 頂点）</param>
+void WriteSpriteVertices(
+    std::span<const SpriteQuad> quads, std::span<const uint32_t> order, SpriteVertex* dst);
@@ -0,0 +1,361 @@
+#include "CollisionBroadphase.h"
+#include "WorldTransform.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+// グループBを表すビット
+constexpr uint32_t kGroupBBit = 0x80000000u;
+
+// セル座標の上限（これより遠い座標は端のセルにまとめる）
+constexpr float kMaxCellCoordinate = 1073741824.0f; // 2^30
+// 空間ハッシュに登録するコライダーが掛かってよいセル数の上限（超えたものは掃引で判定する）
+constexpr uint64_t kMaxCellsPerCollider = 64;
+// バケット数の上限
+constexpr uint32_t kMaxBucketCount = 1u << 24;
+
+// セル座標の範囲
+struct CellRange {
+	int32_t min[3];
+	int32_t max[3];
+};
+
+// 座標をセル座標にする（範囲外と NaN は端に寄せる）
+int32_t ToCell(float value, float inverseCellSize) {
+	float cell = std::floor(value * inverseCellSize);
+	if (!(-kMaxCellCoordinate < cell)) {
+		return -static_cast<int32_t>(kMaxCellCoordinate);
+	}
+	if (kMaxCellCoordinate < cell) {
+		return static_cast<int32_t>(kMaxCellCoordinate);
+	}
+	return static_cast<int32_t>(cell);
+}
+
+// 境界箱が掛かるセルの範囲
+CellRange GetCellRange(const AABB& bounds, float inverseCellSize) {
+	CellRange range;
+	const float* min = &bounds.min.x;
+	const float* max = &bounds.max.x;
+	for (int i = 0; i < 3; i++) {
+		range.min[i] = ToCell(min[i], inverseCellSize);
+		range.max[i] = std::max(range.min[i], ToCell(max[i], inverseCellSize));
+	}
+	return range;
+}
+
+// 範囲内のセル数（上限を超えるときは途中で打ち切って上限+1を返す）
+uint64_t CountCells(const CellRange& range) {
+	uint64_t count = 1;
+	for (int i = 0; i < 3; i++) {
+		// 各軸は 2^31 以下なので、上限以下の値に掛けても溢れない
+		count *= static_cast<uint64_t>(static_cast<int64_t>(range.max[i]) - range.min[i] + 1);
+		if (kMaxCellsPerCollider < count) {
+			return kMaxCellsPerCollider + 1;
+		}
+	}
+	return count;
+}
+
+// セル座標のハッシュ
+uint32_t HashCell(int32_t x, int32_t y, int32_t z, uint32_t mask) {
+	uint32_t h = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u ^
+	             static_cast<uint32_t>(z) * 83492791u;
+	return h & mask;
+}
+
+// 範囲内の全セルについて処理する
+template<class Function> void ForEachCell(const CellRange& range, Function function) {
+	for (int32_t z = range.min[2]; z <= range.max[2]; z++) {
+		for (int32_t y = range.min[1]; y <= range.max[1]; y++) {
+			for (int32_t x = range.min[0]; x <= range.max[0]; x++) {
+				function(x, y, z);
+			}
+		}
+	}
+}
+
+} // namespace
+
+bool CollisionBroadphase::TestShapes(const Collider& a, const Collider& b) {
+	if (a.shape == Shape::kSphere) {
+		return b.shape == Shape::kSphere ? IsCollision(a.sphere, b.sphere)
+		                                 : IsCollision(a.sphere, b.bounds);
+	}
+	return b.shape == Shape::kSphere ? IsCollision(a.bounds, b.sphere)
+	                                 : IsCollision(a.bounds, b.bounds);
+}
+
+void CollisionBroadphase::Initialize(Method method, float cellSize) {
+	method_ = method;
+	SetCellSize(cellSize);
+	narrowphase_ = nullptr;
+	Clear();
+}
+
+void CollisionBroadphase::SetCellSize(float cellSize) {
+	assert(0.0f < cellSize);
+	inverseCellSize_ = 1.0f / cellSize;
+}
+
+void CollisionBroadphase::Clear() {
+	colliders_[0].clear();
+	colliders_[1].clear();
+	pairs_.clear();
+	statistics_ = {};
+}
+
+void CollisionBroadphase::Add(Group group, uint32_t id, const Sphere& sphere) {
+	Collider collider;
+	collider.bounds = MakeAABB(sphere);
+	collider.sphere = sphere;
+	collider.shape = Shape::kSphere;
+	collider.id = id;
+	colliders_[static_cast<size_t>(group)].push_back(collider);
+}
+
+void CollisionBroadphase::Add(Group group, uint32_t id, const AABB& aabb) {
+	Collider collider;
+	collider.bounds = aabb;
+	collider.sphere = {};
+	collider.shape = Shape::kAABB;
+	collider.id = id;
+	colliders_[static_cast<size_t>(group)].push_back(collider);
+}
+
+void CollisionBroadphase::Add(
+    Group group, uint32_t id, const WorldTransform& worldTransform, float radius) {
+	Add(group, id, Sphere{worldTransform.translation_, radius});
+}
+
+const std::vector<CollisionBroadphase::Pair>& CollisionBroadphase::FindPairs() {
+	pairs_.clear();
+	statistics_ = {};
+	if (colliders_[0].empty() || colliders_[1].empty()) {
+		return pairs_;
+	}
+
+	switch (method_) {
+	case Method::kSpatialHash:
+		FindPairsSpatialHash();
+		break;
+	case Method::kSweepAndPrune:
+		FindPairsSweepAndPrune();
+		break;
+	}
+	statistics_.pairCount = static_cast<uint32_t>(pairs_.size());
+	return pairs_;
+}
+
+void CollisionBroadphase::TestPair(uint32_t indexA, uint32_t indexB) {
+	const Collider& a = colliders_[0][indexA];
+	const Collider& b = colliders_[1][indexB];
+	statistics_.testCount++;
+	if (!IsCollision(a.bounds, b.bounds)) {
+		return;
+	}
+	statistics_.narrowphaseCount++;
+	bool hit = narrowphase_ ? narrowphase_(a, b) : TestShapes(a, b);
+	if (hit) {
+		pairs_.push_back(Pair{a.id, b.id});
+	}
+}
+
+void CollisionBroadphase::FindPairsSpatialHash() {
+	// 数の少ない方をグリッドに登録し、多い方で問い合わせる
+	size_t gridGroup = colliders_[0].size() <= colliders_[1].size() ? 0 : 1;
+	const std::vector<Collider>& gridColliders = colliders_[gridGroup];
+	const std::vector<Collider>& queryColliders = colliders_[1 - gridGroup];
+
+	// セルをたくさん跨ぐコライダー（ボス・レーザーなど）はグリッドに入れず、後で掃引で判定する
+	std::vector<uint32_t>& gridLarge = largeIndices_[gridGroup];
+	std::vector<uint32_t>& querySmall = smallIndices_[1 - gridGroup];
+	std::vector<uint32_t>& queryLarge = largeIndices_[1 - gridGroup];
+	gridLarge.clear();
+	querySmall.clear();
+	queryLarge.clear();
+	// 登録しないものは訪問済みの印を付けておき、問い合わせで拾わないようにする
+	constexpr uint32_t kExcluded = 0xffffffffu;
+	visitStamps_.assign(gridColliders.size(), 0);
+	size_t entryCount = 0;
+	for (uint32_t i = 0; i < gridColliders.size(); i++) {
+		uint64_t cellCount = CountCells(GetCellRange(gridColliders[i].bounds, inverseCellSize_));
+		if (kMaxCellsPerCollider < cellCount) {
+			gridLarge.push_back(i);
+			visitStamps_[i] = kExcluded;
+		} else {
+			entryCount += cellCount;
+		}
+	}
+
+	// 登録数からバケット数を決める（2の冪、登録数の2倍以上）
+	uint32_t bucketCount = 64;
+	while (bucketCount < entryCount * 2 && bucketCount < kMaxBucketCount) {
+		bucketCount *= 2;
+	}
+	uint32_t mask = bucketCount - 1;
+
+	// バケットごとの数を数え、累積して終端位置にする
+	bucketOffsets_.assign(bucketCount + 1, 0);
+	for (uint32_t i = 0; i < gridColliders.size(); i++) {
+		if (visitStamps_[i] == kExcluded) {
+			continue;
+		}
+		ForEachCell(
+		    GetCellRange(gridColliders[i].bounds, inverseCellSize_),
+		    [&](int32_t x, int32_t y, int32_t z) { bucketOffsets_[HashCell(x, y, z, mask)]++; });
+	}
+	for (uint32_t i = 1; i <= bucketCount; i++) {
+		bucketOffsets_[i] += bucketOffsets_[i - 1];
+	}
+	// 終端から詰めていくと、各バケットの値が開始位置になる
+	bucketItems_.resize(entryCount);
+	for (uint32_t i = 0; i < gridColliders.size(); i++) {
+		if (visitStamps_[i] == kExcluded) {
+			continue;
+		}
+		ForEachCell(
+		    GetCellRange(gridColliders[i].bounds, inverseCellSize_),
+		    [&](int32_t x, int32_t y, int32_t z) {
+			    bucketItems_[--bucketOffsets_[HashCell(x, y, z, mask)]] = i;
+		    });
+	}
+
+	// 複数セル・ハッシュの衝突で同じ候補を2度調べないよう、問い合わせごとに印を付ける
+	for (uint32_t q = 0; q < queryColliders.size(); q++) {
+		CellRange range = GetCellRange(queryColliders[q].bounds, inverseCellSize_);
+		if (kMaxCellsPerCollider < CountCells(range)) {
+			queryLarge.push_back(q);
+			continue;
+		}
+		querySmall.push_back(q);
+		uint32_t stamp = q + 1;
+		ForEachCell(range, [&](int32_t x, int32_t y, int32_t z) {
+			uint32_t bucket = HashCell(x, y, z, mask);
+			for (uint32_t j = bucketOffsets_[bucket]; j < bucketOffsets_[bucket + 1]; j++) {
+				uint32_t g = bucketItems_[j];
+				if (visitStamps_[g] == stamp) {
+					continue;
+				}
+				visitStamps_[g] = stamp;
+				if (gridGroup == 0) {
+					TestPair(g, q);
+				} else {
+					TestPair(q, g);
+				}
+			}
+		});
+	}
+
+	// 大きいコライダーが絡む組は掃引で判定する
+	// （グリッド側の大 × 問い合わせ側の全部、グリッド側の小 × 問い合わせ側の大。重複はしない）
+	if (gridLarge.empty() && queryLarge.empty()) {
+		return;
+	}
+	statistics_.largeColliderCount = static_cast<uint32_t>(gridLarge.size() + queryLarge.size());
+	std::vector<uint32_t>& gridSmall = smallIndices_[gridGroup];
+	gridSmall.clear();
+	for (uint32_t i = 0; i < gridColliders.size(); i++) {
+		if (visitStamps_[i] != kExcluded) {
+			gridSmall.push_back(i);
+		}
+	}
+	// 問い合わせ側の全部 = 小 + 大
+	querySmall.insert(querySmall.end(), queryLarge.begin(), queryLarge.end());
+	if (gridGroup == 0) {
+		SweepAndPrune(gridLarge, querySmall);
+		SweepAndPrune(gridSmall, queryLarge);
+	} else {
+		SweepAndPrune(querySmall, gridLarge);
+		SweepAndPrune(queryLarge, gridSmall);
+	}
+}
+
+void CollisionBroadphase::FindPairsSweepAndPrune() {
+	for (uint32_t group = 0; group < 2; group++) {
+		std::vector<uint32_t>& indices = smallIndices_[group];
+		indices.resize(colliders_[group].size());
+		for (uint32_t i = 0; i < indices.size(); i++) {
+			indices[i] = i;
+		}
+	}
+	SweepAndPrune(smallIndices_[0], smallIndices_[1]);
+}
+
+void CollisionBroadphase::SweepAndPrune(
+    const std::vector<uint32_t>& indicesA, const std::vector<uint32_t>& indicesB) {
+	if (indicesA.empty() || indicesB.empty()) {
+		return;
+	}
+	const std::vector<uint32_t>* indices[2] = {&indicesA, &indicesB};
+
+	// 中心の分散が最も大きい軸で掃引する
+	double sum[3] = {};
+	double sumSquared[3] = {};
+	size_t count = 0;
+	for (uint32_t group = 0; group < 2; group++) {
+		for (uint32_t index : *indices[group]) {
+			const Collider& collider = colliders_[group][index];
+			const float* min = &collider.bounds.min.x;
+			const float* max = &collider.bounds.max.x;
+			for (int i = 0; i < 3; i++) {
+				double center = 0.5 * (static_cast<double>(min[i]) + static_cast<double>(max[i]));
+				sum[i] += center;
+				sumSquared[i] += center * center;
+			}
+		}
+		count += indices[group]->size();
+	}
+	int axis = 0;
+	double maxVariance = -1.0;
+	for (int i = 0; i < 3; i++) {
+		double mean = sum[i] / static_cast<double>(count);
+		double variance = sumSquared[i] / static_cast<double>(count) - mean * mean;
+		if (maxVariance < variance) {
+			maxVariance = variance;
+			axis = i;
+		}
+	}
+
+	// 軸上の範囲の始点でソート
+	sweepItems_.clear();
+	for (uint32_t group = 0; group < 2; group++) {
+		for (uint32_t i : *indices[group]) {
+			const float* min = &colliders_[group][i].bounds.min.x;
+			const float* max = &colliders_[group][i].bounds.max.x;
+			sweepItems_.push_back(SweepItem{min[axis], max[axis], i | (group ? kGroupBBit : 0)});
+		}
+	}
+	std::sort(
+	    sweepItems_.begin(), sweepItems_.end(),
+	    [](const SweepItem& a, const SweepItem& b) { return a.min < b.min; });
+
+	// 始点順に掃引し、範囲が重なっている相手グループの要素とだけ判定する
+	activeItems_[0].clear();
+	activeItems_[1].clear();
+	for (uint32_t i = 0; i < sweepItems_.size(); i++) {
+		const SweepItem& item = sweepItems_[i];
+		uint32_t group = (item.index & kGroupBBit) ? 1 : 0;
+		uint32_t index = item.index & ~kGroupBBit;
+		std::vector<uint32_t>& others = activeItems_[1 - group];
+		for (size_t j = 0; j < others.size();) {
+			const SweepItem& other = sweepItems_[others[j]];
+			// 終点を過ぎたものは以降も重ならないので外す
+			if (other.max < item.min) {
+				others[j] = others.back();
+				others.pop_back();
+				continue;
+			}
+			uint32_t otherIndex = other.index & ~kGroupBBit;
+			if (group == 0) {
+				TestPair(index, otherIndex);
+			} else {
+				TestPair(otherIndex, index);
+			}
+			j++;
+		}
+		activeItems_[group].push_back(i);
+	}
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+#include "Collision.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct WorldTransform;
+
+/// <summary>
+/// 当たり判定の広域判定
+/// 2つのグループ（自弾と敵など）の間で当たっている組を総当たりせずに探す
+/// </summary>
+class CollisionBroadphase {
+public: // サブクラス
+	/// <summary>
+	/// 広域判定の方式
+	/// </summary>
+	enum class Method {
+		kSpatialHash,   //!< 一様グリッドの空間ハッシュ
+		kSweepAndPrune, //!< 1軸ソートの掃引
+	};
+
+	/// <summary>
+	/// グループ
+	/// </summary>
+	enum class Group {
+		kA,
+		kB,
+	};
+
+	/// <summary>
+	/// 形状
+	/// </summary>
+	enum class Shape {
+		kSphere,
+		kAABB,
+	};
+
+	/// <summary>
+	/// コライダー
+	/// </summary>
+	struct Collider {
+		// 境界箱（AABBのときは形状そのもの）
+		AABB bounds;
+		// 球（球のときのみ）
+		Sphere sphere;
+		// 形状
+		Shape shape;
+		// 呼び出し側の識別子
+		uint32_t id;
+	};
+
+	/// <summary>
+	/// 当たっている組
+	/// </summary>
+	struct Pair {
+		// グループAの識別子
+		uint32_t idA;
+		// グループBの識別子
+		uint32_t idB;
+	};
+
+	/// <summary>
+	/// 直近の FindPairs の統計
+	/// </summary>
+	struct Statistics {
+		// 境界箱で判定した組数
+		uint32_t testCount = 0;
+		// 詳細判定まで進んだ組数
+		uint32_t narrowphaseCount = 0;
+		// 当たっていた組数
+		uint32_t pairCount = 0;
+		// 空間ハッシュに入れず掃引で判定した大きいコライダーの数
+		uint32_t largeColliderCount = 0;
+	};
+
+	/// <summary>
+	/// 詳細判定（当たっていれば true を返す）
+	/// </summary>
+	using Narrowphase = std::function<bool(const Collider& a, const Collider& b)>;
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// 形状どうしの詳細判定
+	/// </summary>
+	static bool TestShapes(const Collider& a, const Collider& b);
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="method">広域判定の方式</param>
+	/// <param name="cellSize">空間ハッシュのセルの大きさ（一般的な敵の直径程度）
+	/// 64セルを超えて跨ぐコライダーは空間ハッシュに入れず掃引で判定する</param>
+	void Initialize(Method method = Method::kSpatialHash, float cellSize = 4.0f);
+
+	/// <summary>
+	/// 広域判定の方式の設定
+	/// </summary>
+	void SetMethod(Method method) { method_ = method; }
+
+	/// <summary>
+	/// 空間ハッシュのセルの大きさの設定
+	/// </summary>
+	void SetCellSize(float cellSize);
+
+	/// <summary>
+	/// 詳細判定の設定（未設定なら TestShapes を使う）
+	/// </summary>
+	void SetNarrowphase(Narrowphase narrowphase) { narrowphase_ = std::move(narrowphase); }
+
+	/// <summary>
+	/// 登録済みコライダーのクリア（毎フレーム登録し直す）
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 球の登録
+	/// </summary>
+	/// <param name="group">グループ</param>
+	/// <param name="id">識別子</param>
+	/// <param name="sphere">球</param>
+	void Add(Group group, uint32_t id, const Sphere& sphere);
+
+	/// <summary>
+	/// AABBの登録
+	/// </summary>
+	/// <param name="group">グループ</param>
+	/// <param name="id">識別子</param>
+	/// <param name="aabb">AABB</param>
+	void Add(Group group, uint32_t id, const AABB& aabb);
+
+	/// <summary>
+	/// ワールドトランスフォームの位置に球を登録
+	/// </summary>
+	/// <param name="group">グループ</param>
+	/// <param name="id">識別子</param>
+	/// <param name="worldTransform">ワールドトランスフォーム（translation_ を中心にする）</param>
+	/// <param name="radius">半径</param>
+	void Add(Group group, uint32_t id, const WorldTransform& worldTransform, float radius);
+
+	/// <summary>
+	/// 当たっている組を探す
+	/// </summary>
+	/// <returns>当たっている組（次の呼び出しまで有効）</returns>
+	const std::vector<Pair>& FindPairs();
+
+	/// <summary>
+	/// 登録済みコライダーの取得
+	/// </summary>
+	const std::vector<Collider>& GetColliders(Group group) const {
+		return colliders_[static_cast<size_t>(group)];
+	}
+
+	/// <summary>
+	/// 直近の FindPairs の統計
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private: // サブクラス
+	// 掃引用の要素
+	struct SweepItem {
+		// 掃引軸上の範囲
+		float min;
+		float max;
+		// コライダー番号（最上位ビットはグループB）
+		uint32_t index;
+	};
+
+private: // メンバ関数
+	/// <summary>
+	/// 空間ハッシュで探す
+	/// </summary>
+	void FindPairsSpatialHash();
+
+	/// <summary>
+	/// 1軸の掃引で探す
+	/// </summary>
+	void FindPairsSweepAndPrune();
+
+	/// <summary>
+	/// 指定したコライダーどうしを1軸の掃引で判定する
+	/// </summary>
+	/// <param name="indicesA">グループAのコライダー番号</param>
+	/// <param name="indicesB">グループBのコライダー番号</param>
+	void SweepAndPrune(
+	    const std::vector<uint32_t>& indicesA, const std::vector<uint32_t>& indicesB);
+
+	/// <summary>
+	/// 候補の組を判定して当たっていれば追加
+	/// </summary>
+	void TestPair(uint32_t indexA, uint32_t indexB);
+
+private: // メンバ変数
+	// 方式
+	Method method_ = Method::kSpatialHash;
+	// セルの大きさの逆数
+	float inverseCellSize_ = 0.25f;
+	// 詳細判定
+	Narrowphase narrowphase_;
+	// グループごとのコライダー
+	std::vector<Collider> colliders_[2];
+	// 当たっている組
+	std::vector<Pair> pairs_;
+	// 統計
+	Statistics statistics_;
+
+	// 空間ハッシュ用の作業領域（フレームをまたいで使い回す）
+	std::vector<uint32_t> bucketOffsets_;
+	std::vector<uint32_t> bucketItems_;
+	std::vector<uint32_t> visitStamps_;
+	// グループごとの、空間ハッシュに入れる小さいコライダーと入れない大きいコライダーの番号
+	std::vector<uint32_t> smallIndices_[2];
+	std::vector<uint32_t> largeIndices_[2];
+	// 掃引用の作業領域
+	std::vector<SweepItem> sweepItems_;
+	std::vector<uint32_t> activeItems_[2];
+};
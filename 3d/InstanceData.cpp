@@ -0,0 +1,22 @@
+#include "InstanceData.h"
+#include "WorldTransform.h"
+#include <cassert>
+
+void PackInstances(
+    std::span<const WorldTransform* const> worldTransforms, std::span<const Vector4> colors,
+    InstanceData* dst) {
+	assert(colors.size() <= 1 || colors.size() == worldTransforms.size());
+	const Vector4 kWhite{1.0f, 1.0f, 1.0f, 1.0f};
+
+	if (colors.size() == worldTransforms.size()) {
+		for (size_t i = 0; i < worldTransforms.size(); i++) {
+			dst[i] = InstanceData{worldTransforms[i]->matWorld_, colors[i]};
+		}
+		return;
+	}
+	// 色が共通なら分岐を外に出す
+	const Vector4 color = colors.empty() ? kWhite : colors[0];
+	for (size_t i = 0; i < worldTransforms.size(); i++) {
+		dst[i] = InstanceData{worldTransforms[i]->matWorld_, color};
+	}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector4.h"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+struct WorldTransform;
+
+/// <summary>
+/// インスタンス描画で1体ごとに渡すデータ（ObjInstancedVS.hlsl の InstanceData と同じ並び）
+/// </summary>
+struct InstanceData {
+	Matrix4x4 world; // ワールド行列
+	Vector4 color;   // 色（テクスチャ・ライティングの結果に乗算する）
+};
+static_assert(sizeof(InstanceData) == 80);
+
+// 1回の描画で送るインスタンス数の上限（インスタンスバッファは定数バッファ用ページから切り出す）
+constexpr size_t kMaxInstancesPerDraw = 8192;
+
+/// <summary>
+/// ワールド行列と色をインスタンスデータに詰める
+/// 書き込み先はアップロードヒープ（書き込み結合メモリ）を想定し、前から順に書くだけで読み戻さない
+/// </summary>
+/// <param name="worldTransforms">ワールドトランスフォーム（matWorld_ を使う）</param>
+/// <param name="colors">色（空なら白、1つならすべて同じ色、それ以外はインスタンスと同数）</param>
+/// <param name="dst">書き込み先（worldTransforms と同数）</param>
+void PackInstances(
+    std::span<const WorldTransform* const> worldTransforms, std::span<const Vector4> colors,
+    InstanceData* dst);
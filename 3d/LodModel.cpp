@@ -0,0 +1,96 @@
+#include "LodModel.h"
+#include "MathUtility.h"
+#include "Model.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+LodModel*
+    LodModel::CreateFromOBJ(const std::string& modelname, uint32_t levelCount, bool smoothing) {
+	assert(1 <= levelCount && levelCount <= kMaxLevelCount);
+
+	// メモリ確保
+	LodModel* instance = new LodModel;
+	// 読み込みは1回だけで、各レベルは1つ前のレベルを簡略化して作る
+	// 頂点処理の効率が上がるよう、どのレベルも並べ替えておく
+	instance->levels_ = Model::CreateLodChainFromOBJ(modelname, levelCount, smoothing, true);
+
+	// 元の形の頂点から境界球を求める
+	AABB box{};
+	bool first = true;
+	for (Mesh* mesh : instance->levels_[0]->GetMeshes()) {
+		for (const Mesh::VertexPosNormalUv& vertex : mesh->GetVertices()) {
+			if (first) {
+				box = AABB{vertex.pos, vertex.pos};
+				first = false;
+			}
+			box.min.x = std::min(box.min.x, vertex.pos.x);
+			box.min.y = std::min(box.min.y, vertex.pos.y);
+			box.min.z = std::min(box.min.z, vertex.pos.z);
+			box.max.x = std::max(box.max.x, vertex.pos.x);
+			box.max.y = std::max(box.max.y, vertex.pos.y);
+			box.max.z = std::max(box.max.z, vertex.pos.z);
+		}
+	}
+	instance->bounds_.center = (box.min + box.max) * 0.5f;
+	instance->bounds_.radius = Length(box.max - box.min) * 0.5f;
+	return instance;
+}
+
+float LodModel::CalculateScreenSize(
+    const Sphere& localBounds, const Matrix4x4& matWorld, const Matrix4x4& matView,
+    const Matrix4x4& matProjection) {
+	// 行ベクトル方式なので各行が軸。最も大きい拡大率で半径を伸ばす
+	float scale = 0.0f;
+	for (int row = 0; row < 3; row++) {
+		Vector3 axis{matWorld.m[row][0], matWorld.m[row][1], matWorld.m[row][2]};
+		scale = std::max(scale, Length(axis));
+	}
+	float radius = localBounds.radius * scale;
+	Vector3 center = TransformPoint(TransformPoint(localBounds.center, matWorld), matView);
+
+	// カメラが球の中にあるか近すぎるときは画面を覆うとみなす
+	if (center.z <= radius) {
+		return std::numeric_limits<float>::max();
+	}
+	// 射影後の高さは -1～1 なので、半径 * m[1][1] / 奥行き がそのまま直径 / 画面の高さになる
+	return radius * matProjection.m[1][1] / center.z;
+}
+
+uint32_t LodModel::SelectLevel(float screenSize, uint32_t levelCount, float switchScreenSize) {
+	assert(levelCount > 0);
+	if (screenSize >= switchScreenSize) {
+		return 0;
+	}
+	if (screenSize <= 0.0f) {
+		return levelCount - 1;
+	}
+	// 画面上の大きさが半分になるごとに三角形数が半分のレベルへ下げる
+	float level = std::floor(std::log2(switchScreenSize / screenSize)) + 1.0f;
+	return static_cast<uint32_t>(std::min(level, static_cast<float>(levelCount - 1)));
+}
+
+LodModel::~LodModel() {
+	for (Model* model : levels_) {
+		delete model;
+	}
+}
+
+void LodModel::Draw(const WorldTransform& worldTransform, const ViewProjection& viewProjection) {
+	levels_[SelectLevel(worldTransform, viewProjection)]->Draw(worldTransform, viewProjection);
+}
+
+void LodModel::Draw(
+    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    uint32_t textureHadle) {
+	levels_[SelectLevel(worldTransform, viewProjection)]->Draw(
+	    worldTransform, viewProjection, textureHadle);
+}
+
+uint32_t LodModel::SelectLevel(
+    const WorldTransform& worldTransform, const ViewProjection& viewProjection) const {
+	float screenSize = CalculateScreenSize(
+	    bounds_, worldTransform.matWorld_, viewProjection.matView, viewProjection.matProjection);
+	return SelectLevel(screenSize, GetLevelCount(), switchScreenSize_);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "Collision.h"
+#include "Matrix4x4.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Model;
+struct ViewProjection;
+struct WorldTransform;
+
+/// <summary>
+/// 詳細度（LOD）付きモデル
+/// 読み込み時に簡略化したモデルを段階的に作り、画面に映る大きさで描き分ける
+/// </summary>
+class LodModel {
+public: // 定数
+	// 最大レベル数
+	static constexpr uint32_t kMaxLevelCount = 8;
+	// レベル0で描く最小の画面占有率（直径 / 画面の高さ）。これが半分になるごとに1段下げる
+	static constexpr float kDefaultSwitchScreenSize = 0.5f;
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// OBJファイルから生成
+	/// </summary>
+	/// <param name="modelname">モデル名</param>
+	/// <param name="levelCount">レベル数（レベル n の三角形数は元の 1/2^n）</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <returns>生成されたモデル</returns>
+	static LodModel* CreateFromOBJ(
+	    const std::string& modelname, uint32_t levelCount = 4, bool smoothing = false);
+
+	/// <summary>
+	/// 境界球が画面に占める大きさ（直径 / 画面の高さ）
+	/// </summary>
+	/// <param name="localBounds">モデル座標での境界球</param>
+	/// <param name="matWorld">ワールド行列</param>
+	/// <param name="matView">ビュー行列</param>
+	/// <param name="matProjection">射影行列</param>
+	static float CalculateScreenSize(
+	    const Sphere& localBounds, const Matrix4x4& matWorld, const Matrix4x4& matView,
+	    const Matrix4x4& matProjection);
+
+	/// <summary>
+	/// 画面に占める大きさから描くレベルを選ぶ
+	/// </summary>
+	/// <param name="screenSize">直径 / 画面の高さ</param>
+	/// <param name="levelCount">レベル数</param>
+	/// <param name="switchScreenSize">レベル0で描く最小の画面占有率</param>
+	static uint32_t SelectLevel(float screenSize, uint32_t levelCount, float switchScreenSize);
+
+public: // メンバ関数
+	/// <summary>
+	/// デストラクタ
+	/// </summary>
+	~LodModel();
+
+	/// <summary>
+	/// 描画（画面に映る大きさでレベルを選ぶ）
+	/// </summary>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	void Draw(const WorldTransform& worldTransform, const ViewProjection& viewProjection);
+
+	/// <summary>
+	/// 描画（テクスチャ差し替え）
+	/// </summary>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="textureHadle">テクスチャハンドル</param>
+	void Draw(
+	    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    uint32_t textureHadle);
+
+	/// <summary>
+	/// 描くレベルを選ぶ
+	/// </summary>
+	uint32_t SelectLevel(
+	    const WorldTransform& worldTransform, const ViewProjection& viewProjection) const;
+
+	/// <summary>
+	/// レベル0で描く最小の画面占有率の設定（大きくすると早く粗いレベルに切り替わる）
+	/// </summary>
+	void SetSwitchScreenSize(float switchScreenSize) { switchScreenSize_ = switchScreenSize; }
+
+	/// <summary>
+	/// レベル数
+	/// </summary>
+	uint32_t GetLevelCount() const { return static_cast<uint32_t>(levels_.size()); }
+
+	/// <summary>
+	/// レベルごとのモデル
+	/// </summary>
+	Model* GetLevel(uint32_t level) const { return levels_[level]; }
+
+	/// <summary>
+	/// モデル座標での境界球
+	/// </summary>
+	const Sphere& GetBounds() const { return bounds_; }
+
+private: // メンバ関数
+	LodModel() = default;
+	LodModel(const LodModel&) = delete;
+	const LodModel& operator=(const LodModel&) = delete;
+
+private: // メンバ変数
+	// レベルごとのモデル（0 が元の形）
+	std::vector<Model*> levels_;
+	// モデル座標での境界球
+	Sphere bounds_{};
+	// レベル0で描く最小の画面占有率
+	float switchScreenSize_ = kDefaultSwitchScreenSize;
+};
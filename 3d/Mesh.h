@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Material.h"
+#include "MeshData.h"
 #include "Vector2.h"
 #include "Vector3.h"
 #include <Windows.h>
@@ -51,6 +52,34 @@ public: // メンバ関数
 	/// <param name="index">インデックス</param>
 	void AddIndex(unsigned short index);
 
+	/// <summary>
+	/// 頂点データとインデックスをまとめて設定
+	/// </summary>
+	/// <param name="meshData">CPU側の形状データ</param>
+	/// <returns>成否（16bitインデックスに収まらなければ false）</returns>
+	bool SetGeometry(const MeshData& meshData);
+
+	/// <summary>
+	/// 頂点データとインデックスをまとめて設定（16bitインデックス）
+	/// </summary>
+	/// <param name="vertices">頂点データ</param>
+	/// <param name="vertexCount">頂点数</param>
+	/// <param name="indices">インデックス</param>
+	/// <param name="indexCount">インデックス数</param>
+	void SetGeometry(
+	    const MeshVertex* vertices, size_t vertexCount, const uint16_t* indices, size_t indexCount);
+
+	/// <summary>
+	/// 頂点データとインデックスをまとめて設定（32bitインデックス）
+	/// </summary>
+	/// <param name="vertices">頂点データ</param>
+	/// <param name="vertexCount">頂点数</param>
+	/// <param name="indices">インデックス（頂点数が16bitに収まること）</param>
+	/// <param name="indexCount">インデックス数</param>
+	/// <returns>成否（範囲外のインデックスがあれば何も設定せずに false）</returns>
+	bool SetGeometry(
+	    const MeshVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount);
+
 	/// <summary>
 	/// 頂点データの数を取得
 	/// </summary>
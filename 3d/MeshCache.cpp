@@ -0,0 +1,410 @@
+#include "MeshCache.h"
+#include "ContentHash.h"
+#include "MeshUtility.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+// ファイル識別子
+constexpr char kMagic[4] = {'K', 'M', 'S', 'H'};
+// データ部のアライメント
+constexpr uint64_t kDataAlignment = 16;
+
+// ファイルヘッダ
+struct FileHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t flags;
+	uint32_t meshCount;
+	uint32_t materialCount;
+	uint32_t libraryCount;
+	uint64_t sourceStamp;
+	uint64_t contentHash;
+	uint64_t fileSize;
+	AABB bounds;
+	uint32_t stringTableOffset;
+	uint32_t stringTableSize;
+};
+
+// 形状データの目次
+struct MeshRecord {
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	uint32_t materialNameOffset;
+	uint32_t materialNameLength;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t indexSize;
+	uint32_t reserved;
+	uint64_t vertexOffset;
+	uint64_t indexOffset;
+	AABB bounds;
+};
+
+// マテリアルデータ
+struct MaterialRecord {
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	uint32_t textureOffset;
+	uint32_t textureLength;
+	Vector3 ambient;
+	Vector3 diffuse;
+	Vector3 specular;
+	float alpha;
+};
+
+// マテリアルファイル名
+struct LibraryRecord {
+	uint32_t offset;
+	uint32_t length;
+};
+
+uint64_t AlignUp(uint64_t value) { return (value + kDataAlignment - 1) & ~(kDataAlignment - 1); }
+
+// 文字列表に追加して位置を返す
+uint32_t AddString(std::string& table, const std::string& text) {
+	uint32_t offset = static_cast<uint32_t>(table.size());
+	table += text;
+	return offset;
+}
+
+const FileHeader& GetHeader(const MappedFile& file) {
+	return *reinterpret_cast<const FileHeader*>(file.GetData());
+}
+
+const MeshRecord* GetMeshRecords(const MappedFile& file) {
+	return reinterpret_cast<const MeshRecord*>(file.GetData() + sizeof(FileHeader));
+}
+
+const MaterialRecord* GetMaterialRecords(const MappedFile& file) {
+	return reinterpret_cast<const MaterialRecord*>(
+	    GetMeshRecords(file) + GetHeader(file).meshCount);
+}
+
+const LibraryRecord* GetLibraryRecords(const MappedFile& file) {
+	return reinterpret_cast<const LibraryRecord*>(
+	    GetMaterialRecords(file) + GetHeader(file).materialCount);
+}
+
+} // namespace
+
+std::vector<std::string> MeshCache::GetSourcePaths(
+    const std::string& directoryPath, const std::string& objFilename,
+    const std::vector<std::string>& materialLibraries) {
+	std::vector<std::string> filePaths;
+	filePaths.reserve(materialLibraries.size() + 1);
+	filePaths.push_back(directoryPath + objFilename);
+	for (const std::string& library : materialLibraries) {
+		filePaths.push_back(directoryPath + library);
+	}
+	return filePaths;
+}
+
+bool MeshCache::ReadSource(
+    const std::vector<std::string>& filePaths, bool hashContent, Source* source) {
+	assert(source);
+	*source = {};
+	source->stamp = ContentHash::kOffsetBasis;
+	source->contentHash = ContentHash::kOffsetBasis;
+
+	for (const std::string& filePath : filePaths) {
+		std::error_code error;
+		uint64_t size = std::filesystem::file_size(filePath, error);
+		if (error) {
+			return false;
+		}
+		int64_t time = static_cast<int64_t>(
+		    std::filesystem::last_write_time(filePath, error).time_since_epoch().count());
+		if (error) {
+			return false;
+		}
+		source->stamp = ContentHash::HashValue(size, source->stamp);
+		source->stamp = ContentHash::HashValue(time, source->stamp);
+
+		if (hashContent) {
+			MappedFile file;
+			if (!file.Open(filePath)) {
+				return false;
+			}
+			source->contentHash =
+			    ContentHash::Hash(file.GetData(), file.GetSize(), source->contentHash);
+		}
+	}
+	return true;
+}
+
+bool MeshCache::Write(
+    const std::string& filePath, const ModelData& modelData, const Source& source,
+    uint32_t flags) {
+	FileHeader header{};
+	std::memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	header.flags = flags;
+	header.meshCount = static_cast<uint32_t>(modelData.meshes.size());
+	header.materialCount = static_cast<uint32_t>(modelData.materials.size());
+	header.libraryCount = static_cast<uint32_t>(modelData.materialLibraries.size());
+	header.sourceStamp = source.stamp;
+	header.contentHash = source.contentHash;
+
+	// 目次と文字列表
+	std::string strings;
+	std::vector<MeshRecord> meshRecords(header.meshCount);
+	std::vector<MaterialRecord> materialRecords(header.materialCount);
+	std::vector<LibraryRecord> libraryRecords(header.libraryCount);
+	for (uint32_t i = 0; i < header.materialCount; i++) {
+		const MaterialData& material = modelData.materials[i];
+		MaterialRecord& record = materialRecords[i];
+		record.nameOffset = AddString(strings, material.name);
+		record.nameLength = static_cast<uint32_t>(material.name.size());
+		record.textureOffset = AddString(strings, material.textureFilename);
+		record.textureLength = static_cast<uint32_t>(material.textureFilename.size());
+		record.ambient = material.ambient;
+		record.diffuse = material.diffuse;
+		record.specular = material.specular;
+		record.alpha = material.alpha;
+	}
+	for (uint32_t i = 0; i < header.libraryCount; i++) {
+		const std::string& library = modelData.materialLibraries[i];
+		libraryRecords[i].offset = AddString(strings, library);
+		libraryRecords[i].length = static_cast<uint32_t>(library.size());
+	}
+
+	uint64_t offset = sizeof(FileHeader) + sizeof(MeshRecord) * meshRecords.size() +
+	                  sizeof(MaterialRecord) * materialRecords.size() +
+	                  sizeof(LibraryRecord) * libraryRecords.size();
+	header.stringTableOffset = static_cast<uint32_t>(offset);
+
+	// 頂点・インデックスは16バイト境界に置く。16bitに収まるインデックスは2バイトで持つ
+	std::vector<std::vector<uint16_t>> indices16(header.meshCount);
+	for (uint32_t i = 0; i < header.meshCount; i++) {
+		const MeshData& mesh = modelData.meshes[i];
+		MeshRecord& record = meshRecords[i];
+		record.nameOffset = AddString(strings, mesh.name);
+		record.nameLength = static_cast<uint32_t>(mesh.name.size());
+		record.materialNameOffset = AddString(strings, mesh.materialName);
+		record.materialNameLength = static_cast<uint32_t>(mesh.materialName.size());
+		record.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+		record.indexCount = static_cast<uint32_t>(mesh.indices.size());
+		record.indexSize = mesh.vertices.size() <= 0x10000 ? 2 : 4;
+		record.bounds = CalculateBounds(mesh);
+		if (record.indexSize == 2) {
+			indices16[i].assign(mesh.indices.begin(), mesh.indices.end());
+		}
+	}
+	header.stringTableSize = static_cast<uint32_t>(strings.size());
+	offset += strings.size();
+	for (MeshRecord& record : meshRecords) {
+		record.vertexOffset = offset = AlignUp(offset);
+		offset += sizeof(MeshVertex) * record.vertexCount;
+		record.indexOffset = offset = AlignUp(offset);
+		offset += static_cast<uint64_t>(record.indexSize) * record.indexCount;
+	}
+	header.fileSize = offset;
+
+	// モデル全体の境界箱
+	for (uint32_t i = 0; i < header.meshCount; i++) {
+		const AABB& bounds = meshRecords[i].bounds;
+		if (i == 0) {
+			header.bounds = bounds;
+			continue;
+		}
+		header.bounds.min.x = std::min(header.bounds.min.x, bounds.min.x);
+		header.bounds.min.y = std::min(header.bounds.min.y, bounds.min.y);
+		header.bounds.min.z = std::min(header.bounds.min.z, bounds.min.z);
+		header.bounds.max.x = std::max(header.bounds.max.x, bounds.max.x);
+		header.bounds.max.y = std::max(header.bounds.max.y, bounds.max.y);
+		header.bounds.max.z = std::max(header.bounds.max.z, bounds.max.z);
+	}
+
+	// 書きかけのファイルを読まれないよう、別名で書いてから置き換える
+	std::string temporaryPath = filePath + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+		auto write = [&file](const void* data, uint64_t size) {
+			file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		};
+		auto pad = [&file, &write](uint64_t position) {
+			static const char kZeros[kDataAlignment] = {};
+			uint64_t current = static_cast<uint64_t>(file.tellp());
+			write(kZeros, position - current);
+		};
+		write(&header, sizeof(header));
+		write(meshRecords.data(), sizeof(MeshRecord) * meshRecords.size());
+		write(materialRecords.data(), sizeof(MaterialRecord) * materialRecords.size());
+		write(libraryRecords.data(), sizeof(LibraryRecord) * libraryRecords.size());
+		write(strings.data(), strings.size());
+		for (uint32_t i = 0; i < header.meshCount; i++) {
+			const MeshData& mesh = modelData.meshes[i];
+			const MeshRecord& record = meshRecords[i];
+			pad(record.vertexOffset);
+			write(mesh.vertices.data(), sizeof(MeshVertex) * record.vertexCount);
+			pad(record.indexOffset);
+			if (record.indexSize == 2) {
+				write(indices16[i].data(), sizeof(uint16_t) * record.indexCount);
+			} else {
+				write(mesh.indices.data(), sizeof(uint32_t) * record.indexCount);
+			}
+		}
+		if (!file) {
+			return false;
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, filePath, error);
+	return !error;
+}
+
+bool MeshCache::RewriteSource(const std::string& filePath, const Source& source) {
+	std::fstream file(filePath, std::ios::binary | std::ios::in | std::ios::out);
+	if (!file) {
+		return false;
+	}
+	file.seekp(offsetof(FileHeader, sourceStamp));
+	file.write(reinterpret_cast<const char*>(&source.stamp), sizeof(source.stamp));
+	file.write(reinterpret_cast<const char*>(&source.contentHash), sizeof(source.contentHash));
+	return static_cast<bool>(file);
+}
+
+bool MeshCache::Open(const std::string& filePath) {
+	Close();
+	if (!file_.Open(filePath) || !Validate()) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MeshCache::Close() {
+	file_.Close();
+	materials_.clear();
+	materialLibraries_.clear();
+}
+
+bool MeshCache::Validate() {
+	if (file_.GetSize() < sizeof(FileHeader)) {
+		return false;
+	}
+	const FileHeader& header = GetHeader(file_);
+	if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+	    header.fileSize != file_.GetSize()) {
+		return false;
+	}
+	uint64_t tableEnd = sizeof(FileHeader) + sizeof(MeshRecord) * uint64_t(header.meshCount) +
+	                    sizeof(MaterialRecord) * uint64_t(header.materialCount) +
+	                    sizeof(LibraryRecord) * uint64_t(header.libraryCount);
+	if (header.stringTableOffset != tableEnd ||
+	    file_.GetSize() < tableEnd + header.stringTableSize) {
+		return false;
+	}
+
+	// 範囲外を指していないか
+	auto isStringValid = [&header](uint32_t offset, uint32_t length) {
+		return uint64_t(offset) + length <= header.stringTableSize;
+	};
+	const MeshRecord* meshRecords = GetMeshRecords(file_);
+	for (uint32_t i = 0; i < header.meshCount; i++) {
+		const MeshRecord& record = meshRecords[i];
+		if (!isStringValid(record.nameOffset, record.nameLength) ||
+		    !isStringValid(record.materialNameOffset, record.materialNameLength) ||
+		    (record.indexSize != 2 && record.indexSize != 4) ||
+		    record.vertexOffset % kDataAlignment != 0 || record.indexOffset % kDataAlignment != 0 ||
+		    file_.GetSize() < record.vertexOffset + sizeof(MeshVertex) * record.vertexCount ||
+		    file_.GetSize() < record.indexOffset + uint64_t(record.indexSize) * record.indexCount) {
+			return false;
+		}
+	}
+
+	// マテリアルとファイル名は小さいので展開しておく
+	const MaterialRecord* materialRecords = GetMaterialRecords(file_);
+	materials_.resize(header.materialCount);
+	for (uint32_t i = 0; i < header.materialCount; i++) {
+		const MaterialRecord& record = materialRecords[i];
+		if (!isStringValid(record.nameOffset, record.nameLength) ||
+		    !isStringValid(record.textureOffset, record.textureLength)) {
+			return false;
+		}
+		MaterialData& material = materials_[i];
+		material.name = GetString(record.nameOffset, record.nameLength);
+		material.textureFilename = GetString(record.textureOffset, record.textureLength);
+		material.ambient = record.ambient;
+		material.diffuse = record.diffuse;
+		material.specular = record.specular;
+		material.alpha = record.alpha;
+	}
+	const LibraryRecord* libraryRecords = GetLibraryRecords(file_);
+	materialLibraries_.resize(header.libraryCount);
+	for (uint32_t i = 0; i < header.libraryCount; i++) {
+		if (!isStringValid(libraryRecords[i].offset, libraryRecords[i].length)) {
+			return false;
+		}
+		materialLibraries_[i] = GetString(libraryRecords[i].offset, libraryRecords[i].length);
+	}
+	return true;
+}
+
+bool MeshCache::IsUpToDate(
+    const std::string& directoryPath, const std::string& objFilename, uint32_t flags,
+    Source* current) const {
+	assert(current);
+	if (!file_.IsOpen() || GetHeader(file_).flags != flags) {
+		return false;
+	}
+	std::vector<std::string> filePaths =
+	    GetSourcePaths(directoryPath, objFilename, materialLibraries_);
+
+	// 大きさと更新時刻が同じなら中身は読まない
+	Source cached = GetSource();
+	if (!ReadSource(filePaths, false, current)) {
+		return false;
+	}
+	if (current->stamp == cached.stamp) {
+		current->contentHash = cached.contentHash;
+		return true;
+	}
+	// 更新時刻だけ変わった場合に備えて中身で比べる
+	return ReadSource(filePaths, true, current) && current->contentHash == cached.contentHash;
+}
+
+MeshCache::Source MeshCache::GetSource() const {
+	assert(file_.IsOpen());
+	const FileHeader& header = GetHeader(file_);
+	return Source{header.sourceStamp, header.contentHash};
+}
+
+uint32_t MeshCache::GetMeshCount() const {
+	return file_.IsOpen() ? GetHeader(file_).meshCount : 0;
+}
+
+MeshCache::MeshView MeshCache::GetMesh(uint32_t index) const {
+	assert(index < GetMeshCount());
+	const MeshRecord& record = GetMeshRecords(file_)[index];
+	MeshView view;
+	view.name = GetString(record.nameOffset, record.nameLength);
+	view.materialName = GetString(record.materialNameOffset, record.materialNameLength);
+	view.vertices = reinterpret_cast<const MeshVertex*>(file_.GetData() + record.vertexOffset);
+	view.vertexCount = record.vertexCount;
+	view.indices = file_.GetData() + record.indexOffset;
+	view.indexCount = record.indexCount;
+	view.indexSize = record.indexSize;
+	view.bounds = record.bounds;
+	return view;
+}
+
+AABB MeshCache::GetBounds() const {
+	assert(file_.IsOpen());
+	return GetHeader(file_).bounds;
+}
+
+std::string_view MeshCache::GetString(uint32_t offset, uint32_t length) const {
+	const char* table =
+	    reinterpret_cast<const char*>(file_.GetData() + GetHeader(file_).stringTableOffset);
+	return std::string_view(table + offset, length);
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "Collision.h"
+#include "MappedFile.h"
+#include "MeshData.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// <summary>
+/// バイナリ形式のメッシュキャッシュ
+/// 頂点・インデックス・マテリアル・境界箱を保存し、読み込み時はメモリマップして解析なしで参照する
+/// </summary>
+class MeshCache {
+public: // 定数
+	// 形式のバージョン（レイアウトか、簡略化など中身の作り方を変えたら上げる）
+	static constexpr uint32_t kVersion = 4;
+	// 法線を平滑化済み
+	static constexpr uint32_t kFlagSmoothing = 1u << 0;
+	// 頂点キャッシュ・重ね描き向けに並べ替え済み
+	static constexpr uint32_t kFlagOptimized = 1u << 1;
+	// 簡略化した詳細度レベル（flags の 8-15 bit に入れる。0 は元の形）
+	static constexpr uint32_t kLodLevelShift = 8;
+
+public: // サブクラス
+	/// <summary>
+	/// 元ファイルの識別情報
+	/// </summary>
+	struct Source {
+		// 大きさと更新時刻から作るハッシュ（変化していなければ中身も変わっていないとみなす）
+		uint64_t stamp = 0;
+		// 中身のハッシュ
+		uint64_t contentHash = 0;
+	};
+
+	/// <summary>
+	/// 形状データの参照（Close するまで有効）
+	/// </summary>
+	struct MeshView {
+		// 名前
+		std::string_view name;
+		// マテリアル名
+		std::string_view materialName;
+		// 頂点データ
+		const MeshVertex* vertices = nullptr;
+		uint32_t vertexCount = 0;
+		// インデックス（indexSize が 2 なら uint16_t、4 なら uint32_t）
+		const void* indices = nullptr;
+		uint32_t indexCount = 0;
+		uint32_t indexSize = 0;
+		// 境界箱
+		AABB bounds{};
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// 元ファイルのパス一覧（OBJとマテリアルファイル）
+	/// </summary>
+	/// <param name="directoryPath">ディレクトリ</param>
+	/// <param name="objFilename">OBJファイル名</param>
+	/// <param name="materialLibraries">マテリアルファイル名</param>
+	static std::vector<std::string> GetSourcePaths(
+	    const std::string& directoryPath, const std::string& objFilename,
+	    const std::vector<std::string>& materialLibraries);
+
+	/// <summary>
+	/// 元ファイルの識別情報を取得
+	/// </summary>
+	/// <param name="filePaths">元ファイルのパス一覧</param>
+	/// <param name="hashContent">中身のハッシュも計算するか</param>
+	/// <param name="source">出力先</param>
+	/// <returns>成否（ファイルが無ければ false）</returns>
+	static bool ReadSource(
+	    const std::vector<std::string>& filePaths, bool hashContent, Source* source);
+
+	/// <summary>
+	/// キャッシュファイルの書き出し
+	/// </summary>
+	/// <param name="filePath">書き出し先</param>
+	/// <param name="modelData">モデルデータ</param>
+	/// <param name="source">元ファイルの識別情報</param>
+	/// <param name="flags">kFlagSmoothing など</param>
+	/// <returns>成否</returns>
+	static bool Write(
+	    const std::string& filePath, const ModelData& modelData, const Source& source,
+	    uint32_t flags);
+
+	/// <summary>
+	/// 元ファイルの識別情報だけを書き換える（中身が同じで更新時刻だけ変わったとき用）
+	/// </summary>
+	static bool RewriteSource(const std::string& filePath, const Source& source);
+
+public: // メンバ関数
+	/// <summary>
+	/// キャッシュファイルを開く
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>成否（無い・壊れている・バージョン違いなら false）</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// 閉じる
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// 元ファイルから作り直す必要がないか
+	/// </summary>
+	/// <param name="directoryPath">ディレクトリ</param>
+	/// <param name="objFilename">OBJファイル名</param>
+	/// <param name="flags">要求する kFlagSmoothing など</param>
+	/// <param name="current">現在の元ファイルの識別情報の出力先</param>
+	bool IsUpToDate(
+	    const std::string& directoryPath, const std::string& objFilename, uint32_t flags,
+	    Source* current) const;
+
+	/// <summary>
+	/// 保存されている元ファイルの識別情報
+	/// </summary>
+	Source GetSource() const;
+
+	/// <summary>
+	/// 形状データの数
+	/// </summary>
+	uint32_t GetMeshCount() const;
+
+	/// <summary>
+	/// 形状データの参照
+	/// </summary>
+	MeshView GetMesh(uint32_t index) const;
+
+	/// <summary>
+	/// マテリアルデータ
+	/// </summary>
+	const std::vector<MaterialData>& GetMaterials() const { return materials_; }
+
+	/// <summary>
+	/// マテリアルファイル名
+	/// </summary>
+	const std::vector<std::string>& GetMaterialLibraries() const { return materialLibraries_; }
+
+	/// <summary>
+	/// モデル全体の境界箱
+	/// </summary>
+	AABB GetBounds() const;
+
+private: // メンバ関数
+	/// <summary>
+	/// 中身の検証と文字列の展開
+	/// </summary>
+	bool Validate();
+
+	/// <summary>
+	/// 文字列表の参照
+	/// </summary>
+	std::string_view GetString(uint32_t offset, uint32_t length) const;
+
+private: // メンバ変数
+	// ファイル
+	MappedFile file_;
+	// マテリアルデータ
+	std::vector<MaterialData> materials_;
+	// マテリアルファイル名
+	std::vector<std::string> materialLibraries_;
+};
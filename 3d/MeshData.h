@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 頂点データ（Mesh::VertexPosNormalUv と同じ並び）
+/// </summary>
+struct MeshVertex {
+	Vector3 pos;    // xyz座標
+	Vector3 normal; // 法線ベクトル
+	Vector2 uv;     // uv座標
+};
+
+/// <summary>
+/// CPU側の形状データ
+/// GPUリソースを持たないので、読み込みや最適化の処理の間で受け渡しに使う
+/// </summary>
+struct MeshData {
+	// 名前
+	std::string name;
+	// マテリアル名
+	std::string materialName;
+	// 頂点データ配列
+	std::vector<MeshVertex> vertices;
+	// 頂点インデックス配列（三角形リスト）
+	std::vector<uint32_t> indices;
+	// 頂点ごとの読み込み元の座標番号（平滑化で同じ座標の頂点をまとめるのに使う）
+	std::vector<uint32_t> positionIndices;
+};
+
+/// <summary>
+/// CPU側のマテリアルデータ（Material の公開パラメータと同じ）
+/// </summary>
+struct MaterialData {
+	// マテリアル名
+	std::string name;
+	// アンビエント影響度
+	Vector3 ambient = {0.3f, 0.3f, 0.3f};
+	// ディフューズ影響度
+	Vector3 diffuse = {0.0f, 0.0f, 0.0f};
+	// スペキュラー影響度
+	Vector3 specular = {0.0f, 0.0f, 0.0f};
+	// アルファ
+	float alpha = 1.0f;
+	// テクスチャファイル名
+	std::string textureFilename;
+};
+
+/// <summary>
+/// CPU側のモデルデータ
+/// </summary>
+struct ModelData {
+	// 形状データ
+	std::vector<MeshData> meshes;
+	// マテリアルデータ
+	std::vector<MaterialData> materials;
+	// マテリアルファイル名
+	std::vector<std::string> materialLibraries;
+	// 座標の数（positionIndices はこれ未満）
+	uint32_t positionCount = 0;
+};
@@ -0,0 +1,296 @@
+#include "MeshOptimizer.h"
+#include "MathUtility.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+// 頂点読み込みのキャッシュラインの大きさ
+constexpr size_t kFetchLineSize = 64;
+// 頂点読み込みのキャッシュのライン数
+constexpr size_t kFetchLineCount = 128;
+
+/// <summary>
+/// 頂点から三角形への隣接（CSR形式）
+/// </summary>
+struct VertexAdjacency {
+	// offsets[v] から offsets[v + 1] までが頂点 v を使う三角形
+	std::vector<uint32_t> offsets;
+	std::vector<uint32_t> triangles;
+};
+
+/// <summary>
+/// 頂点から三角形への隣接を作る
+/// </summary>
+VertexAdjacency BuildAdjacency(const MeshData& mesh) {
+	VertexAdjacency adjacency;
+	adjacency.offsets.assign(mesh.vertices.size() + 1, 0);
+	for (uint32_t index : mesh.indices) {
+		adjacency.offsets[index + 1]++;
+	}
+	for (size_t v = 0; v < mesh.vertices.size(); v++) {
+		adjacency.offsets[v + 1] += adjacency.offsets[v];
+	}
+	adjacency.triangles.resize(mesh.indices.size());
+	std::vector<uint32_t> cursor(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+	for (size_t i = 0; i < mesh.indices.size(); i++) {
+		adjacency.triangles[cursor[mesh.indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+	return adjacency;
+}
+
+} // namespace
+
+VertexCacheStatistics AnalyzeVertexCache(const MeshData& mesh, uint32_t cacheSize) {
+	assert(cacheSize > 0);
+	VertexCacheStatistics statistics;
+	if (mesh.indices.empty()) {
+		return statistics;
+	}
+
+	// 変換後頂点キャッシュ（FIFO）。入った時刻で管理し、cacheSize 回の入れ替えで追い出す
+	std::vector<uint64_t> cacheTime(mesh.vertices.size(), 0);
+	uint64_t time = uint64_t(cacheSize) + 1;
+	size_t transformCount = 0;
+
+	// 頂点読み込みのキャッシュ（FIFO、キャッシュライン単位）
+	size_t lineCount = (sizeof(MeshVertex) * mesh.vertices.size()) / kFetchLineSize + 2;
+	std::vector<uint64_t> lineTime(lineCount, 0);
+	uint64_t lineClock = kFetchLineCount + 1;
+	size_t fetchedLineCount = 0;
+
+	std::vector<bool> used(mesh.vertices.size(), false);
+	size_t usedCount = 0;
+	for (uint32_t index : mesh.indices) {
+		if (!used[index]) {
+			used[index] = true;
+			usedCount++;
+		}
+		if (time - cacheTime[index] <= cacheSize) {
+			continue;
+		}
+		// 頂点シェーダが走る
+		cacheTime[index] = time++;
+		transformCount++;
+
+		// 頂点データが載っているラインを読む
+		size_t first = (sizeof(MeshVertex) * index) / kFetchLineSize;
+		size_t last = (sizeof(MeshVertex) * (index + 1) - 1) / kFetchLineSize;
+		for (size_t line = first; line <= last; line++) {
+			if (lineClock - lineTime[line] > kFetchLineCount) {
+				lineTime[line] = lineClock++;
+				fetchedLineCount++;
+			}
+		}
+	}
+
+	statistics.acmr = static_cast<float>(transformCount) /
+	                  static_cast<float>(mesh.indices.size() / 3);
+	statistics.atvr = static_cast<float>(transformCount) / static_cast<float>(usedCount);
+	statistics.overfetch = static_cast<float>(fetchedLineCount * kFetchLineSize) /
+	                       static_cast<float>(usedCount * sizeof(MeshVertex));
+	return statistics;
+}
+
+std::vector<uint32_t> OptimizeVertexCache(MeshData& mesh, uint32_t cacheSize) {
+	assert(mesh.indices.size() % 3 == 0);
+	std::vector<uint32_t> clusters;
+	const size_t vertexCount = mesh.vertices.size();
+	const size_t triangleCount = mesh.indices.size() / 3;
+	if (triangleCount == 0) {
+		return clusters;
+	}
+
+	// Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+	VertexAdjacency adjacency = BuildAdjacency(mesh);
+	// まだ出力していない三角形の数
+	std::vector<uint32_t> liveCount(vertexCount);
+	for (size_t v = 0; v < vertexCount; v++) {
+		liveCount[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+	}
+	std::vector<uint64_t> cacheTime(vertexCount, 0);
+	uint64_t time = uint64_t(cacheSize) + 1;
+	std::vector<bool> emitted(triangleCount, false);
+	// 行き止まりになったときに戻る候補
+	std::vector<uint32_t> deadEnd;
+	std::vector<uint32_t> candidates;
+	size_t cursor = 0;
+
+	std::vector<uint32_t> output;
+	output.reserve(mesh.indices.size());
+
+	// 隣接をたどれなくなったときの次の頂点（見つからなければ -1）
+	auto skipDeadEnd = [&]() -> int64_t {
+		while (!deadEnd.empty()) {
+			uint32_t vertex = deadEnd.back();
+			deadEnd.pop_back();
+			if (liveCount[vertex] > 0) {
+				return vertex;
+			}
+		}
+		for (; cursor < vertexCount; cursor++) {
+			if (liveCount[cursor] > 0) {
+				return static_cast<int64_t>(cursor);
+			}
+		}
+		return -1;
+	};
+
+	int64_t fanning = skipDeadEnd();
+	clusters.push_back(0);
+	while (fanning >= 0) {
+		// 扇の中心にした頂点を使う三角形をすべて出す
+		candidates.clear();
+		uint32_t center = static_cast<uint32_t>(fanning);
+		for (uint32_t a = adjacency.offsets[center]; a < adjacency.offsets[center + 1]; a++) {
+			uint32_t triangle = adjacency.triangles[a];
+			if (emitted[triangle]) {
+				continue;
+			}
+			emitted[triangle] = true;
+			for (size_t k = 0; k < 3; k++) {
+				uint32_t vertex = mesh.indices[triangle * 3 + k];
+				output.push_back(vertex);
+				deadEnd.push_back(vertex);
+				candidates.push_back(vertex);
+				liveCount[vertex]--;
+				if (time - cacheTime[vertex] > cacheSize) {
+					cacheTime[vertex] = time++;
+				}
+			}
+		}
+
+		// 残りの三角形を出し終えるまでキャッシュに残る頂点のうち、最も古いものを次の中心にする
+		int64_t best = -1;
+		int64_t bestPriority = -1;
+		for (uint32_t vertex : candidates) {
+			if (liveCount[vertex] == 0) {
+				continue;
+			}
+			int64_t priority = 0;
+			if (time - cacheTime[vertex] + 2 * uint64_t(liveCount[vertex]) <= cacheSize) {
+				priority = static_cast<int64_t>(time - cacheTime[vertex]);
+			}
+			if (priority > bestPriority) {
+				bestPriority = priority;
+				best = vertex;
+			}
+		}
+		if (best < 0) {
+			best = skipDeadEnd();
+			// 隣接をたどれず飛んだのでここでクラスタを区切る
+			if (best >= 0 && output.size() / 3 < triangleCount) {
+				clusters.push_back(static_cast<uint32_t>(output.size() / 3));
+			}
+		}
+		fanning = best;
+	}
+	assert(output.size() == mesh.indices.size());
+	mesh.indices = std::move(output);
+	return clusters;
+}
+
+void OptimizeOverdraw(MeshData& mesh, const std::vector<uint32_t>& clusters) {
+	const size_t triangleCount = mesh.indices.size() / 3;
+	if (clusters.size() <= 1) {
+		return;
+	}
+
+	// クラスタごとの重心と向き（面積で重み付け）
+	struct Cluster {
+		uint32_t begin;
+		uint32_t end;
+		float sortKey;
+	};
+	std::vector<Cluster> sorted(clusters.size());
+	std::vector<Vector3> centroids(clusters.size());
+	std::vector<Vector3> normals(clusters.size());
+	Vector3 meshCentroid{0.0f, 0.0f, 0.0f};
+	float meshArea = 0.0f;
+	for (size_t c = 0; c < clusters.size(); c++) {
+		uint32_t begin = clusters[c];
+		uint32_t end = c + 1 < clusters.size() ? clusters[c + 1]
+		                                         : static_cast<uint32_t>(triangleCount);
+		Vector3 centroid{0.0f, 0.0f, 0.0f};
+		Vector3 normal{0.0f, 0.0f, 0.0f};
+		float area = 0.0f;
+		for (uint32_t t = begin; t < end; t++) {
+			const Vector3& p0 = mesh.vertices[mesh.indices[t * 3 + 0]].pos;
+			const Vector3& p1 = mesh.vertices[mesh.indices[t * 3 + 1]].pos;
+			const Vector3& p2 = mesh.vertices[mesh.indices[t * 3 + 2]].pos;
+			Vector3 cross = Cross(p1 - p0, p2 - p0);
+			float triangleArea = Length(cross);
+			centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+			normal += cross;
+			area += triangleArea;
+		}
+		meshCentroid += centroid;
+		meshArea += area;
+		centroids[c] = area > 0.0f ? centroid * (1.0f / area) : centroid;
+		normals[c] = Length(normal) > 0.0f ? Normalize(normal) : normal;
+		sorted[c] = Cluster{begin, end, 0.0f};
+	}
+	if (meshArea > 0.0f) {
+		meshCentroid *= 1.0f / meshArea;
+	}
+
+	// 中心から外を向いている度合いが大きいクラスタほど手前に来やすいので先に描く
+	for (size_t c = 0; c < clusters.size(); c++) {
+		sorted[c].sortKey = Dot(centroids[c] - meshCentroid, normals[c]);
+	}
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster& a, const Cluster& b) {
+		return a.sortKey > b.sortKey;
+	});
+
+	std::vector<uint32_t> output;
+	output.reserve(mesh.indices.size());
+	for (const Cluster& cluster : sorted) {
+		output.insert(
+		    output.end(), mesh.indices.begin() + size_t(cluster.begin) * 3,
+		    mesh.indices.begin() + size_t(cluster.end) * 3);
+	}
+	mesh.indices = std::move(output);
+}
+
+void OptimizeVertexFetch(MeshData& mesh) {
+	constexpr uint32_t kNone = UINT32_MAX;
+	const size_t vertexCount = mesh.vertices.size();
+	const bool hasPositionIndices = mesh.positionIndices.size() == vertexCount;
+
+	// 最初に参照された順に新しい番号を振る
+	std::vector<uint32_t> remap(vertexCount, kNone);
+	uint32_t next = 0;
+	for (uint32_t& index : mesh.indices) {
+		if (remap[index] == kNone) {
+			remap[index] = next++;
+		}
+		index = remap[index];
+	}
+	for (size_t v = 0; v < vertexCount; v++) {
+		if (remap[v] == kNone) {
+			remap[v] = next++;
+		}
+	}
+
+	std::vector<MeshVertex> vertices(vertexCount);
+	std::vector<uint32_t> positionIndices(hasPositionIndices ? vertexCount : 0);
+	for (size_t v = 0; v < vertexCount; v++) {
+		vertices[remap[v]] = mesh.vertices[v];
+		if (hasPositionIndices) {
+			positionIndices[remap[v]] = mesh.positionIndices[v];
+		}
+	}
+	mesh.vertices = std::move(vertices);
+	if (hasPositionIndices) {
+		mesh.positionIndices = std::move(positionIndices);
+	}
+}
+
+void OptimizeMesh(MeshData& mesh, bool reduceOverdraw) {
+	std::vector<uint32_t> clusters = OptimizeVertexCache(mesh);
+	if (reduceOverdraw) {
+		OptimizeOverdraw(mesh, clusters);
+	}
+	// 三角形の順番が決まってから頂点を並べる
+	OptimizeVertexFetch(mesh);
+}
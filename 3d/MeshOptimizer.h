@@ -0,0 +1,58 @@
+#pragma once
+
+#include "MeshData.h"
+#include <cstdint>
+#include <vector>
+
+// 頂点キャッシュの大きさ（最適化と計測で想定するエントリ数）
+constexpr uint32_t kVertexCacheSize = 16;
+
+/// <summary>
+/// 頂点処理の効率の計測結果
+/// </summary>
+struct VertexCacheStatistics {
+	// 三角形あたりの頂点シェーダ実行回数（理想は0.5前後、最悪3）
+	float acmr = 0.0f;
+	// 頂点あたりの頂点シェーダ実行回数（理想は1）
+	float atvr = 0.0f;
+	// 頂点バッファから読み込むバイト数 / 頂点データのバイト数（理想は1）
+	float overfetch = 0.0f;
+};
+
+/// <summary>
+/// 頂点処理の効率をCPUで計測する
+/// 変換後頂点キャッシュはFIFO、頂点の読み込みは64バイト単位のキャッシュとして数える
+/// </summary>
+/// <param name="mesh">形状データ</param>
+/// <param name="cacheSize">変換後頂点キャッシュのエントリ数</param>
+VertexCacheStatistics
+    AnalyzeVertexCache(const MeshData& mesh, uint32_t cacheSize = kVertexCacheSize);
+
+/// <summary>
+/// 変換後頂点キャッシュに合わせて三角形を並べ替える（Tipsify）
+/// </summary>
+/// <param name="mesh">形状データ</param>
+/// <param name="cacheSize">想定するキャッシュのエントリ数</param>
+/// <returns>クラスタの先頭の三角形番号（隣接をたどれず飛んだ位置で区切る）</returns>
+std::vector<uint32_t> OptimizeVertexCache(MeshData& mesh, uint32_t cacheSize = kVertexCacheSize);
+
+/// <summary>
+/// 外を向いたクラスタから描くように並べ替えて重ね描きを減らす
+/// </summary>
+/// <param name="mesh">形状データ</param>
+/// <param name="clusters">OptimizeVertexCache が返したクラスタの先頭</param>
+void OptimizeOverdraw(MeshData& mesh, const std::vector<uint32_t>& clusters);
+
+/// <summary>
+/// 頂点を最初に参照される順に並べ替えて読み込みを連続させる
+/// 参照されない頂点は末尾に残す
+/// </summary>
+/// <param name="mesh">形状データ</param>
+void OptimizeVertexFetch(MeshData& mesh);
+
+/// <summary>
+/// 頂点キャッシュ・重ね描き・頂点読み込みの最適化をまとめて行う
+/// </summary>
+/// <param name="mesh">形状データ</param>
+/// <param name="reduceOverdraw">重ね描きを減らす並べ替えも行うか</param>
+void OptimizeMesh(MeshData& mesh, bool reduceOverdraw = true);
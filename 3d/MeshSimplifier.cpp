@@ -0,0 +1,602 @@
+#include "MeshSimplifier.h"
+#include "MathUtility.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// 縮約後の面の向きがこれより変わる縮約はしない（元の向きとの内積）
+constexpr float kMinFlipDot = 0.25f;
+// 法線・UVの差の重み（辺の長さの2乗に掛ける）
+constexpr double kAttributeWeight = 1.0;
+// 同じ属性とみなす法線・UVの差（2乗）
+constexpr float kWeldEpsilon = 1.0e-8f;
+// 頂点の法線が面の法線とこれ以上揃っていればフラットシェーディングとみなす（内積）
+constexpr float kFacetedDot = 0.9999f;
+
+/// <summary>
+/// 二次誤差（平面までの距離の2乗和を表す対称4x4行列の上三角）
+/// </summary>
+struct Quadric {
+	double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+	double b2 = 0.0, bc = 0.0, bd = 0.0;
+	double c2 = 0.0, cd = 0.0;
+	double d2 = 0.0;
+
+	/// <summary>
+	/// 平面 ax + by + cz + d = 0 を足す
+	/// </summary>
+	void AddPlane(double a, double b, double c, double d) {
+		a2 += a * a, ab += a * b, ac += a * c, ad += a * d;
+		b2 += b * b, bc += b * c, bd += b * d;
+		c2 += c * c, cd += c * d;
+		d2 += d * d;
+	}
+
+	Quadric& operator+=(const Quadric& q) {
+		a2 += q.a2, ab += q.ab, ac += q.ac, ad += q.ad;
+		b2 += q.b2, bc += q.bc, bd += q.bd;
+		c2 += q.c2, cd += q.cd;
+		d2 += q.d2;
+		return *this;
+	}
+
+	/// <summary>
+	/// 点 p での誤差
+	/// </summary>
+	double Evaluate(const Vector3& p) const {
+		double x = p.x, y = p.y, z = p.z;
+		double result = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x +
+		                b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y + c2 * z * z +
+		                2.0 * cd * z + d2;
+		// 丸め誤差で負にならないようにする
+		return std::max(result, 0.0);
+	}
+};
+
+/// <summary>
+/// 縮約の候補
+/// </summary>
+struct Collapse {
+	uint32_t from;
+	uint32_t to;
+	double cost;
+};
+
+/// <summary>
+/// 2乗距離
+/// </summary>
+float DistanceSquared(const Vector3& a, const Vector3& b) {
+	Vector3 d = a - b;
+	return Dot(d, d);
+}
+
+/// <summary>
+/// 法線とUVが同じか
+/// </summary>
+bool HasSameAttributes(const MeshVertex& a, const MeshVertex& b, bool ignoreNormal) {
+	const float uvDistanceSquared = (a.uv.x - b.uv.x) * (a.uv.x - b.uv.x) +
+	                                (a.uv.y - b.uv.y) * (a.uv.y - b.uv.y);
+	return uvDistanceSquared <= kWeldEpsilon &&
+	       (ignoreNormal || DistanceSquared(a.normal, b.normal) <= kWeldEpsilon);
+}
+
+/// <summary>
+/// すべての頂点の法線がその頂点を使う面の法線と一致するか（フラットシェーディング）
+/// </summary>
+bool IsFaceted(const MeshData& mesh) {
+	bool hasFace = false;
+	for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+		const MeshVertex* v[3] = {
+		    &mesh.vertices[mesh.indices[i + 0]], &mesh.vertices[mesh.indices[i + 1]],
+		    &mesh.vertices[mesh.indices[i + 2]]};
+		Vector3 cross = Cross(v[1]->pos - v[0]->pos, v[2]->pos - v[0]->pos);
+		float length = Length(cross);
+		if (length <= 0.0f) {
+			continue;
+		}
+		Vector3 n = cross * (1.0f / length);
+		for (const MeshVertex* vertex : v) {
+			if (Dot(vertex->normal, n) < kFacetedDot) {
+				return false;
+			}
+		}
+		hasFace = true;
+	}
+	return hasFace;
+}
+
+/// <summary>
+/// 同じ座標で法線・UVも同じ頂点を1つにまとめる
+/// </summary>
+/// <returns>頂点ごとのまとめ先</returns>
+std::vector<uint32_t> WeldVertices(const MeshData& mesh, bool ignoreNormal) {
+	const size_t vertexCount = mesh.vertices.size();
+	std::vector<uint32_t> weld(vertexCount);
+	for (uint32_t v = 0; v < vertexCount; v++) {
+		weld[v] = v;
+	}
+	if (mesh.positionIndices.size() != vertexCount) {
+		return weld;
+	}
+
+	// 座標ごとに、それまでに出てきた別属性の頂点と比べる
+	std::unordered_map<uint32_t, std::vector<uint32_t>> groups;
+	groups.reserve(vertexCount);
+	for (uint32_t v = 0; v < vertexCount; v++) {
+		std::vector<uint32_t>& group = groups[mesh.positionIndices[v]];
+		for (uint32_t other : group) {
+			if (HasSameAttributes(mesh.vertices[v], mesh.vertices[other], ignoreNormal)) {
+				weld[v] = other;
+				break;
+			}
+		}
+		if (weld[v] == v) {
+			group.push_back(v);
+		}
+	}
+	return weld;
+}
+
+/// <summary>
+/// 動かしてはいけない頂点（継ぎ目・開いた縁）に印を付ける
+/// 同じ属性の頂点はまとめた後なので、同じ座標に残っている別の頂点は法線かUVが違う継ぎ目
+/// </summary>
+std::vector<bool> FindLockedVertices(const MeshData& mesh) {
+	const size_t vertexCount = mesh.vertices.size();
+	const bool hasPositionIndices = mesh.positionIndices.size() == vertexCount;
+	auto positionOf = [&](uint32_t vertex) {
+		return hasPositionIndices ? mesh.positionIndices[vertex] : vertex;
+	};
+
+	std::vector<bool> locked(vertexCount, false);
+
+	// 三角形で使われている頂点のうち、同じ座標を別の頂点が使っていれば継ぎ目
+	std::vector<bool> used(vertexCount, false);
+	for (uint32_t index : mesh.indices) {
+		used[index] = true;
+	}
+	std::unordered_map<uint32_t, uint32_t> firstVertex;
+	firstVertex.reserve(vertexCount);
+	for (uint32_t v = 0; v < vertexCount; v++) {
+		if (!used[v]) {
+			continue;
+		}
+		auto [it, inserted] = firstVertex.emplace(positionOf(v), v);
+		if (!inserted) {
+			locked[v] = true;
+			locked[it->second] = true;
+		}
+	}
+
+	// 座標で数えて1つの三角形にしか使われない辺は開いた縁
+	std::unordered_map<uint64_t, uint32_t> edgeCount;
+	edgeCount.reserve(mesh.indices.size());
+	auto edgeKey = [&](uint32_t a, uint32_t b) {
+		uint64_t pa = positionOf(a);
+		uint64_t pb = positionOf(b);
+		return pa < pb ? (pa << 32) | pb : (pb << 32) | pa;
+	};
+	for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+		for (size_t k = 0; k < 3; k++) {
+			edgeCount[edgeKey(mesh.indices[i + k], mesh.indices[i + (k + 1) % 3])]++;
+		}
+	}
+	for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+		for (size_t k = 0; k < 3; k++) {
+			uint32_t a = mesh.indices[i + k];
+			uint32_t b = mesh.indices[i + (k + 1) % 3];
+			if (edgeCount[edgeKey(a, b)] == 1) {
+				locked[a] = true;
+				locked[b] = true;
+			}
+		}
+	}
+	return locked;
+}
+
+/// <summary>
+/// 点から三角形までの2乗距離
+/// </summary>
+float DistanceSquaredToTriangle(
+    const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c) {
+	// 最近点がどの領域（頂点・辺・面）にあるかで場合分けする
+	Vector3 ab = b - a, ac = c - a, ap = p - a;
+	float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f) {
+		return DistanceSquared(p, a);
+	}
+	Vector3 bp = p - b;
+	float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3) {
+		return DistanceSquared(p, b);
+	}
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+		return DistanceSquared(p, a + ab * (d1 / (d1 - d3)));
+	}
+	Vector3 cp = p - c;
+	float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6) {
+		return DistanceSquared(p, c);
+	}
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+		return DistanceSquared(p, a + ac * (d2 / (d2 - d6)));
+	}
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+		return DistanceSquared(p, b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+	}
+	float denominator = va + vb + vc;
+	if (denominator <= 0.0f) {
+		// 潰れた三角形
+		return std::min({DistanceSquared(p, a), DistanceSquared(p, b), DistanceSquared(p, c)});
+	}
+	float v = vb / denominator, w = vc / denominator;
+	return DistanceSquared(p, a + ab * v + ac * w);
+}
+
+/// <summary>
+/// 寄せた頂点の元の位置から、寄せ先の周りに残った面までの距離の最大値
+/// </summary>
+/// <param name="mesh">簡略化後（頂点を詰める前）のメッシュ</param>
+/// <param name="positions">元の頂点座標</param>
+/// <param name="collapsedInto">頂点ごとの寄せ先（寄せていなければ自分）</param>
+float MeasureDeviation(
+    const MeshData& mesh, const std::vector<Vector3>& positions,
+    std::vector<uint32_t>& collapsedInto) {
+	const size_t vertexCount = positions.size();
+
+	// 頂点から三角形への隣接（CSR形式）
+	std::vector<uint32_t> offsets(vertexCount + 1, 0);
+	for (uint32_t index : mesh.indices) {
+		offsets[index + 1]++;
+	}
+	for (size_t v = 0; v < vertexCount; v++) {
+		offsets[v + 1] += offsets[v];
+	}
+	std::vector<uint32_t> adjacency(mesh.indices.size());
+	std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+	for (size_t i = 0; i < mesh.indices.size(); i++) {
+		adjacency[cursor[mesh.indices[i]]++] = static_cast<uint32_t>(i / 3);
+	}
+
+	float maxDistanceSquared = 0.0f;
+	for (uint32_t v = 0; v < vertexCount; v++) {
+		if (collapsedInto[v] == v) {
+			continue;
+		}
+		// 寄せ先をたどって、今残っている頂点を求める（次からは直接引けるよう付け替える）
+		uint32_t root = collapsedInto[v];
+		while (collapsedInto[root] != root) {
+			root = collapsedInto[root];
+		}
+		collapsedInto[v] = root;
+
+		const Vector3& p = positions[v];
+		float distanceSquared = DistanceSquared(p, mesh.vertices[root].pos);
+		for (uint32_t j = offsets[root]; j < offsets[root + 1]; j++) {
+			const uint32_t* triangle = &mesh.indices[size_t(adjacency[j]) * 3];
+			distanceSquared = std::min(
+			    distanceSquared, DistanceSquaredToTriangle(
+			                         p, mesh.vertices[triangle[0]].pos,
+			                         mesh.vertices[triangle[1]].pos,
+			                         mesh.vertices[triangle[2]].pos));
+		}
+		maxDistanceSquared = std::max(maxDistanceSquared, distanceSquared);
+	}
+	return std::sqrt(maxDistanceSquared);
+}
+
+/// <summary>
+/// 面ごとの法線を付け直す（法線が同じ面どうしでは頂点を共有する）
+/// </summary>
+void AssignFaceNormals(MeshData& mesh) {
+	const bool hasPositionIndices = mesh.positionIndices.size() == mesh.vertices.size();
+	std::vector<MeshVertex> vertices;
+	std::vector<uint32_t> positionIndices;
+	// 元の頂点ごとに、作った頂点の番号
+	std::vector<std::vector<uint32_t>> created(mesh.vertices.size());
+	for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+		const Vector3& p0 = mesh.vertices[mesh.indices[i + 0]].pos;
+		const Vector3& p1 = mesh.vertices[mesh.indices[i + 1]].pos;
+		const Vector3& p2 = mesh.vertices[mesh.indices[i + 2]].pos;
+		Vector3 cross = Cross(p1 - p0, p2 - p0);
+		float length = Length(cross);
+		Vector3 n = length > 0.0f ? cross * (1.0f / length) : Vector3{0.0f, 0.0f, 0.0f};
+		for (size_t k = 0; k < 3; k++) {
+			uint32_t source = mesh.indices[i + k];
+			uint32_t index = std::numeric_limits<uint32_t>::max();
+			for (uint32_t candidate : created[source]) {
+				if (DistanceSquared(vertices[candidate].normal, n) <= kWeldEpsilon) {
+					index = candidate;
+					break;
+				}
+			}
+			if (index == std::numeric_limits<uint32_t>::max()) {
+				index = static_cast<uint32_t>(vertices.size());
+				MeshVertex vertex = mesh.vertices[source];
+				vertex.normal = n;
+				vertices.push_back(vertex);
+				if (hasPositionIndices) {
+					positionIndices.push_back(mesh.positionIndices[source]);
+				}
+				created[source].push_back(index);
+			}
+			mesh.indices[i + k] = index;
+		}
+	}
+	mesh.vertices = std::move(vertices);
+	mesh.positionIndices = std::move(positionIndices);
+}
+
+/// <summary>
+/// 使われていない頂点を詰める
+/// </summary>
+void CompactVertices(MeshData& mesh) {
+	constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+	const bool hasPositionIndices = mesh.positionIndices.size() == mesh.vertices.size();
+	std::vector<uint32_t> remap(mesh.vertices.size(), kNone);
+	std::vector<MeshVertex> vertices;
+	std::vector<uint32_t> positionIndices;
+	for (uint32_t& index : mesh.indices) {
+		if (remap[index] == kNone) {
+			remap[index] = static_cast<uint32_t>(vertices.size());
+			vertices.push_back(mesh.vertices[index]);
+			if (hasPositionIndices) {
+				positionIndices.push_back(mesh.positionIndices[index]);
+			}
+		}
+		index = remap[index];
+	}
+	mesh.vertices = std::move(vertices);
+	mesh.positionIndices = std::move(positionIndices);
+}
+
+} // namespace
+
+MeshData SimplifyMesh(const MeshData& mesh, size_t targetTriangleCount, float* error) {
+	assert(mesh.indices.size() % 3 == 0);
+	MeshData result = mesh;
+	const size_t vertexCount = mesh.vertices.size();
+
+	// 面ごとの法線しか持たないメッシュは、座標だけでつないで簡略化し、後で法線を付け直す
+	const bool faceted = IsFaceted(mesh);
+	// 同じ属性の頂点をまとめておかないと、分かれた頂点が継ぎ目扱いになって縮約できない
+	std::vector<uint32_t> weld = WeldVertices(mesh, faceted);
+	for (uint32_t& index : result.indices) {
+		index = weld[index];
+	}
+	std::vector<Vector3> positions(vertexCount);
+	std::vector<uint32_t> collapsedInto(vertexCount);
+	for (uint32_t v = 0; v < vertexCount; v++) {
+		positions[v] = mesh.vertices[v].pos;
+		collapsedInto[v] = v;
+	}
+
+	// 頂点ごとに周りの面の平面を集める
+	std::vector<Quadric> quadrics(vertexCount);
+	for (size_t i = 0; i < result.indices.size(); i += 3) {
+		const Vector3& p0 = result.vertices[result.indices[i + 0]].pos;
+		const Vector3& p1 = result.vertices[result.indices[i + 1]].pos;
+		const Vector3& p2 = result.vertices[result.indices[i + 2]].pos;
+		Vector3 cross = Cross(p1 - p0, p2 - p0);
+		float length = Length(cross);
+		if (length <= 0.0f) {
+			continue;
+		}
+		Vector3 n = cross * (1.0f / length);
+		double d = -Dot(n, p0);
+		for (size_t k = 0; k < 3; k++) {
+			quadrics[result.indices[i + k]].AddPlane(n.x, n.y, n.z, d);
+		}
+	}
+	std::vector<bool> locked = FindLockedVertices(result);
+
+	std::vector<uint32_t> offsets;
+	std::vector<uint32_t> adjacency;
+	std::vector<Collapse> collapses;
+	std::vector<uint32_t> remap(vertexCount);
+	std::vector<bool> touched(vertexCount);
+
+	// 互いに重ならない縮約をまとめて行う処理を、目標に届くか縮約できなくなるまで繰り返す
+	while (result.indices.size() / 3 > targetTriangleCount) {
+		size_t triangleCount = result.indices.size() / 3;
+
+		// 頂点から三角形への隣接（CSR形式）
+		offsets.assign(vertexCount + 1, 0);
+		for (uint32_t index : result.indices) {
+			offsets[index + 1]++;
+		}
+		for (size_t v = 0; v < vertexCount; v++) {
+			offsets[v + 1] += offsets[v];
+		}
+		adjacency.resize(result.indices.size());
+		{
+			std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < result.indices.size(); i++) {
+				adjacency[cursor[result.indices[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+
+		// 頂点ごとに、最も誤差の小さい寄せ先を選ぶ
+		collapses.clear();
+		for (uint32_t from = 0; from < vertexCount; from++) {
+			if (locked[from] || offsets[from] == offsets[from + 1]) {
+				continue;
+			}
+			Collapse best{from, from, std::numeric_limits<double>::max()};
+			const MeshVertex& a = result.vertices[from];
+			for (uint32_t j = offsets[from]; j < offsets[from + 1]; j++) {
+				const uint32_t* triangle = &result.indices[size_t(adjacency[j]) * 3];
+				for (size_t k = 0; k < 3; k++) {
+					uint32_t to = triangle[k];
+					if (to == from) {
+						continue;
+					}
+					const MeshVertex& b = result.vertices[to];
+					Quadric q = quadrics[from];
+					q += quadrics[to];
+					double cost = q.Evaluate(b.pos);
+					// 寄せた先の法線・UVを使うことになるので、その差も誤差に含める
+					double attribute =
+					    DistanceSquared(a.normal, b.normal) + DistanceSquared(
+					                                              Vector3{a.uv.x, a.uv.y, 0.0f},
+					                                              Vector3{b.uv.x, b.uv.y, 0.0f});
+					cost += kAttributeWeight * attribute * DistanceSquared(a.pos, b.pos);
+					if (cost < best.cost) {
+						best = Collapse{from, to, cost};
+					}
+				}
+			}
+			if (best.to != from) {
+				collapses.push_back(best);
+			}
+		}
+		if (collapses.empty()) {
+			break;
+		}
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+			return a.cost < b.cost;
+		});
+
+		// 誤差の小さい順に、周りが今回まだ動いていないものだけ縮約する
+		for (uint32_t v = 0; v < vertexCount; v++) {
+			remap[v] = v;
+		}
+		std::fill(touched.begin(), touched.end(), false);
+		size_t removedCount = 0;
+		size_t collapsedCount = 0;
+		for (const Collapse& collapse : collapses) {
+			if (triangleCount - removedCount <= targetTriangleCount) {
+				break;
+			}
+			if (touched[collapse.from] || touched[collapse.to]) {
+				continue;
+			}
+
+			// 面が裏返る・潰れる縮約はしない
+			bool valid = true;
+			size_t removing = 0;
+			const Vector3& target = result.vertices[collapse.to].pos;
+			for (uint32_t j = offsets[collapse.from]; j < offsets[collapse.from + 1]; j++) {
+				const uint32_t* triangle = &result.indices[size_t(adjacency[j]) * 3];
+				if (triangle[0] == collapse.to || triangle[1] == collapse.to ||
+				    triangle[2] == collapse.to) {
+					removing++;
+					continue;
+				}
+				Vector3 p[3];
+				Vector3 moved[3];
+				for (size_t k = 0; k < 3; k++) {
+					p[k] = result.vertices[triangle[k]].pos;
+					moved[k] = triangle[k] == collapse.from ? target : p[k];
+				}
+				Vector3 before = Cross(p[1] - p[0], p[2] - p[0]);
+				Vector3 after = Cross(moved[1] - moved[0], moved[2] - moved[0]);
+				float lengths = Length(before) * Length(after);
+				if (lengths <= 0.0f || Dot(before, after) < kMinFlipDot * lengths) {
+					valid = false;
+					break;
+				}
+			}
+			if (!valid) {
+				continue;
+			}
+
+			// 周りの頂点も今回は動かさない（裏返りの判定が前提にした形を保つ）
+			for (uint32_t j = offsets[collapse.from]; j < offsets[collapse.from + 1]; j++) {
+				const uint32_t* triangle = &result.indices[size_t(adjacency[j]) * 3];
+				for (size_t k = 0; k < 3; k++) {
+					touched[triangle[k]] = true;
+				}
+			}
+			remap[collapse.from] = collapse.to;
+			collapsedInto[collapse.from] = collapse.to;
+			quadrics[collapse.to] += quadrics[collapse.from];
+			removedCount += removing;
+			collapsedCount++;
+		}
+		if (collapsedCount == 0) {
+			break;
+		}
+
+		// 付け替えて、潰れた三角形を取り除く
+		size_t write = 0;
+		for (size_t i = 0; i < result.indices.size(); i += 3) {
+			uint32_t a = remap[result.indices[i + 0]];
+			uint32_t b = remap[result.indices[i + 1]];
+			uint32_t c = remap[result.indices[i + 2]];
+			if (a == b || b == c || c == a) {
+				continue;
+			}
+			result.indices[write++] = a;
+			result.indices[write++] = b;
+			result.indices[write++] = c;
+		}
+		result.indices.resize(write);
+	}
+
+	if (error) {
+		*error = MeasureDeviation(result, positions, collapsedInto);
+	}
+	if (faceted) {
+		AssignFaceNormals(result);
+	} else {
+		CompactVertices(result);
+	}
+	return result;
+}
+
+ModelData SimplifyModel(const ModelData& modelData, float ratio, float* error) {
+	assert(0.0f <= ratio && ratio <= 1.0f);
+	ModelData result;
+	result.materials = modelData.materials;
+	result.materialLibraries = modelData.materialLibraries;
+	result.positionCount = modelData.positionCount;
+	float maxError = 0.0f;
+	for (const MeshData& mesh : modelData.meshes) {
+		size_t target = static_cast<size_t>(static_cast<double>(mesh.indices.size() / 3) * ratio);
+		float meshError = 0.0f;
+		result.meshes.push_back(SimplifyMesh(mesh, target, &meshError));
+		maxError = std::max(maxError, meshError);
+	}
+	if (error) {
+		*error = maxError;
+	}
+	return result;
+}
+
+std::vector<ModelData> SimplifyModelChain(
+    const ModelData& modelData, uint32_t levelCount, std::vector<float>* errors) {
+	assert(levelCount >= 1);
+	std::vector<ModelData> levels(1, modelData);
+	std::vector<float> levelErrors(1, 0.0f);
+	for (uint32_t level = 1; level < levelCount; level++) {
+		const ModelData& previous = levels.back();
+		ModelData result;
+		result.materials = previous.materials;
+		result.materialLibraries = previous.materialLibraries;
+		result.positionCount = previous.positionCount;
+		float maxError = 0.0f;
+		for (size_t i = 0; i < previous.meshes.size(); i++) {
+			// 目標は元の三角形数から決める（前のレベルが目標に届かなくても先のレベルは縮まない）
+			size_t target = (modelData.meshes[i].indices.size() / 3) >> level;
+			float meshError = 0.0f;
+			result.meshes.push_back(SimplifyMesh(previous.meshes[i], target, &meshError));
+			maxError = std::max(maxError, meshError);
+		}
+		// 各段のずれは前のレベルからの距離なので、元の形からは足し合わせた分まで離れうる
+		levelErrors.push_back(levelErrors.back() + maxError);
+		levels.push_back(std::move(result));
+	}
+	if (errors) {
+		*errors = std::move(levelErrors);
+	}
+	return levels;
+}
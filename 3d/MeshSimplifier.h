@@ -0,0 +1,45 @@
+#pragma once
+
+#include "MeshData.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 二次誤差（QEM）による辺の縮約でメッシュを簡略化する
+/// 頂点は隣の頂点に寄せるだけなので、残る頂点の法線・UVはそのまま保たれる
+/// 同じ座標で法線・UVも同じ頂点はまとめてから縮約する
+/// 法線かUVが違う継ぎ目と、開いた縁の頂点は動かさない
+/// 法線がすべて面の法線と一致するメッシュ（フラットシェーディング）は
+/// 座標だけでつないで縮約し、面の法線を付け直す
+/// </summary>
+/// <param name="mesh">形状データ</param>
+/// <param name="targetTriangleCount">目標の三角形数（これ以下になるか、縮約できる辺が無くなるまで続ける）</param>
+/// <param name="error">
+/// 元の形からのずれ（寄せた頂点の元の位置から残った面までの最大距離）の出力先
+/// </param>
+/// <returns>簡略化したメッシュ（使わなくなった頂点は詰める）</returns>
+MeshData
+    SimplifyMesh(const MeshData& mesh, size_t targetTriangleCount, float* error = nullptr);
+
+/// <summary>
+/// モデルのすべてのメッシュを同じ割合で簡略化する
+/// </summary>
+/// <param name="modelData">モデルデータ</param>
+/// <param name="ratio">残す三角形の割合</param>
+/// <param name="error">全メッシュのずれの最大値の出力先</param>
+ModelData SimplifyModel(const ModelData& modelData, float ratio, float* error = nullptr);
+
+/// <summary>
+/// 詳細度レベルの列を作る
+/// レベル n はレベル n-1 をさらに簡略化して作るので、レベルごとに元の形から簡略化し直すより
+/// 速く、粗いレベルの頂点は細かいレベルの頂点から選ばれる
+/// </summary>
+/// <param name="modelData">モデルデータ（レベル0 としてそのまま入る）</param>
+/// <param name="levelCount">レベル数（レベル n の目標三角形数は元の 1/2^n）</param>
+/// <param name="errors">
+/// レベルごとの元の形からのずれの上限の出力先（各段のずれの合計。レベル0 は 0）
+/// </param>
+/// <returns>レベルごとのモデルデータ</returns>
+std::vector<ModelData> SimplifyModelChain(
+    const ModelData& modelData, uint32_t levelCount, std::vector<float>* errors = nullptr);
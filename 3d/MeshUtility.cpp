@@ -0,0 +1,275 @@
+#include "MeshUtility.h"
+#include "MathUtility.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+// 並列処理で1回に受け持つ要素数
+constexpr size_t kSmoothingGrainSize = 16384;
+
+/// <summary>
+/// 10bit の値を3つおきのビットに広げる
+/// </summary>
+uint32_t SpreadBits(uint32_t value) {
+	value &= 0x3ff;
+	value = (value | (value << 16)) & 0x030000ff;
+	value = (value | (value << 8)) & 0x0300f00f;
+	value = (value | (value << 4)) & 0x030c30c3;
+	value = (value | (value << 2)) & 0x09249249;
+	return value;
+}
+
+/// <summary>
+/// 三角形の重心のモートン順に並べた三角形番号
+/// </summary>
+std::vector<uint32_t> SortTrianglesSpatially(const MeshData& mesh) {
+	// 薄い軸の細かな凹凸で順番が散らばらないよう、全軸を最も長い辺で量子化する
+	AABB bounds = CalculateBounds(mesh);
+	Vector3 extent = bounds.max - bounds.min;
+	float size = std::max({extent.x, extent.y, extent.z});
+	auto quantize = [size](float value, float min) {
+		float t = size > 0.0f ? (value - min) / size : 0.0f;
+		return static_cast<uint32_t>(std::clamp(t, 0.0f, 1.0f) * 1023.0f);
+	};
+
+	size_t triangleCount = mesh.indices.size() / 3;
+	std::vector<uint64_t> keys(triangleCount);
+	for (size_t i = 0; i < triangleCount; i++) {
+		Vector3 center = (mesh.vertices[mesh.indices[i * 3 + 0]].pos +
+		                  mesh.vertices[mesh.indices[i * 3 + 1]].pos +
+		                  mesh.vertices[mesh.indices[i * 3 + 2]].pos) *
+		                 (1.0f / 3.0f);
+		uint32_t code = SpreadBits(quantize(center.x, bounds.min.x)) |
+		                (SpreadBits(quantize(center.y, bounds.min.y)) << 1) |
+		                (SpreadBits(quantize(center.z, bounds.min.z)) << 2);
+		// 上位にモートン符号、下位に三角形番号を入れて並べる
+		keys[i] = (static_cast<uint64_t>(code) << 32) | i;
+	}
+	std::sort(keys.begin(), keys.end());
+
+	std::vector<uint32_t> order(triangleCount);
+	for (size_t i = 0; i < triangleCount; i++) {
+		order[i] = static_cast<uint32_t>(keys[i]);
+	}
+	return order;
+}
+
+/// <summary>
+/// 指定した順に三角形を詰めて分割
+/// </summary>
+std::vector<MeshData> SplitMeshInOrder(
+    const MeshData& mesh, const std::vector<uint32_t>* order, uint32_t maxVertexCount) {
+	const bool hasPositionIndices = mesh.positionIndices.size() == mesh.vertices.size();
+	constexpr uint32_t kNone = std::numeric_limits<uint32_t>::max();
+	// 元の頂点が今のメッシュのどこにあるか（chunkOf が今のメッシュ番号のときだけ有効）
+	std::vector<uint32_t> chunkOf(mesh.vertices.size(), kNone);
+	std::vector<uint32_t> localIndex(mesh.vertices.size());
+
+	std::vector<MeshData> chunks;
+	auto beginChunk = [&]() {
+		MeshData& chunk = chunks.emplace_back();
+		chunk.name = mesh.name;
+		chunk.materialName = mesh.materialName;
+	};
+	beginChunk();
+
+	size_t triangleCount = mesh.indices.size() / 3;
+	for (size_t t = 0; t < triangleCount; t++) {
+		size_t i = (order ? (*order)[t] : t) * size_t(3);
+
+		// 入りきらなければ次のメッシュへ
+		uint32_t current = static_cast<uint32_t>(chunks.size() - 1);
+		size_t newVertexCount = 0;
+		for (size_t k = 0; k < 3; k++) {
+			uint32_t index = mesh.indices[i + k];
+			if (chunkOf[index] != current) {
+				// 同じ三角形で同じ頂点を重ねて数えないように仮に印を付ける
+				chunkOf[index] = current;
+				localIndex[index] = kNone;
+				newVertexCount++;
+			}
+		}
+		if (chunks.back().vertices.size() + newVertexCount > maxVertexCount) {
+			beginChunk();
+			current++;
+		}
+
+		MeshData& chunk = chunks.back();
+		for (size_t k = 0; k < 3; k++) {
+			uint32_t index = mesh.indices[i + k];
+			if (chunkOf[index] != current || localIndex[index] == kNone) {
+				chunkOf[index] = current;
+				localIndex[index] = static_cast<uint32_t>(chunk.vertices.size());
+				chunk.vertices.push_back(mesh.vertices[index]);
+				if (hasPositionIndices) {
+					chunk.positionIndices.push_back(mesh.positionIndices[index]);
+				}
+			}
+			chunk.indices.push_back(localIndex[index]);
+		}
+	}
+	return chunks;
+}
+
+/// <summary>
+/// 分割後の頂点数の合計
+/// </summary>
+size_t CountVertices(const std::vector<MeshData>& chunks) {
+	size_t count = 0;
+	for (const MeshData& chunk : chunks) {
+		count += chunk.vertices.size();
+	}
+	return count;
+}
+
+} // namespace
+
+void CalculateSmoothedNormals(
+    MeshData& mesh, uint32_t positionCount, NormalWeight weight, ThreadPool* threadPool) {
+	assert(mesh.positionIndices.size() == mesh.vertices.size());
+	assert(mesh.indices.size() % 3 == 0);
+
+	auto parallelFor = [threadPool](size_t count, const std::function<void(size_t, size_t)>& f) {
+		if (threadPool) {
+			threadPool->ParallelFor(count, kSmoothingGrainSize, f);
+		} else if (count != 0) {
+			f(0, count);
+		}
+	};
+
+	// 座標ごとの法線の合計
+	std::vector<Vector3> normals(positionCount, Vector3{0.0f, 0.0f, 0.0f});
+	if (weight == NormalWeight::kUniform) {
+		// 頂点が持つ法線を座標ごとに足すだけなので1回なめれば済む
+		for (size_t v = 0; v < mesh.vertices.size(); v++) {
+			assert(mesh.positionIndices[v] < positionCount);
+			normals[mesh.positionIndices[v]] += mesh.vertices[v].normal;
+		}
+	} else {
+		// 座標ごとの角の一覧（CSR形式: offsets[p] から offsets[p + 1] までが座標 p の角）
+		const size_t cornerCount = mesh.indices.size();
+		std::vector<uint32_t> offsets(size_t(positionCount) + 1, 0);
+		for (size_t c = 0; c < cornerCount; c++) {
+			uint32_t position = mesh.positionIndices[mesh.indices[c]];
+			assert(position < positionCount);
+			offsets[position + 1]++;
+		}
+		for (size_t p = 0; p < positionCount; p++) {
+			offsets[p + 1] += offsets[p];
+		}
+		std::vector<uint32_t> corners(cornerCount);
+		{
+			std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+			for (size_t c = 0; c < cornerCount; c++) {
+				uint32_t position = mesh.positionIndices[mesh.indices[c]];
+				corners[cursor[position]++] = static_cast<uint32_t>(c);
+			}
+		}
+
+		// 座標ごとに角の面法線を重み付けして集める
+		// 座標ごとに独立しているので並列でも書き込みが衝突せず、角ごとの中間データも要らない
+		parallelFor(positionCount, [&](size_t begin, size_t end) {
+			for (size_t p = begin; p < end; p++) {
+				Vector3 sum{0.0f, 0.0f, 0.0f};
+				for (uint32_t i = offsets[p]; i < offsets[p + 1]; i++) {
+					// 角を先頭にして三角形の頂点を回す（回しても面の向きは変わらない）
+					size_t triangle = corners[i] / 3 * 3;
+					size_t k = corners[i] - triangle;
+					const Vector3& p0 = mesh.vertices[mesh.indices[triangle + k]].pos;
+					const Vector3& p1 = mesh.vertices[mesh.indices[triangle + (k + 1) % 3]].pos;
+					const Vector3& p2 = mesh.vertices[mesh.indices[triangle + (k + 2) % 3]].pos;
+					Vector3 e1 = p1 - p0;
+					Vector3 e2 = p2 - p0;
+					// 外積の長さは面積の2倍なので、そのまま面積の重みになる
+					Vector3 cross = Cross(e1, e2);
+					if (weight == NormalWeight::kArea) {
+						sum += cross;
+						continue;
+					}
+					// 角度の重み。acos より範囲の端で精度が落ちにくい atan2 で求める
+					float length = Length(cross);
+					if (length > 0.0f) {
+						sum += cross * (std::atan2(length, Dot(e1, e2)) / length);
+					}
+				}
+				normals[p] = sum;
+			}
+		});
+	}
+
+	// 書き戻す（向きが決まらなかった頂点は元の法線のまま）
+	parallelFor(mesh.vertices.size(), [&](size_t begin, size_t end) {
+		for (size_t v = begin; v < end; v++) {
+			const Vector3& sum = normals[mesh.positionIndices[v]];
+			if (Length(sum) > 0.0f) {
+				mesh.vertices[v].normal = Normalize(sum);
+			}
+		}
+	});
+}
+
+AABB CalculateBounds(const MeshData& mesh) {
+	if (mesh.vertices.empty()) {
+		return AABB{};
+	}
+	AABB bounds{mesh.vertices[0].pos, mesh.vertices[0].pos};
+	for (const MeshVertex& vertex : mesh.vertices) {
+		bounds.min.x = std::min(bounds.min.x, vertex.pos.x);
+		bounds.min.y = std::min(bounds.min.y, vertex.pos.y);
+		bounds.min.z = std::min(bounds.min.z, vertex.pos.z);
+		bounds.max.x = std::max(bounds.max.x, vertex.pos.x);
+		bounds.max.y = std::max(bounds.max.y, vertex.pos.y);
+		bounds.max.z = std::max(bounds.max.z, vertex.pos.z);
+	}
+	return bounds;
+}
+
+std::vector<MeshData> SplitMesh(const MeshData& mesh, uint32_t maxVertexCount) {
+	assert(maxVertexCount >= 3);
+	assert(mesh.indices.size() % 3 == 0);
+	if (mesh.vertices.size() <= maxVertexCount) {
+		return {mesh};
+	}
+
+	// まずは元の順番のまま分割する（三角形の順に描画したいデータを崩さない）
+	std::vector<MeshData> chunks = SplitMeshInOrder(mesh, nullptr, maxVertexCount);
+
+	// 三角形の並びがばらばらで境界の頂点が増えすぎたら、空間的に近い順に並べ直して分割する
+	if (CountVertices(chunks) > mesh.vertices.size() + mesh.vertices.size() / 8) {
+		std::vector<uint32_t> order = SortTrianglesSpatially(mesh);
+		std::vector<MeshData> sorted = SplitMeshInOrder(mesh, &order, maxVertexCount);
+		if (CountVertices(sorted) < CountVertices(chunks)) {
+			chunks = std::move(sorted);
+		}
+	}
+	return chunks;
+}
+
+bool SplitLargeMeshes(ModelData& modelData) {
+	bool split = false;
+	std::vector<MeshData> meshes;
+	meshes.reserve(modelData.meshes.size());
+	for (MeshData& mesh : modelData.meshes) {
+		if (mesh.vertices.size() <= kMaxVertexCount16) {
+			meshes.push_back(std::move(mesh));
+			continue;
+		}
+		std::vector<MeshData> chunks = SplitMesh(mesh);
+		meshes.insert(
+		    meshes.end(), std::make_move_iterator(chunks.begin()),
+		    std::make_move_iterator(chunks.end()));
+		split = true;
+	}
+	modelData.meshes = std::move(meshes);
+	return split;
+}
+
+size_t CalculateGeometrySize(const MeshData& mesh, uint32_t indexSize) {
+	return sizeof(MeshVertex) * mesh.vertices.size() + size_t(indexSize) * mesh.indices.size();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Collision.h"
+#include "MeshData.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 16bitインデックスで参照できる最大頂点数
+constexpr uint32_t kMaxVertexCount16 = 0x10000;
+
+class ThreadPool;
+
+/// <summary>
+/// 平滑化法線の重み付け
+/// </summary>
+enum class NormalWeight {
+	kUniform, // 頂点が持つ法線をそのまま平均する
+	kArea,    // 面の法線を面積で重み付けする
+	kAngle,   // 面の法線を頂点での角度で重み付けする
+};
+
+/// <summary>
+/// 平滑化された頂点法線の計算
+/// 読み込み元の座標が同じ頂点どうしで法線をまとめる
+/// </summary>
+/// <param name="mesh">形状データ</param>
+/// <param name="positionCount">座標の数（positionIndices はこれ未満）</param>
+/// <param name="weight">重み付け</param>
+/// <param name="threadPool">並列計算に使うスレッドプール（nullptr なら使わない）</param>
+void CalculateSmoothedNormals(
+    MeshData& mesh, uint32_t positionCount, NormalWeight weight = NormalWeight::kAngle,
+    ThreadPool* threadPool = nullptr);
+
+/// <summary>
+/// 頂点を囲むAABB（頂点が無ければすべて0）
+/// </summary>
+AABB CalculateBounds(const MeshData& mesh);
+
+/// <summary>
+/// 頂点数が上限を超えないようにメッシュを分割
+/// 三角形の順番を保ったまま詰めていき、入りきらなくなったら次のメッシュに移る
+/// </summary>
+/// <param name="mesh">形状データ</param>
+/// <param name="maxVertexCount">1つあたりの最大頂点数</param>
+/// <returns>分割したメッシュ（上限以内ならそのままのコピー1つ）</returns>
+std::vector<MeshData> SplitMesh(const MeshData& mesh, uint32_t maxVertexCount = kMaxVertexCount16);
+
+/// <summary>
+/// 16bitインデックスに収まらないメッシュをすべて分割
+/// </summary>
+/// <param name="modelData">モデルデータ</param>
+/// <returns>分割したメッシュがあったか</returns>
+bool SplitLargeMeshes(ModelData& modelData);
+
+/// <summary>
+/// 頂点とインデックスのバイト数
+/// </summary>
+/// <param name="mesh">形状データ</param>
+/// <param name="indexSize">インデックス1つのバイト数（2 か 4）</param>
+size_t CalculateGeometrySize(const MeshData& mesh, uint32_t indexSize);
@@ -1,14 +1,19 @@
 #pragma once
 
+#include "InstanceData.h"
 #include "LightGroup.h"
 #include "Mesh.h"
+#include "MeshData.h"
 #include "TextureManager.h"
 #include "ViewProjection.h"
 #include "WorldTransform.h"
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+class MeshCache;
+
 /// <summary>
 /// モデルデータ
 /// </summary>
@@ -44,6 +49,10 @@ private: // 静的メンバ変数
 	static Microsoft::WRL::ComPtr<ID3D12PipelineState> sPipelineState_;
 	// ライト
 	static std::unique_ptr<LightGroup> lightGroup;
+	// インスタンス描画用ルートシグネチャ（初回の DrawInstanced で生成）
+	static Microsoft::WRL::ComPtr<ID3D12RootSignature> sInstancedRootSignature_;
+	// インスタンス描画用パイプラインステートオブジェクト
+	static Microsoft::WRL::ComPtr<ID3D12PipelineState> sInstancedPipelineState_;
 
 public: // 静的メンバ関数
 	/// <summary>
@@ -70,6 +79,33 @@ public: // 静的メンバ関数
 	/// <returns>生成されたモデル</returns>
 	static Model* CreateFromOBJ(const std::string& modelname, bool smoothing = false);
 
+	/// <summary>
+	/// OBJファイルからメッシュ生成（メモリマップ読み込み版）
+	/// 同じディレクトリにバイナリキャッシュを作り、元ファイルが変わっていなければ次回からそれを使う
+	/// </summary>
+	/// <param name="modelname">モデル名</param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <param name="optimize">頂点キャッシュ・重ね描き向けに三角形と頂点を並べ替えるか</param>
+	/// <returns>生成されたモデル</returns>
+	static Model* CreateFromOBJFast(
+	    const std::string& modelname, bool smoothing = false, bool optimize = false);
+
+	/// <summary>
+	/// OBJファイルから詳細度レベルごとに簡略化したメッシュを生成（レベルごとにキャッシュする）
+	/// どれかのレベルのキャッシュが古ければ、読み込みと平滑化を1回だけ行い、
+	/// 前のレベルから順に簡略化してすべてのレベルを作り直す
+	/// </summary>
+	/// <param name="modelname">モデル名</param>
+	/// <param name="levelCount">
+	/// レベル数（レベル n の三角形数は元の 1/2^n。レベル0 は簡略化しない）
+	/// </param>
+	/// <param name="smoothing">エッジ平滑化フラグ</param>
+	/// <param name="optimize">頂点キャッシュ・重ね描き向けに三角形と頂点を並べ替えるか</param>
+	/// <returns>レベルごとに生成されたモデル</returns>
+	static std::vector<Model*> CreateLodChainFromOBJ(
+	    const std::string& modelname, uint32_t levelCount, bool smoothing = false,
+	    bool optimize = false);
+
 	/// <summary>
 	/// 描画前処理
 	/// </summary>
@@ -111,6 +147,16 @@ public: // メンバ関数
 	    const WorldTransform& worldTransform, const ViewProjection& viewProjection,
 	    uint32_t textureHadle);
 
+	/// <summary>
+	/// インスタンス描画（メッシュごとに1回の描画コールでまとめて描く）
+	/// </summary>
+	/// <param name="worldTransforms">ワールドトランスフォーム（matWorld_ だけを使う）</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="colors">色（空なら白、1つなら共通、それ以外はインスタンスと同数）</param>
+	void DrawInstanced(
+	    std::span<const WorldTransform* const> worldTransforms,
+	    const ViewProjection& viewProjection, std::span<const Vector4> colors = {});
+
 	/// <summary>
 	/// メッシュコンテナを取得
 	/// </summary>
@@ -127,6 +173,12 @@ private: // メンバ変数
 	// デフォルトマテリアル
 	Material* defaultMaterial_ = nullptr;
 
+private: // 静的メンバ関数
+	/// <summary>
+	/// インスタンス描画用グラフィックスパイプラインの初期化
+	/// </summary>
+	static void InitializeInstancedPipeline();
+
 private: // メンバ関数
 	/// <summary>
 	/// モデル読み込み
@@ -135,6 +187,31 @@ private: // メンバ関数
 	/// <param name="modelname">エッジ平滑化フラグ</param>
 	void LoadModel(const std::string& modelname, bool smoothing);
 
+	/// <summary>
+	/// CPU側のモデルデータから初期化
+	/// </summary>
+	/// <param name="modelname">モデル名</param>
+	/// <param name="modelData">モデルデータ（法線の平滑化は済ませておく）</param>
+	void InitializeFromData(const std::string& modelname, const ModelData& modelData);
+
+	/// <summary>
+	/// メッシュキャッシュから初期化
+	/// </summary>
+	/// <param name="modelname">モデル名</param>
+	/// <param name="cache">開いたキャッシュ</param>
+	/// <returns>成否（16bitインデックスで描けないメッシュがあれば false）</returns>
+	bool InitializeFromCache(const std::string& modelname, const MeshCache& cache);
+
+	/// <summary>
+	/// マテリアルデータからマテリアルを生成して登録
+	/// </summary>
+	void CreateMaterials(const std::vector<MaterialData>& materials);
+
+	/// <summary>
+	/// 生成したメッシュの仕上げ（マテリアル割り当て・バッファ生成・テクスチャ読み込み）
+	/// </summary>
+	void SetupMeshes();
+
 	/// <summary>
 	/// マテリアル読み込み
 	/// </summary>
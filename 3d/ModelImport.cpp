@@ -0,0 +1,338 @@
+#include "Model.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "MeshUtility.h"
+#include "ObjLoader.h"
+#include "ThreadPool.h"
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+// Model/Mesh の本体はエンジンライブラリ側にあるので、ここではデータ読み込みの追加分だけを定義する
+
+static_assert(sizeof(MeshVertex) == sizeof(Mesh::VertexPosNormalUv));
+static_assert(offsetof(MeshVertex, normal) == offsetof(Mesh::VertexPosNormalUv, normal));
+static_assert(offsetof(MeshVertex, uv) == offsetof(Mesh::VertexPosNormalUv, uv));
+
+bool Mesh::SetGeometry(const MeshData& meshData) {
+	return SetGeometry(
+	    meshData.vertices.data(), meshData.vertices.size(), meshData.indices.data(),
+	    meshData.indices.size());
+}
+
+void Mesh::SetGeometry(
+    const MeshVertex* vertices, size_t vertexCount, const uint16_t* indices, size_t indexCount) {
+	// 頂点もインデックスもレイアウトが同じなのでそのままコピーする
+	vertices_.resize(vertexCount);
+	if (vertexCount != 0) {
+		std::memcpy(vertices_.data(), vertices, sizeof(VertexPosNormalUv) * vertexCount);
+	}
+	static_assert(sizeof(unsigned short) == sizeof(uint16_t));
+	indices_.resize(indexCount);
+	if (indexCount != 0) {
+		std::memcpy(indices_.data(), indices, sizeof(uint16_t) * indexCount);
+	}
+}
+
+bool Mesh::SetGeometry(
+    const MeshVertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount) {
+	// 16bitに切り詰めると別の頂点を指してしまうので、収まらなければ何もせずに失敗する
+	// （分割前に書かれたキャッシュや壊れたキャッシュはリリースビルドでもここで弾く）
+	if (kMaxVertexCount16 < vertexCount) {
+		return false;
+	}
+	for (size_t i = 0; i < indexCount; i++) {
+		if (vertexCount <= indices[i]) {
+			return false;
+		}
+	}
+
+	vertices_.resize(vertexCount);
+	if (vertexCount != 0) {
+		std::memcpy(vertices_.data(), vertices, sizeof(VertexPosNormalUv) * vertexCount);
+	}
+	indices_.resize(indexCount);
+	for (size_t i = 0; i < indexCount; i++) {
+		indices_[i] = static_cast<unsigned short>(indices[i]);
+	}
+	return true;
+}
+
+namespace {
+
+/// <summary>
+/// 詳細度レベルごとのキャッシュファイルのパス
+/// </summary>
+std::string GetCachePath(
+    const std::string& directoryPath, const std::string& modelname, uint32_t level) {
+	return directoryPath + modelname +
+	       (level == 0 ? std::string() : ".lod" + std::to_string(level)) + ".meshcache";
+}
+
+/// <summary>
+/// キャッシュに記録する作り方のフラグ
+/// </summary>
+uint32_t GetCacheFlags(bool smoothing, bool optimize, uint32_t level) {
+	return (smoothing ? MeshCache::kFlagSmoothing : 0) |
+	       (optimize ? MeshCache::kFlagOptimized : 0) | (level << MeshCache::kLodLevelShift);
+}
+
+/// <summary>
+/// キャッシュを開き、元ファイルから作り直す必要がないか調べる
+/// </summary>
+/// <param name="source">現在の元ファイルの識別情報の出力先</param>
+bool OpenCache(
+    MeshCache* cache, const std::string& cachePath, const std::string& directoryPath,
+    const std::string& filename, uint32_t flags, MeshCache::Source* source) {
+	return cache->Open(cachePath) && cache->IsUpToDate(directoryPath, filename, flags, source);
+}
+
+/// <summary>
+/// 更新時刻だけ変わっていたら、次回は中身を読まずに済むようキャッシュを書き換える
+/// </summary>
+void RefreshCacheSource(
+    MeshCache* cache, const std::string& cachePath, const MeshCache::Source& source) {
+	if (source.stamp != cache->GetSource().stamp) {
+		cache->Close();
+		MeshCache::RewriteSource(cachePath, source);
+	}
+}
+
+/// <summary>
+/// OBJファイルの読み込みと頂点法線の平滑化
+/// </summary>
+ModelData ImportModelData(
+    const std::string& directoryPath, const std::string& filename, bool smoothing) {
+	ModelData modelData;
+	[[maybe_unused]] bool result = ObjLoader::Load(directoryPath + filename, &modelData);
+	assert(result);
+	ObjLoader::LoadMaterials(directoryPath, &modelData);
+
+	if (smoothing) {
+		for (MeshData& meshData : modelData.meshes) {
+			CalculateSmoothedNormals(
+			    meshData, modelData.positionCount, NormalWeight::kAngle, ThreadPool::GetInstance());
+		}
+	}
+	return modelData;
+}
+
+/// <summary>
+/// 描画用に分割・並べ替えをして、次回用にキャッシュを書き出す（失敗しても読み込みは続ける）
+/// </summary>
+void FinishModelData(
+    ModelData& modelData, bool optimize, const std::string& directoryPath,
+    const std::string& filename, const std::string& cachePath, uint32_t flags) {
+	// Mesh は16bitインデックスなので、頂点の多いメッシュは分けておく（平滑化は分割前に済ませる）
+	SplitLargeMeshes(modelData);
+
+	// 頂点キャッシュ・重ね描き・頂点読み込みの順に並べ替える
+	if (optimize) {
+		for (MeshData& meshData : modelData.meshes) {
+			OptimizeMesh(meshData);
+		}
+	}
+
+	std::vector<std::string> sourcePaths =
+	    MeshCache::GetSourcePaths(directoryPath, filename, modelData.materialLibraries);
+	MeshCache::Source source;
+	if (MeshCache::ReadSource(sourcePaths, true, &source)) {
+		MeshCache::Write(cachePath, modelData, source, flags);
+	}
+}
+
+} // namespace
+
+Model* Model::CreateFromOBJFast(const std::string& modelname, bool smoothing, bool optimize) {
+	const std::string filename = modelname + ".obj";
+	const std::string directoryPath = kBaseDirectory + modelname + "/";
+	const std::string cachePath = GetCachePath(directoryPath, modelname, 0);
+	const uint32_t flags = GetCacheFlags(smoothing, optimize, 0);
+
+	// メモリ確保
+	Model* instance = new Model;
+
+	// 元ファイルが変わっていなければキャッシュから読み込む
+	MeshCache cache;
+	MeshCache::Source source;
+	if (OpenCache(&cache, cachePath, directoryPath, filename, flags, &source)) {
+		if (instance->InitializeFromCache(modelname, cache)) {
+			RefreshCacheSource(&cache, cachePath, source);
+			return instance;
+		}
+		// 16bitインデックスで描けないキャッシュは使わずに作り直す（書き直しで置き換わる）
+		delete instance;
+		instance = new Model;
+	}
+	cache.Close();
+
+	// OBJファイルから読み込む
+	ModelData modelData = ImportModelData(directoryPath, filename, smoothing);
+	FinishModelData(modelData, optimize, directoryPath, filename, cachePath, flags);
+	instance->InitializeFromData(modelname, modelData);
+	return instance;
+}
+
+std::vector<Model*> Model::CreateLodChainFromOBJ(
+    const std::string& modelname, uint32_t levelCount, bool smoothing, bool optimize) {
+	assert(1 <= levelCount && levelCount < 256);
+	const std::string filename = modelname + ".obj";
+	const std::string directoryPath = kBaseDirectory + modelname + "/";
+
+	// すべてのレベルのキャッシュが新しければキャッシュから読み込む
+	std::vector<MeshCache> caches(levelCount);
+	std::vector<MeshCache::Source> sources(levelCount);
+	bool upToDate = true;
+	for (uint32_t level = 0; level < levelCount && upToDate; level++) {
+		upToDate = OpenCache(
+		    &caches[level], GetCachePath(directoryPath, modelname, level), directoryPath, filename,
+		    GetCacheFlags(smoothing, optimize, level), &sources[level]);
+	}
+	std::vector<Model*> levels;
+	for (uint32_t level = 0; level < levelCount && upToDate; level++) {
+		Model* instance = new Model;
+		levels.push_back(instance);
+		upToDate = instance->InitializeFromCache(modelname, caches[level]);
+	}
+	if (upToDate) {
+		for (uint32_t level = 0; level < levelCount; level++) {
+			RefreshCacheSource(
+			    &caches[level], GetCachePath(directoryPath, modelname, level), sources[level]);
+		}
+		return levels;
+	}
+	// 16bitインデックスで描けないキャッシュがあれば、読み込んだレベルも捨てて作り直す
+	for (Model* instance : levels) {
+		delete instance;
+	}
+	levels.clear();
+	caches.clear();
+
+	// レベルn は n-1 から作るので、1つでも古ければ全レベルを作り直す
+	// 読み込みと平滑化は1回だけで、法線は元の形で平滑化したものを引き継ぐ
+	std::vector<ModelData> chain =
+	    SimplifyModelChain(ImportModelData(directoryPath, filename, smoothing), levelCount);
+	for (uint32_t level = 0; level < levelCount; level++) {
+		FinishModelData(
+		    chain[level], optimize, directoryPath, filename,
+		    GetCachePath(directoryPath, modelname, level),
+		    GetCacheFlags(smoothing, optimize, level));
+		Model* instance = new Model;
+		instance->InitializeFromData(modelname, chain[level]);
+		levels.push_back(instance);
+	}
+	return levels;
+}
+
+void Model::InitializeFromData(const std::string& modelname, const ModelData& modelData) {
+	name_ = modelname;
+
+	// マテリアル生成
+	CreateMaterials(modelData.materials);
+
+	// メッシュ生成
+	auto addMesh = [this](const MeshData& meshData) {
+		Mesh* mesh = new Mesh;
+		mesh->SetName(meshData.name);
+		[[maybe_unused]] bool result = mesh->SetGeometry(meshData);
+		assert(result);
+
+		// マテリアルの割り当て
+		auto it = materials_.find(meshData.materialName);
+		if (it != materials_.end()) {
+			mesh->SetMaterial(it->second);
+		}
+		meshes_.push_back(mesh);
+	};
+	for (const MeshData& meshData : modelData.meshes) {
+		// 16bitインデックスに収まらないメッシュは分割してから渡す（切り詰めない）
+		if (kMaxVertexCount16 < meshData.vertices.size()) {
+			for (const MeshData& chunk : SplitMesh(meshData)) {
+				addMesh(chunk);
+			}
+		} else {
+			addMesh(meshData);
+		}
+	}
+
+	SetupMeshes();
+}
+
+bool Model::InitializeFromCache(const std::string& modelname, const MeshCache& cache) {
+	name_ = modelname;
+
+	// マテリアル生成
+	CreateMaterials(cache.GetMaterials());
+
+	// メッシュ生成（マップしたデータから直接コピーする）
+	for (uint32_t i = 0; i < cache.GetMeshCount(); i++) {
+		MeshCache::MeshView view = cache.GetMesh(i);
+		Mesh* mesh = new Mesh;
+		mesh->SetName(std::string(view.name));
+		if (view.indexSize == sizeof(uint16_t)) {
+			mesh->SetGeometry(
+			    view.vertices, view.vertexCount, static_cast<const uint16_t*>(view.indices),
+			    view.indexCount);
+		} else if (!mesh->SetGeometry(
+		               view.vertices, view.vertexCount, static_cast<const uint32_t*>(view.indices),
+		               view.indexCount)) {
+			// それまでに作ったメッシュとマテリアルは、呼び出し側が Model ごと解放する
+			delete mesh;
+			return false;
+		}
+
+		// マテリアルの割り当て
+		auto it = materials_.find(std::string(view.materialName));
+		if (it != materials_.end()) {
+			mesh->SetMaterial(it->second);
+		}
+		meshes_.push_back(mesh);
+	}
+
+	SetupMeshes();
+	return true;
+}
+
+void Model::CreateMaterials(const std::vector<MaterialData>& materials) {
+	for (const MaterialData& materialData : materials) {
+		Material* material = Material::Create();
+		material->name_ = materialData.name;
+		material->ambient_ = materialData.ambient;
+		material->diffuse_ = materialData.diffuse;
+		material->specular_ = materialData.specular;
+		material->alpha_ = materialData.alpha;
+		material->textureFilename_ = materialData.textureFilename;
+		AddMaterial(material);
+	}
+}
+
+void Model::SetupMeshes() {
+	// メッシュのマテリアルチェック
+	for (Mesh* mesh : meshes_) {
+		// マテリアルの割り当てがない
+		if (mesh->GetMaterial() == nullptr) {
+			if (defaultMaterial_ == nullptr) {
+				// デフォルトマテリアルを生成
+				defaultMaterial_ = Material::Create();
+				defaultMaterial_->name_ = "no material";
+				materials_.emplace(defaultMaterial_->name_, defaultMaterial_);
+			}
+			// デフォルトマテリアルをセット
+			mesh->SetMaterial(defaultMaterial_);
+		}
+	}
+
+	// メッシュのバッファ生成
+	for (Mesh* mesh : meshes_) {
+		mesh->CreateBuffers();
+	}
+
+	// マテリアルの数値を定数バッファに反映
+	for (auto& material : materials_) {
+		material.second->Update();
+	}
+
+	// テクスチャの読み込み
+	LoadTextures();
+}
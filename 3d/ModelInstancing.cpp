@@ -0,0 +1,188 @@
+#include "DirectXCommon.h"
+#include "Model.h"
+#include "ShaderCompiler.h"
+#include <algorithm>
+#include <cassert>
+
+// Model の本体はエンジンライブラリ側にあるので、インスタンス描画の追加分だけをここで定義する
+
+using namespace Microsoft::WRL;
+
+ComPtr<ID3D12RootSignature> Model::sInstancedRootSignature_;
+ComPtr<ID3D12PipelineState> Model::sInstancedPipelineState_;
+
+namespace {
+
+/// <summary>
+/// インスタンス描画用ルートパラメータ番号
+/// </summary>
+enum class InstancedRoomParameter {
+	kInstances,      // インスタンスデータ（t1）
+	kViewProjection, // ビュープロジェクション変換行列
+	kMaterial,       // マテリアル
+	kTexture,        // テクスチャ
+	kLight,          // ライト
+};
+
+} // namespace
+
+void Model::InitializeInstancedPipeline() {
+	HRESULT result = S_FALSE;
+	ID3D12Device* device = DirectXCommon::GetInstance()->GetDevice();
+
+	ComPtr<ID3DBlob> vsBlob = CompileShader(L"Resources/shaders/ObjInstancedVS.hlsl", "vs_5_0");
+	ComPtr<ID3DBlob> psBlob = CompileShader(L"Resources/shaders/ObjInstancedPS.hlsl", "ps_5_0");
+
+	// 頂点レイアウト（通常の描画と同じ）
+	D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+	    {// xy座標
+	     "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {// 法線ベクトル
+	     "NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	    {// uv座標
+	     "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT,
+	     D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+	};
+
+	// グラフィックスパイプラインの流れを設定
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC gpipeline{};
+	gpipeline.VS = CD3DX12_SHADER_BYTECODE(vsBlob.Get());
+	gpipeline.PS = CD3DX12_SHADER_BYTECODE(psBlob.Get());
+	// サンプルマスク
+	gpipeline.SampleMask = D3D12_DEFAULT_SAMPLE_MASK;
+	// ラスタライザステート
+	gpipeline.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+	// デプスステンシルステート
+	gpipeline.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+
+	// レンダーターゲットのブレンド設定（半透明合成）
+	D3D12_RENDER_TARGET_BLEND_DESC blenddesc{};
+	blenddesc.RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	blenddesc.BlendEnable = true;
+	blenddesc.BlendOp = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+	blenddesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+	blenddesc.BlendOpAlpha = D3D12_BLEND_OP_ADD;
+	blenddesc.SrcBlendAlpha = D3D12_BLEND_ONE;
+	blenddesc.DestBlendAlpha = D3D12_BLEND_ZERO;
+	gpipeline.BlendState.RenderTarget[0] = blenddesc;
+
+	// 深度バッファのフォーマット
+	gpipeline.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+	// 頂点レイアウトの設定
+	gpipeline.InputLayout.pInputElementDescs = inputLayout;
+	gpipeline.InputLayout.NumElements = _countof(inputLayout);
+	// 図形の形状設定（三角形）
+	gpipeline.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	gpipeline.NumRenderTargets = 1;                            // 描画対象は1つ
+	gpipeline.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM_SRGB; // 0～255指定のRGBA
+	gpipeline.SampleDesc.Count = 1; // 1ピクセルにつき1回サンプリング
+
+	// デスクリプタレンジ
+	CD3DX12_DESCRIPTOR_RANGE descRangeSRV;
+	descRangeSRV.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0); // t0 レジスタ
+
+	// ルートパラメータ（インスタンスデータは定数バッファ用ページに置くのでルートSRVで渡す）
+	CD3DX12_ROOT_PARAMETER rootparams[5];
+	rootparams[static_cast<size_t>(InstancedRoomParameter::kInstances)].InitAsShaderResourceView(
+	    1, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+	rootparams[static_cast<size_t>(InstancedRoomParameter::kViewProjection)]
+	    .InitAsConstantBufferView(1, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[static_cast<size_t>(InstancedRoomParameter::kMaterial)].InitAsConstantBufferView(
+	    2, 0, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[static_cast<size_t>(InstancedRoomParameter::kTexture)].InitAsDescriptorTable(
+	    1, &descRangeSRV, D3D12_SHADER_VISIBILITY_ALL);
+	rootparams[static_cast<size_t>(InstancedRoomParameter::kLight)].InitAsConstantBufferView(
+	    3, 0, D3D12_SHADER_VISIBILITY_ALL);
+
+	// スタティックサンプラー
+	CD3DX12_STATIC_SAMPLER_DESC samplerDesc =
+	    CD3DX12_STATIC_SAMPLER_DESC(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR);
+
+	// ルートシグネチャの設定
+	CD3DX12_VERSIONED_ROOT_SIGNATURE_DESC rootSignatureDesc;
+	rootSignatureDesc.Init_1_0(
+	    _countof(rootparams), rootparams, 1, &samplerDesc,
+	    D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT);
+
+	ComPtr<ID3DBlob> rootSigBlob;
+	ComPtr<ID3DBlob> errorBlob;
+	// バージョン自動判定のシリアライズ
+	result = D3DX12SerializeVersionedRootSignature(
+	    &rootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1_0, &rootSigBlob, &errorBlob);
+	assert(SUCCEEDED(result));
+	// ルートシグネチャの生成
+	result = device->CreateRootSignature(
+	    0, rootSigBlob->GetBufferPointer(), rootSigBlob->GetBufferSize(),
+	    IID_PPV_ARGS(&sInstancedRootSignature_));
+	assert(SUCCEEDED(result));
+
+	gpipeline.pRootSignature = sInstancedRootSignature_.Get();
+
+	// グラフィックスパイプラインの生成
+	result =
+	    device->CreateGraphicsPipelineState(&gpipeline, IID_PPV_ARGS(&sInstancedPipelineState_));
+	assert(SUCCEEDED(result));
+}
+
+void Model::DrawInstanced(
+    std::span<const WorldTransform* const> worldTransforms, const ViewProjection& viewProjection,
+    std::span<const Vector4> colors) {
+	// PreDraw と PostDraw の間で呼ぶこと
+	assert(sCommandList_);
+	assert(colors.size() <= 1 || colors.size() == worldTransforms.size());
+	if (worldTransforms.empty()) {
+		return;
+	}
+	if (!sInstancedPipelineState_) {
+		InitializeInstancedPipeline();
+	}
+
+	ConstantBufferAllocator* allocator = DirectXCommon::GetInstance()->GetConstantBufferAllocator();
+
+	// パイプラインステートとルートシグネチャの設定コマンド
+	sCommandList_->SetPipelineState(sInstancedPipelineState_.Get());
+	sCommandList_->SetGraphicsRootSignature(sInstancedRootSignature_.Get());
+
+	// CBVをセット（ビュープロジェクション行列）
+	sCommandList_->SetGraphicsRootConstantBufferView(
+	    static_cast<UINT>(InstancedRoomParameter::kViewProjection),
+	    viewProjection.constBuff_->GetGPUVirtualAddress());
+	// ライトの描画
+	lightGroup->Draw(sCommandList_, static_cast<UINT>(InstancedRoomParameter::kLight));
+
+	for (size_t first = 0; first < worldTransforms.size(); first += kMaxInstancesPerDraw) {
+		size_t count = std::min(kMaxInstancesPerDraw, worldTransforms.size() - first);
+		std::span<const WorldTransform* const> batch = worldTransforms.subspan(first, count);
+		std::span<const Vector4> batchColors =
+		    colors.size() <= 1 ? colors : colors.subspan(first, count);
+
+		// インスタンスデータは今フレームのページに直接詰める
+		ConstantBufferAllocator::Allocation allocation =
+		    allocator->Allocate(sizeof(InstanceData) * count);
+		if (!allocation.cpuAddress) {
+			// 書き込み先が無ければ残りは描かない
+			break;
+		}
+		PackInstances(batch, batchColors, static_cast<InstanceData*>(allocation.cpuAddress));
+		sCommandList_->SetGraphicsRootShaderResourceView(
+		    static_cast<UINT>(InstancedRoomParameter::kInstances), allocation.gpuAddress);
+
+		// メッシュごとに1回の描画コール
+		for (Mesh* mesh : meshes_) {
+			mesh->GetMaterial()->SetGraphicsCommand(
+			    sCommandList_, static_cast<UINT>(InstancedRoomParameter::kMaterial),
+			    static_cast<UINT>(InstancedRoomParameter::kTexture));
+			sCommandList_->IASetVertexBuffers(0, 1, &mesh->GetVBView());
+			sCommandList_->IASetIndexBuffer(&mesh->GetIBView());
+			sCommandList_->DrawIndexedInstanced(
+			    static_cast<UINT>(mesh->GetIndices().size()), static_cast<UINT>(count), 0, 0, 0);
+		}
+	}
+
+	// 通常の Draw が続けて呼ばれてもよいように元に戻す
+	sCommandList_->SetPipelineState(sPipelineState_.Get());
+	sCommandList_->SetGraphicsRootSignature(sRootSignature_.Get());
+}
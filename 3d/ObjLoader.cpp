@@ -0,0 +1,394 @@
+#include "ObjLoader.h"
+#include "MappedFile.h"
+#include <cassert>
+#include <charconv>
+#include <cstring>
+
+namespace {
+
+/// <summary>
+/// v/vt/vn の組から頂点番号を引く開番地法のハッシュ表
+/// </summary>
+class VertexMap {
+public:
+	// 想定要素数で空にする
+	void Reset(size_t expectedCount) {
+		size_t capacity = 16;
+		while (capacity < expectedCount * 2) {
+			capacity *= 2;
+		}
+		entries_.assign(capacity, Entry{});
+		count_ = 0;
+	}
+
+	// 登録済みならその頂点番号、無ければ newIndex を登録して返す
+	uint32_t FindOrInsert(int32_t p, int32_t t, int32_t n, uint32_t newIndex, bool* inserted) {
+		if (entries_.size() < (count_ + 1) * 2) {
+			Grow();
+		}
+		size_t mask = entries_.size() - 1;
+		for (size_t i = Hash(p, t, n) & mask;; i = (i + 1) & mask) {
+			Entry& entry = entries_[i];
+			if (entry.p == 0) {
+				entry = Entry{p, t, n, newIndex};
+				count_++;
+				*inserted = true;
+				return newIndex;
+			}
+			if (entry.p == p && entry.t == t && entry.n == n) {
+				*inserted = false;
+				return entry.index;
+			}
+		}
+	}
+
+private:
+	// 要素（p == 0 は空き。OBJの番号は1始まりなので衝突しない）
+	struct Entry {
+		int32_t p = 0;
+		int32_t t = 0;
+		int32_t n = 0;
+		uint32_t index = 0;
+	};
+
+	static size_t Hash(int32_t p, int32_t t, int32_t n) {
+		uint64_t h = static_cast<uint32_t>(p) * 0x9E3779B97F4A7C15ull;
+		h ^= static_cast<uint32_t>(t) * 0xC2B2AE3D27D4EB4Full;
+		h ^= static_cast<uint32_t>(n) * 0x165667B19E3779F9ull;
+		return static_cast<size_t>(h ^ (h >> 29));
+	}
+
+	void Grow() {
+		std::vector<Entry> old;
+		old.swap(entries_);
+		entries_.assign(old.size() * 2, Entry{});
+		size_t mask = entries_.size() - 1;
+		for (const Entry& entry : old) {
+			if (entry.p == 0) {
+				continue;
+			}
+			size_t i = Hash(entry.p, entry.t, entry.n) & mask;
+			while (entries_[i].p != 0) {
+				i = (i + 1) & mask;
+			}
+			entries_[i] = entry;
+		}
+	}
+
+	std::vector<Entry> entries_;
+	size_t count_ = 0;
+};
+
+// 読み込み前の集計
+struct Prescan {
+	size_t positionCount = 0;
+	size_t texcoordCount = 0;
+	size_t normalCount = 0;
+	size_t faceCount = 0;
+	// オブジェクト("o")ごとの面の数。先頭は最初の "o" より前の分
+	std::vector<size_t> objectFaceCounts;
+};
+
+// 行の終端（改行の位置、無ければ end）
+const char* FindLineEnd(const char* p, const char* end) {
+	const void* found = std::memchr(p, '\n', static_cast<size_t>(end - p));
+	return found ? static_cast<const char*>(found) : end;
+}
+
+const char* SkipSpaces(const char* p, const char* end) {
+	while (p < end && (*p == ' ' || *p == '\t')) {
+		p++;
+	}
+	return p;
+}
+
+// 行頭のキーワードが一致するか（キーワードの後は空白か行末）
+bool MatchKeyword(const char* p, const char* end, const char* keyword, size_t length) {
+	return static_cast<size_t>(end - p) >= length && std::memcmp(p, keyword, length) == 0 &&
+	       (p + length == end || p[length] == ' ' || p[length] == '\t');
+}
+
+bool ParseFloat(const char*& p, const char* end, float* value) {
+	p = SkipSpaces(p, end);
+	if (p < end && *p == '+') {
+		p++;
+	}
+	std::from_chars_result result = std::from_chars(p, end, *value);
+	if (result.ec != std::errc()) {
+		return false;
+	}
+	p = result.ptr;
+	return true;
+}
+
+bool ParseInt(const char*& p, const char* end, int32_t* value) {
+	std::from_chars_result result = std::from_chars(p, end, *value);
+	if (result.ec != std::errc()) {
+		return false;
+	}
+	p = result.ptr;
+	return true;
+}
+
+// 負の番号（末尾からの相対指定）を1始まりの絶対番号にする
+int32_t ResolveIndex(int32_t index, size_t count) {
+	return index < 0 ? static_cast<int32_t>(count) + index + 1 : index;
+}
+
+bool ParseVector3(const char*& p, const char* end, Vector3* value) {
+	return ParseFloat(p, end, &value->x) && ParseFloat(p, end, &value->y) &&
+	       ParseFloat(p, end, &value->z);
+}
+
+// 次の行を取り出す（行末の '\r' と行頭の空白を除く）。戻り値は次の行の先頭
+const char* NextLine(const char* p, const char* end, const char** lineBegin, const char** lineEnd) {
+	const char* found = FindLineEnd(p, end);
+	const char* next = found < end ? found + 1 : end;
+	if (p < found && found[-1] == '\r') {
+		found--;
+	}
+	*lineBegin = SkipSpaces(p, found);
+	*lineEnd = found;
+	return next;
+}
+
+Prescan PrescanText(const char* p, const char* end) {
+	Prescan prescan;
+	prescan.objectFaceCounts.push_back(0);
+	while (p < end) {
+		const char* line = nullptr;
+		const char* lineEnd = nullptr;
+		p = NextLine(p, end, &line, &lineEnd);
+		// 本読み込みと同じ判定で数える（"o" の数がずれると形状ごとの見積もりがずれる）
+		if (MatchKeyword(line, lineEnd, "v", 1)) {
+			prescan.positionCount++;
+		} else if (MatchKeyword(line, lineEnd, "vt", 2)) {
+			prescan.texcoordCount++;
+		} else if (MatchKeyword(line, lineEnd, "vn", 2)) {
+			prescan.normalCount++;
+		} else if (MatchKeyword(line, lineEnd, "f", 1)) {
+			prescan.faceCount++;
+			prescan.objectFaceCounts.back()++;
+		} else if (MatchKeyword(line, lineEnd, "o", 1)) {
+			prescan.objectFaceCounts.push_back(0);
+		}
+	}
+	return prescan;
+}
+
+} // namespace
+
+bool ObjLoader::Load(const std::string& filePath, ModelData* modelData) {
+	MappedFile file;
+	if (!file.Open(filePath)) {
+		return false;
+	}
+	return Parse(reinterpret_cast<const char*>(file.GetData()), file.GetSize(), modelData);
+}
+
+bool ObjLoader::Parse(const char* text, size_t size, ModelData* modelData) {
+	assert(modelData);
+	*modelData = {};
+	const char* p = text;
+	const char* end = text + size;
+
+	// 配列を先に確保しておくため、行の種類だけ数える
+	Prescan prescan = PrescanText(p, end);
+	std::vector<Vector3> positions;
+	std::vector<Vector2> texcoords;
+	std::vector<Vector3> normals;
+	positions.reserve(prescan.positionCount);
+	texcoords.reserve(prescan.texcoordCount);
+	normals.reserve(prescan.normalCount);
+
+	VertexMap vertexMap;
+	std::vector<uint32_t> face;
+	size_t objectIndex = 0;
+
+	// オブジェクトの面の数から頂点・インデックス数を見積もって確保する
+	auto reserveMesh = [&](MeshData& mesh, size_t faceCount) {
+		size_t vertexCount = prescan.faceCount == 0
+		                         ? 0
+		                         : prescan.positionCount * faceCount / prescan.faceCount * 5 / 4;
+		mesh.vertices.reserve(vertexCount);
+		mesh.positionIndices.reserve(vertexCount);
+		mesh.indices.reserve(faceCount * 3);
+		vertexMap.Reset(vertexCount);
+	};
+
+	modelData->meshes.emplace_back();
+	reserveMesh(modelData->meshes.back(), prescan.objectFaceCounts[0]);
+
+	while (p < end) {
+		const char* lineEnd = nullptr;
+		const char* next = NextLine(p, end, &p, &lineEnd);
+
+		MeshData* mesh = &modelData->meshes.back();
+		if (MatchKeyword(p, lineEnd, "v", 1)) {
+			Vector3 position{};
+			p += 1;
+			if (!ParseVector3(p, lineEnd, &position)) {
+				return false;
+			}
+			positions.push_back(position);
+		} else if (MatchKeyword(p, lineEnd, "vt", 2)) {
+			Vector2 texcoord{};
+			p += 2;
+			if (!ParseFloat(p, lineEnd, &texcoord.x) || !ParseFloat(p, lineEnd, &texcoord.y)) {
+				return false;
+			}
+			// V方向反転
+			texcoord.y = 1.0f - texcoord.y;
+			texcoords.push_back(texcoord);
+		} else if (MatchKeyword(p, lineEnd, "vn", 2)) {
+			Vector3 normal{};
+			p += 2;
+			if (!ParseVector3(p, lineEnd, &normal)) {
+				return false;
+			}
+			normals.push_back(normal);
+		} else if (MatchKeyword(p, lineEnd, "f", 1)) {
+			face.clear();
+			p = SkipSpaces(p + 1, lineEnd);
+			while (p < lineEnd) {
+				// v, v/vt, v//vn, v/vt/vn
+				int32_t indexPosition = 0, indexTexcoord = 0, indexNormal = 0;
+				if (!ParseInt(p, lineEnd, &indexPosition)) {
+					return false;
+				}
+				if (p < lineEnd && *p == '/') {
+					p++;
+					if (p < lineEnd && *p != '/' && !ParseInt(p, lineEnd, &indexTexcoord)) {
+						return false;
+					}
+					if (p < lineEnd && *p == '/') {
+						p++;
+						if (!ParseInt(p, lineEnd, &indexNormal)) {
+							return false;
+						}
+					}
+				}
+				indexPosition = ResolveIndex(indexPosition, positions.size());
+				indexTexcoord = ResolveIndex(indexTexcoord, texcoords.size());
+				indexNormal = ResolveIndex(indexNormal, normals.size());
+				if (indexPosition <= 0 || positions.size() < static_cast<size_t>(indexPosition) ||
+				    indexTexcoord < 0 || texcoords.size() < static_cast<size_t>(indexTexcoord) ||
+				    indexNormal < 0 || normals.size() < static_cast<size_t>(indexNormal)) {
+					return false;
+				}
+
+				// 同じ組み合わせの頂点は使い回す
+				bool inserted = false;
+				uint32_t vertexIndex = vertexMap.FindOrInsert(
+				    indexPosition, indexTexcoord, indexNormal,
+				    static_cast<uint32_t>(mesh->vertices.size()), &inserted);
+				if (inserted) {
+					MeshVertex vertex{};
+					vertex.pos = positions[indexPosition - 1];
+					if (indexTexcoord) {
+						vertex.uv = texcoords[indexTexcoord - 1];
+					}
+					if (indexNormal) {
+						vertex.normal = normals[indexNormal - 1];
+					}
+					mesh->vertices.push_back(vertex);
+					mesh->positionIndices.push_back(static_cast<uint32_t>(indexPosition - 1));
+				}
+				face.push_back(vertexIndex);
+				p = SkipSpaces(p, lineEnd);
+			}
+			// 多角形は扇状に三角形へ分割する
+			for (size_t i = 2; i < face.size(); i++) {
+				mesh->indices.push_back(face[0]);
+				mesh->indices.push_back(face[i - 1]);
+				mesh->indices.push_back(face[i]);
+			}
+		} else if (MatchKeyword(p, lineEnd, "o", 1)) {
+			objectIndex++;
+			// 中身のある形状の後なら新しい形状を始める
+			if (!mesh->name.empty() && !mesh->vertices.empty()) {
+				modelData->meshes.emplace_back();
+				mesh = &modelData->meshes.back();
+			}
+			if (mesh->vertices.empty()) {
+				const std::vector<size_t>& counts = prescan.objectFaceCounts;
+				reserveMesh(*mesh, objectIndex < counts.size() ? counts[objectIndex] : 0);
+			}
+			mesh->name.assign(SkipSpaces(p + 1, lineEnd), lineEnd);
+		} else if (MatchKeyword(p, lineEnd, "usemtl", 6)) {
+			mesh->materialName.assign(SkipSpaces(p + 6, lineEnd), lineEnd);
+		} else if (MatchKeyword(p, lineEnd, "mtllib", 6)) {
+			modelData->materialLibraries.emplace_back(SkipSpaces(p + 6, lineEnd), lineEnd);
+		}
+		p = next;
+	}
+
+	// 空の形状は捨てる
+	if (modelData->meshes.back().vertices.empty()) {
+		modelData->meshes.pop_back();
+	}
+	modelData->positionCount = static_cast<uint32_t>(positions.size());
+	return true;
+}
+
+bool ObjLoader::LoadMaterials(const std::string& directoryPath, ModelData* modelData) {
+	assert(modelData);
+	for (const std::string& library : modelData->materialLibraries) {
+		MappedFile file;
+		if (!file.Open(directoryPath + library)) {
+			return false;
+		}
+		if (!ParseMaterials(
+		        reinterpret_cast<const char*>(file.GetData()), file.GetSize(),
+		        &modelData->materials)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool ObjLoader::ParseMaterials(
+    const char* text, size_t size, std::vector<MaterialData>* materials) {
+	assert(materials);
+	const char* p = text;
+	const char* end = text + size;
+	MaterialData* material = nullptr;
+
+	while (p < end) {
+		const char* lineEnd = nullptr;
+		const char* next = NextLine(p, end, &p, &lineEnd);
+
+		if (MatchKeyword(p, lineEnd, "newmtl", 6)) {
+			materials->emplace_back();
+			material = &materials->back();
+			material->name.assign(SkipSpaces(p + 6, lineEnd), lineEnd);
+		} else if (material && MatchKeyword(p, lineEnd, "Ka", 2)) {
+			p += 2;
+			if (!ParseVector3(p, lineEnd, &material->ambient)) {
+				return false;
+			}
+		} else if (material && MatchKeyword(p, lineEnd, "Kd", 2)) {
+			p += 2;
+			if (!ParseVector3(p, lineEnd, &material->diffuse)) {
+				return false;
+			}
+		} else if (material && MatchKeyword(p, lineEnd, "Ks", 2)) {
+			p += 2;
+			if (!ParseVector3(p, lineEnd, &material->specular)) {
+				return false;
+			}
+		} else if (material && MatchKeyword(p, lineEnd, "map_Kd", 6)) {
+			// フルパスからファイル名を取り出す
+			const char* path = SkipSpaces(p + 6, lineEnd);
+			const char* name = path;
+			for (const char* c = path; c < lineEnd; c++) {
+				if (*c == '/' || *c == '\\') {
+					name = c + 1;
+				}
+			}
+			material->textureFilename.assign(name, lineEnd);
+		}
+		p = next;
+	}
+	return true;
+}
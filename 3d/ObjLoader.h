@@ -0,0 +1,47 @@
+#pragma once
+
+#include "MeshData.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// OBJファイルの読み込み
+/// ファイルをメモリマップし、ストリームを通さずに直接数値を読み取る
+/// </summary>
+class ObjLoader {
+public: // 静的メンバ関数
+	/// <summary>
+	/// ファイルから読み込む
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <param name="modelData">読み込み先</param>
+	/// <returns>成否</returns>
+	static bool Load(const std::string& filePath, ModelData* modelData);
+
+	/// <summary>
+	/// メモリ上のテキストから読み込む
+	/// </summary>
+	/// <param name="text">OBJ形式のテキスト</param>
+	/// <param name="size">バイト数</param>
+	/// <param name="modelData">読み込み先</param>
+	/// <returns>成否</returns>
+	static bool Parse(const char* text, size_t size, ModelData* modelData);
+
+	/// <summary>
+	/// OBJファイルが参照するマテリアルファイルをすべて読み込む
+	/// </summary>
+	/// <param name="directoryPath">マテリアルファイルのあるディレクトリ</param>
+	/// <param name="modelData">materialLibraries を読み、materials に追加する</param>
+	/// <returns>成否</returns>
+	static bool LoadMaterials(const std::string& directoryPath, ModelData* modelData);
+
+	/// <summary>
+	/// メモリ上のMTL形式のテキストからマテリアルを読み込む
+	/// </summary>
+	/// <param name="text">MTL形式のテキスト</param>
+	/// <param name="size">バイト数</param>
+	/// <param name="materials">追加先</param>
+	/// <returns>成否</returns>
+	static bool ParseMaterials(const char* text, size_t size, std::vector<MaterialData>* materials);
+};
@@ -0,0 +1,249 @@
+#include "TransformHierarchy.h"
+#include "MathUtility.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+void TransformHierarchy::Reserve(size_t capacity) {
+	parentIndex_.reserve(capacity);
+	scale_.reserve(capacity);
+	rotation_.reserve(capacity);
+	translation_.reserve(capacity);
+	matLocal_.reserve(capacity);
+	matWorld_.reserve(capacity);
+	flags_.reserve(capacity);
+	targets_.reserve(capacity);
+	nodeOfIndex_.reserve(capacity);
+	indexOfNode_.reserve(capacity);
+}
+
+void TransformHierarchy::Clear() {
+	parentIndex_.clear();
+	scale_.clear();
+	rotation_.clear();
+	translation_.clear();
+	matLocal_.clear();
+	matWorld_.clear();
+	flags_.clear();
+	targets_.clear();
+	nodeOfIndex_.clear();
+	indexOfNode_.clear();
+	freeNodes_.clear();
+	needsSort_ = false;
+	updatedCount_ = 0;
+}
+
+uint32_t TransformHierarchy::CreateNode(uint32_t parent) {
+	assert(parent == kInvalidNode || IsValid(parent));
+
+	// ノード番号の割り当て
+	uint32_t node;
+	if (freeNodes_.empty()) {
+		node = static_cast<uint32_t>(indexOfNode_.size());
+		indexOfNode_.push_back(kInvalidNode);
+	} else {
+		node = freeNodes_.back();
+		freeNodes_.pop_back();
+	}
+
+	// 末尾に追加すれば親より後ろになる
+	uint32_t index = static_cast<uint32_t>(nodeOfIndex_.size());
+	indexOfNode_[node] = index;
+	nodeOfIndex_.push_back(node);
+	parentIndex_.push_back(parent == kInvalidNode ? kInvalidNode : indexOfNode_[parent]);
+	scale_.push_back({1.0f, 1.0f, 1.0f});
+	rotation_.push_back({0.0f, 0.0f, 0.0f});
+	translation_.push_back({0.0f, 0.0f, 0.0f});
+	matLocal_.push_back(MakeIdentityMatrix());
+	matWorld_.push_back(MakeIdentityMatrix());
+	flags_.push_back(kDirtyLocal | kDirtyWorld);
+	targets_.push_back(nullptr);
+	return node;
+}
+
+void TransformHierarchy::DestroyNode(uint32_t node) {
+	assert(IsValid(node));
+	if (needsSort_) {
+		SortByDepth();
+	}
+
+	// 親が先に並んでいるので、前から順に見れば子孫をすべて拾える
+	uint32_t root = indexOfNode_[node];
+	std::vector<uint8_t> removed(nodeOfIndex_.size(), 0);
+	removed[root] = 1;
+	for (size_t i = root + 1; i < nodeOfIndex_.size(); ++i) {
+		uint32_t parent = parentIndex_[i];
+		if (parent != kInvalidNode && removed[parent]) {
+			removed[i] = 1;
+		}
+	}
+
+	// 残すノードの並び
+	std::vector<uint32_t> order;
+	order.reserve(nodeOfIndex_.size());
+	for (uint32_t i = 0; i < nodeOfIndex_.size(); ++i) {
+		if (removed[i]) {
+			indexOfNode_[nodeOfIndex_[i]] = kInvalidNode;
+			freeNodes_.push_back(nodeOfIndex_[i]);
+		} else {
+			order.push_back(i);
+		}
+	}
+	Reorder(order);
+}
+
+bool TransformHierarchy::SetParent(uint32_t node, uint32_t parent) {
+	assert(IsValid(node));
+	assert(parent == kInvalidNode || IsValid(parent));
+	uint32_t index = indexOfNode_[node];
+
+	if (parent == kInvalidNode) {
+		parentIndex_[index] = kInvalidNode;
+	} else {
+		uint32_t parentIndex = indexOfNode_[parent];
+		// 自分の子孫を親にすると循環し、並べ直しが終わらなくなる
+		for (uint32_t i = parentIndex; i != kInvalidNode; i = parentIndex_[i]) {
+			if (i == index) {
+				return false;
+			}
+		}
+		parentIndex_[index] = parentIndex;
+		// 親が後ろにいる場合は並べ直しが必要
+		if (index < parentIndex) {
+			needsSort_ = true;
+		}
+	}
+	flags_[index] |= kDirtyWorld;
+	return true;
+}
+
+uint32_t TransformHierarchy::GetParent(uint32_t node) const {
+	assert(IsValid(node));
+	uint32_t parentIndex = parentIndex_[indexOfNode_[node]];
+	return parentIndex == kInvalidNode ? kInvalidNode : nodeOfIndex_[parentIndex];
+}
+
+bool TransformHierarchy::IsValid(uint32_t node) const {
+	return node < indexOfNode_.size() && indexOfNode_[node] != kInvalidNode;
+}
+
+void TransformHierarchy::SetScale(uint32_t node, const Vector3& scale) {
+	uint32_t index = indexOfNode_[node];
+	scale_[index] = scale;
+	flags_[index] |= kDirtyLocal;
+}
+
+void TransformHierarchy::SetRotation(uint32_t node, const Vector3& rotation) {
+	uint32_t index = indexOfNode_[node];
+	rotation_[index] = rotation;
+	flags_[index] |= kDirtyLocal;
+}
+
+void TransformHierarchy::SetTranslation(uint32_t node, const Vector3& translation) {
+	uint32_t index = indexOfNode_[node];
+	translation_[index] = translation;
+	flags_[index] |= kDirtyLocal;
+}
+
+void TransformHierarchy::SetTarget(uint32_t node, Matrix4x4* target) {
+	uint32_t index = indexOfNode_[node];
+	targets_[index] = target;
+	// 書き込み先が変わったら次の更新で転送する
+	flags_[index] |= kDirtyWorld;
+}
+
+void TransformHierarchy::UpdateMatrices() {
+	if (needsSort_) {
+		SortByDepth();
+	}
+
+	updatedCount_ = 0;
+	for (size_t i = 0; i < flags_.size(); ++i) {
+		uint8_t flags = flags_[i];
+		uint32_t parent = parentIndex_[i];
+
+		if (flags & kDirtyLocal) {
+			matLocal_[i] = MakeAffineMatrix(scale_[i], rotation_[i], translation_[i]);
+			flags |= kDirtyWorld;
+		}
+		// 親が今回更新されていれば子も更新する
+		if (parent != kInvalidNode && (flags_[parent] & kUpdated)) {
+			flags |= kDirtyWorld;
+		}
+
+		if (flags & kDirtyWorld) {
+			matWorld_[i] =
+			    parent == kInvalidNode ? matLocal_[i] : Multiply(matLocal_[i], matWorld_[parent]);
+			if (targets_[i]) {
+				std::memcpy(targets_[i], &matWorld_[i], sizeof(Matrix4x4));
+			}
+			flags_[i] = kUpdated;
+			++updatedCount_;
+		} else {
+			flags_[i] = 0;
+		}
+	}
+}
+
+void TransformHierarchy::SortByDepth() {
+	size_t count = nodeOfIndex_.size();
+
+	// 各ノードの深さを求める
+	std::vector<uint32_t> depth(count, kInvalidNode);
+	std::vector<uint32_t> stack;
+	for (uint32_t i = 0; i < count; ++i) {
+		uint32_t j = i;
+		while (j != kInvalidNode && depth[j] == kInvalidNode) {
+			stack.push_back(j);
+			j = parentIndex_[j];
+		}
+		uint32_t d = j == kInvalidNode ? 0 : depth[j] + 1;
+		while (!stack.empty()) {
+			depth[stack.back()] = d++;
+			stack.pop_back();
+		}
+	}
+
+	// 深さ順に並べれば親が必ず先になる（同じ深さでは元の順を保つ）
+	std::vector<uint32_t> order(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		order[i] = i;
+	}
+	std::stable_sort(
+	    order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return depth[a] < depth[b]; });
+	Reorder(order);
+	needsSort_ = false;
+}
+
+void TransformHierarchy::Reorder(const std::vector<uint32_t>& order) {
+	// 旧インデックス → 新インデックス
+	std::vector<uint32_t> remap(nodeOfIndex_.size(), kInvalidNode);
+	for (uint32_t i = 0; i < order.size(); ++i) {
+		remap[order[i]] = i;
+	}
+
+	auto permute = [&order](auto& values) {
+		std::remove_reference_t<decltype(values)> sorted;
+		sorted.reserve(values.capacity());
+		for (uint32_t oldIndex : order) {
+			sorted.push_back(values[oldIndex]);
+		}
+		values.swap(sorted);
+	};
+	permute(parentIndex_);
+	permute(scale_);
+	permute(rotation_);
+	permute(translation_);
+	permute(matLocal_);
+	permute(matWorld_);
+	permute(flags_);
+	permute(targets_);
+	permute(nodeOfIndex_);
+
+	for (uint32_t i = 0; i < order.size(); ++i) {
+		if (parentIndex_[i] != kInvalidNode) {
+			parentIndex_[i] = remap[parentIndex_[i]];
+		}
+		indexOfNode_[nodeOfIndex_[i]] = i;
+	}
+}
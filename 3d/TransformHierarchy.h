@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 親子関係付きワールド変換
+/// ノードを親が必ず子より前に来る順で配列に並べ、変更のあった部分木だけ行列を再計算する
+/// </summary>
+class TransformHierarchy {
+public: // 定数
+	// 無効なノード
+	static constexpr uint32_t kInvalidNode = 0xffffffffu;
+
+public: // メンバ関数
+	/// <summary>
+	/// 容量確保
+	/// </summary>
+	/// <param name="capacity">最大ノード数</param>
+	void Reserve(size_t capacity);
+
+	/// <summary>
+	/// 全ノード削除
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// ノード生成
+	/// </summary>
+	/// <param name="parent">親ノード（なしなら kInvalidNode）</param>
+	/// <returns>ノード番号（削除されるまで変わらない）</returns>
+	uint32_t CreateNode(uint32_t parent = kInvalidNode);
+
+	/// <summary>
+	/// ノード削除。子孫もまとめて削除する
+	/// </summary>
+	/// <param name="node">ノード番号</param>
+	void DestroyNode(uint32_t node);
+
+	/// <summary>
+	/// 親の付け替え
+	/// </summary>
+	/// <param name="node">ノード番号</param>
+	/// <param name="parent">新しい親（なしなら kInvalidNode）</param>
+	/// <returns>成否（自分自身か自分の子孫を親にすると循環するので、何もせず false）</returns>
+	bool SetParent(uint32_t node, uint32_t parent);
+
+	/// <summary>
+	/// 親ノードの取得
+	/// </summary>
+	uint32_t GetParent(uint32_t node) const;
+
+	/// <summary>
+	/// ノードが有効か
+	/// </summary>
+	bool IsValid(uint32_t node) const;
+
+	/// <summary>
+	/// ノード数の取得
+	/// </summary>
+	size_t GetCount() const { return nodeOfIndex_.size(); }
+
+	void SetScale(uint32_t node, const Vector3& scale);
+	void SetRotation(uint32_t node, const Vector3& rotation);
+	void SetTranslation(uint32_t node, const Vector3& translation);
+	const Vector3& GetScale(uint32_t node) const { return scale_[indexOfNode_[node]]; }
+	const Vector3& GetRotation(uint32_t node) const { return rotation_[indexOfNode_[node]]; }
+	const Vector3& GetTranslation(uint32_t node) const {
+		return translation_[indexOfNode_[node]];
+	}
+
+	/// <summary>
+	/// 行列の書き込み先を設定（&worldTransform.constMap->matWorld など）
+	/// </summary>
+	/// <param name="node">ノード番号</param>
+	/// <param name="target">書き込み先（nullptrで解除）</param>
+	void SetTarget(uint32_t node, Matrix4x4* target);
+
+	/// <summary>
+	/// 変更のあったノードとその子孫のワールド行列を再計算する
+	/// </summary>
+	void UpdateMatrices();
+
+	/// <summary>
+	/// ワールド行列の取得（UpdateMatrices 後に有効）
+	/// </summary>
+	const Matrix4x4& GetWorldMatrix(uint32_t node) const { return matWorld_[indexOfNode_[node]]; }
+
+	/// <summary>
+	/// 直前の UpdateMatrices で再計算したノード数
+	/// </summary>
+	size_t GetUpdatedCount() const { return updatedCount_; }
+
+private: // 定数
+	// ダーティフラグ
+	static constexpr uint8_t kDirtyLocal = 1 << 0; // ローカル行列の再計算が必要
+	static constexpr uint8_t kDirtyWorld = 1 << 1; // ワールド行列の再計算が必要
+	static constexpr uint8_t kUpdated = 1 << 2;    // 今回ワールド行列が更新された
+
+private: // メンバ関数
+	/// <summary>
+	/// 親が子より前に来るように並べ直す
+	/// </summary>
+	void SortByDepth();
+
+	/// <summary>
+	/// 配列を新しい順番で並べ直す
+	/// </summary>
+	/// <param name="order">新しい並びでの旧インデックス</param>
+	void Reorder(const std::vector<uint32_t>& order);
+
+private: // メンバ変数
+	// 親のインデックス（配列内の位置）
+	std::vector<uint32_t> parentIndex_;
+	// ローカルスケール
+	std::vector<Vector3> scale_;
+	// X,Y,Z軸回りのローカル回転角
+	std::vector<Vector3> rotation_;
+	// ローカル座標
+	std::vector<Vector3> translation_;
+	// ローカル行列
+	std::vector<Matrix4x4> matLocal_;
+	// ワールド行列
+	std::vector<Matrix4x4> matWorld_;
+	// ダーティフラグ
+	std::vector<uint8_t> flags_;
+	// 行列の書き込み先
+	std::vector<Matrix4x4*> targets_;
+	// 配列内の位置 → ノード番号
+	std::vector<uint32_t> nodeOfIndex_;
+	// ノード番号 → 配列内の位置
+	std::vector<uint32_t> indexOfNode_;
+	// 再利用可能なノード番号
+	std::vector<uint32_t> freeNodes_;
+	// 並べ直しが必要か
+	bool needsSort_ = false;
+	// 直前の更新数
+	size_t updatedCount_ = 0;
+};
@@ -0,0 +1,230 @@
+#include "TransformSystem.h"
+#include "MathUtility.h"
+#include "SimdConfig.h"
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+#if defined(MATH_USE_SSE)
+/// <summary>
+/// 4要素同時の sin/cos（Cephes の多項式近似）
+/// </summary>
+void SinCos4(__m128 x, __m128* outSin, __m128* outCos) {
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+
+	// 絶対値と符号に分ける
+	__m128 signSin = _mm_and_ps(x, signMask);
+	x = _mm_andnot_ps(signMask, x);
+
+	// π/4 単位の象限を求める（偶数に切り上げ）
+	__m128i j = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+	j = _mm_add_epi32(j, _mm_set1_epi32(1));
+	j = _mm_and_si128(j, _mm_set1_epi32(~1));
+	__m128 y = _mm_cvtepi32_ps(j);
+
+	// 象限ごとの符号反転と多項式の選択
+	__m128 swapSignSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, _mm_set1_epi32(4)), 29));
+	__m128 polyMask = _mm_castsi128_ps(
+	    _mm_cmpeq_epi32(_mm_and_si128(j, _mm_set1_epi32(2)), _mm_setzero_si128()));
+	__m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(
+	    _mm_andnot_si128(_mm_sub_epi32(j, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+	signSin = _mm_xor_ps(signSin, swapSignSin);
+
+	// x - y * π/4 を3分割で精度よく計算
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+	__m128 z = _mm_mul_ps(x, x);
+
+	// cos の多項式
+	__m128 pc = _mm_set1_ps(2.443315711809948e-5f);
+	pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(-1.388731625493765e-3f));
+	pc = _mm_add_ps(_mm_mul_ps(pc, z), _mm_set1_ps(4.166664568298827e-2f));
+	pc = _mm_mul_ps(_mm_mul_ps(pc, z), z);
+	pc = _mm_sub_ps(pc, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	pc = _mm_add_ps(pc, _mm_set1_ps(1.0f));
+
+	// sin の多項式
+	__m128 ps = _mm_set1_ps(-1.9515295891e-4f);
+	ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(8.3321608736e-3f));
+	ps = _mm_add_ps(_mm_mul_ps(ps, z), _mm_set1_ps(-1.6666654611e-1f));
+	ps = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, z), x), x);
+
+	__m128 s = _mm_or_ps(_mm_and_ps(polyMask, ps), _mm_andnot_ps(polyMask, pc));
+	__m128 c = _mm_or_ps(_mm_and_ps(polyMask, pc), _mm_andnot_ps(polyMask, ps));
+	*outSin = _mm_xor_ps(s, signSin);
+	*outCos = _mm_xor_ps(c, signCos);
+}
+#endif
+
+} // namespace
+
+void TransformSystem::Reserve(size_t capacity) {
+	for (auto* channel : {
+	         &scaleX_, &scaleY_, &scaleZ_, &rotateX_, &rotateY_, &rotateZ_, &translateX_,
+	         &translateY_, &translateZ_}) {
+		channel->reserve(capacity);
+	}
+	matWorld_.reserve(capacity);
+	targets_.reserve(capacity);
+}
+
+void TransformSystem::Clear() {
+	for (auto* channel : {
+	         &scaleX_, &scaleY_, &scaleZ_, &rotateX_, &rotateY_, &rotateZ_, &translateX_,
+	         &translateY_, &translateZ_}) {
+		channel->clear();
+	}
+	matWorld_.clear();
+	targets_.clear();
+}
+
+uint32_t TransformSystem::Add(
+    const Vector3& scale, const Vector3& rotation, const Vector3& translation) {
+	uint32_t index = static_cast<uint32_t>(matWorld_.size());
+	scaleX_.push_back(scale.x);
+	scaleY_.push_back(scale.y);
+	scaleZ_.push_back(scale.z);
+	rotateX_.push_back(rotation.x);
+	rotateY_.push_back(rotation.y);
+	rotateZ_.push_back(rotation.z);
+	translateX_.push_back(translation.x);
+	translateY_.push_back(translation.y);
+	translateZ_.push_back(translation.z);
+	matWorld_.push_back(MakeAffineMatrix(scale, rotation, translation));
+	targets_.push_back(nullptr);
+	return index;
+}
+
+void TransformSystem::Remove(uint32_t index) {
+	assert(index < matWorld_.size());
+	size_t last = matWorld_.size() - 1;
+	for (auto* channel : {
+	         &scaleX_, &scaleY_, &scaleZ_, &rotateX_, &rotateY_, &rotateZ_, &translateX_,
+	         &translateY_, &translateZ_}) {
+		(*channel)[index] = (*channel)[last];
+		channel->pop_back();
+	}
+	matWorld_[index] = matWorld_[last];
+	matWorld_.pop_back();
+	targets_[index] = targets_[last];
+	targets_.pop_back();
+}
+
+void TransformSystem::SetScale(uint32_t index, const Vector3& scale) {
+	scaleX_[index] = scale.x;
+	scaleY_[index] = scale.y;
+	scaleZ_[index] = scale.z;
+}
+
+void TransformSystem::SetRotation(uint32_t index, const Vector3& rotation) {
+	rotateX_[index] = rotation.x;
+	rotateY_[index] = rotation.y;
+	rotateZ_[index] = rotation.z;
+}
+
+void TransformSystem::SetTranslation(uint32_t index, const Vector3& translation) {
+	translateX_[index] = translation.x;
+	translateY_[index] = translation.y;
+	translateZ_[index] = translation.z;
+}
+
+Vector3 TransformSystem::GetScale(uint32_t index) const {
+	return {scaleX_[index], scaleY_[index], scaleZ_[index]};
+}
+
+Vector3 TransformSystem::GetRotation(uint32_t index) const {
+	return {rotateX_[index], rotateY_[index], rotateZ_[index]};
+}
+
+Vector3 TransformSystem::GetTranslation(uint32_t index) const {
+	return {translateX_[index], translateY_[index], translateZ_[index]};
+}
+
+void TransformSystem::SetTarget(uint32_t index, Matrix4x4* target) { targets_[index] = target; }
+
+void TransformSystem::UpdateMatrices() {
+	Compute(0, matWorld_.size(), [this](size_t i) { return &matWorld_[i]; });
+
+	// 書き込み先へ転送
+	for (size_t i = 0; i < targets_.size(); ++i) {
+		if (targets_[i]) {
+			std::memcpy(targets_[i], &matWorld_[i], sizeof(Matrix4x4));
+		}
+	}
+}
+
+void TransformSystem::UpdateMatrices(void* dst, size_t strideBytes) {
+	assert(dst);
+	assert(sizeof(Matrix4x4) <= strideBytes);
+	uint8_t* base = static_cast<uint8_t*>(dst);
+	Compute(0, matWorld_.size(), [base, strideBytes](size_t i) {
+		return reinterpret_cast<Matrix4x4*>(base + i * strideBytes);
+	});
+}
+
+template<class Writer>
+void TransformSystem::Compute(size_t begin, size_t end, Writer&& writer) const {
+	size_t i = begin;
+#if defined(MATH_USE_SSE)
+	// 4要素ずつ、MakeAffineMatrix と同じ式を成分配列のまま計算する
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= end; i += 4) {
+		__m128 sinX, cosX, sinY, cosY, sinZ, cosZ;
+		SinCos4(_mm_loadu_ps(&rotateX_[i]), &sinX, &cosX);
+		SinCos4(_mm_loadu_ps(&rotateY_[i]), &sinY, &cosY);
+		SinCos4(_mm_loadu_ps(&rotateZ_[i]), &sinZ, &cosZ);
+		__m128 scaleX = _mm_loadu_ps(&scaleX_[i]);
+		__m128 scaleY = _mm_loadu_ps(&scaleY_[i]);
+		__m128 scaleZ = _mm_loadu_ps(&scaleZ_[i]);
+
+		__m128 sxsy = _mm_mul_ps(sinX, sinY);
+		__m128 cxsy = _mm_mul_ps(cosX, sinY);
+
+		__m128 m00 = _mm_mul_ps(scaleX, _mm_mul_ps(cosY, cosZ));
+		__m128 m01 = _mm_mul_ps(scaleX, _mm_mul_ps(cosY, sinZ));
+		__m128 m02 = _mm_mul_ps(scaleX, _mm_sub_ps(zero, sinY));
+		__m128 m10 = _mm_mul_ps(
+		    scaleY, _mm_sub_ps(_mm_mul_ps(sxsy, cosZ), _mm_mul_ps(cosX, sinZ)));
+		__m128 m11 = _mm_mul_ps(
+		    scaleY, _mm_add_ps(_mm_mul_ps(sxsy, sinZ), _mm_mul_ps(cosX, cosZ)));
+		__m128 m12 = _mm_mul_ps(scaleY, _mm_mul_ps(sinX, cosY));
+		__m128 m20 = _mm_mul_ps(
+		    scaleZ, _mm_add_ps(_mm_mul_ps(cxsy, cosZ), _mm_mul_ps(sinX, sinZ)));
+		__m128 m21 = _mm_mul_ps(
+		    scaleZ, _mm_sub_ps(_mm_mul_ps(cxsy, sinZ), _mm_mul_ps(sinX, cosZ)));
+		__m128 m22 = _mm_mul_ps(scaleZ, _mm_mul_ps(cosX, cosY));
+		__m128 m30 = _mm_loadu_ps(&translateX_[i]);
+		__m128 m31 = _mm_loadu_ps(&translateY_[i]);
+		__m128 m32 = _mm_loadu_ps(&translateZ_[i]);
+
+		// 成分ごとの並びを要素ごとの行に並べ替える
+		__m128 w0 = zero, w1 = zero, w2 = zero, w3 = one;
+		_MM_TRANSPOSE4_PS(m00, m01, m02, w0);
+		_MM_TRANSPOSE4_PS(m10, m11, m12, w1);
+		_MM_TRANSPOSE4_PS(m20, m21, m22, w2);
+		_MM_TRANSPOSE4_PS(m30, m31, m32, w3);
+		__m128 rows[4][4] = {
+		    {m00, m10, m20, m30},
+		    {m01, m11, m21, m31},
+		    {m02, m12, m22, m32},
+		    {w0, w1, w2, w3},
+		};
+		for (size_t k = 0; k < 4; ++k) {
+			Matrix4x4* dst = writer(i + k);
+			_mm_storeu_ps(dst->m[0], rows[k][0]);
+			_mm_storeu_ps(dst->m[1], rows[k][1]);
+			_mm_storeu_ps(dst->m[2], rows[k][2]);
+			_mm_storeu_ps(dst->m[3], rows[k][3]);
+		}
+	}
+#endif
+	// 端数（SIMD無効時は全要素）
+	for (; i < end; ++i) {
+		*writer(i) = MakeAffineMatrix(
+		    {scaleX_[i], scaleY_[i], scaleZ_[i]}, {rotateX_[i], rotateY_[i], rotateZ_[i]},
+		    {translateX_[i], translateY_[i], translateZ_[i]});
+	}
+}
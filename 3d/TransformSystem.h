@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// ワールド変換の一括更新
+/// スケール・回転・平行移動を成分ごとの配列(SoA)で持ち、全ワールド行列をまとめて計算する
+/// </summary>
+class TransformSystem {
+public: // サブクラス
+	/// <summary>
+	/// 成分配列への参照（x,y,z がそれぞれ GetCount() 個並ぶ）
+	/// </summary>
+	struct Channel {
+		float* x;
+		float* y;
+		float* z;
+	};
+
+public: // メンバ関数
+	/// <summary>
+	/// 容量確保
+	/// </summary>
+	/// <param name="capacity">最大要素数</param>
+	void Reserve(size_t capacity);
+
+	/// <summary>
+	/// 全要素削除
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 要素追加
+	/// </summary>
+	/// <param name="scale">スケール</param>
+	/// <param name="rotation">X,Y,Z軸回りの回転角</param>
+	/// <param name="translation">座標</param>
+	/// <returns>要素番号</returns>
+	uint32_t Add(
+	    const Vector3& scale = {1.0f, 1.0f, 1.0f}, const Vector3& rotation = {0.0f, 0.0f, 0.0f},
+	    const Vector3& translation = {0.0f, 0.0f, 0.0f});
+
+	/// <summary>
+	/// 要素削除。末尾の要素が index に移動する
+	/// </summary>
+	/// <param name="index">要素番号</param>
+	void Remove(uint32_t index);
+
+	/// <summary>
+	/// 要素数の取得
+	/// </summary>
+	size_t GetCount() const { return matWorld_.size(); }
+
+	void SetScale(uint32_t index, const Vector3& scale);
+	void SetRotation(uint32_t index, const Vector3& rotation);
+	void SetTranslation(uint32_t index, const Vector3& translation);
+	Vector3 GetScale(uint32_t index) const;
+	Vector3 GetRotation(uint32_t index) const;
+	Vector3 GetTranslation(uint32_t index) const;
+
+	/// <summary>
+	/// 成分配列を直接取得（全要素をまとめて動かす用）
+	/// </summary>
+	Channel GetScales() { return {scaleX_.data(), scaleY_.data(), scaleZ_.data()}; }
+	Channel GetRotations() { return {rotateX_.data(), rotateY_.data(), rotateZ_.data()}; }
+	Channel GetTranslations() {
+		return {translateX_.data(), translateY_.data(), translateZ_.data()};
+	}
+
+	/// <summary>
+	/// 行列の書き込み先を設定
+	/// &worldTransform.constMap->matWorld を渡せば定数バッファへ直接書き込む
+	/// </summary>
+	/// <param name="index">要素番号</param>
+	/// <param name="target">書き込み先（nullptrで解除）</param>
+	void SetTarget(uint32_t index, Matrix4x4* target);
+
+	/// <summary>
+	/// 全ワールド行列を再計算し、書き込み先が設定されていればそこにも書き込む
+	/// </summary>
+	void UpdateMatrices();
+
+	/// <summary>
+	/// 全ワールド行列を再計算し、指定メモリに直接書き込む（内部の行列は更新しない）
+	/// </summary>
+	/// <param name="dst">書き込み先の先頭（マップ済み定数バッファなど）</param>
+	/// <param name="strideBytes">1要素あたりのバイト数（定数バッファなら256）</param>
+	void UpdateMatrices(void* dst, size_t strideBytes);
+
+	/// <summary>
+	/// ワールド行列の取得
+	/// </summary>
+	const Matrix4x4& GetMatrix(uint32_t index) const { return matWorld_[index]; }
+	const Matrix4x4* GetMatrices() const { return matWorld_.data(); }
+
+private: // メンバ関数
+	/// <summary>
+	/// [begin, end) のワールド行列を計算して writer に渡す
+	/// </summary>
+	template<class Writer> void Compute(size_t begin, size_t end, Writer&& writer) const;
+
+private: // メンバ変数
+	// スケール
+	std::vector<float> scaleX_, scaleY_, scaleZ_;
+	// X,Y,Z軸回りの回転角
+	std::vector<float> rotateX_, rotateY_, rotateZ_;
+	// 座標
+	std::vector<float> translateX_, translateY_, translateZ_;
+	// ワールド変換行列
+	std::vector<Matrix4x4> matWorld_;
+	// 行列の書き込み先
+	std::vector<Matrix4x4*> targets_;
+};
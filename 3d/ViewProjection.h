@@ -2,8 +2,10 @@
 
 #include "Matrix4x4.h"
 #include "Vector3.h"
+#ifdef _WIN32
 #include <d3d12.h>
 #include <wrl.h>
+#endif
 
 // 定数バッファ用データ構造体
 struct ConstBufferDataViewProjection {
@@ -16,8 +18,10 @@ struct ConstBufferDataViewProjection {
 /// ビュープロジェクション変換データ
 /// </summary>
 struct ViewProjection {
-	// 定数バッファ
+#ifdef _WIN32
+	// 定数バッファ（ヘッドレス実行のビルドには無い）
 	Microsoft::WRL::ComPtr<ID3D12Resource> constBuff_;
+#endif
 	// マッピング済みアドレス
 	ConstBufferDataViewProjection* constMap = nullptr;
 
@@ -2,8 +2,10 @@
 
 #include "Matrix4x4.h"
 #include "Vector3.h"
+#ifdef _WIN32
 #include <d3d12.h>
 #include <wrl.h>
+#endif
 
 // 定数バッファ用データ構造体
 struct ConstBufferDataWorldTransform {
@@ -14,8 +16,10 @@ struct ConstBufferDataWorldTransform {
 /// ワールド変換データ
 /// </summary>
 struct WorldTransform {
-	// 定数バッファ
+#ifdef _WIN32
+	// 定数バッファ（ヘッドレス実行のビルドには無い）
 	Microsoft::WRL::ComPtr<ID3D12Resource> constBuff_;
+#endif
 	// マッピング済みアドレス
 	ConstBufferDataWorldTransform* constMap = nullptr;
 	// ローカルスケール
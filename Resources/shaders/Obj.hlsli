@@ -78,3 +78,12 @@ struct VSOutput {
 	float3 normal : NORMAL;     // 法線
 	float2 uv : TEXCOORD;       // uv値
 };
+
+// インスタンス描画で頂点シェーダーからピクセルシェーダーへのやり取りに使用する構造体
+struct VSOutputInstanced {
+	float4 svpos : SV_POSITION; // システム用頂点座標
+	float4 worldpos : POSITION; // ワールド座標
+	float3 normal : NORMAL;     // 法線
+	float2 uv : TEXCOORD;       // uv値
+	float4 color : COLOR;       // インスタンスの色
+};
@@ -0,0 +1,10 @@
+#include "ObjShading.hlsli"
+
+float4 main(VSOutputInstanced input) : SV_TARGET {
+	VSOutput shading;
+	shading.svpos = input.svpos;
+	shading.worldpos = input.worldpos;
+	shading.normal = input.normal;
+	shading.uv = input.uv;
+	return ShadeObj(shading) * input.color;
+}
\ No newline at end of file
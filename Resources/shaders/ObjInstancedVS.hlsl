@@ -0,0 +1,30 @@
+#include "Obj.hlsli"
+
+// インスタンスごとのデータ（InstanceData.h と同じ並び）
+struct InstanceData {
+	matrix world; // ワールド行列
+	float4 color; // 色
+};
+
+StructuredBuffer<InstanceData> instances : register(t1);
+
+VSOutputInstanced main(
+    float4 pos : POSITION, float3 normal : NORMAL, float2 uv : TEXCOORD,
+    uint instanceId : SV_InstanceID) {
+	InstanceData instance = instances[instanceId];
+
+	// 法線にワールド行列によるスケーリング・回転を適用
+	// ※スケーリングが一様な場合のみ正しい
+	float4 worldNormal = normalize(mul(float4(normal, 0), instance.world));
+	float4 worldPos = mul(pos, instance.world);
+
+	VSOutputInstanced output; // ピクセルシェーダーに渡す値
+	output.svpos = mul(worldPos, mul(view, projection));
+
+	output.worldpos = worldPos;
+	output.normal = worldNormal.xyz;
+	output.uv = uv;
+	output.color = instance.color;
+
+	return output;
+}
@@ -0,0 +1,11 @@
+cbuffer ScreenTransform : register(b0) {
+	float2 screenScale;  // ピクセル座標から正規化デバイス座標への拡大
+	float2 screenOffset; // ピクセル座標から正規化デバイス座標への平行移動
+};
+
+// 頂点シェーダーからピクセルシェーダーへのやり取りに使用する構造体
+struct VSOutput {
+	float4 svpos : SV_POSITION; // システム用頂点座標
+	float2 uv : TEXCOORD;       // uv値
+	float4 color : COLOR;       // 色(RGBA)
+};
@@ -0,0 +1,9 @@
+#include "SpriteBatch.hlsli"
+
+VSOutput main(float3 pos : POSITION, float2 uv : TEXCOORD, float4 color : COLOR) {
+	VSOutput output; // ピクセルシェーダーに渡す値
+	output.svpos = float4(pos.xy * screenScale + screenOffset, pos.z, 1.0f);
+	output.uv = uv;
+	output.color = color;
+	return output;
+}
\ No newline at end of file
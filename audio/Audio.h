@@ -68,6 +68,11 @@ public:
 	/// </summary>
 	void Finalize();
 
+	/// <summary>
+	/// XAudio2 の取得（サウンドバンク・ストリーミング再生で共有する）
+	/// </summary>
+	IXAudio2* GetXAudio2() const { return xAudio2_.Get(); }
+
 	/// <summary>
 	/// WAV音声読み込み
 	/// </summary>
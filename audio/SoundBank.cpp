@@ -0,0 +1,191 @@
+#include "SoundBank.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+namespace {
+
+// ファイル識別子
+constexpr char kMagic[4] = {'K', 'S', 'B', 'K'};
+// 波形データのアライメント
+constexpr uint64_t kDataAlignment = 16;
+
+// ファイルヘッダ
+struct FileHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t soundCount;
+	uint32_t stringTableOffset;
+	uint32_t stringTableSize;
+	uint32_t reserved;
+	uint64_t fileSize;
+};
+
+// 音声の目次（名前順）
+struct SoundRecord {
+	uint32_t nameOffset;
+	uint32_t nameLength;
+	WaveFormat format;
+	uint64_t dataOffset;
+	uint32_t dataSize;
+	uint32_t reserved;
+};
+
+uint64_t AlignUp(uint64_t value) { return (value + kDataAlignment - 1) & ~(kDataAlignment - 1); }
+
+const FileHeader& GetHeader(const MappedFile& file) {
+	return *reinterpret_cast<const FileHeader*>(file.GetData());
+}
+
+const SoundRecord* GetSoundRecords(const MappedFile& file) {
+	return reinterpret_cast<const SoundRecord*>(file.GetData() + sizeof(FileHeader));
+}
+
+std::string_view GetName(const MappedFile& file, const SoundRecord& record) {
+	const char* table =
+	    reinterpret_cast<const char*>(file.GetData() + GetHeader(file).stringTableOffset);
+	return std::string_view(table + record.nameOffset, record.nameLength);
+}
+
+} // namespace
+
+bool SoundBank::Write(const std::string& filePath, const std::vector<Source>& sources) {
+	// 名前順に並べる
+	std::vector<size_t> order(sources.size());
+	std::iota(order.begin(), order.end(), size_t(0));
+	std::sort(order.begin(), order.end(), [&sources](size_t a, size_t b) {
+		return sources[a].name < sources[b].name;
+	});
+
+	FileHeader header{};
+	std::memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	header.soundCount = static_cast<uint32_t>(sources.size());
+	header.stringTableOffset =
+	    static_cast<uint32_t>(sizeof(FileHeader) + sizeof(SoundRecord) * sources.size());
+
+	// 元の WAV を開いて目次を作る
+	std::vector<MappedFile> files(sources.size());
+	std::vector<SoundRecord> records(sources.size());
+	std::vector<const uint8_t*> waveData(sources.size());
+	std::string strings;
+	for (size_t i = 0; i < order.size(); i++) {
+		const Source& source = sources[order[i]];
+		WaveInfo info;
+		if (!files[i].Open(source.filePath) ||
+		    !WaveFile::Parse(files[i].GetData(), files[i].GetSize(), &info)) {
+			return false;
+		}
+		SoundRecord& record = records[i];
+		record = {};
+		record.nameOffset = static_cast<uint32_t>(strings.size());
+		record.nameLength = static_cast<uint32_t>(source.name.size());
+		record.format = info.format;
+		record.dataSize = info.dataSize;
+		waveData[i] = files[i].GetData() + info.dataOffset;
+		strings += source.name;
+	}
+	header.stringTableSize = static_cast<uint32_t>(strings.size());
+	uint64_t offset = uint64_t(header.stringTableOffset) + strings.size();
+	for (SoundRecord& record : records) {
+		record.dataOffset = offset = AlignUp(offset);
+		offset += record.dataSize;
+	}
+	header.fileSize = offset;
+
+	// 書きかけのファイルを読まれないよう、別名で書いてから置き換える
+	std::string temporaryPath = filePath + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+		auto write = [&file](const void* data, uint64_t size) {
+			file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		};
+		write(&header, sizeof(header));
+		write(records.data(), sizeof(SoundRecord) * records.size());
+		write(strings.data(), strings.size());
+		for (size_t i = 0; i < records.size(); i++) {
+			static const char kZeros[kDataAlignment] = {};
+			write(kZeros, records[i].dataOffset - static_cast<uint64_t>(file.tellp()));
+			write(waveData[i], records[i].dataSize);
+		}
+		if (!file) {
+			return false;
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, filePath, error);
+	return !error;
+}
+
+bool SoundBank::Open(const std::string& filePath) {
+	Close();
+	if (!file_.Open(filePath) || !Validate()) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void SoundBank::Close() { file_.Close(); }
+
+bool SoundBank::Validate() const {
+	if (file_.GetSize() < sizeof(FileHeader)) {
+		return false;
+	}
+	const FileHeader& header = GetHeader(file_);
+	if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+	    header.fileSize != file_.GetSize()) {
+		return false;
+	}
+	uint64_t tableEnd = sizeof(FileHeader) + sizeof(SoundRecord) * uint64_t(header.soundCount);
+	if (header.stringTableOffset != tableEnd ||
+	    file_.GetSize() < tableEnd + header.stringTableSize) {
+		return false;
+	}
+	// 範囲外を指していないか
+	const SoundRecord* records = GetSoundRecords(file_);
+	for (uint32_t i = 0; i < header.soundCount; i++) {
+		const SoundRecord& record = records[i];
+		if (header.stringTableSize < uint64_t(record.nameOffset) + record.nameLength ||
+		    file_.GetSize() < record.dataOffset + record.dataSize ||
+		    record.format.blockAlign == 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uint32_t SoundBank::GetSoundCount() const {
+	return file_.IsOpen() ? GetHeader(file_).soundCount : 0;
+}
+
+uint32_t SoundBank::Find(std::string_view name) const {
+	const SoundRecord* begin = GetSoundRecords(file_);
+	const SoundRecord* end = begin + GetSoundCount();
+	const SoundRecord* it = std::lower_bound(
+	    begin, end, name,
+	    [this](const SoundRecord& record, std::string_view key) {
+		    return GetName(file_, record) < key;
+	    });
+	if (it == end || GetName(file_, *it) != name) {
+		return kInvalidIndex;
+	}
+	return static_cast<uint32_t>(it - begin);
+}
+
+SoundBank::SoundView SoundBank::GetSound(uint32_t index) const {
+	assert(index < GetSoundCount());
+	const SoundRecord& record = GetSoundRecords(file_)[index];
+	SoundView view;
+	view.name = GetName(file_, record);
+	view.format = &record.format;
+	view.data = file_.GetData() + record.dataOffset;
+	view.size = record.dataSize;
+	return view;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "WaveFile.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// <summary>
+/// サウンドバンク（多数の WAV の波形を1ファイルに詰めたもの）
+/// 読み込み時はメモリマップして、波形データをコピーせずにそのまま再生に渡す
+/// </summary>
+class SoundBank {
+public: // 定数
+	// 形式のバージョン（レイアウトを変えたら上げる）
+	static constexpr uint32_t kVersion = 1;
+	// 見つからなかったときの番号
+	static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+public: // サブクラス
+	/// <summary>
+	/// 詰める音声
+	/// </summary>
+	struct Source {
+		// 名前（バンク内で引くときの名前）
+		std::string name;
+		// WAV ファイルのパス
+		std::string filePath;
+	};
+
+	/// <summary>
+	/// 音声の参照（Close するまで有効）
+	/// </summary>
+	struct SoundView {
+		// 名前
+		std::string_view name;
+		// 波形フォーマット
+		const WaveFormat* format = nullptr;
+		// 波形データ
+		const uint8_t* data = nullptr;
+		uint32_t size = 0;
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// バンクファイルの書き出し
+	/// </summary>
+	/// <param name="filePath">書き出し先</param>
+	/// <param name="sources">詰める音声（名前が重複しないこと）</param>
+	/// <returns>成否（読めない WAV があれば false）</returns>
+	static bool Write(const std::string& filePath, const std::vector<Source>& sources);
+
+public: // メンバ関数
+	/// <summary>
+	/// バンクファイルを開く
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>成否（無い・壊れている・バージョン違いなら false）</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// 閉じる
+	/// </summary>
+	void Close();
+
+	bool IsOpen() const { return file_.IsOpen(); }
+
+	/// <summary>
+	/// 音声の数
+	/// </summary>
+	uint32_t GetSoundCount() const;
+
+	/// <summary>
+	/// 名前で探す（名前順に並べてあるので二分探索）
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <returns>番号（無ければ kInvalidIndex）</returns>
+	uint32_t Find(std::string_view name) const;
+
+	/// <summary>
+	/// 音声の参照
+	/// </summary>
+	/// <param name="index">番号</param>
+	SoundView GetSound(uint32_t index) const;
+
+private: // メンバ関数
+	/// <summary>
+	/// 中身の検証
+	/// </summary>
+	bool Validate() const;
+
+private: // メンバ変数
+	// ファイル
+	MappedFile file_;
+};
@@ -0,0 +1,261 @@
+#include "StreamingAudio.h"
+#include <cassert>
+#include <cstddef>
+#include <filesystem>
+
+// WaveFormat はそのまま WAVEFORMATEX（拡張部分込みで WAVEFORMATEXTENSIBLE）として渡す
+static_assert(offsetof(WaveFormat, extraSize) == offsetof(WAVEFORMATEX, cbSize));
+static_assert(sizeof(WaveFormat) == sizeof(WAVEFORMATEXTENSIBLE));
+
+void STDMETHODCALLTYPE StreamingAudio::Voice::OnStreamEnd() { isFinished.store(true); }
+
+void STDMETHODCALLTYPE StreamingAudio::Voice::OnBufferEnd(void* pBufferContext) {
+	if (stream) {
+		stream->Release(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(pBufferContext)));
+	}
+}
+
+void STDMETHODCALLTYPE StreamingAudio::Voice::OnVoiceError(void*, HRESULT) {
+	isFinished.store(true);
+}
+
+StreamingAudio* StreamingAudio::GetInstance() {
+	static StreamingAudio instance;
+	return &instance;
+}
+
+void StreamingAudio::Initialize(IXAudio2* xAudio2, const std::string& directoryPath) {
+	assert(xAudio2);
+
+	xAudio2_ = xAudio2;
+	directoryPath_ = directoryPath;
+}
+
+void StreamingAudio::Finalize() {
+	// バンクの波形を参照しているボイスを先に止める
+	for (auto& [handle, voice] : voices_) {
+		DestroyVoice(voice.get());
+	}
+	voices_.clear();
+	banks_.clear();
+	xAudio2_ = nullptr;
+}
+
+void StreamingAudio::Update() {
+	for (auto it = voices_.begin(); it != voices_.end();) {
+		Voice* voice = it->second.get();
+		if (voice->isFinished.load()) {
+			DestroyVoice(voice);
+			it = voices_.erase(it);
+			continue;
+		}
+		if (voice->stream) {
+			SubmitStream(voice);
+		}
+		++it;
+	}
+}
+
+bool StreamingAudio::LoadBank(
+    const std::string& bankName, const std::vector<std::string>& fileNames) {
+	if (banks_.count(bankName)) {
+		return true;
+	}
+
+	const std::string bankPath = GetFullPath(bankName + kBankExtension);
+	auto bank = std::make_unique<SoundBank>();
+	if (!IsBankUpToDate(bankPath, fileNames, bank.get())) {
+		bank->Close();
+		std::vector<SoundBank::Source> sources;
+		for (const std::string& fileName : fileNames) {
+			sources.push_back({fileName, GetFullPath(fileName)});
+		}
+		if (!SoundBank::Write(bankPath, sources) || !bank->Open(bankPath)) {
+			return false;
+		}
+	}
+	banks_[bankName] = std::move(bank);
+	return true;
+}
+
+bool StreamingAudio::IsBankUpToDate(
+    const std::string& bankPath, const std::vector<std::string>& fileNames,
+    SoundBank* bank) const {
+	namespace fs = std::filesystem;
+	std::error_code error;
+
+	// 同じ WAV の組か（名前は重複しないので、数と全部あるかで判定できる）
+	if (!bank->Open(bankPath) || bank->GetSoundCount() != fileNames.size()) {
+		return false;
+	}
+	for (const std::string& fileName : fileNames) {
+		if (bank->Find(fileName) == SoundBank::kInvalidIndex) {
+			return false;
+		}
+	}
+
+	// どの元の WAV より新しいか
+	const fs::file_time_type bankTime = fs::last_write_time(bankPath, error);
+	if (error) {
+		return false;
+	}
+	for (const std::string& fileName : fileNames) {
+		fs::file_time_type sourceTime = fs::last_write_time(GetFullPath(fileName), error);
+		if (error || bankTime < sourceTime) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void StreamingAudio::UnloadBank(const std::string& bankName) {
+	auto bank = banks_.find(bankName);
+	if (bank == banks_.end()) {
+		return;
+	}
+	for (auto it = voices_.begin(); it != voices_.end();) {
+		if (it->second->bank == bank->second.get()) {
+			DestroyVoice(it->second.get());
+			it = voices_.erase(it);
+		} else {
+			++it;
+		}
+	}
+	banks_.erase(bank);
+}
+
+uint32_t StreamingAudio::PlayBank(
+    const std::string& bankName, const std::string& fileName, bool loopFlag, float volume) {
+	auto bank = banks_.find(bankName);
+	if (bank == banks_.end()) {
+		return 0u;
+	}
+	uint32_t index = bank->second->Find(fileName);
+	if (index == SoundBank::kInvalidIndex) {
+		return 0u;
+	}
+	SoundBank::SoundView sound = bank->second->GetSound(index);
+
+	auto voice = std::make_unique<Voice>();
+	voice->bank = bank->second.get();
+	Voice* pVoice = voice.get();
+	uint32_t handle = CreateVoice(std::move(voice), *sound.format, volume);
+	if (handle == 0u) {
+		return 0u;
+	}
+
+	// マップしたファイルの波形をそのまま渡す
+	XAUDIO2_BUFFER buf{};
+	buf.pAudioData = sound.data;
+	buf.AudioBytes = sound.size;
+	buf.Flags = XAUDIO2_END_OF_STREAM;
+	buf.LoopCount = loopFlag ? XAUDIO2_LOOP_INFINITE : 0;
+	HRESULT result = pVoice->sourceVoice->SubmitSourceBuffer(&buf);
+	if (SUCCEEDED(result)) {
+		result = pVoice->sourceVoice->Start();
+	}
+	if (FAILED(result)) {
+		Stop(handle);
+		return 0u;
+	}
+	return handle;
+}
+
+uint32_t StreamingAudio::PlayStream(const std::string& fileName, bool loopFlag, float volume) {
+	auto stream = std::make_unique<WaveStream>();
+	if (!stream->Open(GetFullPath(fileName), kStreamBufferSeconds)) {
+		return 0u;
+	}
+	stream->SetLooping(loopFlag);
+
+	auto voice = std::make_unique<Voice>();
+	WaveFormat format = stream->GetFormat();
+	voice->stream = std::move(stream);
+	Voice* pVoice = voice.get();
+	uint32_t handle = CreateVoice(std::move(voice), format, volume);
+	if (handle == 0u) {
+		return 0u;
+	}
+	// 最初の分は再生を始める前に読んで渡しておく
+	SubmitStream(pVoice);
+	if (FAILED(pVoice->sourceVoice->Start())) {
+		Stop(handle);
+		return 0u;
+	}
+	return handle;
+}
+
+uint32_t StreamingAudio::CreateVoice(
+    std::unique_ptr<Voice> voice, const WaveFormat& format, float volume) {
+	assert(xAudio2_);
+
+	HRESULT result = xAudio2_->CreateSourceVoice(
+	    &voice->sourceVoice, reinterpret_cast<const WAVEFORMATEX*>(&format), 0,
+	    XAUDIO2_DEFAULT_FREQ_RATIO, voice.get());
+	if (FAILED(result)) {
+		return 0u;
+	}
+	voice->sourceVoice->SetVolume(volume);
+
+	uint32_t handle = nextVoiceHandle_++;
+	if (nextVoiceHandle_ == 0u) {
+		nextVoiceHandle_ = 1u;
+	}
+	voices_[handle] = std::move(voice);
+	return handle;
+}
+
+void StreamingAudio::SubmitStream(Voice* voice) {
+	WaveStream* stream = voice->stream.get();
+	stream->Fill();
+
+	WaveStream::Chunk chunk;
+	while (stream->Acquire(&chunk)) {
+		if (chunk.size == 0) {
+			// 空の塊はキューに渡せないので、すぐ返して終わりだけ伝える
+			stream->Release(chunk.index);
+			if (chunk.endOfStream) {
+				voice->sourceVoice->Discontinuity();
+			}
+			continue;
+		}
+		XAUDIO2_BUFFER buf{};
+		buf.pAudioData = chunk.data;
+		buf.AudioBytes = chunk.size;
+		buf.Flags = chunk.endOfStream ? XAUDIO2_END_OF_STREAM : 0;
+		buf.pContext = reinterpret_cast<void*>(static_cast<uintptr_t>(chunk.index));
+		if (FAILED(voice->sourceVoice->SubmitSourceBuffer(&buf))) {
+			stream->Release(chunk.index);
+			voice->isFinished.store(true);
+		}
+	}
+}
+
+void StreamingAudio::DestroyVoice(Voice* voice) {
+	// DestroyVoice はコールバックが終わるまで待つので、この後はバッファを解放してよい
+	if (voice->sourceVoice) {
+		voice->sourceVoice->DestroyVoice();
+		voice->sourceVoice = nullptr;
+	}
+}
+
+void StreamingAudio::Stop(uint32_t voiceHandle) {
+	auto it = voices_.find(voiceHandle);
+	if (it == voices_.end()) {
+		return;
+	}
+	DestroyVoice(it->second.get());
+	voices_.erase(it);
+}
+
+bool StreamingAudio::IsPlaying(uint32_t voiceHandle) const {
+	auto it = voices_.find(voiceHandle);
+	return it != voices_.end() && !it->second->isFinished.load();
+}
+
+void StreamingAudio::SetVolume(uint32_t voiceHandle, float volume) {
+	auto it = voices_.find(voiceHandle);
+	if (it != voices_.end()) {
+		it->second->sourceVoice->SetVolume(volume);
+	}
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "SoundBank.h"
+#include "WaveStream.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <xaudio2.h>
+
+/// <summary>
+/// サウンドバンクとストリーミングの再生
+/// バンクはメモリマップした波形をコピーせずに再生し、長い BGM はディスクから少しずつ読んで流す
+/// </summary>
+class StreamingAudio {
+public: // 定数
+	// バンクファイルの拡張子
+	static constexpr const char* kBankExtension = ".ksb";
+	// ストリーミングの1バッファの秒数
+	static constexpr float kStreamBufferSeconds = 0.5f;
+
+public: // 静的メンバ関数
+	static StreamingAudio* GetInstance();
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="xAudio2">XAudio2（Audio::GetXAudio2）</param>
+	/// <param name="directoryPath">サウンド格納ディレクトリ</param>
+	void Initialize(IXAudio2* xAudio2, const std::string& directoryPath = "Resources/");
+
+	/// <summary>
+	/// 終了処理（XAudio2 を解放する前に呼ぶ）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 毎フレーム処理（ストリーミングの読み込みと、再生し終えたボイスの破棄）
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// サウンドバンクの読み込み
+	/// 元の WAV の組が変わったか、どれかが新しければ作り直す
+	/// </summary>
+	/// <param name="bankName">バンク名（ファイル名は バンク名 + kBankExtension）</param>
+	/// <param name="fileNames">詰める WAV ファイル名（再生するときの名前になる）</param>
+	/// <returns>成否</returns>
+	bool LoadBank(const std::string& bankName, const std::vector<std::string>& fileNames);
+
+	/// <summary>
+	/// サウンドバンクの解放（再生中のものは止める）
+	/// </summary>
+	/// <param name="bankName">バンク名</param>
+	void UnloadBank(const std::string& bankName);
+
+	/// <summary>
+	/// バンクの音声の再生
+	/// </summary>
+	/// <param name="bankName">バンク名</param>
+	/// <param name="fileName">WAV ファイル名</param>
+	/// <param name="loopFlag">ループ再生フラグ</param>
+	/// <param name="volume">ボリューム（0で無音、1がデフォルト音量）</param>
+	/// <returns>再生ハンドル（失敗したら 0）</returns>
+	uint32_t PlayBank(
+	    const std::string& bankName, const std::string& fileName, bool loopFlag = false,
+	    float volume = 1.0f);
+
+	/// <summary>
+	/// WAV ファイルのストリーミング再生
+	/// </summary>
+	/// <param name="fileName">WAV ファイル名</param>
+	/// <param name="loopFlag">ループ再生フラグ</param>
+	/// <param name="volume">ボリューム（0で無音、1がデフォルト音量）</param>
+	/// <returns>再生ハンドル（失敗したら 0）</returns>
+	uint32_t PlayStream(const std::string& fileName, bool loopFlag = false, float volume = 1.0f);
+
+	/// <summary>
+	/// 音声停止
+	/// </summary>
+	/// <param name="voiceHandle">再生ハンドル</param>
+	void Stop(uint32_t voiceHandle);
+
+	/// <summary>
+	/// 音声再生中かどうか
+	/// </summary>
+	/// <param name="voiceHandle">再生ハンドル</param>
+	bool IsPlaying(uint32_t voiceHandle) const;
+
+	/// <summary>
+	/// 音量設定
+	/// </summary>
+	/// <param name="voiceHandle">再生ハンドル</param>
+	/// <param name="volume">ボリューム（0で無音、1がデフォルト音量）</param>
+	void SetVolume(uint32_t voiceHandle, float volume);
+
+private: // サブクラス
+	/// <summary>
+	/// 再生中のボイス（コールバックはオーディオスレッドから呼ばれる）
+	/// </summary>
+	class Voice : public IXAudio2VoiceCallback {
+	public:
+		// ボイス処理パスの開始時
+		STDMETHOD_(void, OnVoiceProcessingPassStart)
+		([[maybe_unused]] THIS_ UINT32 BytesRequired){};
+		// ボイス処理パスの終了時
+		STDMETHOD_(void, OnVoiceProcessingPassEnd)(THIS){};
+		// バッファストリームの再生が終了した時
+		STDMETHOD_(void, OnStreamEnd)(THIS);
+		// バッファの使用開始時
+		STDMETHOD_(void, OnBufferStart)([[maybe_unused]] THIS_ void* pBufferContext){};
+		// バッファの末尾に達した時
+		STDMETHOD_(void, OnBufferEnd)(THIS_ void* pBufferContext);
+		// 再生がループ位置に達した時
+		STDMETHOD_(void, OnLoopEnd)([[maybe_unused]] THIS_ void* pBufferContext){};
+		// ボイスの実行エラー時
+		STDMETHOD_(void, OnVoiceError)
+		([[maybe_unused]] THIS_ void* pBufferContext, [[maybe_unused]] HRESULT Error);
+
+		IXAudio2SourceVoice* sourceVoice = nullptr;
+		// 再生しているバンク（ストリーミングなら nullptr）
+		const SoundBank* bank = nullptr;
+		// ストリーミング（バンクなら nullptr）
+		std::unique_ptr<WaveStream> stream;
+		// 再生し終えたか
+		std::atomic<bool> isFinished = false;
+	};
+
+private: // メンバ関数
+	StreamingAudio() = default;
+	~StreamingAudio() = default;
+	StreamingAudio(const StreamingAudio&) = delete;
+	const StreamingAudio& operator=(const StreamingAudio&) = delete;
+
+	/// <summary>
+	/// 作ってあるバンクファイルがそのまま使えるか
+	/// </summary>
+	bool IsBankUpToDate(
+	    const std::string& bankPath, const std::vector<std::string>& fileNames,
+	    SoundBank* bank) const;
+
+	/// <summary>
+	/// ボイスを作って登録する
+	/// </summary>
+	/// <returns>再生ハンドル（失敗したら 0）</returns>
+	uint32_t CreateVoice(std::unique_ptr<Voice> voice, const WaveFormat& format, float volume);
+
+	/// <summary>
+	/// ストリーミングの読み込んだ分を再生キューに渡す
+	/// </summary>
+	void SubmitStream(Voice* voice);
+
+	/// <summary>
+	/// ボイスの破棄
+	/// </summary>
+	void DestroyVoice(Voice* voice);
+
+	std::string GetFullPath(const std::string& fileName) const {
+		return directoryPath_ + fileName;
+	}
+
+private: // メンバ変数
+	// XAudio2（Audio が持っている）
+	IXAudio2* xAudio2_ = nullptr;
+	// サウンド格納ディレクトリ
+	std::string directoryPath_;
+	// 読み込んだバンク
+	std::unordered_map<std::string, std::unique_ptr<SoundBank>> banks_;
+	// 再生中のボイス
+	std::unordered_map<uint32_t, std::unique_ptr<Voice>> voices_;
+	// 次に使う再生ハンドル
+	uint32_t nextVoiceHandle_ = 1u;
+};
@@ -0,0 +1,125 @@
+#include "WaveFile.h"
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+static_assert(offsetof(WaveFormat, formatTag) == 0);
+static_assert(offsetof(WaveFormat, samplesPerSec) == 4);
+static_assert(offsetof(WaveFormat, blockAlign) == 12);
+static_assert(offsetof(WaveFormat, extraSize) == 16);
+static_assert(offsetof(WaveFormat, extra) == 18);
+static_assert(sizeof(WaveFormat) == 40);
+
+// fmt チャンクの最小サイズ（cbSize なし）
+constexpr uint32_t kMinFormatSize = 16;
+// cbSize までのサイズ（WAVEFORMATEX）
+constexpr uint32_t kBaseFormatSize = 18;
+
+uint32_t ReadU32(const uint8_t* bytes) {
+	uint32_t value;
+	std::memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+/// <summary>
+/// チャンクをたどって fmt と data を探す
+/// read(offset, size, dst) は範囲を読めたら true を返すこと
+/// </summary>
+template<class Read> bool WalkChunks(uint64_t fileSize, const Read& read, WaveInfo* info) {
+	assert(info);
+	*info = {};
+	uint8_t header[12];
+	if (!read(0, sizeof(header), header) || std::memcmp(header, "RIFF", 4) != 0 ||
+	    std::memcmp(header + 8, "WAVE", 4) != 0) {
+		return false;
+	}
+	// RIFF のサイズが実際より大きいファイルもあるので小さい方に合わせる
+	const uint64_t end = std::min<uint64_t>(fileSize, uint64_t(ReadU32(header + 4)) + 8);
+
+	bool hasFormat = false;
+	uint64_t offset = sizeof(header);
+	while (offset + 8 <= end) {
+		uint8_t chunk[8];
+		if (!read(offset, sizeof(chunk), chunk)) {
+			return false;
+		}
+		const uint32_t chunkSize = ReadU32(chunk + 4);
+		const uint64_t body = offset + sizeof(chunk);
+
+		if (std::memcmp(chunk, "fmt ", 4) == 0) {
+			if (chunkSize < kMinFormatSize) {
+				return false;
+			}
+			// 拡張部分は WaveFormat に収まる分だけ読む
+			const uint32_t size = std::min<uint32_t>(chunkSize, sizeof(WaveFormat));
+			uint8_t bytes[sizeof(WaveFormat)] = {};
+			if (!read(body, size, bytes)) {
+				return false;
+			}
+			std::memcpy(static_cast<void*>(&info->format), bytes, sizeof(WaveFormat));
+			// cbSize が無いか、実際より大きく書かれていれば読めた分にする
+			const uint32_t extraSize = size - std::min<uint32_t>(size, kBaseFormatSize);
+			info->format.extraSize = static_cast<uint16_t>(
+			    size < kBaseFormatSize ? 0 : std::min<uint32_t>(info->format.extraSize, extraSize));
+			hasFormat = true;
+		} else if (std::memcmp(chunk, "data", 4) == 0) {
+			if (!hasFormat) {
+				return false;
+			}
+			info->dataOffset = body;
+			// 途中で切れているファイルは読める分だけにする
+			info->dataSize = static_cast<uint32_t>(std::min<uint64_t>(chunkSize, end - body));
+			break;
+		}
+		// チャンクは2バイト境界に揃える
+		offset = body + chunkSize + (chunkSize & 1);
+	}
+
+	const WaveFormat& format = info->format;
+	if (!hasFormat || info->dataOffset == 0 || format.channels == 0 || format.blockAlign == 0 ||
+	    format.samplesPerSec == 0) {
+		return false;
+	}
+	if (format.formatTag != WaveFile::kFormatPcm &&
+	    format.formatTag != WaveFile::kFormatIeeeFloat &&
+	    format.formatTag != WaveFile::kFormatExtensible) {
+		return false;
+	}
+	// 半端なサンプルは捨てる
+	info->dataSize -= info->dataSize % format.blockAlign;
+	return true;
+}
+
+} // namespace
+
+bool WaveFile::Parse(const uint8_t* data, size_t size, WaveInfo* info) {
+	auto read = [data, size](uint64_t offset, size_t length, uint8_t* dst) {
+		if (size < offset || size - offset < length) {
+			return false;
+		}
+		std::memcpy(dst, data + offset, length);
+		return true;
+	};
+	return WalkChunks(size, read, info);
+}
+
+bool WaveFile::ReadHeader(const std::string& filePath, WaveInfo* info) {
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return false;
+	}
+	const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+	auto read = [&file, fileSize](uint64_t offset, size_t length, uint8_t* dst) {
+		if (fileSize < offset || fileSize - offset < length) {
+			return false;
+		}
+		file.seekg(static_cast<std::streamoff>(offset));
+		file.read(reinterpret_cast<char*>(dst), static_cast<std::streamsize>(length));
+		return static_cast<bool>(file);
+	};
+	return WalkChunks(fileSize, read, info);
+}
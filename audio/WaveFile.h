@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// 波形フォーマット（先頭 18 バイトは WAVEFORMATEX と同じ並び、続きは拡張部分）
+/// Windows のヘッダに頼らないので、Windows 以外でも解析できる
+/// </summary>
+struct WaveFormat {
+	uint16_t formatTag = 0;
+	uint16_t channels = 0;
+	uint32_t samplesPerSec = 0;
+	uint32_t avgBytesPerSec = 0;
+	uint16_t blockAlign = 0;
+	uint16_t bitsPerSample = 0;
+	// 拡張部分のバイト数（WAVEFORMATEX::cbSize）
+	uint16_t extraSize = 0;
+	// 拡張部分（WAVEFORMATEXTENSIBLE の残り）
+	uint8_t extra[22] = {};
+};
+
+/// <summary>
+/// WAV ファイルの中身の位置
+/// </summary>
+struct WaveInfo {
+	// 波形フォーマット
+	WaveFormat format;
+	// 波形データの先頭位置（ファイル先頭から）
+	uint64_t dataOffset = 0;
+	// 波形データのバイト数
+	uint32_t dataSize = 0;
+};
+
+/// <summary>
+/// WAV（RIFF）の解析
+/// 対応: PCM・IEEE float・WAVE_FORMAT_EXTENSIBLE。fmt と data 以外のチャンクは読み飛ばす
+/// </summary>
+namespace WaveFile {
+
+// 形式タグ
+constexpr uint16_t kFormatPcm = 0x0001;
+constexpr uint16_t kFormatIeeeFloat = 0x0003;
+constexpr uint16_t kFormatExtensible = 0xfffe;
+
+/// <summary>
+/// メモリ上の WAV の解析
+/// </summary>
+/// <param name="data">ファイルの中身</param>
+/// <param name="size">バイト数</param>
+/// <param name="info">出力先</param>
+/// <returns>成否（壊れているか対応していない形式なら false）</returns>
+bool Parse(const uint8_t* data, size_t size, WaveInfo* info);
+
+/// <summary>
+/// ファイルのヘッダだけを読んで解析する（波形データは読まない）
+/// </summary>
+/// <param name="filePath">ファイルパス</param>
+/// <param name="info">出力先</param>
+/// <returns>成否（無い・壊れている・対応していない形式なら false）</returns>
+bool ReadHeader(const std::string& filePath, WaveInfo* info);
+
+} // namespace WaveFile
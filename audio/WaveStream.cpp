@@ -0,0 +1,114 @@
+#include "WaveStream.h"
+#include <algorithm>
+#include <cassert>
+
+bool WaveStream::Open(const std::string& filePath, float bufferSeconds) {
+	Close();
+	if (!WaveFile::ReadHeader(filePath, &info_) || info_.dataSize == 0) {
+		return false;
+	}
+	file_.open(filePath, std::ios::binary);
+	if (!file_) {
+		return false;
+	}
+
+	// 1バッファの大きさはブロック境界に揃える
+	const WaveFormat& format = info_.format;
+	uint32_t blocks = static_cast<uint32_t>(
+	    float(format.samplesPerSec) * std::max(bufferSeconds, 0.01f) + 0.5f);
+	bufferSize_ = std::max<uint32_t>(blocks, 1) * format.blockAlign;
+	bufferSize_ = std::min(bufferSize_, info_.dataSize);
+	for (Buffer& buffer : buffers_) {
+		buffer.data.resize(bufferSize_);
+	}
+	return true;
+}
+
+void WaveStream::Close() {
+	for (Buffer& buffer : buffers_) {
+		assert(buffer.state.load() != State::kQueued);
+		buffer.data.clear();
+		buffer.data.shrink_to_fit();
+		buffer.size = 0;
+		buffer.endOfStream = false;
+		buffer.state.store(State::kFree);
+	}
+	if (file_.is_open()) {
+		file_.close();
+	}
+	file_.clear();
+	info_ = {};
+	bufferSize_ = 0;
+	readPosition_ = 0;
+	fillIndex_ = 0;
+	acquireIndex_ = 0;
+	isEndOfFile_ = false;
+}
+
+uint32_t WaveStream::Fill() {
+	uint32_t filledCount = 0;
+	while (file_.is_open() && !isEndOfFile_) {
+		Buffer& buffer = buffers_[fillIndex_];
+		// オーディオスレッドが返したバッファの中身を見るので acquire
+		if (buffer.state.load(std::memory_order_acquire) != State::kFree) {
+			break;
+		}
+
+		uint32_t size = std::min(bufferSize_, info_.dataSize - readPosition_);
+		file_.seekg(static_cast<std::streamoff>(info_.dataOffset + readPosition_));
+		file_.read(reinterpret_cast<char*>(buffer.data.data()), size);
+		if (!file_) {
+			// 読めなければそこで終わりにする
+			file_.clear();
+			size = static_cast<uint32_t>(std::max<std::streamsize>(file_.gcount(), 0));
+			size -= size % info_.format.blockAlign;
+			isEndOfFile_ = true;
+		}
+		readPosition_ += size;
+		if (readPosition_ >= info_.dataSize) {
+			if (isLooping_) {
+				readPosition_ = 0;
+			} else {
+				isEndOfFile_ = true;
+			}
+		}
+		buffer.size = size;
+		buffer.endOfStream = isEndOfFile_;
+		buffer.state.store(State::kFilled, std::memory_order_relaxed);
+		fillIndex_ = (fillIndex_ + 1) % kBufferCount;
+		filledCount++;
+	}
+	return filledCount;
+}
+
+bool WaveStream::Acquire(Chunk* chunk) {
+	Buffer& buffer = buffers_[acquireIndex_];
+	if (buffer.state.load(std::memory_order_relaxed) != State::kFilled) {
+		return false;
+	}
+	chunk->data = buffer.data.data();
+	chunk->size = buffer.size;
+	chunk->index = acquireIndex_;
+	chunk->endOfStream = buffer.endOfStream;
+	buffer.state.store(State::kQueued, std::memory_order_relaxed);
+	acquireIndex_ = (acquireIndex_ + 1) % kBufferCount;
+	return true;
+}
+
+void WaveStream::Release(uint32_t index) {
+	assert(index < kBufferCount);
+	assert(buffers_[index].state.load() == State::kQueued);
+	buffers_[index].state.store(State::kFree, std::memory_order_release);
+}
+
+bool WaveStream::IsFinished() const {
+	if (!isEndOfFile_) {
+		return false;
+	}
+	for (const Buffer& buffer : buffers_) {
+		if (buffer.state.load(std::memory_order_acquire) != State::kFree) {
+			return false;
+		}
+	}
+	return true;
+}
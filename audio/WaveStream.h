@@ -0,0 +1,121 @@
+#pragma once
+
+#include "WaveFile.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// WAV のストリーミング読み込み（ダブルバッファ）
+/// 波形データ全体を持たず、一定時間分ずつディスクから読んで再生キューに渡す
+/// Fill・Acquire はメインスレッド、Release はオーディオスレッドから呼んでよい
+/// </summary>
+class WaveStream {
+public: // 定数
+	// バッファの数
+	static constexpr uint32_t kBufferCount = 2;
+
+public: // サブクラス
+	/// <summary>
+	/// 再生キューに渡す1塊
+	/// </summary>
+	struct Chunk {
+		// 波形データ（Release するまで有効）
+		const uint8_t* data = nullptr;
+		uint32_t size = 0;
+		// バッファ番号（Release に渡す）
+		uint32_t index = 0;
+		// 最後の塊か（ループしないときだけ立つ）
+		bool endOfStream = false;
+	};
+
+public: // メンバ関数
+	WaveStream() = default;
+	WaveStream(const WaveStream&) = delete;
+	WaveStream& operator=(const WaveStream&) = delete;
+
+	/// <summary>
+	/// 開く
+	/// </summary>
+	/// <param name="filePath">WAV ファイルのパス</param>
+	/// <param name="bufferSeconds">1バッファの秒数</param>
+	/// <returns>成否（無い・壊れている・対応していない形式なら false）</returns>
+	bool Open(const std::string& filePath, float bufferSeconds = 0.5f);
+
+	/// <summary>
+	/// 閉じる（再生キューに渡したバッファが返ってきてから呼ぶこと）
+	/// </summary>
+	void Close();
+
+	bool IsOpen() const { return file_.is_open(); }
+
+	/// <summary>
+	/// 空いているバッファに続きを読み込む
+	/// </summary>
+	/// <returns>読み込んだバッファの数</returns>
+	uint32_t Fill();
+
+	/// <summary>
+	/// 読み込み済みのバッファを再生順に取り出す
+	/// </summary>
+	/// <param name="chunk">出力先</param>
+	/// <returns>取り出せたか</returns>
+	bool Acquire(Chunk* chunk);
+
+	/// <summary>
+	/// 再生し終えたバッファを返す
+	/// </summary>
+	/// <param name="index">バッファ番号</param>
+	void Release(uint32_t index);
+
+	/// <summary>
+	/// 最後まで読み、すべてのバッファが返ってきたか
+	/// </summary>
+	bool IsFinished() const;
+
+	/// <summary>
+	/// ループ再生するか（終端に達したら先頭から読み直す）
+	/// </summary>
+	void SetLooping(bool looping) { isLooping_ = looping; }
+
+	const WaveFormat& GetFormat() const { return info_.format; }
+	// 1バッファのバイト数
+	uint32_t GetBufferSize() const { return bufferSize_; }
+
+private: // サブクラス
+	// バッファの状態
+	enum class State : uint8_t {
+		kFree,   // 空き
+		kFilled, // 読み込み済み
+		kQueued, // 再生キューに渡した
+	};
+
+	struct Buffer {
+		std::vector<uint8_t> data;
+		uint32_t size = 0;
+		bool endOfStream = false;
+		std::atomic<State> state = State::kFree;
+	};
+
+private: // メンバ変数
+	// ファイル
+	std::ifstream file_;
+	// ヘッダの情報
+	WaveInfo info_;
+	// バッファ
+	std::array<Buffer, kBufferCount> buffers_;
+	// 1バッファのバイト数
+	uint32_t bufferSize_ = 0;
+	// 次に読む位置（波形データの先頭から）
+	uint32_t readPosition_ = 0;
+	// 次に読み込むバッファ、次に取り出すバッファ
+	uint32_t fillIndex_ = 0;
+	uint32_t acquireIndex_ = 0;
+	// ループ再生するか
+	bool isLooping_ = false;
+	// 最後まで読んだか
+	bool isEndOfFile_ = false;
+};
@@ -0,0 +1,91 @@
+#include "AsyncTextureLoader.h"
+#include "MappedFile.h"
+#include "MipGenerator.h"
+#include "PngDecoder.h"
+#include "TextureCache.h"
+#include "ThreadPool.h"
+#include <cassert>
+#include <utility>
+
+AsyncTextureLoader::~AsyncTextureLoader() { WaitAll(); }
+
+void AsyncTextureLoader::Initialize(ThreadPool* threadPool, TextureCache* textureCache) {
+	assert(threadPool);
+	threadPool_ = threadPool;
+	textureCache_ = textureCache;
+}
+
+void AsyncTextureLoader::Request(
+    uint32_t handle, const std::string& name, const std::string& filePath) {
+	assert(threadPool_);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		inFlightCount_++;
+	}
+	threadPool_->Submit([this, handle, name, filePath]() {
+		Result result;
+		result.handle = handle;
+		result.name = name;
+		result.filePath = filePath;
+		Load(result);
+
+		std::lock_guard<std::mutex> lock(mutex_);
+		completed_.push_back(std::move(result));
+		inFlightCount_--;
+		condition_.notify_all();
+	});
+}
+
+size_t AsyncTextureLoader::TakeCompleted(size_t byteBudget, std::vector<Result>* results) {
+	assert(results);
+	std::lock_guard<std::mutex> lock(mutex_);
+	size_t count = 0;
+	size_t bytes = 0;
+	while (!completed_.empty() && (count == 0 || bytes < byteBudget)) {
+		const Result& result = completed_.front();
+		bytes += result.image.pixels.size();
+		if (result.dds.IsOpen()) {
+			bytes += DdsFile::GetDataSize(
+			    result.dds.GetFormat(), result.dds.GetWidth(), result.dds.GetHeight(),
+			    result.dds.GetMipCount());
+		}
+		results->push_back(std::move(completed_.front()));
+		completed_.pop_front();
+		count++;
+	}
+	return count;
+}
+
+void AsyncTextureLoader::WaitAll() {
+	std::unique_lock<std::mutex> lock(mutex_);
+	condition_.wait(lock, [this]() { return inFlightCount_ == 0; });
+}
+
+void AsyncTextureLoader::Clear() {
+	WaitAll();
+	std::lock_guard<std::mutex> lock(mutex_);
+	completed_.clear();
+}
+
+uint32_t AsyncTextureLoader::GetInFlightCount() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	return inFlightCount_;
+}
+
+void AsyncTextureLoader::Load(Result& result) {
+	// キャッシュがあれば展開せずに済む
+	if (textureCache_ && textureCache_->IsEnabled() &&
+	    textureCache_->Open(result.name, result.filePath, &result.dds)) {
+		return;
+	}
+
+	MappedFile file;
+	if (!file.Open(result.filePath) || !PngDecoder::IsPng(file.GetData(), file.GetSize())) {
+		return;
+	}
+	if (!PngDecoder::Decode(file.GetData(), file.GetSize(), &result.image)) {
+		return;
+	}
+	MipGenerator::Generate(&result.image, MipGenerator::Filter::kBox, threadPool_);
+	result.decoded = true;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "DdsFile.h"
+#include "TextureImage.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class TextureCache;
+class ThreadPool;
+
+/// <summary>
+/// テクスチャのバックグラウンド読み込み
+/// キャッシュの DDS を開くか、ファイル読み込み・PNG 展開・ミップマップ生成をワーカーで行い、
+/// 完成したものをメインスレッドが取り出して GPU へ転送する（D3D には触らない）
+/// </summary>
+class AsyncTextureLoader {
+public: // サブクラス
+	/// <summary>
+	/// 読み込み結果
+	/// </summary>
+	struct Result {
+		// テクスチャハンドル
+		uint32_t handle = 0;
+		// 名前
+		std::string name;
+		// ファイルパス
+		std::string filePath;
+		// 展開できたか（false なら PNG 以外か壊れているので、呼び出し側の方法で読み直す）
+		bool decoded = false;
+		// 画像（ミップマップ付き）
+		TextureImage image;
+		// キャッシュの DDS（開けていれば image の代わりにこれを転送する）
+		DdsFile dds;
+	};
+
+public: // メンバ関数
+	~AsyncTextureLoader();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="threadPool">仕事を積むスレッドプール</param>
+	/// <param name="textureCache">テクスチャキャッシュ（nullptr なら毎回展開する）</param>
+	void Initialize(ThreadPool* threadPool, TextureCache* textureCache = nullptr);
+
+	/// <summary>
+	/// 読み込み要求
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	/// <param name="name">名前</param>
+	/// <param name="filePath">ファイルパス</param>
+	void Request(uint32_t handle, const std::string& name, const std::string& filePath);
+
+	/// <summary>
+	/// 完成した結果を取り出す
+	/// 合計バイト数が上限を越えたら残りは次回に回す（1件は必ず取り出す）
+	/// </summary>
+	/// <param name="byteBudget">取り出すピクセルの合計バイト数の上限</param>
+	/// <param name="results">出力先（末尾に足す）</param>
+	/// <returns>取り出した数</returns>
+	size_t TakeCompleted(size_t byteBudget, std::vector<Result>* results);
+
+	/// <summary>
+	/// 処理中の要求がすべて終わるまで待つ
+	/// </summary>
+	void WaitAll();
+
+	/// <summary>
+	/// 処理中の要求を待ってから、結果をすべて捨てる
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// 処理中の要求数
+	/// </summary>
+	uint32_t GetInFlightCount();
+
+private: // メンバ関数
+	/// <summary>
+	/// ワーカーでの読み込み
+	/// </summary>
+	void Load(Result& result);
+
+private: // メンバ変数
+	// スレッドプール
+	ThreadPool* threadPool_ = nullptr;
+	// テクスチャキャッシュ
+	TextureCache* textureCache_ = nullptr;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	// 完成した結果
+	std::deque<Result> completed_;
+	// 処理中の要求数
+	uint32_t inFlightCount_ = 0;
+};
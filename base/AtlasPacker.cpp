@@ -0,0 +1,243 @@
+#include "AtlasPacker.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <sstream>
+
+namespace {
+
+// 対応表のバージョン（形式を変えたら上げる）
+constexpr uint32_t kTableVersion = 1;
+
+bool Intersects(const AtlasRect& a, const AtlasRect& b) {
+	return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height &&
+	       b.y < a.y + a.height;
+}
+
+bool Contains(const AtlasRect& outer, const AtlasRect& inner) {
+	return outer.x <= inner.x && outer.y <= inner.y &&
+	       inner.x + inner.width <= outer.x + outer.width &&
+	       inner.y + inner.height <= outer.y + outer.height;
+}
+
+} // namespace
+
+void MaxRectsPacker::Initialize(uint32_t width, uint32_t height) {
+	width_ = width;
+	height_ = height;
+	freeRects_.assign(1, AtlasRect{0, 0, width, height});
+	usedArea_ = 0;
+	usedWidth_ = 0;
+	usedHeight_ = 0;
+}
+
+bool MaxRectsPacker::Insert(uint32_t width, uint32_t height, AtlasRect* rect) {
+	assert(rect);
+	// 短辺の余りが最小（同じなら長辺の余りが最小）の空き領域の左上に置く
+	uint32_t bestShortSide = std::numeric_limits<uint32_t>::max();
+	uint32_t bestLongSide = std::numeric_limits<uint32_t>::max();
+	const AtlasRect* best = nullptr;
+	for (const AtlasRect& freeRect : freeRects_) {
+		if (freeRect.width < width || freeRect.height < height) {
+			continue;
+		}
+		uint32_t leftoverX = freeRect.width - width;
+		uint32_t leftoverY = freeRect.height - height;
+		uint32_t shortSide = std::min(leftoverX, leftoverY);
+		uint32_t longSide = std::max(leftoverX, leftoverY);
+		if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide)) {
+			bestShortSide = shortSide;
+			bestLongSide = longSide;
+			best = &freeRect;
+		}
+	}
+	if (!best) {
+		return false;
+	}
+
+	*rect = AtlasRect{best->x, best->y, width, height};
+	SplitFreeRects(*rect);
+	PruneFreeRects();
+
+	usedArea_ += uint64_t(width) * height;
+	usedWidth_ = std::max(usedWidth_, rect->x + width);
+	usedHeight_ = std::max(usedHeight_, rect->y + height);
+	return true;
+}
+
+void MaxRectsPacker::SplitFreeRects(const AtlasRect& placed) {
+	newFreeRects_.clear();
+	for (size_t i = 0; i < freeRects_.size();) {
+		const AtlasRect freeRect = freeRects_[i];
+		if (!Intersects(freeRect, placed)) {
+			i++;
+			continue;
+		}
+		// 置いた矩形の上下左右に残る部分をそれぞれ極大な空き領域にする
+		if (freeRect.x < placed.x) {
+			newFreeRects_.push_back(
+			    {freeRect.x, freeRect.y, placed.x - freeRect.x, freeRect.height});
+		}
+		if (placed.x + placed.width < freeRect.x + freeRect.width) {
+			uint32_t right = placed.x + placed.width;
+			newFreeRects_.push_back(
+			    {right, freeRect.y, freeRect.x + freeRect.width - right, freeRect.height});
+		}
+		if (freeRect.y < placed.y) {
+			newFreeRects_.push_back(
+			    {freeRect.x, freeRect.y, freeRect.width, placed.y - freeRect.y});
+		}
+		if (placed.y + placed.height < freeRect.y + freeRect.height) {
+			uint32_t bottom = placed.y + placed.height;
+			newFreeRects_.push_back(
+			    {freeRect.x, bottom, freeRect.width, freeRect.y + freeRect.height - bottom});
+		}
+		// 順番は問わないので末尾と入れ替えて消す
+		freeRects_[i] = freeRects_.back();
+		freeRects_.pop_back();
+	}
+	freeRects_.insert(freeRects_.end(), newFreeRects_.begin(), newFreeRects_.end());
+}
+
+void MaxRectsPacker::PruneFreeRects() {
+	for (size_t i = 0; i < freeRects_.size(); i++) {
+		for (size_t j = i + 1; j < freeRects_.size();) {
+			if (Contains(freeRects_[i], freeRects_[j])) {
+				freeRects_[j] = freeRects_.back();
+				freeRects_.pop_back();
+				continue;
+			}
+			if (Contains(freeRects_[j], freeRects_[i])) {
+				freeRects_[i] = freeRects_[j];
+				freeRects_[j] = freeRects_.back();
+				freeRects_.pop_back();
+				// 入れ替わった i を最初から比べ直す
+				j = i + 1;
+				continue;
+			}
+			j++;
+		}
+	}
+}
+
+bool PackAtlas(
+    std::span<const AtlasRect> sizes, uint32_t pageSize, uint32_t padding, AtlasLayout* layout) {
+	assert(layout);
+	assert(padding < pageSize);
+	layout->pages.clear();
+	layout->placements.assign(sizes.size(), AtlasLayout::Placement{});
+
+	// 長辺が長いもの（同じなら面積が大きいもの）から置くと隙間が少ない
+	std::vector<uint32_t> order(sizes.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+		uint32_t longA = std::max(sizes[a].width, sizes[a].height);
+		uint32_t longB = std::max(sizes[b].width, sizes[b].height);
+		if (longA != longB) {
+			return longA > longB;
+		}
+		return uint64_t(sizes[a].width) * sizes[a].height >
+		       uint64_t(sizes[b].width) * sizes[b].height;
+	});
+
+	// 左上の余白の分だけ詰め込む範囲を狭め、各画像は右下に余白を付けて置く
+	const uint32_t area = pageSize - padding;
+	std::vector<MaxRectsPacker> packers;
+	bool succeeded = true;
+	for (uint32_t index : order) {
+		uint32_t width = sizes[index].width + padding;
+		uint32_t height = sizes[index].height + padding;
+		if (area < width || area < height) {
+			succeeded = false;
+			continue;
+		}
+		AtlasRect rect;
+		size_t page = 0;
+		for (; page < packers.size(); page++) {
+			if (packers[page].Insert(width, height, &rect)) {
+				break;
+			}
+		}
+		if (page == packers.size()) {
+			packers.emplace_back().Initialize(area, area);
+			bool inserted = packers.back().Insert(width, height, &rect);
+			assert(inserted);
+			(void)inserted;
+		}
+		layout->placements[index].page = static_cast<uint32_t>(page);
+		layout->placements[index].rect = AtlasRect{
+		    rect.x + padding, rect.y + padding, sizes[index].width, sizes[index].height};
+	}
+
+	// 使った範囲まで縮める
+	for (const MaxRectsPacker& packer : packers) {
+		AtlasLayout::Page page;
+		page.width = std::min(pageSize, std::bit_ceil(packer.GetUsedWidth() + padding));
+		page.height = std::min(pageSize, std::bit_ceil(packer.GetUsedHeight() + padding));
+		layout->pages.push_back(page);
+	}
+	return succeeded;
+}
+
+bool WriteAtlasTable(const std::string& filePath, const AtlasTable& table) {
+	std::ofstream file(filePath, std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	file << "atlas " << kTableVersion << "\n";
+	for (const std::string& pageFile : table.pageFiles) {
+		file << "page " << pageFile << "\n";
+	}
+	// 名前に空白があってもよいように行末に書く
+	for (const AtlasTable::Entry& entry : table.entries) {
+		file << "image " << entry.page << " " << entry.rect.x << " " << entry.rect.y << " "
+		     << entry.rect.width << " " << entry.rect.height << " " << entry.name << "\n";
+	}
+	return static_cast<bool>(file);
+}
+
+bool ReadAtlasTable(const std::string& filePath, AtlasTable* table) {
+	assert(table);
+	std::ifstream file(filePath);
+	if (!file) {
+		return false;
+	}
+	std::string line;
+	uint32_t version = 0;
+	if (!std::getline(file, line) || std::sscanf(line.c_str(), "atlas %u", &version) != 1 ||
+	    version != kTableVersion) {
+		return false;
+	}
+
+	table->pageFiles.clear();
+	table->entries.clear();
+	while (std::getline(file, line)) {
+		std::istringstream stream(line);
+		std::string key;
+		stream >> key;
+		if (key == "page") {
+			std::string pageFile;
+			stream >> std::ws;
+			std::getline(stream, pageFile);
+			table->pageFiles.push_back(pageFile);
+		} else if (key == "image") {
+			AtlasTable::Entry entry;
+			stream >> entry.page >> entry.rect.x >> entry.rect.y >> entry.rect.width >>
+			    entry.rect.height;
+			if (!stream || table->pageFiles.size() <= entry.page) {
+				return false;
+			}
+			stream >> std::ws;
+			std::getline(stream, entry.name);
+			if (entry.name.empty()) {
+				return false;
+			}
+			table->entries.push_back(entry);
+		}
+	}
+	return true;
+}
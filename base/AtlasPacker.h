@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// アトラス内の矩形（ピクセル）
+/// </summary>
+struct AtlasRect {
+	uint32_t x = 0;
+	uint32_t y = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+};
+
+/// <summary>
+/// MaxRects 法による矩形詰め込み（1ページ分）
+/// 空き領域を重なりを許した極大矩形の集合で持ち、短辺の余りが最小になる場所に置く
+/// </summary>
+class MaxRectsPacker {
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="width">ページの幅</param>
+	/// <param name="height">ページの高さ</param>
+	void Initialize(uint32_t width, uint32_t height);
+
+	/// <summary>
+	/// 矩形を置く
+	/// </summary>
+	/// <param name="width">幅</param>
+	/// <param name="height">高さ</param>
+	/// <param name="rect">置いた場所の出力先</param>
+	/// <returns>置けたか</returns>
+	bool Insert(uint32_t width, uint32_t height, AtlasRect* rect);
+
+	/// <summary>
+	/// 置いた矩形の面積の合計
+	/// </summary>
+	uint64_t GetUsedArea() const { return usedArea_; }
+
+	/// <summary>
+	/// 置いた矩形をすべて含む範囲（右端・下端）
+	/// </summary>
+	uint32_t GetUsedWidth() const { return usedWidth_; }
+	uint32_t GetUsedHeight() const { return usedHeight_; }
+
+private: // メンバ関数
+	/// <summary>
+	/// 置いた矩形と重なる空き領域を分割する
+	/// </summary>
+	void SplitFreeRects(const AtlasRect& placed);
+
+	/// <summary>
+	/// 他の空き領域に含まれる空き領域を取り除く
+	/// </summary>
+	void PruneFreeRects();
+
+private: // メンバ変数
+	// ページの大きさ
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	// 空き領域
+	std::vector<AtlasRect> freeRects_;
+	// 分割で新しくできた空き領域
+	std::vector<AtlasRect> newFreeRects_;
+	// 使用量
+	uint64_t usedArea_ = 0;
+	uint32_t usedWidth_ = 0;
+	uint32_t usedHeight_ = 0;
+};
+
+/// <summary>
+/// 詰め込み結果
+/// </summary>
+struct AtlasLayout {
+	/// <summary>
+	/// ページの大きさ（使った範囲を含む2の累乗に縮めてある）
+	/// </summary>
+	struct Page {
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+	/// <summary>
+	/// 画像の置き場所（余白を除いた範囲）
+	/// </summary>
+	struct Placement {
+		uint32_t page = 0;
+		AtlasRect rect;
+	};
+
+	std::vector<Page> pages;
+	// 入力と同じ順
+	std::vector<Placement> placements;
+};
+
+/// <summary>
+/// 画像をできるだけ少ないページに詰め込む
+/// 大きいものから順に置き、既存のページに入らなければ新しいページを作る
+/// </summary>
+/// <param name="sizes">画像の大きさ（x, y は使わない）</param>
+/// <param name="pageSize">ページの最大の幅・高さ</param>
+/// <param name="padding">画像の間と周囲に空ける余白（ミップマップや線形補間のにじみ止め）</param>
+/// <param name="layout">出力先</param>
+/// <returns>すべて置けたか（ページより大きい画像があると false）</returns>
+bool PackAtlas(
+    std::span<const AtlasRect> sizes, uint32_t pageSize, uint32_t padding, AtlasLayout* layout);
+
+/// <summary>
+/// アトラスの対応表（画像名 → ページと矩形）
+/// </summary>
+struct AtlasTable {
+	/// <summary>
+	/// 画像1枚分
+	/// </summary>
+	struct Entry {
+		std::string name;
+		uint32_t page = 0;
+		AtlasRect rect;
+	};
+
+	// ページの画像ファイル名
+	std::vector<std::string> pageFiles;
+	// 画像
+	std::vector<Entry> entries;
+};
+
+/// <summary>
+/// 対応表の書き出し（テキスト形式）
+/// </summary>
+/// <param name="filePath">書き出し先</param>
+/// <param name="table">対応表</param>
+/// <returns>成否</returns>
+bool WriteAtlasTable(const std::string& filePath, const AtlasTable& table);
+
+/// <summary>
+/// 対応表の読み込み
+/// </summary>
+/// <param name="filePath">ファイルパス</param>
+/// <param name="table">出力先</param>
+/// <returns>成否（ファイルが無いか形式が違えば false）</returns>
+bool ReadAtlasTable(const std::string& filePath, AtlasTable* table);
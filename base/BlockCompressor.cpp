@@ -0,0 +1,614 @@
+#include "BlockCompressor.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// 1ブロックのピクセル数
+constexpr int kBlockPixels = 16;
+
+// BC7 の 4ビット補間の重み（/64）
+constexpr int kBC7Weights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/// <summary>
+/// 主成分方向（平均と、分散が最大の向き）
+/// </summary>
+void ComputePrincipalAxis(const uint8_t* block, int channels, float mean[4], float axis[4]) {
+	for (int c = 0; c < 4; c++) {
+		mean[c] = 0.0f;
+		axis[c] = 0.0f;
+	}
+	for (int i = 0; i < kBlockPixels; i++) {
+		for (int c = 0; c < channels; c++) {
+			mean[c] += block[i * 4 + c];
+		}
+	}
+	for (int c = 0; c < channels; c++) {
+		mean[c] /= kBlockPixels;
+	}
+
+	float covariance[4][4] = {};
+	for (int i = 0; i < kBlockPixels; i++) {
+		float d[4] = {};
+		for (int c = 0; c < channels; c++) {
+			d[c] = block[i * 4 + c] - mean[c];
+		}
+		for (int a = 0; a < channels; a++) {
+			for (int b = 0; b < channels; b++) {
+				covariance[a][b] += d[a] * d[b];
+			}
+		}
+	}
+
+	// べき乗法（対角成分が最大の軸から始める）
+	int start = 0;
+	for (int c = 1; c < channels; c++) {
+		if (covariance[start][start] < covariance[c][c]) {
+			start = c;
+		}
+	}
+	float v[4] = {};
+	for (int c = 0; c < channels; c++) {
+		v[c] = covariance[start][c];
+	}
+	for (int iteration = 0; iteration < 8; iteration++) {
+		float next[4] = {};
+		float length = 0.0f;
+		for (int a = 0; a < channels; a++) {
+			for (int b = 0; b < channels; b++) {
+				next[a] += covariance[a][b] * v[b];
+			}
+			length = std::max(length, std::abs(next[a]));
+		}
+		if (length < FLT_EPSILON) {
+			return;
+		}
+		for (int c = 0; c < channels; c++) {
+			v[c] = next[c] / length;
+		}
+	}
+	float length = 0.0f;
+	for (int c = 0; c < channels; c++) {
+		length += v[c] * v[c];
+	}
+	length = std::sqrt(length);
+	if (length < FLT_EPSILON) {
+		return;
+	}
+	for (int c = 0; c < channels; c++) {
+		axis[c] = v[c] / length;
+	}
+}
+
+/// <summary>
+/// 主成分方向に投影した両端を端点にする
+/// </summary>
+void ComputeEndpoints(const uint8_t* block, int channels, float e0[4], float e1[4]) {
+	float mean[4];
+	float axis[4];
+	ComputePrincipalAxis(block, channels, mean, axis);
+	float minT = FLT_MAX;
+	float maxT = -FLT_MAX;
+	for (int i = 0; i < kBlockPixels; i++) {
+		float t = 0.0f;
+		for (int c = 0; c < channels; c++) {
+			t += (block[i * 4 + c] - mean[c]) * axis[c];
+		}
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+	for (int c = 0; c < 4; c++) {
+		e0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+		e1[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+	}
+}
+
+/// <summary>
+/// 重み付きの最小二乗で端点を詰め直す（weights は e0 側の重み 0～1）
+/// </summary>
+bool RefineEndpoints(
+    const uint8_t* block, int channels, const float* weights, float e0[4], float e1[4]) {
+	float aa = 0.0f;
+	float bb = 0.0f;
+	float ab = 0.0f;
+	float ap[4] = {};
+	float bp[4] = {};
+	for (int i = 0; i < kBlockPixels; i++) {
+		float a = weights[i];
+		float b = 1.0f - a;
+		aa += a * a;
+		bb += b * b;
+		ab += a * b;
+		for (int c = 0; c < channels; c++) {
+			ap[c] += a * block[i * 4 + c];
+			bp[c] += b * block[i * 4 + c];
+		}
+	}
+	float det = aa * bb - ab * ab;
+	if (std::abs(det) < 1e-6f) {
+		return false;
+	}
+	for (int c = 0; c < channels; c++) {
+		e0[c] = std::clamp((ap[c] * bb - bp[c] * ab) / det, 0.0f, 255.0f);
+		e1[c] = std::clamp((bp[c] * aa - ap[c] * ab) / det, 0.0f, 255.0f);
+	}
+	return true;
+}
+
+#pragma region BC1
+
+uint16_t Pack565(const float color[4]) {
+	uint32_t r = static_cast<uint32_t>(std::lround(color[0] * 31.0f / 255.0f));
+	uint32_t g = static_cast<uint32_t>(std::lround(color[1] * 63.0f / 255.0f));
+	uint32_t b = static_cast<uint32_t>(std::lround(color[2] * 31.0f / 255.0f));
+	return static_cast<uint16_t>(r << 11 | g << 5 | b);
+}
+
+void Unpack565(uint16_t packed, int color[3]) {
+	int r = packed >> 11;
+	int g = (packed >> 5) & 0x3f;
+	int b = packed & 0x1f;
+	color[0] = (r << 3) | (r >> 2);
+	color[1] = (g << 2) | (g >> 4);
+	color[2] = (b << 3) | (b >> 2);
+}
+
+/// <summary>
+/// 色ブロックの番号を決めて誤差を返す
+/// </summary>
+int SelectColorIndices(const uint8_t* block, uint16_t c0, uint16_t c1, uint32_t* indices) {
+	int palette[4][3];
+	Unpack565(c0, palette[0]);
+	Unpack565(c1, palette[1]);
+	for (int c = 0; c < 3; c++) {
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+	int total = 0;
+	*indices = 0;
+	for (int i = 0; i < kBlockPixels; i++) {
+		int best = 0;
+		int bestError = INT32_MAX;
+		for (int k = 0; k < 4; k++) {
+			int error = 0;
+			for (int c = 0; c < 3; c++) {
+				int d = block[i * 4 + c] - palette[k][c];
+				error += d * d;
+			}
+			if (error < bestError) {
+				bestError = error;
+				best = k;
+			}
+		}
+		*indices |= uint32_t(best) << (i * 2);
+		total += bestError;
+	}
+	return total;
+}
+
+/// <summary>
+/// 色ブロック（4色モード）
+/// </summary>
+void EncodeColorBlock(const uint8_t* block, uint8_t* out) {
+	float e0[4];
+	float e1[4];
+	ComputeEndpoints(block, 3, e0, e1);
+
+	uint16_t bestC0 = 0;
+	uint16_t bestC1 = 0;
+	uint32_t bestIndices = 0;
+	int bestError = INT32_MAX;
+	for (int iteration = 0; iteration < 2; iteration++) {
+		uint16_t c0 = Pack565(e0);
+		uint16_t c1 = Pack565(e1);
+		// c0 > c1 で4色モード
+		if (c0 < c1) {
+			std::swap(c0, c1);
+		}
+		uint32_t indices = 0;
+		int error = SelectColorIndices(block, c0, c1, &indices);
+		if (error < bestError) {
+			bestError = error;
+			bestC0 = c0;
+			bestC1 = c1;
+			bestIndices = indices;
+		}
+		if (bestError == 0 || c0 == c1) {
+			break;
+		}
+
+		// 選んだ番号で端点を詰め直す
+		static constexpr float kWeights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+		float weights[kBlockPixels];
+		for (int i = 0; i < kBlockPixels; i++) {
+			weights[i] = kWeights[(indices >> (i * 2)) & 3];
+		}
+		if (!RefineEndpoints(block, 3, weights, e0, e1)) {
+			break;
+		}
+	}
+
+	out[0] = static_cast<uint8_t>(bestC0);
+	out[1] = static_cast<uint8_t>(bestC0 >> 8);
+	out[2] = static_cast<uint8_t>(bestC1);
+	out[3] = static_cast<uint8_t>(bestC1 >> 8);
+	std::memcpy(out + 4, &bestIndices, 4);
+}
+
+/// <summary>
+/// 色ブロックを戻す（c0 <= c1 の3色モードも読む。アルファは触らない）
+/// </summary>
+void DecodeColorBlock(const uint8_t* in, uint8_t* block) {
+	const uint16_t c0 = static_cast<uint16_t>(in[0] | in[1] << 8);
+	const uint16_t c1 = static_cast<uint16_t>(in[2] | in[3] << 8);
+	int palette[4][3];
+	Unpack565(c0, palette[0]);
+	Unpack565(c1, palette[1]);
+	for (int c = 0; c < 3; c++) {
+		if (c1 < c0) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		} else {
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+	}
+	uint32_t indices;
+	std::memcpy(&indices, in + 4, 4);
+	for (int i = 0; i < kBlockPixels; i++) {
+		const int* color = palette[(indices >> (i * 2)) & 3];
+		for (int c = 0; c < 3; c++) {
+			block[i * 4 + c] = static_cast<uint8_t>(color[c]);
+		}
+	}
+}
+
+#pragma endregion
+
+#pragma region BC3 アルファ
+
+/// <summary>
+/// アルファブロック（8段階補間）
+/// </summary>
+void EncodeAlphaBlock(const uint8_t* block, uint8_t* out) {
+	int a0 = 0;
+	int a1 = 255;
+	for (int i = 0; i < kBlockPixels; i++) {
+		a0 = std::max<int>(a0, block[i * 4 + 3]);
+		a1 = std::min<int>(a1, block[i * 4 + 3]);
+	}
+	out[0] = static_cast<uint8_t>(a0);
+	out[1] = static_cast<uint8_t>(a1);
+
+	uint64_t indices = 0;
+	if (a0 != a1) {
+		int palette[8] = {a0, a1};
+		for (int k = 1; k < 7; k++) {
+			palette[k + 1] = ((7 - k) * a0 + k * a1) / 7;
+		}
+		for (int i = 0; i < kBlockPixels; i++) {
+			int best = 0;
+			int bestError = INT32_MAX;
+			for (int k = 0; k < 8; k++) {
+				int error = std::abs(block[i * 4 + 3] - palette[k]);
+				if (error < bestError) {
+					bestError = error;
+					best = k;
+				}
+			}
+			indices |= uint64_t(best) << (i * 3);
+		}
+	}
+	for (int i = 0; i < 6; i++) {
+		out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+	}
+}
+
+/// <summary>
+/// アルファブロックを戻す（a0 <= a1 の6段階モードも読む）
+/// </summary>
+void DecodeAlphaBlock(const uint8_t* in, uint8_t* block) {
+	const int a0 = in[0];
+	const int a1 = in[1];
+	int palette[8] = {a0, a1};
+	if (a1 < a0) {
+		for (int k = 1; k < 7; k++) {
+			palette[k + 1] = ((7 - k) * a0 + k * a1) / 7;
+		}
+	} else {
+		for (int k = 1; k < 5; k++) {
+			palette[k + 1] = ((5 - k) * a0 + k * a1) / 5;
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+	uint64_t indices = 0;
+	for (int i = 0; i < 6; i++) {
+		indices |= uint64_t(in[2 + i]) << (i * 8);
+	}
+	for (int i = 0; i < kBlockPixels; i++) {
+		block[i * 4 + 3] = static_cast<uint8_t>(palette[(indices >> (i * 3)) & 7]);
+	}
+}
+
+#pragma endregion
+
+#pragma region BC7
+
+/// <summary>
+/// 128ビットに下位から詰める
+/// </summary>
+class BitWriter {
+public:
+	explicit BitWriter(uint8_t* out) : out_(out) { std::memset(out_, 0, 16); }
+
+	void Write(uint32_t value, int bits) {
+		for (int i = 0; i < bits; i++, position_++) {
+			if ((value >> i) & 1) {
+				out_[position_ >> 3] |= static_cast<uint8_t>(1 << (position_ & 7));
+			}
+		}
+	}
+
+private:
+	uint8_t* out_;
+	int position_ = 0;
+};
+
+/// <summary>
+/// 128ビットを下位から読む
+/// </summary>
+class BitReader {
+public:
+	explicit BitReader(const uint8_t* in) : in_(in) {}
+
+	uint32_t Read(int bits) {
+		uint32_t value = 0;
+		for (int i = 0; i < bits; i++, position_++) {
+			value |= uint32_t((in_[position_ >> 3] >> (position_ & 7)) & 1) << i;
+		}
+		return value;
+	}
+
+private:
+	const uint8_t* in_;
+	int position_ = 0;
+};
+
+/// <summary>
+/// モード6の候補
+/// </summary>
+struct BC7Candidate {
+	// 7ビットの端点
+	int q0[4] = {};
+	int q1[4] = {};
+	// pビット
+	int p0 = 0;
+	int p1 = 0;
+	uint8_t indices[kBlockPixels] = {};
+	int error = INT32_MAX;
+};
+
+/// <summary>
+/// pビットを除いた7ビットに量子化する
+/// </summary>
+int QuantizeBC7(float value, int pBit) {
+	return std::clamp(static_cast<int>(std::lround((value - float(pBit)) / 2.0f)), 0, 127);
+}
+
+/// <summary>
+/// pビットを決めて量子化し、番号を選ぶ
+/// </summary>
+void EvaluateBC7(const uint8_t* block, const float e0[4], const float e1[4], BC7Candidate* best) {
+	for (int p0 = 0; p0 < 2; p0++) {
+		for (int p1 = 0; p1 < 2; p1++) {
+			BC7Candidate candidate;
+			candidate.p0 = p0;
+			candidate.p1 = p1;
+			int r0[4];
+			int r1[4];
+			for (int c = 0; c < 4; c++) {
+				candidate.q0[c] = QuantizeBC7(e0[c], p0);
+				candidate.q1[c] = QuantizeBC7(e1[c], p1);
+				r0[c] = candidate.q0[c] << 1 | p0;
+				r1[c] = candidate.q1[c] << 1 | p1;
+			}
+			int palette[16][4];
+			for (int k = 0; k < 16; k++) {
+				for (int c = 0; c < 4; c++) {
+					int w = kBC7Weights[k];
+					palette[k][c] = ((64 - w) * r0[c] + w * r1[c] + 32) >> 6;
+				}
+			}
+			candidate.error = 0;
+			for (int i = 0; i < kBlockPixels; i++) {
+				int bestIndex = 0;
+				int bestError = INT32_MAX;
+				for (int k = 0; k < 16; k++) {
+					int error = 0;
+					for (int c = 0; c < 4; c++) {
+						int d = block[i * 4 + c] - palette[k][c];
+						error += d * d;
+					}
+					if (error < bestError) {
+						bestError = error;
+						bestIndex = k;
+					}
+				}
+				candidate.indices[i] = static_cast<uint8_t>(bestIndex);
+				candidate.error += bestError;
+			}
+			if (candidate.error < best->error) {
+				*best = candidate;
+			}
+		}
+	}
+}
+
+/// <summary>
+/// モード6のブロックを戻す
+/// </summary>
+bool DecodeBC7Block(const uint8_t* in, uint8_t* block) {
+	BitReader reader(in);
+	if (reader.Read(7) != (1u << 6)) {
+		return false;
+	}
+	int r0[4];
+	int r1[4];
+	for (int c = 0; c < 4; c++) {
+		r0[c] = static_cast<int>(reader.Read(7)) << 1;
+		r1[c] = static_cast<int>(reader.Read(7)) << 1;
+	}
+	const int p0 = static_cast<int>(reader.Read(1));
+	const int p1 = static_cast<int>(reader.Read(1));
+	for (int i = 0; i < kBlockPixels; i++) {
+		const int w = kBC7Weights[reader.Read(i == 0 ? 3 : 4)];
+		for (int c = 0; c < 4; c++) {
+			block[i * 4 + c] =
+			    static_cast<uint8_t>(((64 - w) * (r0[c] | p0) + w * (r1[c] | p1) + 32) >> 6);
+		}
+	}
+	return true;
+}
+
+#pragma endregion
+
+} // namespace
+
+void BlockCompressor::EncodeBC1(const uint8_t* block, uint8_t* out) {
+	EncodeColorBlock(block, out);
+}
+
+void BlockCompressor::EncodeBC3(const uint8_t* block, uint8_t* out) {
+	EncodeAlphaBlock(block, out);
+	EncodeColorBlock(block, out + 8);
+}
+
+void BlockCompressor::EncodeBC7(const uint8_t* block, uint8_t* out) {
+	float e0[4];
+	float e1[4];
+	ComputeEndpoints(block, 4, e0, e1);
+
+	BC7Candidate best;
+	EvaluateBC7(block, e0, e1, &best);
+	if (best.error != 0) {
+		// 選んだ番号で端点を詰め直してもう一度
+		float weights[kBlockPixels];
+		for (int i = 0; i < kBlockPixels; i++) {
+			weights[i] = 1.0f - float(kBC7Weights[best.indices[i]]) / 64.0f;
+		}
+		if (RefineEndpoints(block, 4, weights, e0, e1)) {
+			EvaluateBC7(block, e0, e1, &best);
+		}
+	}
+
+	// 先頭ピクセルの番号の最上位ビットは省略されるので 0 になるよう向きを揃える
+	if (8 <= best.indices[0]) {
+		std::swap(best.q0, best.q1);
+		std::swap(best.p0, best.p1);
+		for (uint8_t& index : best.indices) {
+			index = static_cast<uint8_t>(15 - index);
+		}
+	}
+
+	BitWriter writer(out);
+	writer.Write(1u << 6, 7); // モード6
+	for (int c = 0; c < 4; c++) {
+		writer.Write(best.q0[c], 7);
+		writer.Write(best.q1[c], 7);
+	}
+	writer.Write(best.p0, 1);
+	writer.Write(best.p1, 1);
+	writer.Write(best.indices[0], 3);
+	for (int i = 1; i < kBlockPixels; i++) {
+		writer.Write(best.indices[i], 4);
+	}
+}
+
+void BlockCompressor::CompressLevel(
+    const uint8_t* pixels, uint32_t width, uint32_t height, TextureFormat format, uint8_t* out,
+    ThreadPool* threadPool) {
+	assert(IsBlockCompressed(format));
+	const uint32_t blocksX = std::max(1u, (width + 3) / 4);
+	const uint32_t blocksY = std::max(1u, (height + 3) / 4);
+	const size_t blockBytes = GetBlockBytes(format);
+
+	auto compressRows = [&](size_t begin, size_t end) {
+		uint8_t block[kBlockPixels * 4];
+		for (size_t by = begin; by < end; by++) {
+			for (uint32_t bx = 0; bx < blocksX; bx++) {
+				// 4x4 を集める（はみ出す分は端を繰り返す）
+				for (uint32_t y = 0; y < 4; y++) {
+					uint32_t sy = std::min(static_cast<uint32_t>(by) * 4 + y, height - 1);
+					for (uint32_t x = 0; x < 4; x++) {
+						uint32_t sx = std::min(bx * 4 + x, width - 1);
+						std::memcpy(
+						    block + (y * 4 + x) * 4, pixels + (size_t(sy) * width + sx) * 4, 4);
+					}
+				}
+				uint8_t* dst = out + (by * blocksX + bx) * blockBytes;
+				switch (format) {
+				case TextureFormat::kBC1:
+					EncodeBC1(block, dst);
+					break;
+				case TextureFormat::kBC3:
+					EncodeBC3(block, dst);
+					break;
+				default:
+					EncodeBC7(block, dst);
+					break;
+				}
+			}
+		}
+	};
+
+	if (threadPool) {
+		threadPool->ParallelFor(blocksY, 4, compressRows);
+	} else {
+		compressRows(0, blocksY);
+	}
+}
+
+bool BlockCompressor::DecompressLevel(
+    const uint8_t* blocks, uint32_t width, uint32_t height, TextureFormat format, uint8_t* out) {
+	assert(IsBlockCompressed(format));
+	const uint32_t blocksX = std::max(1u, (width + 3) / 4);
+	const uint32_t blocksY = std::max(1u, (height + 3) / 4);
+	const size_t blockBytes = GetBlockBytes(format);
+	uint8_t block[kBlockPixels * 4];
+	for (uint32_t by = 0; by < blocksY; by++) {
+		for (uint32_t bx = 0; bx < blocksX; bx++) {
+			const uint8_t* src = blocks + (size_t(by) * blocksX + bx) * blockBytes;
+			switch (format) {
+			case TextureFormat::kBC1:
+				DecodeColorBlock(src, block);
+				for (int i = 0; i < kBlockPixels; i++) {
+					block[i * 4 + 3] = 0xff;
+				}
+				break;
+			case TextureFormat::kBC3:
+				DecodeAlphaBlock(src, block);
+				DecodeColorBlock(src + 8, block);
+				break;
+			default:
+				if (!DecodeBC7Block(src, block)) {
+					return false;
+				}
+				break;
+			}
+			// はみ出す分は捨てる
+			for (uint32_t y = 0; y < 4 && by * 4 + y < height; y++) {
+				for (uint32_t x = 0; x < 4 && bx * 4 + x < width; x++) {
+					std::memcpy(
+					    out + ((size_t(by) * 4 + y) * width + bx * 4 + x) * 4,
+					    block + (y * 4 + x) * 4, 4);
+				}
+			}
+		}
+	}
+	return true;
+}
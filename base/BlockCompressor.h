@@ -0,0 +1,61 @@
+#pragma once
+
+#include "TextureFormat.h"
+#include <cstddef>
+#include <cstdint>
+
+class ThreadPool;
+
+/// <summary>
+/// BC1 / BC3 / BC7 のブロック圧縮（CPU）
+/// 主成分方向で端点を決めて最小二乗で詰め直す。sRGB の値のまま圧縮する
+/// </summary>
+namespace BlockCompressor {
+
+/// <summary>
+/// BC1（アルファは無視して不透明の4色モードで詰める）
+/// </summary>
+/// <param name="block">4x4 の RGBA8（64バイト、行順）</param>
+/// <param name="out">出力先（8バイト）</param>
+void EncodeBC1(const uint8_t* block, uint8_t* out);
+
+/// <summary>
+/// BC3（色は BC1 と同じ、アルファは8段階補間）
+/// </summary>
+/// <param name="block">4x4 の RGBA8（64バイト、行順）</param>
+/// <param name="out">出力先（16バイト）</param>
+void EncodeBC3(const uint8_t* block, uint8_t* out);
+
+/// <summary>
+/// BC7（モード6: 1区画、RGBA 各7ビット + pビット、16段階）
+/// </summary>
+/// <param name="block">4x4 の RGBA8（64バイト、行順）</param>
+/// <param name="out">出力先（16バイト）</param>
+void EncodeBC7(const uint8_t* block, uint8_t* out);
+
+/// <summary>
+/// 1レベル分を圧縮する（4の倍数でない端は端のピクセルを繰り返す）
+/// </summary>
+/// <param name="pixels">RGBA8（行ピッチ = 幅 × 4）</param>
+/// <param name="width">幅</param>
+/// <param name="height">高さ</param>
+/// <param name="format">圧縮形式</param>
+/// <param name="out">出力先（GetLevelSize バイト）</param>
+/// <param name="threadPool">ブロック行を分けるスレッドプール（nullptr なら呼び出し元だけ）</param>
+void CompressLevel(
+    const uint8_t* pixels, uint32_t width, uint32_t height, TextureFormat format, uint8_t* out,
+    ThreadPool* threadPool = nullptr);
+
+/// <summary>
+/// 1レベル分を RGBA8 に戻す（画質の確認用。BC7 はこのクラスが書くモード6だけ読める）
+/// </summary>
+/// <param name="blocks">圧縮データ（GetLevelSize バイト）</param>
+/// <param name="width">幅</param>
+/// <param name="height">高さ</param>
+/// <param name="format">圧縮形式</param>
+/// <param name="out">出力先（RGBA8、行ピッチ = 幅 × 4）</param>
+/// <returns>成否（BC7 のモード6以外のブロックがあれば false）</returns>
+bool DecompressLevel(
+    const uint8_t* blocks, uint32_t width, uint32_t height, TextureFormat format, uint8_t* out);
+
+} // namespace BlockCompressor
@@ -0,0 +1,97 @@
+#include "ConstantBufferAllocator.h"
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+void ConstantBufferAllocator::Initialize(
+    BackingStore* backingStore, uint32_t frameCount, size_t pageSize) {
+	assert(backingStore);
+	assert(0 < frameCount);
+	assert(pageSize == AlignUp(pageSize) && 0 < pageSize);
+
+	backingStore_ = backingStore;
+	pageSize_ = pageSize;
+	pages_.clear();
+	freePages_.clear();
+	frames_.assign(frameCount, Frame{});
+	frameIndex_ = 0;
+	// 最初の確保でページを取りに行く
+	offset_ = pageSize_;
+	statistics_ = {};
+}
+
+void ConstantBufferAllocator::BeginFrame() {
+	// 終了したフレームの統計
+	const Frame& finished = frames_[frameIndex_];
+	statistics_.lastFrameBytes = finished.usedBytes;
+	statistics_.lastFrameAllocations = finished.allocations;
+	statistics_.highWaterMarkBytes = std::max(statistics_.highWaterMarkBytes, finished.usedBytes);
+
+	// 次のフレームへ。このスロットのページはGPUが使い終わっている
+	frameIndex_ = (frameIndex_ + 1) % static_cast<uint32_t>(frames_.size());
+	Frame& frame = frames_[frameIndex_];
+	freePages_.insert(freePages_.end(), frame.pages.begin(), frame.pages.end());
+	frame.pages.clear();
+	frame.usedBytes = 0;
+	frame.allocations = 0;
+	offset_ = pageSize_;
+}
+
+ConstantBufferAllocator::Allocation ConstantBufferAllocator::Allocate(size_t size) {
+	assert(backingStore_);
+	assert(0 < size);
+	size_t alignedSize = AlignUp(size);
+	// 1ページに収まらないサイズは扱わない（定数バッファは最大64KB）
+	assert(alignedSize <= pageSize_);
+
+	if (pageSize_ < offset_ + alignedSize && !NextPage()) {
+		statistics_.failedAllocations++;
+		return Allocation{};
+	}
+
+	Frame& frame = frames_[frameIndex_];
+	const Page& page = pages_[frame.pages.back()];
+	Allocation allocation;
+	allocation.cpuAddress = page.cpuAddress + offset_;
+	allocation.gpuAddress = page.gpuAddress + offset_;
+	allocation.size = alignedSize;
+
+	offset_ += alignedSize;
+	frame.usedBytes += alignedSize;
+	frame.allocations++;
+	return allocation;
+}
+
+bool ConstantBufferAllocator::NextPage() {
+	uint32_t pageIndex;
+	if (freePages_.empty()) {
+		// 空きが無ければ供給元から追加
+		Page page{};
+		if (!backingStore_->CreatePage(pageSize_, &page.cpuAddress, &page.gpuAddress)) {
+			return false;
+		}
+		pageIndex = static_cast<uint32_t>(pages_.size());
+		pages_.push_back(page);
+		statistics_.pageCount = pages_.size();
+	} else {
+		pageIndex = freePages_.back();
+		freePages_.pop_back();
+	}
+	frames_[frameIndex_].pages.push_back(pageIndex);
+	offset_ = 0;
+	return true;
+}
+
+bool SystemMemoryBackingStore::CreatePage(
+    size_t size, uint8_t** cpuAddress, uint64_t* gpuAddress) {
+	pages_.emplace_back(static_cast<uint8_t*>(
+	    ::operator new[](size, std::align_val_t(ConstantBufferAllocator::kAlignment))));
+	*cpuAddress = pages_.back().get();
+	// GPUアドレスの代わりにCPUアドレスをそのまま返す
+	*gpuAddress = reinterpret_cast<uint64_t>(*cpuAddress);
+	return true;
+}
+
+void SystemMemoryBackingStore::PageDeleter::operator()(uint8_t* page) const {
+	::operator delete[](page, std::align_val_t(ConstantBufferAllocator::kAlignment));
+}
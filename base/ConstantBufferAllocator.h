@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// 定数バッファ用のフレーム単位リングアロケータ
+/// 大きなマップ済みバッファ（ページ）から256バイト境界の領域を切り出して返す
+/// </summary>
+class ConstantBufferAllocator {
+public: // 定数
+	// 定数バッファのアライメント (D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT)
+	static constexpr size_t kAlignment = 256;
+	// デフォルトのページサイズ
+	static constexpr size_t kDefaultPageSize = 1024 * 1024;
+
+public: // サブクラス
+	/// <summary>
+	/// ページの供給元
+	/// </summary>
+	class BackingStore {
+	public:
+		virtual ~BackingStore() = default;
+
+		/// <summary>
+		/// ページ生成
+		/// </summary>
+		/// <param name="size">バイト数</param>
+		/// <param name="cpuAddress">マップ済みアドレスの出力先</param>
+		/// <param name="gpuAddress">GPU仮想アドレスの出力先</param>
+		/// <returns>成否</returns>
+		virtual bool CreatePage(size_t size, uint8_t** cpuAddress, uint64_t* gpuAddress) = 0;
+	};
+
+	/// <summary>
+	/// 確保した領域
+	/// </summary>
+	struct Allocation {
+		// 書き込み用アドレス
+		void* cpuAddress = nullptr;
+		// GPU仮想アドレス (SetGraphicsRootConstantBufferView に渡す)
+		uint64_t gpuAddress = 0;
+		// アライメント後のバイト数
+		size_t size = 0;
+	};
+
+	/// <summary>
+	/// 使用量の統計
+	/// </summary>
+	struct Statistics {
+		// 直近に終了したフレームの使用バイト数
+		size_t lastFrameBytes = 0;
+		// 全フレーム中の最大使用バイト数
+		size_t highWaterMarkBytes = 0;
+		// 直近に終了したフレームの確保回数
+		uint32_t lastFrameAllocations = 0;
+		// 生成済みページ数
+		size_t pageCount = 0;
+		// ページを作れずに失敗した確保の回数（全フレームの累計）
+		uint32_t failedAllocations = 0;
+	};
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="backingStore">ページの供給元（借りてくる）</param>
+	/// <param name="frameCount">GPUが同時に参照しうるフレーム数</param>
+	/// <param name="pageSize">1ページのバイト数</param>
+	void Initialize(
+	    BackingStore* backingStore, uint32_t frameCount, size_t pageSize = kDefaultPageSize);
+
+	/// <summary>
+	/// フレーム開始。frameCount フレーム前に使ったページを再利用可能にする
+	/// </summary>
+	void BeginFrame();
+
+	/// <summary>
+	/// 領域確保
+	/// </summary>
+	/// <param name="size">バイト数（256バイトに切り上げる）</param>
+	/// <returns>確保した領域（ページを作れなければ cpuAddress が nullptr）</returns>
+	Allocation Allocate(size_t size);
+
+	/// <summary>
+	/// 構造体を書き込んでGPU仮想アドレスを返す
+	/// </summary>
+	/// <returns>GPU仮想アドレス（確保できなければ 0）</returns>
+	template<class T> uint64_t Push(const T& data) {
+		Allocation allocation = Allocate(sizeof(T));
+		if (!allocation.cpuAddress) {
+			return 0;
+		}
+		*static_cast<T*>(allocation.cpuAddress) = data;
+		return allocation.gpuAddress;
+	}
+
+	/// <summary>
+	/// 現在のフレームの使用バイト数
+	/// </summary>
+	size_t GetCurrentFrameBytes() const { return frames_[frameIndex_].usedBytes; }
+
+	/// <summary>
+	/// 統計の取得
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+	/// <summary>
+	/// 256バイト境界への切り上げ
+	/// </summary>
+	static constexpr size_t AlignUp(size_t size) {
+		return (size + kAlignment - 1) & ~(kAlignment - 1);
+	}
+
+private: // サブクラス
+	// ページ
+	struct Page {
+		uint8_t* cpuAddress;
+		uint64_t gpuAddress;
+	};
+
+	// フレームごとの使用状況
+	struct Frame {
+		// このフレームで使ったページ
+		std::vector<uint32_t> pages;
+		// 使用バイト数
+		size_t usedBytes = 0;
+		// 確保回数
+		uint32_t allocations = 0;
+	};
+
+private: // メンバ関数
+	/// <summary>
+	/// 新しいページに切り替える
+	/// </summary>
+	/// <returns>成否（供給元がページを作れなければ false で、今のページのまま）</returns>
+	bool NextPage();
+
+private: // メンバ変数
+	// ページの供給元
+	BackingStore* backingStore_ = nullptr;
+	// ページサイズ
+	size_t pageSize_ = kDefaultPageSize;
+	// 全ページ
+	std::vector<Page> pages_;
+	// 空きページ
+	std::vector<uint32_t> freePages_;
+	// フレームごとの使用状況
+	std::vector<Frame> frames_;
+	// 現在のフレーム
+	uint32_t frameIndex_ = 0;
+	// 現在のページ内の書き込み位置
+	size_t offset_ = 0;
+	// 統計
+	Statistics statistics_;
+};
+
+/// <summary>
+/// システムメモリ上のページ供給元（GPUを使わない実行やテスト用）
+/// アップロードヒープと同じく、ページの先頭は256バイト境界に揃える
+/// </summary>
+class SystemMemoryBackingStore : public ConstantBufferAllocator::BackingStore {
+public:
+	bool CreatePage(size_t size, uint8_t** cpuAddress, uint64_t* gpuAddress) override;
+
+	/// <summary>
+	/// 生成済みページ数
+	/// </summary>
+	size_t GetPageCount() const { return pages_.size(); }
+
+private:
+	// 境界を指定して確保したメモリの解放
+	struct PageDeleter {
+		void operator()(uint8_t* page) const;
+	};
+
+	std::vector<std::unique_ptr<uint8_t[], PageDeleter>> pages_;
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// 内容ハッシュ (FNV-1a 64bit)
+/// キャッシュの元データが変わっていないかの判定に使う（暗号用途には使わないこと）
+/// </summary>
+namespace ContentHash {
+
+// 初期値
+constexpr uint64_t kOffsetBasis = 14695981039346656037ull;
+// 素数
+constexpr uint64_t kPrime = 1099511628211ull;
+
+/// <summary>
+/// バイト列のハッシュ
+/// </summary>
+/// <param name="data">先頭アドレス</param>
+/// <param name="size">バイト数</param>
+/// <param name="hash">続きから計算する場合の途中のハッシュ値</param>
+inline uint64_t Hash(const void* data, size_t size, uint64_t hash = kOffsetBasis) {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= kPrime;
+	}
+	return hash;
+}
+
+/// <summary>
+/// 値のハッシュ
+/// </summary>
+template<class T> inline uint64_t HashValue(const T& value, uint64_t hash = kOffsetBasis) {
+	return Hash(&value, sizeof(T), hash);
+}
+
+} // namespace ContentHash
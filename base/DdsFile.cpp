@@ -0,0 +1,173 @@
+#include "DdsFile.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// ファイル識別子
+constexpr uint32_t kMagic = 0x20534444; // "DDS "
+// ピクセル形式が DX10 拡張ヘッダにあることを表す FourCC
+constexpr uint32_t kFourCCDX10 = 0x30315844; // "DX10"
+
+// DDS_HEADER の各フラグ
+constexpr uint32_t kFlagCaps = 0x1;
+constexpr uint32_t kFlagHeight = 0x2;
+constexpr uint32_t kFlagWidth = 0x4;
+constexpr uint32_t kFlagPixelFormat = 0x1000;
+constexpr uint32_t kFlagMipMapCount = 0x20000;
+constexpr uint32_t kFlagLinearSize = 0x80000;
+constexpr uint32_t kPixelFormatFourCC = 0x4;
+constexpr uint32_t kCapsComplex = 0x8;
+constexpr uint32_t kCapsTexture = 0x1000;
+constexpr uint32_t kCapsMipMap = 0x400000;
+// D3D10_RESOURCE_DIMENSION_TEXTURE2D
+constexpr uint32_t kDimensionTexture2D = 3;
+
+// DDS_PIXELFORMAT
+struct PixelFormat {
+	uint32_t size;
+	uint32_t flags;
+	uint32_t fourCC;
+	uint32_t rgbBitCount;
+	uint32_t bitMask[4];
+};
+
+// DDS_HEADER
+struct Header {
+	uint32_t size;
+	uint32_t flags;
+	uint32_t height;
+	uint32_t width;
+	uint32_t pitchOrLinearSize;
+	uint32_t depth;
+	uint32_t mipMapCount;
+	uint32_t reserved1[11];
+	PixelFormat pixelFormat;
+	uint32_t caps[4];
+	uint32_t reserved2;
+};
+
+// DDS_HEADER_DXT10
+struct HeaderDX10 {
+	uint32_t dxgiFormat;
+	uint32_t resourceDimension;
+	uint32_t miscFlag;
+	uint32_t arraySize;
+	uint32_t miscFlags2;
+};
+
+static_assert(sizeof(Header) == 124);
+static_assert(sizeof(HeaderDX10) == 20);
+
+// データの始まり
+constexpr size_t kDataOffset = sizeof(uint32_t) + sizeof(Header) + sizeof(HeaderDX10);
+
+bool IsSupportedFormat(uint32_t format) {
+	return format == uint32_t(TextureFormat::kRGBA8) || format == uint32_t(TextureFormat::kBC1) ||
+	       format == uint32_t(TextureFormat::kBC3) || format == uint32_t(TextureFormat::kBC7);
+}
+
+} // namespace
+
+size_t DdsFile::GetDataSize(
+    TextureFormat format, uint32_t width, uint32_t height, uint32_t mipCount) {
+	size_t size = 0;
+	for (uint32_t mip = 0; mip < mipCount; mip++) {
+		size += GetLevelSize(format, std::max(width >> mip, 1u), std::max(height >> mip, 1u));
+	}
+	return size;
+}
+
+bool DdsFile::Write(
+    const std::string& filePath, TextureFormat format, uint32_t width, uint32_t height,
+    uint32_t mipCount, const uint8_t* data) {
+	assert(data && 0 < mipCount);
+	Header header{};
+	header.size = sizeof(Header);
+	header.flags = kFlagCaps | kFlagHeight | kFlagWidth | kFlagPixelFormat | kFlagMipMapCount |
+	               kFlagLinearSize;
+	header.height = height;
+	header.width = width;
+	header.pitchOrLinearSize = static_cast<uint32_t>(GetLevelSize(format, width, height));
+	header.mipMapCount = mipCount;
+	header.pixelFormat.size = sizeof(PixelFormat);
+	header.pixelFormat.flags = kPixelFormatFourCC;
+	header.pixelFormat.fourCC = kFourCCDX10;
+	header.caps[0] = kCapsTexture | (1 < mipCount ? kCapsComplex | kCapsMipMap : 0);
+
+	HeaderDX10 headerDX10{};
+	headerDX10.dxgiFormat = static_cast<uint32_t>(format);
+	headerDX10.resourceDimension = kDimensionTexture2D;
+	headerDX10.arraySize = 1;
+
+	std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(&kMagic), sizeof(kMagic));
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(&headerDX10), sizeof(headerDX10));
+	file.write(
+	    reinterpret_cast<const char*>(data),
+	    static_cast<std::streamsize>(GetDataSize(format, width, height, mipCount)));
+	return static_cast<bool>(file);
+}
+
+bool DdsFile::Open(const std::string& filePath) {
+	Close();
+	if (!file_.Open(filePath) || file_.GetSize() < kDataOffset) {
+		Close();
+		return false;
+	}
+
+	uint32_t magic = 0;
+	Header header{};
+	HeaderDX10 headerDX10{};
+	const uint8_t* data = file_.GetData();
+	std::memcpy(&magic, data, sizeof(magic));
+	std::memcpy(&header, data + sizeof(magic), sizeof(header));
+	std::memcpy(&headerDX10, data + sizeof(magic) + sizeof(header), sizeof(headerDX10));
+	if (magic != kMagic || header.size != sizeof(Header) ||
+	    header.pixelFormat.fourCC != kFourCCDX10 || !IsSupportedFormat(headerDX10.dxgiFormat) ||
+	    headerDX10.resourceDimension != kDimensionTexture2D || headerDX10.arraySize != 1 ||
+	    header.width == 0 || header.height == 0) {
+		Close();
+		return false;
+	}
+
+	format_ = static_cast<TextureFormat>(headerDX10.dxgiFormat);
+	width_ = header.width;
+	height_ = header.height;
+	mipCount_ = std::max(header.mipMapCount, 1u);
+	// レベル数がおかしいか、データが足りなければ壊れている
+	if (32 < mipCount_ ||
+	    file_.GetSize() - kDataOffset < GetDataSize(format_, width_, height_, mipCount_)) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void DdsFile::Close() {
+	file_.Close();
+	width_ = 0;
+	height_ = 0;
+	mipCount_ = 0;
+}
+
+DdsFile::Level DdsFile::GetLevel(uint32_t mip) const {
+	assert(mip < mipCount_);
+	const uint8_t* data = file_.GetData() + kDataOffset;
+	for (uint32_t i = 0; i < mip; i++) {
+		data += GetLevelSize(format_, std::max(width_ >> i, 1u), std::max(height_ >> i, 1u));
+	}
+	Level level;
+	level.data = data;
+	level.width = std::max(width_ >> mip, 1u);
+	level.height = std::max(height_ >> mip, 1u);
+	level.rowPitch = GetRowPitch(format_, level.width);
+	level.size = GetLevelSize(format_, level.width, level.height);
+	return level;
+}
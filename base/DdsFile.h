@@ -0,0 +1,84 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "TextureFormat.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// DDS ファイル（DX10 拡張ヘッダ付きの2Dテクスチャ、ミップマップ付き）
+/// 読み込みはメモリマップして、各レベルをそのまま GPU へ渡せる形で参照する
+/// </summary>
+class DdsFile {
+public: // サブクラス
+	/// <summary>
+	/// ミップマップ1レベル分の参照（Close するまで有効）
+	/// </summary>
+	struct Level {
+		const uint8_t* data = nullptr;
+		// 1行（圧縮ならブロック1行）のバイト数
+		size_t rowPitch = 0;
+		// レベル全体のバイト数
+		size_t size = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// 書き出し
+	/// </summary>
+	/// <param name="filePath">書き出し先</param>
+	/// <param name="format">形式</param>
+	/// <param name="width">レベル0の幅</param>
+	/// <param name="height">レベル0の高さ</param>
+	/// <param name="mipCount">レベル数</param>
+	/// <param name="data">全レベルのデータ（レベル順に詰めたもの）</param>
+	/// <returns>成否</returns>
+	static bool Write(
+	    const std::string& filePath, TextureFormat format, uint32_t width, uint32_t height,
+	    uint32_t mipCount, const uint8_t* data);
+
+	/// <summary>
+	/// 全レベルのバイト数
+	/// </summary>
+	static size_t GetDataSize(
+	    TextureFormat format, uint32_t width, uint32_t height, uint32_t mipCount);
+
+public: // メンバ関数
+	/// <summary>
+	/// 開く
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>成否（無い・壊れている・対応していない形式なら false）</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// 閉じる
+	/// </summary>
+	void Close();
+
+	bool IsOpen() const { return file_.IsOpen(); }
+	TextureFormat GetFormat() const { return format_; }
+	uint32_t GetWidth() const { return width_; }
+	uint32_t GetHeight() const { return height_; }
+	uint32_t GetMipCount() const { return mipCount_; }
+
+	/// <summary>
+	/// レベルの参照
+	/// </summary>
+	/// <param name="mip">レベル</param>
+	Level GetLevel(uint32_t mip) const;
+
+private: // メンバ変数
+	// ファイル
+	MappedFile file_;
+	// 形式
+	TextureFormat format_ = TextureFormat::kRGBA8;
+	// レベル0の大きさ
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	// レベル数
+	uint32_t mipCount_ = 0;
+};
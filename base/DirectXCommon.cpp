@@ -30,7 +30,7 @@ void DirectXCommon::Initialize(WinApp* winApp, int32_t backBufferWidth, int32_t
 	winApp_ = winApp;
 	backBufferWidth_ = backBufferWidth;
 	backBufferHeight_ = backBufferHeight;
-	reference_ = std::chrono::steady_clock::now();
+	framePacer_.Initialize(FramePacer::kDefaultTargetRate);
 
 	// DXGIデバイス初期化
 	InitializeDXGIDevice();
@@ -49,6 +49,11 @@ void DirectXCommon::Initialize(WinApp* winApp, int32_t backBufferWidth, int32_t
 
 	// フェンス生成
 	CreateFence();
+
+	// 定数バッファアロケータ初期化
+	constantBufferStore_.Initialize(device_.Get());
+	constantBufferAllocator_.Initialize(
+	    &constantBufferStore_, static_cast<uint32_t>(backBuffers_.size()));
 }
 
 void DirectXCommon::PreDraw() {
@@ -83,6 +88,9 @@ void DirectXCommon::PreDraw() {
 	// シザリング矩形の設定
 	CD3DX12_RECT rect = CD3DX12_RECT(0, 0, backBufferWidth_, backBufferHeight_);
 	commandList_->RSSetScissorRects(1, &rect);
+
+	// 定数バッファの切り出し位置を今フレーム用に進める
+	constantBufferAllocator_.BeginFrame();
 }
 
 void DirectXCommon::PostDraw() {
@@ -132,29 +140,8 @@ void DirectXCommon::PostDraw() {
 	// 初期化時にframeLatencyWaitableObject_のカウンタを無理やり0にしたのでこの対応がいる。
 	WaitForSingleObject(frameLatencyWaitableObject_, 1000);
 
-	// max 60fps 固定
-	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
-	std::chrono::microseconds elapsed =
-	    std::chrono::duration_cast<std::chrono::microseconds>(now - reference_);
-
-	// 60ギリギリだとちょっとばかし高いリフレッシュレートのモニタで逆にかくついてしまうので少しバッファを取る
-	static const std::chrono::microseconds kMinCheckTime(uint64_t(1000000.0f / 62.0f));
-	// 実際にwaitするのは60基準
-	static const std::chrono::microseconds kMinTime(uint64_t(1000000.0f / 60.0f));
-	std::chrono::microseconds check = kMinCheckTime - elapsed;
-	if (std::chrono::microseconds(0) < check) {
-		std::chrono::microseconds waitTime = kMinTime - elapsed;
-
-		// sleepは信用ならないので1uでポーリング
-		std::chrono::steady_clock::time_point waitStart = std::chrono::steady_clock::now();
-		do {
-			std::this_thread::sleep_for(std::chrono::microseconds(1));
-		} while (std::chrono::steady_clock::now() - waitStart < waitTime);
-	}
-
-	elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
-	    std::chrono::steady_clock::now() - reference_);
-	reference_ = std::chrono::steady_clock::now();
+	// max 60fps 固定。sleepで大まかに待ち、最後だけスピンで合わせる
+	framePacer_.Wait();
 
 	commandAllocator_->Reset();
 	commandList_->Reset(commandAllocator_.Get(), nullptr);
@@ -1,13 +1,15 @@
 #pragma once
 
 #include <Windows.h>
-#include <chrono>
 #include <cstdlib>
 #include <d3d12.h>
 #include <d3dx12.h>
 #include <dxgi1_6.h>
 #include <wrl.h>
 
+#include "ConstantBufferAllocator.h"
+#include "FramePacer.h"
+#include "UploadBufferStore.h"
 #include "WinApp.h"
 
 /// <summary>
@@ -75,6 +77,18 @@ public: // メンバ関数
 	// バックバッファの数を取得
 	size_t GetBackBufferCount() const { return backBuffers_.size(); }
 
+	/// <summary>
+	/// 定数バッファアロケータの取得
+	/// </summary>
+	/// <returns>フレーム単位の定数バッファアロケータ</returns>
+	ConstantBufferAllocator* GetConstantBufferAllocator() { return &constantBufferAllocator_; }
+
+	/// <summary>
+	/// フレームレート制御の取得
+	/// </summary>
+	/// <returns>目標フレームレートの変更やフレーム時間の統計に使う</returns>
+	FramePacer* GetFramePacer() { return &framePacer_; }
+
 private: // メンバ変数
 	// ウィンドウズアプリケーション管理
 	WinApp* winApp_;
@@ -95,8 +109,13 @@ private: // メンバ変数
 	int32_t backBufferWidth_ = 0;
 	int32_t backBufferHeight_ = 0;
 	HANDLE frameLatencyWaitableObject_;
-	std::chrono::steady_clock::time_point reference_;
 	int32_t refreshRate_ = 0;
+	// 定数バッファ用のページ供給元
+	UploadBufferStore constantBufferStore_;
+	// フレーム単位の定数バッファアロケータ
+	ConstantBufferAllocator constantBufferAllocator_;
+	// フレームレート制御
+	FramePacer framePacer_;
 
 private: // メンバ関数
 	DirectXCommon() = default;
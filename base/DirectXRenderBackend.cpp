@@ -0,0 +1,100 @@
+#include "DirectXRenderBackend.h"
+#include "Model.h"
+#include "Sprite.h"
+#include "TextureManager.h"
+#include <cassert>
+#include <cstring>
+
+void DirectXRenderBackend::Initialize(DirectXCommon* dxCommon) {
+	assert(dxCommon);
+	dxCommon_ = dxCommon;
+	pass_ = Pass::kNone;
+	ResetStatistics();
+}
+
+void DirectXRenderBackend::BeginFrame() { dxCommon_->PreDraw(); }
+
+void DirectXRenderBackend::EndFrame() {
+	assert(pass_ == Pass::kNone);
+	dxCommon_->PostDraw();
+	statistics_.frameCount++;
+}
+
+void DirectXRenderBackend::ClearDepthBuffer() { dxCommon_->ClearDepthBuffer(); }
+
+void DirectXRenderBackend::BeginSpritePass() {
+	assert(pass_ == Pass::kNone);
+	Sprite::PreDraw(dxCommon_->GetCommandList());
+	pass_ = Pass::kSprite;
+	statistics_.passCount++;
+}
+
+void DirectXRenderBackend::BeginModelPass() {
+	assert(pass_ == Pass::kNone);
+	Model::PreDraw(dxCommon_->GetCommandList());
+	pass_ = Pass::kModel;
+	statistics_.passCount++;
+}
+
+void DirectXRenderBackend::EndPass() {
+	switch (pass_) {
+	case Pass::kSprite:
+		Sprite::PostDraw();
+		break;
+	case Pass::kModel:
+		Model::PostDraw();
+		break;
+	default:
+		assert(false);
+		break;
+	}
+	pass_ = Pass::kNone;
+}
+
+void DirectXRenderBackend::DrawModel(
+    Model* model, const WorldTransform& worldTransform, const ViewProjection& viewProjection) {
+	assert(pass_ == Pass::kModel);
+	model->Draw(worldTransform, viewProjection);
+	statistics_.drawCallCount++;
+}
+
+void DirectXRenderBackend::DrawModel(
+    Model* model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+    uint32_t textureHandle) {
+	assert(pass_ == Pass::kModel);
+	model->Draw(worldTransform, viewProjection, textureHandle);
+	statistics_.drawCallCount++;
+}
+
+void DirectXRenderBackend::DrawModelInstanced(
+    Model* model, std::span<const WorldTransform* const> worldTransforms,
+    const ViewProjection& viewProjection, std::span<const Vector4> colors) {
+	assert(pass_ == Pass::kModel);
+	model->DrawInstanced(worldTransforms, viewProjection, colors);
+	// メッシュごとに1コール（インスタンス数が上限を超える分は分割される）
+	size_t batchCount = (worldTransforms.size() + kMaxInstancesPerDraw - 1) / kMaxInstancesPerDraw;
+	statistics_.drawCallCount += batchCount * model->GetMeshes().size();
+}
+
+void DirectXRenderBackend::DrawSprite(Sprite* sprite) {
+	assert(pass_ == Pass::kSprite);
+	sprite->Draw();
+	statistics_.drawCallCount++;
+}
+
+uint64_t DirectXRenderBackend::WriteConstantBuffer(const void* data, size_t size) {
+	ConstantBufferAllocator::Allocation allocation =
+	    dxCommon_->GetConstantBufferAllocator()->Allocate(size);
+	if (!allocation.cpuAddress) {
+		return 0;
+	}
+	std::memcpy(allocation.cpuAddress, data, size);
+	statistics_.constantBufferWriteCount++;
+	statistics_.constantBufferWriteBytes += size;
+	return allocation.gpuAddress;
+}
+
+uint32_t DirectXRenderBackend::LoadTexture(const std::string& fileName) {
+	statistics_.textureLoadCount++;
+	return TextureManager::Load(fileName);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "DirectXCommon.h"
+#include "RenderBackend.h"
+
+/// <summary>
+/// DirectX12による描画バックエンド
+/// </summary>
+class DirectXRenderBackend : public RenderBackend {
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="dxCommon">DirectX基盤（借りてくる）</param>
+	void Initialize(DirectXCommon* dxCommon);
+
+	bool IsHeadless() const override { return false; }
+	void BeginFrame() override;
+	void EndFrame() override;
+	void ClearDepthBuffer() override;
+	void BeginSpritePass() override;
+	void BeginModelPass() override;
+	void EndPass() override;
+	void DrawModel(
+	    Model* model, const WorldTransform& worldTransform,
+	    const ViewProjection& viewProjection) override;
+	void DrawModel(
+	    Model* model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    uint32_t textureHandle) override;
+	void DrawModelInstanced(
+	    Model* model, std::span<const WorldTransform* const> worldTransforms,
+	    const ViewProjection& viewProjection, std::span<const Vector4> colors) override;
+	void DrawSprite(Sprite* sprite) override;
+	uint64_t WriteConstantBuffer(const void* data, size_t size) override;
+	uint32_t LoadTexture(const std::string& fileName) override;
+
+private: // サブクラス
+	// 描画パス
+	enum class Pass {
+		kNone,
+		kSprite,
+		kModel,
+	};
+
+private: // メンバ変数
+	// DirectX基盤
+	DirectXCommon* dxCommon_ = nullptr;
+	// 現在の描画パス
+	Pass pass_ = Pass::kNone;
+};
@@ -0,0 +1,54 @@
+#include "FixedTimestep.h"
+#include <cassert>
+
+void FixedTimestep::Initialize(double stepSeconds, uint32_t maxStepsPerFrame) {
+	assert(0.0 < stepSeconds);
+	assert(0 < maxStepsPerFrame);
+
+	stepDuration_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+	    std::chrono::duration<double>(stepSeconds));
+	stepSeconds_ = static_cast<float>(stepSeconds);
+	maxStepsPerFrame_ = maxStepsPerFrame;
+	Reset();
+}
+
+void FixedTimestep::Reset() {
+	accumulator_ = std::chrono::nanoseconds(0);
+	isTicked_ = false;
+	stepCount_ = 0;
+	droppedStepCount_ = 0;
+}
+
+uint32_t FixedTimestep::Tick() {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	// 初回は基準時刻を取るだけ
+	std::chrono::nanoseconds elapsed(0);
+	if (isTicked_) {
+		elapsed = now - reference_;
+	}
+	reference_ = now;
+	isTicked_ = true;
+	return Advance(elapsed);
+}
+
+uint32_t FixedTimestep::Advance(std::chrono::nanoseconds elapsed) {
+	assert(std::chrono::nanoseconds(0) <= elapsed);
+	accumulator_ += elapsed;
+
+	int64_t steps = accumulator_ / stepDuration_;
+	// 処理落ちで追いつけなくなるのを防ぐため、上限を超えた分は捨てる（端数は残す）
+	if (static_cast<int64_t>(maxStepsPerFrame_) < steps) {
+		int64_t dropped = steps - maxStepsPerFrame_;
+		accumulator_ -= stepDuration_ * dropped;
+		droppedStepCount_ += static_cast<uint64_t>(dropped);
+		steps = maxStepsPerFrame_;
+	}
+	accumulator_ -= stepDuration_ * steps;
+	stepCount_ += static_cast<uint64_t>(steps);
+	return static_cast<uint32_t>(steps);
+}
+
+float FixedTimestep::GetAlpha() const {
+	return static_cast<float>(
+	    static_cast<double>(accumulator_.count()) / static_cast<double>(stepDuration_.count()));
+}
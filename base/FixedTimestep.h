@@ -0,0 +1,83 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/// <summary>
+/// 固定ステップのシミュレーション時間管理
+/// 経過時間を蓄積し、1描画フレームあたりに進めるステップ数を返す
+/// </summary>
+class FixedTimestep {
+public: // 定数
+	// デフォルトのステップ間隔（60Hz）
+	static constexpr double kDefaultStepSeconds = 1.0 / 60.0;
+	// 1描画フレームあたりの最大ステップ数（これを超えた分は捨てる）
+	static constexpr uint32_t kDefaultMaxStepsPerFrame = 8;
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="stepSeconds">1ステップの秒数</param>
+	/// <param name="maxStepsPerFrame">1描画フレームあたりの最大ステップ数</param>
+	void Initialize(
+	    double stepSeconds = kDefaultStepSeconds,
+	    uint32_t maxStepsPerFrame = kDefaultMaxStepsPerFrame);
+
+	/// <summary>
+	/// 蓄積した時間と統計のリセット
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// 実時間で時間を進める（描画フレームごとに1回呼ぶ）
+	/// </summary>
+	/// <returns>今フレームに実行するステップ数</returns>
+	uint32_t Tick();
+
+	/// <summary>
+	/// 指定時間だけ時間を進める
+	/// </summary>
+	/// <param name="elapsed">前フレームからの経過時間</param>
+	/// <returns>今フレームに実行するステップ数</returns>
+	uint32_t Advance(std::chrono::nanoseconds elapsed);
+
+	/// <summary>
+	/// 補間係数の取得
+	/// 最後のステップから次のステップまでの進み具合 [0, 1)
+	/// </summary>
+	float GetAlpha() const;
+
+	/// <summary>
+	/// 1ステップの秒数
+	/// </summary>
+	float GetStepSeconds() const { return stepSeconds_; }
+
+	/// <summary>
+	/// 累計ステップ数
+	/// </summary>
+	uint64_t GetStepCount() const { return stepCount_; }
+
+	/// <summary>
+	/// 上限を超えて捨てた累計ステップ数
+	/// </summary>
+	uint64_t GetDroppedStepCount() const { return droppedStepCount_; }
+
+private: // メンバ変数
+	// 1ステップの長さ（整数で蓄積するので表示側のレートに関わらず刻みがずれない）
+	std::chrono::nanoseconds stepDuration_{16666667};
+	// 1ステップの秒数
+	float stepSeconds_ = static_cast<float>(kDefaultStepSeconds);
+	// 1描画フレームあたりの最大ステップ数
+	uint32_t maxStepsPerFrame_ = kDefaultMaxStepsPerFrame;
+	// 未消化の時間
+	std::chrono::nanoseconds accumulator_{0};
+	// 前回の Tick の時刻
+	std::chrono::steady_clock::time_point reference_;
+	// Tick を呼んだことがあるか
+	bool isTicked_ = false;
+	// 累計ステップ数
+	uint64_t stepCount_ = 0;
+	// 捨てた累計ステップ数
+	uint64_t droppedStepCount_ = 0;
+};
@@ -0,0 +1,165 @@
+#include "FramePacer.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <thread>
+#ifdef _WIN32
+#include <Windows.h>
+#include <timeapi.h>
+#pragma comment(lib, "Winmm.lib")
+#endif
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// スピン待ち1回分（yield だと他スレッドにタイムスライスごと取られて寝過ごすことがある）
+inline void SpinPause() {
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+	_mm_pause();
+#else
+	std::this_thread::yield();
+#endif
+}
+
+} // namespace
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+	if (isTimerResolutionRaised_) {
+		timeEndPeriod(1);
+	}
+#endif
+}
+
+void FramePacer::Initialize(double targetRate) {
+#ifdef _WIN32
+	// sleepの分解能をあげておく（呼び出し回数で管理されるので、他で上げていても問題ない）
+	if (!isTimerResolutionRaised_) {
+		timeBeginPeriod(1);
+		isTimerResolutionRaised_ = true;
+	}
+#endif
+	SetTargetRate(targetRate);
+	// sleep の精度は実測で詰めていく。最初は控えめに見積もる
+	sleepMean_ = 0.0;
+	sleepM2_ = 0.0;
+	sleepCount_ = 0;
+	sleepEstimate_ = 5e-3;
+	reference_ = std::chrono::steady_clock::now();
+	deadline_ = reference_ + period_;
+	ResetHistogram();
+}
+
+void FramePacer::SetTargetRate(double targetRate) {
+	if (targetRate <= 0.0) {
+		period_ = std::chrono::steady_clock::duration::zero();
+		latePeriod_ = std::chrono::steady_clock::duration::zero();
+		return;
+	}
+	period_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+	    std::chrono::duration<double>(1.0 / targetRate));
+	latePeriod_ = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+	    std::chrono::duration<double>(1.0 / (targetRate + kLateRateMargin)));
+	deadline_ = reference_ + period_;
+}
+
+void FramePacer::Wait() {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	if (period_ != std::chrono::steady_clock::duration::zero()) {
+		if (now - reference_ < latePeriod_ && now < deadline_) {
+			// 大まかに sleep で待つ
+			SleepUntil(deadline_);
+			// 残りはスピンで合わせる
+			while (std::chrono::steady_clock::now() < deadline_) {
+				SpinPause();
+			}
+			now = std::chrono::steady_clock::now();
+			// 開始時刻は目標の間隔で刻む（スピンの行き過ぎを次のフレームに持ち越さない）
+			deadline_ += period_;
+		} else {
+			// 遅れたフレームは待たずに、基準を今に置き直す（遅れを取り返そうと連続で詰めない）
+			deadline_ = now + period_;
+		}
+	}
+
+	Record(now - reference_);
+	reference_ = now;
+}
+
+void FramePacer::SleepUntil(std::chrono::steady_clock::time_point deadline) {
+	while (true) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		double remaining = std::chrono::duration<double>(deadline - start).count();
+		// sleep で寝過ごしそうならここまで
+		if (remaining <= sleepEstimate_) {
+			break;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		// 実際に寝ていた時間から見積もりを更新（平均 + 標準偏差）
+		double observed =
+		    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		sleepCount_++;
+		double delta = observed - sleepMean_;
+		sleepMean_ += delta / static_cast<double>(sleepCount_);
+		sleepM2_ += delta * (observed - sleepMean_);
+		double stddev = std::sqrt(sleepM2_ / static_cast<double>(sleepCount_));
+		sleepEstimate_ = sleepMean_ + stddev;
+
+		// 環境の変化に追従できるよう、古い実測は定期的に捨てる
+		if (10000 <= sleepCount_) {
+			sleepCount_ = 0;
+			sleepMean_ = 0.0;
+			sleepM2_ = 0.0;
+		}
+	}
+}
+
+void FramePacer::Record(std::chrono::steady_clock::duration frameTime) {
+	uint32_t microseconds = static_cast<uint32_t>(std::min<int64_t>(
+	    std::chrono::duration_cast<std::chrono::microseconds>(frameTime).count(), UINT32_MAX));
+	uint32_t bucket = std::min(microseconds / kBucketWidthMicroseconds, kBucketCount - 1);
+	histogram_[bucket]++;
+	frameCount_++;
+	maxFrameTime_ = std::max(maxFrameTime_, microseconds);
+}
+
+FramePacer::Statistics FramePacer::GetStatistics() const {
+	Statistics statistics;
+	statistics.frameCount = frameCount_;
+	statistics.p50 = GetPercentile(50.0);
+	statistics.p99 = GetPercentile(99.0);
+	statistics.max = maxFrameTime_;
+	return statistics;
+}
+
+uint32_t FramePacer::GetPercentile(double percentile) const {
+	assert(0.0 <= percentile && percentile <= 100.0);
+	if (frameCount_ == 0) {
+		return 0;
+	}
+
+	// 小さい方から数えて目標の順位に達した区間を探す
+	uint64_t rank = std::max<uint64_t>(
+	    1, static_cast<uint64_t>(
+	           std::ceil(percentile / 100.0 * static_cast<double>(frameCount_))));
+	uint64_t count = 0;
+	for (uint32_t i = 0; i < kBucketCount; i++) {
+		count += histogram_[i];
+		if (rank <= count) {
+			// 区間の上端を返す（最大値は超えない）
+			return std::min((i + 1) * kBucketWidthMicroseconds, maxFrameTime_);
+		}
+	}
+	return maxFrameTime_;
+}
+
+void FramePacer::ResetHistogram() {
+	histogram_.fill(0);
+	frameCount_ = 0;
+	maxFrameTime_ = 0;
+}
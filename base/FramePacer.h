@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+/// <summary>
+/// フレームレート制御
+/// 大まかにsleepで待ってから、最後の数百マイクロ秒だけスピンして目標時刻に合わせる
+/// </summary>
+class FramePacer {
+public: // 定数
+	// デフォルトの目標フレームレート
+	static constexpr double kDefaultTargetRate = 60.0;
+	// 遅れとみなすフレームレートの余裕（目標ぎりぎりだと少し高いリフレッシュレートの
+	// モニタでかえってかくつくので、目標 + 2fps の間隔を超えたフレームは待たない）
+	static constexpr double kLateRateMargin = 2.0;
+	// ヒストグラムの1区間の幅（マイクロ秒）
+	static constexpr uint32_t kBucketWidthMicroseconds = 10;
+	// ヒストグラムの区間数（これを超えるフレーム時間は最後の区間に入れる）
+	static constexpr uint32_t kBucketCount = 10000;
+
+public: // サブクラス
+	/// <summary>
+	/// フレーム時間の統計（マイクロ秒）
+	/// </summary>
+	struct Statistics {
+		// 記録したフレーム数
+		uint64_t frameCount = 0;
+		// 中央値
+		uint32_t p50 = 0;
+		// 99パーセンタイル
+		uint32_t p99 = 0;
+		// 最大値
+		uint32_t max = 0;
+	};
+
+public: // メンバ関数
+	/// <summary>
+	/// デストラクタ（上げたタイマー分解能を戻す）
+	/// </summary>
+	~FramePacer();
+
+	/// <summary>
+	/// 初期化
+	/// Windows ではタイマー分解能を1msに上げる（sleep の寝過ごしが15.6ms単位になるのを防ぐ）
+	/// </summary>
+	/// <param name="targetRate">目標フレームレート（0以下なら待たない）</param>
+	void Initialize(double targetRate = kDefaultTargetRate);
+
+	/// <summary>
+	/// 目標フレームレートの設定
+	/// </summary>
+	/// <param name="targetRate">目標フレームレート（0以下なら待たない）</param>
+	void SetTargetRate(double targetRate);
+
+	/// <summary>
+	/// 次のフレームの開始時刻まで待ち、フレーム時間を記録する
+	/// 前のフレームから目標 + kLateRateMargin の間隔を超えていれば待たずに戻り、
+	/// 次のフレームの開始時刻を今から数え直す
+	/// </summary>
+	void Wait();
+
+	/// <summary>
+	/// 次のフレームの開始時刻（Wait が待つ先）
+	/// </summary>
+	std::chrono::steady_clock::time_point GetDeadline() const { return deadline_; }
+
+	/// <summary>
+	/// フレーム時間の統計を集計する
+	/// </summary>
+	Statistics GetStatistics() const;
+
+	/// <summary>
+	/// フレーム時間のパーセンタイル（マイクロ秒、区間の幅で丸める）
+	/// </summary>
+	/// <param name="percentile">パーセンタイル [0, 100]</param>
+	uint32_t GetPercentile(double percentile) const;
+
+	/// <summary>
+	/// ヒストグラムのリセット
+	/// </summary>
+	void ResetHistogram();
+
+private: // メンバ関数
+	/// <summary>
+	/// 指定時刻の少し前まで sleep する
+	/// </summary>
+	void SleepUntil(std::chrono::steady_clock::time_point deadline);
+
+	/// <summary>
+	/// フレーム時間の記録
+	/// </summary>
+	void Record(std::chrono::steady_clock::duration frameTime);
+
+private: // メンバ変数
+	// 1フレームの長さ（0なら待たない）
+	std::chrono::steady_clock::duration period_{};
+	// これより長くかかったフレームは待たない
+	std::chrono::steady_clock::duration latePeriod_{};
+	// 次のフレームの開始時刻
+	std::chrono::steady_clock::time_point deadline_;
+	// 前のフレームの開始時刻
+	std::chrono::steady_clock::time_point reference_;
+	// sleep(1ms) の実際の所要時間の平均・分散の推定（秒）
+	double sleepMean_ = 0.0;
+	double sleepM2_ = 0.0;
+	uint64_t sleepCount_ = 0;
+	double sleepEstimate_ = 0.0;
+	// フレーム時間のヒストグラム
+	std::array<uint32_t, kBucketCount> histogram_{};
+	// 記録したフレーム数
+	uint64_t frameCount_ = 0;
+	// 最大フレーム時間（マイクロ秒）
+	uint32_t maxFrameTime_ = 0;
+	// タイマー分解能を上げたか
+	bool isTimerResolutionRaised_ = false;
+};
@@ -0,0 +1,125 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() { Close(); }
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		Close();
+		data_ = std::exchange(other.data_, nullptr);
+		size_ = std::exchange(other.size_, 0);
+		isOpen_ = std::exchange(other.isOpen_, false);
+#ifdef _WIN32
+		file_ = std::exchange(other.file_, nullptr);
+		mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+	}
+	return *this;
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	HANDLE file = CreateFileA(
+	    filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return false;
+	}
+	file_ = file;
+	isOpen_ = true;
+	// 空のファイルはマップできないので、サイズ0のまま成功とする
+	if (fileSize.QuadPart == 0) {
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		Close();
+		return false;
+	}
+	mapping_ = mapping;
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr) {
+		Close();
+		return false;
+	}
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_) {
+		UnmapViewOfFile(data_);
+	}
+	if (mapping_) {
+		CloseHandle(mapping_);
+	}
+	if (file_) {
+		CloseHandle(file_);
+	}
+	data_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+	file_ = nullptr;
+	mapping_ = nullptr;
+}
+#else
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	int fd = open(filePath.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+	struct stat status {};
+	if (fstat(fd, &status) != 0) {
+		close(fd);
+		return false;
+	}
+	isOpen_ = true;
+	if (status.st_size == 0) {
+		close(fd);
+		return true;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	// マップ後はファイル記述子を閉じても参照できる
+	close(fd);
+	if (view == MAP_FAILED) {
+		isOpen_ = false;
+		return false;
+	}
+	madvise(view, static_cast<size_t>(status.st_size), MADV_SEQUENTIAL);
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(status.st_size);
+	return true;
+}
+
+void MappedFile::Close() {
+	if (data_) {
+		munmap(const_cast<uint8_t*>(data_), size_);
+	}
+	data_ = nullptr;
+	size_ = 0;
+	isOpen_ = false;
+}
+#endif
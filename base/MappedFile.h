@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// 読み込み専用のメモリマップドファイル
+/// ファイルの中身をコピーせずにアドレス空間へ割り当てて参照する
+/// </summary>
+class MappedFile {
+public: // メンバ関数
+	MappedFile() = default;
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	/// <summary>
+	/// ファイルを開いて割り当てる
+	/// </summary>
+	/// <param name="filePath">ファイルパス</param>
+	/// <returns>成否（空のファイルも成功とし、GetSize() が0になる）</returns>
+	bool Open(const std::string& filePath);
+
+	/// <summary>
+	/// 割り当ての解除
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// 先頭アドレス
+	/// </summary>
+	const uint8_t* GetData() const { return data_; }
+
+	/// <summary>
+	/// バイト数
+	/// </summary>
+	size_t GetSize() const { return size_; }
+
+	/// <summary>
+	/// 開いているか
+	/// </summary>
+	bool IsOpen() const { return isOpen_; }
+
+private: // メンバ変数
+	// 先頭アドレス
+	const uint8_t* data_ = nullptr;
+	// バイト数
+	size_t size_ = 0;
+	// 開いているか
+	bool isOpen_ = false;
+#ifdef _WIN32
+	// ファイルハンドル
+	void* file_ = nullptr;
+	// マッピングハンドル
+	void* mapping_ = nullptr;
+#endif
+};
@@ -0,0 +1,300 @@
+#include "MipGenerator.h"
+#include "SimdConfig.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// 1ピクセルの要素数
+constexpr size_t kChannels = TextureImage::kBytesPerPixel;
+// フィルタの最大タップ数
+constexpr int kMaxTaps = 8;
+// sRGB へ詰め直す表が扱う最小の線形値（これ未満は 0 になる）
+constexpr float kMinLinear = 1.0f / 8192.0f;
+// 表の1区間の幅（float のビット列の下位を捨てる数）
+constexpr int kEncodeShift = 13;
+// 表の要素数（2^-13 から 1 までの13オクターブ × 1024区間）
+constexpr size_t kEncodeTableSize = 13 << (23 - kEncodeShift);
+// 1並列単位あたりの出力ピクセル数の目安
+constexpr uint32_t kPixelsPerTask = 16384;
+
+uint32_t FloatBits(float value) {
+	uint32_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	return bits;
+}
+
+float BitsToFloat(uint32_t bits) {
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+/// <summary>
+/// 変換表
+/// </summary>
+struct ConversionTables {
+	// 8bit → 線形（0～255 は sRGB の色、256～511 はアルファ）
+	float toLinear[512];
+	// 線形 → sRGB 8bit（float のビット列で引く。32bit 読みで拾えるよう末尾に余白を置く）
+	uint8_t toSrgb[kEncodeTableSize + 3];
+
+	ConversionTables() {
+		for (int i = 0; i < 256; i++) {
+			float value = float(i) / 255.0f;
+			toLinear[i] = value <= 0.04045f ? value / 12.92f
+			                                : std::pow((value + 0.055f) / 1.055f, 2.4f);
+			toLinear[256 + i] = value;
+		}
+		// 各区間の中央の値で決める
+		const uint32_t minBits = FloatBits(kMinLinear);
+		for (size_t i = 0; i < kEncodeTableSize; i++) {
+			uint32_t bits = minBits + (uint32_t(i) << kEncodeShift) + (1u << (kEncodeShift - 1));
+			double linear = BitsToFloat(bits);
+			double srgb = linear <= 0.0031308 ? linear * 12.92
+			                                  : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+			toSrgb[i] = static_cast<uint8_t>(std::clamp(srgb * 255.0 + 0.5, 0.0, 255.0));
+		}
+		std::memset(toSrgb + kEncodeTableSize, 0, 3);
+	}
+};
+
+const ConversionTables& GetTables() {
+	static const ConversionTables tables;
+	return tables;
+}
+
+/// <summary>
+/// 1次元の縮小フィルタ（出力 x は入力 2x + first から count 個を重み付きで足す）
+/// </summary>
+struct Kernel {
+	int first = 0;
+	int count = 0;
+	float weights[kMaxTaps] = {};
+};
+
+/// <summary>
+/// 第1種変形ベッセル関数 I0
+/// </summary>
+double BesselI0(double x) {
+	double sum = 1.0;
+	double term = 1.0;
+	for (int k = 1; k < 32; k++) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+Kernel MakeKaiserKernel() {
+	// 出力の画素単位で半径2の窓、α = 4
+	constexpr double kAlpha = 4.0;
+	constexpr double kRadius = 2.0;
+	constexpr double kPi = 3.14159265358979323846;
+	Kernel kernel;
+	kernel.first = -3;
+	kernel.count = 8;
+	double weights[kMaxTaps];
+	double total = 0.0;
+	for (int k = 0; k < kernel.count; k++) {
+		// 入力の画素中心から出力の画素中心までの距離（出力の画素単位）
+		double t = std::abs(kernel.first + k + 0.5 - 1.0) / 2.0;
+		double sinc = t == 0.0 ? 1.0 : std::sin(kPi * t) / (kPi * t);
+		double ratio = t / kRadius;
+		double window = BesselI0(kAlpha * std::sqrt(std::max(0.0, 1.0 - ratio * ratio))) /
+		                BesselI0(kAlpha);
+		weights[k] = sinc * window;
+		total += weights[k];
+	}
+	for (int k = 0; k < kernel.count; k++) {
+		kernel.weights[k] = static_cast<float>(weights[k] / total);
+	}
+	return kernel;
+}
+
+const Kernel& GetKernel(MipGenerator::Filter filter) {
+	static const Kernel kBox = {0, 2, {0.5f, 0.5f}};
+	static const Kernel kKaiser = MakeKaiserKernel();
+	return filter == MipGenerator::Filter::kKaiser ? kKaiser : kBox;
+}
+
+/// <summary>
+/// 線形の値を8bitに詰める
+/// </summary>
+uint8_t EncodeColor(const ConversionTables& tables, float value) {
+	value = std::clamp(value, kMinLinear, 0.99999994f);
+	return tables.toSrgb[(FloatBits(value) - FloatBits(kMinLinear)) >> kEncodeShift];
+}
+
+uint8_t EncodeAlpha(float value) {
+	return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+/// <summary>
+/// 縦方向に縮めて線形の1行にする
+/// </summary>
+void FilterColumns(
+    const ConversionTables& tables, const Kernel& kernel, const uint8_t* const* rows,
+    uint32_t width, float* out) {
+	uint32_t x = 0;
+#if defined(MATH_USE_AVX2)
+	// 2ピクセル（8要素）ずつ表を引いて足す
+	const __m256i alphaOffset = _mm256_setr_epi32(0, 0, 0, 256, 0, 0, 0, 256);
+	for (; x + 2 <= width; x += 2) {
+		__m256 sum = _mm256_setzero_ps();
+		for (int k = 0; k < kernel.count; k++) {
+			__m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rows[k] + x * 4));
+			__m256i index = _mm256_add_epi32(_mm256_cvtepu8_epi32(bytes), alphaOffset);
+			__m256 linear = _mm256_i32gather_ps(tables.toLinear, index, 4);
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(kernel.weights[k]), linear));
+		}
+		_mm256_storeu_ps(out + x * kChannels, sum);
+	}
+#endif
+	for (; x < width; x++) {
+		for (size_t c = 0; c < kChannels; c++) {
+			const size_t offset = c == 3 ? 256 : 0;
+			float sum = 0.0f;
+			for (int k = 0; k < kernel.count; k++) {
+				float linear = tables.toLinear[rows[k][x * kChannels + c] + offset];
+				sum = sum + kernel.weights[k] * linear;
+			}
+			out[x * kChannels + c] = sum;
+		}
+	}
+}
+
+/// <summary>
+/// 横方向に縮めて sRGB に詰める（column は左右に端を繰り返した余白付き）
+/// </summary>
+void FilterRow(
+    const ConversionTables& tables, const Kernel& kernel, const float* column, uint32_t width,
+    uint8_t* out) {
+	uint32_t x = 0;
+#if defined(MATH_USE_AVX2)
+	const __m256 minColor = _mm256_set1_ps(kMinLinear);
+	const __m256 maxColor = _mm256_set1_ps(0.99999994f);
+	const __m256i minBits = _mm256_set1_epi32(static_cast<int>(FloatBits(kMinLinear)));
+	const __m256 isAlpha = _mm256_castsi256_ps(_mm256_setr_epi32(0, 0, 0, -1, 0, 0, 0, -1));
+	// 各128bitの先頭4バイトに下位バイトを集めて、2つの32bitを並べる
+	const __m256i packBytes = _mm256_setr_epi8(
+	    0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 4, 8, 12, -1, -1, -1, -1,
+	    -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m256i packDwords = _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0);
+	for (; x + 2 <= width; x += 2) {
+		// 出力2ピクセル分を下位・上位128bitで並行して足す
+		const float* source = column + size_t(x) * 2 * kChannels;
+		__m256 sum = _mm256_setzero_ps();
+		for (int k = 0; k < kernel.count; k++) {
+			__m256 value = _mm256_loadu2_m128(source + (k + 2) * kChannels, source + k * kChannels);
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(kernel.weights[k]), value));
+		}
+		// 色は表、アルファは 255 倍して丸める
+		__m256 color = _mm256_min_ps(_mm256_max_ps(sum, minColor), maxColor);
+		__m256i index =
+		    _mm256_srli_epi32(_mm256_sub_epi32(_mm256_castps_si256(color), minBits), kEncodeShift);
+		__m256i colorBytes = _mm256_and_si256(
+		    _mm256_i32gather_epi32(reinterpret_cast<const int*>(tables.toSrgb), index, 1),
+		    _mm256_set1_epi32(0xff));
+		__m256 alpha = _mm256_min_ps(_mm256_max_ps(sum, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+		__m256i alphaBytes = _mm256_cvttps_epi32(
+		    _mm256_add_ps(_mm256_mul_ps(alpha, _mm256_set1_ps(255.0f)), _mm256_set1_ps(0.5f)));
+		__m256i bytes = _mm256_castps_si256(_mm256_blendv_ps(
+		    _mm256_castsi256_ps(colorBytes), _mm256_castsi256_ps(alphaBytes), isAlpha));
+		bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(bytes, packBytes), packDwords);
+		_mm_storel_epi64(
+		    reinterpret_cast<__m128i*>(out + x * kChannels), _mm256_castsi256_si128(bytes));
+	}
+#endif
+	for (; x < width; x++) {
+		const float* source = column + size_t(x) * 2 * kChannels;
+		for (size_t c = 0; c < kChannels; c++) {
+			float sum = 0.0f;
+			for (int k = 0; k < kernel.count; k++) {
+				sum = sum + kernel.weights[k] * source[k * kChannels + c];
+			}
+			out[x * kChannels + c] = c == 3 ? EncodeAlpha(sum) : EncodeColor(tables, sum);
+		}
+	}
+}
+
+/// <summary>
+/// 1レベル縮める
+/// </summary>
+void Downsample(
+    const Kernel& kernel, const uint8_t* src, uint32_t srcWidth, uint32_t srcHeight, uint8_t* dst,
+    uint32_t dstWidth, uint32_t dstHeight, ThreadPool* threadPool) {
+	const ConversionTables& tables = GetTables();
+	const size_t srcPitch = size_t(srcWidth) * kChannels;
+	const size_t dstPitch = size_t(dstWidth) * kChannels;
+	// 横方向で読む範囲（出力の右端のタップまで）
+	const uint32_t padLeft = static_cast<uint32_t>(-kernel.first);
+	const uint32_t columnWidth = dstWidth * 2 + kernel.count;
+
+	auto filterRows = [&](size_t begin, size_t end) {
+		std::vector<float> column(size_t(columnWidth) * kChannels);
+		float* columnBody = column.data() + size_t(padLeft) * kChannels;
+		const uint8_t* rows[kMaxTaps];
+		for (size_t y = begin; y < end; y++) {
+			for (int k = 0; k < kernel.count; k++) {
+				int64_t sy = int64_t(y) * 2 + kernel.first + k;
+				rows[k] = src + srcPitch * size_t(std::clamp<int64_t>(sy, 0, srcHeight - 1));
+			}
+			// 読む範囲のうち入力の内側だけ縦に縮め、外側は端を繰り返す
+			const uint32_t bodyWidth = std::min(srcWidth, columnWidth - padLeft);
+			FilterColumns(tables, kernel, rows, bodyWidth, columnBody);
+			for (uint32_t x = 0; x < padLeft; x++) {
+				std::memcpy(&column[x * kChannels], columnBody, sizeof(float) * kChannels);
+			}
+			for (uint32_t x = padLeft + bodyWidth; x < columnWidth; x++) {
+				std::memcpy(
+				    &column[x * kChannels], columnBody + size_t(bodyWidth - 1) * kChannels,
+				    sizeof(float) * kChannels);
+			}
+			FilterRow(tables, kernel, column.data(), dstWidth, dst + dstPitch * y);
+		}
+	};
+
+	if (threadPool) {
+		threadPool->ParallelFor(dstHeight, std::max(1u, kPixelsPerTask / dstWidth), filterRows);
+	} else {
+		filterRows(0, dstHeight);
+	}
+}
+
+} // namespace
+
+void MipGenerator::Generate(TextureImage* image, Filter filter, ThreadPool* threadPool) {
+	assert(image && !image->mips.empty());
+
+	// レベルの大きさと位置を先に決めて、ピクセルをまとめて確保する
+	image->mips.resize(1);
+	size_t totalSize = image->GetSlicePitch(0);
+	for (;;) {
+		const TextureImage::MipLevel& last = image->mips.back();
+		if (last.width == 1 && last.height == 1) {
+			break;
+		}
+		TextureImage::MipLevel level;
+		level.width = std::max(last.width / 2, 1u);
+		level.height = std::max(last.height / 2, 1u);
+		level.offset = totalSize;
+		image->mips.push_back(level);
+		totalSize += image->GetSlicePitch(image->mips.size() - 1);
+	}
+	image->pixels.resize(totalSize);
+
+	// レベルは順に依存するので、各レベルの中を行で分ける
+	const Kernel& kernel = GetKernel(filter);
+	for (size_t mip = 1; mip < image->mips.size(); mip++) {
+		const TextureImage::MipLevel& src = image->mips[mip - 1];
+		const TextureImage::MipLevel& dst = image->mips[mip];
+		Downsample(
+		    kernel, image->GetPixels(mip - 1), src.width, src.height, image->GetPixels(mip),
+		    dst.width, dst.height, threadPool);
+	}
+}
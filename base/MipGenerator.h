@@ -0,0 +1,32 @@
+#pragma once
+
+#include "TextureImage.h"
+
+class ThreadPool;
+
+/// <summary>
+/// ミップマップ生成（CPU）
+/// 色は sRGB として線形に戻してから縮め、sRGB に詰め直す（アルファはそのまま線形に扱う）
+/// AVX2 が有効なら8要素ずつ処理する
+/// </summary>
+namespace MipGenerator {
+
+/// <summary>
+/// 縮小フィルタ
+/// </summary>
+enum class Filter {
+	kBox,    // 2x2 の平均
+	kKaiser, // Kaiser 窓の sinc（8タップ、ぼけにくいが縁がわずかに立つ）
+};
+
+/// <summary>
+/// レベル0から 1x1 までのミップマップを作り直す
+/// 各レベルは1つ上のレベルから作る（奇数の辺は端を繰り返す）
+/// </summary>
+/// <param name="image">画像（レベル0だけ使い、残りは作り直す）</param>
+/// <param name="filter">縮小フィルタ</param>
+/// <param name="threadPool">行を分けるスレッドプール（nullptr なら呼び出し元だけ）</param>
+void Generate(
+    TextureImage* image, Filter filter = Filter::kBox, ThreadPool* threadPool = nullptr);
+
+} // namespace MipGenerator
@@ -0,0 +1,104 @@
+#include "NullRenderBackend.h"
+#include "InstanceData.h"
+#include "WorldTransform.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+void NullRenderBackend::Initialize(uint32_t frameCount) {
+	constantBufferAllocator_.Initialize(&constantBufferStore_, frameCount);
+	textures_.clear();
+	isInPass_ = false;
+	ResetStatistics();
+}
+
+void NullRenderBackend::BeginFrame() { constantBufferAllocator_.BeginFrame(); }
+
+void NullRenderBackend::EndFrame() {
+	assert(!isInPass_);
+	statistics_.frameCount++;
+}
+
+void NullRenderBackend::BeginSpritePass() {
+	assert(!isInPass_);
+	isInPass_ = true;
+	statistics_.passCount++;
+}
+
+void NullRenderBackend::BeginModelPass() {
+	assert(!isInPass_);
+	isInPass_ = true;
+	statistics_.passCount++;
+}
+
+void NullRenderBackend::EndPass() {
+	assert(isInPass_);
+	isInPass_ = false;
+}
+
+void NullRenderBackend::DrawModel(
+    Model*, const WorldTransform& worldTransform, const ViewProjection&) {
+	assert(isInPass_);
+	WriteWorldTransform(worldTransform);
+	statistics_.drawCallCount++;
+}
+
+void NullRenderBackend::DrawModel(
+    Model*, const WorldTransform& worldTransform, const ViewProjection&, uint32_t) {
+	assert(isInPass_);
+	WriteWorldTransform(worldTransform);
+	statistics_.drawCallCount++;
+}
+
+void NullRenderBackend::DrawModelInstanced(
+    Model*, std::span<const WorldTransform* const> worldTransforms, const ViewProjection&,
+    std::span<const Vector4> colors) {
+	assert(isInPass_);
+	// メッシュ数は分からないので1バッチ1コールと数える。インスタンスデータは実際に詰める
+	for (size_t first = 0; first < worldTransforms.size(); first += kMaxInstancesPerDraw) {
+		size_t count = std::min(kMaxInstancesPerDraw, worldTransforms.size() - first);
+		size_t size = sizeof(InstanceData) * count;
+		ConstantBufferAllocator::Allocation allocation = constantBufferAllocator_.Allocate(size);
+		if (!allocation.cpuAddress) {
+			return;
+		}
+		PackInstances(
+		    worldTransforms.subspan(first, count),
+		    colors.size() <= 1 ? colors : colors.subspan(first, count),
+		    static_cast<InstanceData*>(allocation.cpuAddress));
+		statistics_.drawCallCount++;
+		statistics_.constantBufferWriteCount++;
+		statistics_.constantBufferWriteBytes += size;
+	}
+}
+
+void NullRenderBackend::DrawSprite(Sprite*) {
+	assert(isInPass_);
+	statistics_.drawCallCount++;
+}
+
+uint64_t NullRenderBackend::WriteConstantBuffer(const void* data, size_t size) {
+	// 書き込み自体は行うので、呼び出し側のコピー負荷も計測に含まれる
+	ConstantBufferAllocator::Allocation allocation = constantBufferAllocator_.Allocate(size);
+	if (!allocation.cpuAddress) {
+		return 0;
+	}
+	std::memcpy(allocation.cpuAddress, data, size);
+	statistics_.constantBufferWriteCount++;
+	statistics_.constantBufferWriteBytes += size;
+	return allocation.gpuAddress;
+}
+
+uint32_t NullRenderBackend::LoadTexture(const std::string& fileName) {
+	statistics_.textureLoadCount++;
+	// 同じ名前には同じハンドルを返す
+	auto it = textures_.try_emplace(fileName, static_cast<uint32_t>(textures_.size())).first;
+	return it->second;
+}
+
+void NullRenderBackend::WriteWorldTransform(const WorldTransform& worldTransform) {
+	// GPUで描くときに転送するワールド行列と同じ大きさを書き込む
+	ConstBufferDataWorldTransform data;
+	data.matWorld = worldTransform.matWorld_;
+	WriteConstantBuffer(&data, sizeof(data));
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "ConstantBufferAllocator.h"
+#include "RenderBackend.h"
+#include <unordered_map>
+
+/// <summary>
+/// GPUを使わない描画バックエンド
+/// 描画要求は実行せず、定数バッファへの書き込みと回数・バイト数の記録だけを行う
+/// </summary>
+class NullRenderBackend : public RenderBackend {
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="frameCount">定数バッファを使い回すまでのフレーム数</param>
+	void Initialize(uint32_t frameCount = 2);
+
+	bool IsHeadless() const override { return true; }
+	void BeginFrame() override;
+	void EndFrame() override;
+	void ClearDepthBuffer() override {}
+	void BeginSpritePass() override;
+	void BeginModelPass() override;
+	void EndPass() override;
+	void DrawModel(
+	    Model* model, const WorldTransform& worldTransform,
+	    const ViewProjection& viewProjection) override;
+	void DrawModel(
+	    Model* model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    uint32_t textureHandle) override;
+	void DrawModelInstanced(
+	    Model* model, std::span<const WorldTransform* const> worldTransforms,
+	    const ViewProjection& viewProjection, std::span<const Vector4> colors) override;
+	void DrawSprite(Sprite* sprite) override;
+	uint64_t WriteConstantBuffer(const void* data, size_t size) override;
+	uint32_t LoadTexture(const std::string& fileName) override;
+
+	/// <summary>
+	/// 定数バッファアロケータの取得
+	/// </summary>
+	const ConstantBufferAllocator& GetConstantBufferAllocator() const {
+		return constantBufferAllocator_;
+	}
+
+private: // メンバ関数
+	/// <summary>
+	/// ワールド行列を定数バッファアロケータ経由で書き込む
+	/// </summary>
+	void WriteWorldTransform(const WorldTransform& worldTransform);
+
+private: // メンバ変数
+	// 定数バッファ用のページ供給元
+	SystemMemoryBackingStore constantBufferStore_;
+	// 定数バッファアロケータ
+	ConstantBufferAllocator constantBufferAllocator_;
+	// 読み込み済みテクスチャ
+	std::unordered_map<std::string, uint32_t> textures_;
+	// 描画パス中か
+	bool isInPass_ = false;
+};
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// <summary>
+/// 世代付きハンドル
+/// 解放済みの要素を指すハンドルは世代が合わなくなるので無効と判定できる
+/// </summary>
+struct PoolHandle {
+	// スロット番号
+	uint32_t index = 0;
+	// 世代（0は無効）
+	uint32_t generation = 0;
+
+	bool operator==(const PoolHandle& other) const {
+		return index == other.index && generation == other.generation;
+	}
+	bool operator!=(const PoolHandle& other) const { return !(*this == other); }
+};
+
+/// <summary>
+/// 固定容量のオブジェクトプール
+/// 生成・破棄はO(1)、生存中の要素は配列に詰めて並ぶので先頭から順に回せる
+/// 初期化時に容量分を確保し、それ以降はヒープを使わない
+/// </summary>
+template<class T> class ObjectPool {
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// 2回目以降は残っている要素をすべて破棄する。それまでのハンドルはすべて無効になる
+	/// </summary>
+	/// <param name="capacity">最大要素数</param>
+	void Initialize(uint32_t capacity) {
+		assert(0 < capacity);
+		objects_.clear();
+		objects_.reserve(capacity);
+		objectSlots_.clear();
+		objectSlots_.reserve(capacity);
+
+		// 世代は引き継いで進める（1からやり直すと、前に配ったハンドルが別の要素を指してしまう）
+		for (const Slot& slot : slots_) {
+			newSlotGeneration_ = std::max(newSlotGeneration_, NextGeneration(slot.generation));
+		}
+		uint32_t keptCount = std::min(capacity, static_cast<uint32_t>(slots_.size()));
+		for (uint32_t i = 0; i < keptCount; i++) {
+			slots_[i].generation = NextGeneration(slots_[i].generation);
+		}
+		// 新しく増えるスロットは、これまでに配ったどの世代とも重ならない値から始める
+		slots_.resize(capacity, Slot{0, newSlotGeneration_});
+		// 空きスロットを番号順に繋いでおく
+		for (uint32_t i = 0; i < capacity; i++) {
+			slots_[i].next = i + 1;
+		}
+		freeHead_ = 0;
+	}
+
+	/// <summary>
+	/// 生成
+	/// </summary>
+	/// <param name="args">コンストラクタ引数</param>
+	/// <returns>ハンドル（満杯なら無効なハンドル）</returns>
+	template<class... Args> PoolHandle Spawn(Args&&... args) {
+		if (IsFull()) {
+			return PoolHandle{};
+		}
+		uint32_t index = freeHead_;
+		Slot& slot = slots_[index];
+		freeHead_ = slot.next;
+		slot.next = static_cast<uint32_t>(objects_.size());
+
+		objects_.emplace_back(std::forward<Args>(args)...);
+		objectSlots_.push_back(index);
+		return PoolHandle{index, slot.generation};
+	}
+
+	/// <summary>
+	/// 破棄
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns>破棄したか（既に無効なハンドルなら false）</returns>
+	bool Despawn(PoolHandle handle) {
+		if (!IsAlive(handle)) {
+			return false;
+		}
+		RemoveAt(slots_[handle.index].next);
+		return true;
+	}
+
+	/// <summary>
+	/// 条件を満たす要素をまとめて破棄
+	/// </summary>
+	/// <param name="predicate">破棄するなら true を返す関数</param>
+	/// <returns>破棄した数</returns>
+	template<class Predicate> uint32_t DespawnIf(Predicate predicate) {
+		uint32_t count = 0;
+		// 末尾と入れ替えて詰めるので、入れ替え後の要素も同じ位置で判定する
+		for (uint32_t i = 0; i < objects_.size();) {
+			if (predicate(objects_[i])) {
+				RemoveAt(i);
+				count++;
+			} else {
+				i++;
+			}
+		}
+		return count;
+	}
+
+	/// <summary>
+	/// 全要素の破棄
+	/// </summary>
+	void Clear() {
+		while (!objects_.empty()) {
+			RemoveAt(static_cast<uint32_t>(objects_.size() - 1));
+		}
+	}
+
+	/// <summary>
+	/// 要素の取得
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns>要素（無効なハンドルなら nullptr）</returns>
+	T* Get(PoolHandle handle) {
+		return IsAlive(handle) ? &objects_[slots_[handle.index].next] : nullptr;
+	}
+	const T* Get(PoolHandle handle) const {
+		return IsAlive(handle) ? &objects_[slots_[handle.index].next] : nullptr;
+	}
+
+	/// <summary>
+	/// ハンドルが生存中の要素を指しているか
+	/// </summary>
+	bool IsAlive(PoolHandle handle) const {
+		return handle.index < slots_.size() && handle.generation != 0 &&
+		       slots_[handle.index].generation == handle.generation;
+	}
+
+	/// <summary>
+	/// 詰めた配列上の位置から要素のハンドルを取得
+	/// </summary>
+	/// <param name="position">0 ～ GetSize()-1</param>
+	PoolHandle GetHandle(uint32_t position) const {
+		assert(position < objects_.size());
+		uint32_t index = objectSlots_[position];
+		return PoolHandle{index, slots_[index].generation};
+	}
+
+	/// <summary>
+	/// 生存中の要素数
+	/// </summary>
+	uint32_t GetSize() const { return static_cast<uint32_t>(objects_.size()); }
+
+	/// <summary>
+	/// 最大要素数
+	/// </summary>
+	uint32_t GetCapacity() const { return static_cast<uint32_t>(slots_.size()); }
+
+	/// <summary>
+	/// 満杯か
+	/// </summary>
+	bool IsFull() const { return objects_.size() == slots_.size(); }
+
+	// 生存中の要素を先頭から順に回す（回している間に Spawn/Despawn しないこと）
+	T* begin() { return objects_.data(); }
+	T* end() { return objects_.data() + objects_.size(); }
+	const T* begin() const { return objects_.data(); }
+	const T* end() const { return objects_.data() + objects_.size(); }
+
+private: // サブクラス
+	// スロット
+	struct Slot {
+		// 生存中は配列上の位置、空きなら次の空きスロット
+		uint32_t next = 0;
+		// 世代
+		uint32_t generation = 1;
+	};
+
+private: // メンバ関数
+	/// <summary>
+	/// 次の世代（0は無効なので飛ばす）
+	/// </summary>
+	static uint32_t NextGeneration(uint32_t generation) {
+		return generation + 1 == 0 ? 1 : generation + 1;
+	}
+
+	/// <summary>
+	/// 配列上の位置の要素を破棄（末尾の要素を移して詰める）
+	/// </summary>
+	void RemoveAt(uint32_t position) {
+		uint32_t index = objectSlots_[position];
+		uint32_t last = static_cast<uint32_t>(objects_.size() - 1);
+		if (position != last) {
+			objects_[position] = std::move(objects_[last]);
+			objectSlots_[position] = objectSlots_[last];
+			slots_[objectSlots_[position]].next = position;
+		}
+		objects_.pop_back();
+		objectSlots_.pop_back();
+
+		// 世代を進めて古いハンドルを無効にし、空きリストへ戻す
+		Slot& slot = slots_[index];
+		slot.generation = NextGeneration(slot.generation);
+		slot.next = freeHead_;
+		freeHead_ = index;
+	}
+
+private: // メンバ変数
+	// 生存中の要素（詰めて並べる）
+	std::vector<T> objects_;
+	// 要素ごとのスロット番号
+	std::vector<uint32_t> objectSlots_;
+	// スロット
+	std::vector<Slot> slots_;
+	// 空きスロットの先頭
+	uint32_t freeHead_ = 0;
+	// 再初期化で新しく増えるスロットの世代
+	uint32_t newSlotGeneration_ = 1;
+};
@@ -0,0 +1,612 @@
+#include "PngDecoder.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// 扱う最大の幅・高さ
+constexpr uint32_t kMaxDimension = 16384;
+
+#pragma region Deflate 展開
+
+// 符号の最大ビット数
+constexpr int kMaxCodeBits = 15;
+// 表引きで一度に読むビット数
+constexpr int kFastBits = 10;
+
+/// <summary>
+/// 下位ビットから読むビットストリーム
+/// </summary>
+class BitReader {
+public:
+	BitReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+	/// <summary>
+	/// 先読み（n は 25 以下）
+	/// </summary>
+	uint32_t Peek(int n) {
+		Refill();
+		return static_cast<uint32_t>(buffer_ & ((uint64_t(1) << n) - 1));
+	}
+
+	void Consume(int n) {
+		buffer_ >>= n;
+		bitCount_ -= n;
+	}
+
+	uint32_t Read(int n) {
+		uint32_t bits = Peek(n);
+		Consume(n);
+		return bits;
+	}
+
+	/// <summary>
+	/// バイト境界まで読み飛ばす
+	/// </summary>
+	void AlignToByte() { Consume(bitCount_ & 7); }
+
+	/// <summary>
+	/// 入力の終わりを越えて読んだか
+	/// </summary>
+	bool IsOverrun() const { return int64_t(size_) * 8 < int64_t(pos_) * 8 - bitCount_; }
+
+	/// <summary>
+	/// バイト境界から生のバイト列を写す
+	/// </summary>
+	bool CopyBytes(uint8_t* dst, size_t count) {
+		// 先読みしてある分を先に使う（ここでは補充しない）
+		while (count != 0 && 8 <= bitCount_) {
+			*dst++ = static_cast<uint8_t>(buffer_);
+			Consume(8);
+			count--;
+		}
+		if (count == 0) {
+			return !IsOverrun();
+		}
+		if (size_ < pos_ || size_ - pos_ < count) {
+			return false;
+		}
+		std::memcpy(dst, data_ + pos_, count);
+		pos_ += count;
+		return true;
+	}
+
+private:
+	void Refill() {
+		while (bitCount_ <= 56) {
+			// 終わりを越えたら 0 を詰め、越えたかどうかは IsOverrun で見る
+			uint64_t byte = pos_ < size_ ? data_[pos_] : 0;
+			buffer_ |= byte << bitCount_;
+			bitCount_ += 8;
+			pos_++;
+		}
+	}
+
+	const uint8_t* data_;
+	size_t size_;
+	size_t pos_ = 0;
+	uint64_t buffer_ = 0;
+	int bitCount_ = 0;
+};
+
+/// <summary>
+/// 正準ハフマン符号の復号表
+/// </summary>
+struct Huffman {
+	// 下位 kFastBits ビットで引く表（記号 << 4 | 長さ、0 は表に無い）
+	uint16_t fast[1 << kFastBits];
+	// 長さごとの符号数
+	uint16_t count[kMaxCodeBits + 1];
+	// 符号順の記号
+	uint16_t symbol[288];
+
+	/// <summary>
+	/// 符号長から表を作る
+	/// </summary>
+	bool Build(const uint8_t* lengths, int n) {
+		std::memset(count, 0, sizeof(count));
+		for (int i = 0; i < n; i++) {
+			count[lengths[i]]++;
+		}
+		count[0] = 0;
+		// 符号が足りすぎていないか
+		int left = 1;
+		for (int len = 1; len <= kMaxCodeBits; len++) {
+			left = (left << 1) - count[len];
+			if (left < 0) {
+				return false;
+			}
+		}
+
+		uint16_t offsets[kMaxCodeBits + 2] = {};
+		for (int len = 1; len <= kMaxCodeBits; len++) {
+			offsets[len + 1] = offsets[len] + count[len];
+		}
+		for (int i = 0; i < n; i++) {
+			if (lengths[i] != 0) {
+				symbol[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+			}
+		}
+
+		// 短い符号はビット順を反転させた値で直接引けるようにする
+		std::memset(fast, 0, sizeof(fast));
+		uint32_t code = 0;
+		int index = 0;
+		for (int len = 1; len <= kMaxCodeBits; len++) {
+			for (int i = 0; i < count[len]; i++, index++, code++) {
+				if (len > kFastBits) {
+					continue;
+				}
+				uint32_t reversed = 0;
+				for (int bit = 0; bit < len; bit++) {
+					reversed |= ((code >> bit) & 1) << (len - 1 - bit);
+				}
+				uint16_t entry = static_cast<uint16_t>(symbol[index] << 4 | len);
+				for (uint32_t fill = reversed; fill < (1u << kFastBits); fill += 1u << len) {
+					fast[fill] = entry;
+				}
+			}
+			code <<= 1;
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// 記号を1つ読む（壊れていれば -1）
+	/// </summary>
+	int Decode(BitReader& reader) const {
+		uint32_t bits = reader.Peek(kMaxCodeBits);
+		uint16_t entry = fast[bits & ((1u << kFastBits) - 1)];
+		if (entry != 0) {
+			reader.Consume(entry & 0xf);
+			return entry >> 4;
+		}
+		// 長い符号は1ビットずつ
+		int code = 0;
+		int first = 0;
+		int index = 0;
+		for (int len = 1; len <= kMaxCodeBits; len++) {
+			code |= (bits >> (len - 1)) & 1;
+			int n = count[len];
+			if (code - first < n) {
+				reader.Consume(len);
+				return symbol[index + (code - first)];
+			}
+			index += n;
+			first = (first + n) << 1;
+			code <<= 1;
+		}
+		return -1;
+	}
+};
+
+constexpr uint16_t kLengthBase[29] = {3,  4,  5,  6,  7,  8,  9,  10,  11,  13,
+                                      15, 17, 19, 23, 27, 31, 35, 43,  51,  59,
+                                      67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                      2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t kDistanceBase[30] = {1,    2,    3,    4,    5,    7,     9,     13,
+                                        17,   25,   33,   49,   65,   97,    129,   193,
+                                        257,  385,  513,  769,  1025, 1537,  2049,  3073,
+                                        4097, 6145, 8193, 12289, 16385, 24577};
+constexpr uint8_t kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,  4,  4,  5,  5,  6,
+                                        6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/// <summary>
+/// 圧縮ブロック1つを展開
+/// </summary>
+bool InflateBlock(
+    BitReader& reader, const Huffman& lengthCodes, const Huffman& distanceCodes,
+    std::vector<uint8_t>& out) {
+	for (;;) {
+		int symbol = lengthCodes.Decode(reader);
+		if (symbol < 0 || reader.IsOverrun()) {
+			return false;
+		}
+		if (symbol < 256) {
+			out.push_back(static_cast<uint8_t>(symbol));
+			continue;
+		}
+		if (symbol == 256) {
+			return true;
+		}
+		symbol -= 257;
+		if (29 <= symbol) {
+			return false;
+		}
+		size_t length = kLengthBase[symbol] + reader.Read(kLengthExtra[symbol]);
+		int distanceSymbol = distanceCodes.Decode(reader);
+		if (distanceSymbol < 0 || 30 <= distanceSymbol) {
+			return false;
+		}
+		size_t distance =
+		    kDistanceBase[distanceSymbol] + reader.Read(kDistanceExtra[distanceSymbol]);
+		if (out.size() < distance) {
+			return false;
+		}
+		// 重なることがあるので前から1バイトずつ写す
+		size_t from = out.size() - distance;
+		out.resize(out.size() + length);
+		uint8_t* dst = out.data() + out.size() - length;
+		const uint8_t* src = out.data() + from;
+		for (size_t i = 0; i < length; i++) {
+			dst[i] = src[i];
+		}
+	}
+}
+
+/// <summary>
+/// zlib ストリームの展開
+/// </summary>
+bool Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+	// zlib ヘッダ（deflate で辞書なし）
+	if (size < 2 || (data[0] & 0x0f) != 8 || ((data[0] << 8) | data[1]) % 31 != 0 ||
+	    (data[1] & 0x20) != 0) {
+		return false;
+	}
+	BitReader reader(data + 2, size - 2);
+
+	Huffman lengthCodes;
+	Huffman distanceCodes;
+	bool last = false;
+	while (!last) {
+		last = reader.Read(1) != 0;
+		uint32_t type = reader.Read(2);
+		if (type == 0) {
+			// 無圧縮
+			reader.AlignToByte();
+			uint32_t length = reader.Read(16);
+			uint32_t inverted = reader.Read(16);
+			if ((length ^ 0xffff) != inverted) {
+				return false;
+			}
+			size_t offset = out.size();
+			out.resize(offset + length);
+			if (!reader.CopyBytes(out.data() + offset, length)) {
+				return false;
+			}
+			continue;
+		}
+
+		uint8_t lengths[288 + 32] = {};
+		if (type == 1) {
+			// 固定ハフマン符号
+			std::fill(lengths, lengths + 144, uint8_t(8));
+			std::fill(lengths + 144, lengths + 256, uint8_t(9));
+			std::fill(lengths + 256, lengths + 280, uint8_t(7));
+			std::fill(lengths + 280, lengths + 288, uint8_t(8));
+			lengthCodes.Build(lengths, 288);
+			std::fill(lengths, lengths + 30, uint8_t(5));
+			distanceCodes.Build(lengths, 30);
+		} else if (type == 2) {
+			// 動的ハフマン符号
+			static constexpr uint8_t kOrder[19] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+			                                       11, 4,  12, 3, 13, 2, 14, 1, 15};
+			int lengthCount = static_cast<int>(reader.Read(5)) + 257;
+			int distanceCount = static_cast<int>(reader.Read(5)) + 1;
+			int codeLengthCount = static_cast<int>(reader.Read(4)) + 4;
+			if (286 < lengthCount || 30 < distanceCount) {
+				return false;
+			}
+			uint8_t codeLengths[19] = {};
+			for (int i = 0; i < codeLengthCount; i++) {
+				codeLengths[kOrder[i]] = static_cast<uint8_t>(reader.Read(3));
+			}
+			Huffman codeLengthCodes;
+			if (!codeLengthCodes.Build(codeLengths, 19)) {
+				return false;
+			}
+			int total = lengthCount + distanceCount;
+			for (int i = 0; i < total;) {
+				int symbol = codeLengthCodes.Decode(reader);
+				if (symbol < 0) {
+					return false;
+				}
+				if (symbol < 16) {
+					lengths[i++] = static_cast<uint8_t>(symbol);
+					continue;
+				}
+				uint8_t value = 0;
+				int repeat = 0;
+				if (symbol == 16) {
+					if (i == 0) {
+						return false;
+					}
+					value = lengths[i - 1];
+					repeat = 3 + static_cast<int>(reader.Read(2));
+				} else if (symbol == 17) {
+					repeat = 3 + static_cast<int>(reader.Read(3));
+				} else {
+					repeat = 11 + static_cast<int>(reader.Read(7));
+				}
+				if (total < i + repeat) {
+					return false;
+				}
+				std::fill(lengths + i, lengths + i + repeat, value);
+				i += repeat;
+			}
+			if (lengths[256] == 0 || !lengthCodes.Build(lengths, lengthCount) ||
+			    !distanceCodes.Build(lengths + lengthCount, distanceCount)) {
+				return false;
+			}
+		} else {
+			return false;
+		}
+
+		if (!InflateBlock(reader, lengthCodes, distanceCodes, out)) {
+			return false;
+		}
+	}
+	return !reader.IsOverrun();
+}
+
+#pragma endregion
+
+#pragma region PNG
+
+uint32_t ReadBigEndian32(const uint8_t* p) {
+	return uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | uint32_t(p[3]);
+}
+
+uint8_t Paeth(uint8_t a, uint8_t b, uint8_t c) {
+	int p = int(a) + int(b) - int(c);
+	int pa = std::abs(p - int(a));
+	int pb = std::abs(p - int(b));
+	int pc = std::abs(p - int(c));
+	if (pa <= pb && pa <= pc) {
+		return a;
+	}
+	return pb <= pc ? b : c;
+}
+
+/// <summary>
+/// 行ごとのフィルタを戻す（その場で書き換え、フィルタ種別のバイトは残す）
+/// </summary>
+bool Unfilter(uint8_t* data, uint32_t height, size_t rowBytes, size_t bytesPerPixel) {
+	const uint8_t* prior = nullptr;
+	for (uint32_t y = 0; y < height; y++) {
+		uint8_t filter = data[0];
+		uint8_t* row = data + 1;
+		switch (filter) {
+		case 0:
+			break;
+		case 1:
+			for (size_t x = bytesPerPixel; x < rowBytes; x++) {
+				row[x] = static_cast<uint8_t>(row[x] + row[x - bytesPerPixel]);
+			}
+			break;
+		case 2:
+			if (prior) {
+				for (size_t x = 0; x < rowBytes; x++) {
+					row[x] = static_cast<uint8_t>(row[x] + prior[x]);
+				}
+			}
+			break;
+		case 3:
+			for (size_t x = 0; x < rowBytes; x++) {
+				int left = bytesPerPixel <= x ? row[x - bytesPerPixel] : 0;
+				int up = prior ? prior[x] : 0;
+				row[x] = static_cast<uint8_t>(row[x] + ((left + up) >> 1));
+			}
+			break;
+		case 4:
+			for (size_t x = 0; x < rowBytes; x++) {
+				uint8_t left = bytesPerPixel <= x ? row[x - bytesPerPixel] : 0;
+				uint8_t up = prior ? prior[x] : 0;
+				uint8_t upLeft = prior && bytesPerPixel <= x ? prior[x - bytesPerPixel] : 0;
+				row[x] = static_cast<uint8_t>(row[x] + Paeth(left, up, upLeft));
+			}
+			break;
+		default:
+			return false;
+		}
+		prior = row;
+		data += rowBytes + 1;
+	}
+	return true;
+}
+
+/// <summary>
+/// 1ビット～8ビットのサンプルを読む
+/// </summary>
+uint32_t ReadSample(const uint8_t* row, uint32_t index, uint32_t bitDepth) {
+	if (bitDepth == 8) {
+		return row[index];
+	}
+	if (bitDepth == 16) {
+		return uint32_t(row[index * 2]) << 8 | row[index * 2 + 1];
+	}
+	uint32_t bit = index * bitDepth;
+	uint32_t shift = 8 - bitDepth - (bit & 7);
+	return (row[bit >> 3] >> shift) & ((1u << bitDepth) - 1);
+}
+
+/// <summary>
+/// サンプルを8ビットにする
+/// </summary>
+uint8_t ToByte(uint32_t sample, uint32_t bitDepth) {
+	if (bitDepth == 16) {
+		return static_cast<uint8_t>(sample >> 8);
+	}
+	return static_cast<uint8_t>(sample * 255 / ((1u << bitDepth) - 1));
+}
+
+#pragma endregion
+
+} // namespace
+
+bool PngDecoder::IsPng(const uint8_t* data, size_t size) {
+	static constexpr uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+	return 8 <= size && std::memcmp(data, kSignature, 8) == 0;
+}
+
+bool PngDecoder::Decode(const uint8_t* data, size_t size, TextureImage* image) {
+	if (!IsPng(data, size)) {
+		return false;
+	}
+
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint32_t bitDepth = 0;
+	uint32_t colorType = 0;
+	uint8_t palette[256][4] = {};
+	uint32_t paletteSize = 0;
+	// 透明色（グレー・RGB の場合）
+	bool hasColorKey = false;
+	uint32_t colorKey[3] = {};
+	std::vector<uint8_t> compressed;
+
+	// チャンクを読む
+	size_t pos = 8;
+	bool hasHeader = false;
+	for (;;) {
+		if (size - pos < 12) {
+			return false;
+		}
+		uint32_t length = ReadBigEndian32(data + pos);
+		const uint8_t* type = data + pos + 4;
+		const uint8_t* body = data + pos + 8;
+		if (size - pos - 12 < length) {
+			return false;
+		}
+		pos += size_t(length) + 12;
+
+		if (std::memcmp(type, "IHDR", 4) == 0) {
+			if (length < 13) {
+				return false;
+			}
+			width = ReadBigEndian32(body);
+			height = ReadBigEndian32(body + 4);
+			bitDepth = body[8];
+			colorType = body[9];
+			// 圧縮・フィルタ方式は 0 のみ。インターレースには対応しない
+			if (body[10] != 0 || body[11] != 0 || body[12] != 0) {
+				return false;
+			}
+			hasHeader = true;
+		} else if (std::memcmp(type, "PLTE", 4) == 0) {
+			paletteSize = std::min<uint32_t>(length / 3, 256);
+			for (uint32_t i = 0; i < paletteSize; i++) {
+				palette[i][0] = body[i * 3];
+				palette[i][1] = body[i * 3 + 1];
+				palette[i][2] = body[i * 3 + 2];
+				palette[i][3] = 255;
+			}
+		} else if (std::memcmp(type, "tRNS", 4) == 0) {
+			if (colorType == 3) {
+				for (uint32_t i = 0; i < std::min<uint32_t>(length, paletteSize); i++) {
+					palette[i][3] = body[i];
+				}
+			} else if (colorType == 0 && 2 <= length) {
+				hasColorKey = true;
+				colorKey[0] = uint32_t(body[0]) << 8 | body[1];
+			} else if (colorType == 2 && 6 <= length) {
+				hasColorKey = true;
+				for (int i = 0; i < 3; i++) {
+					colorKey[i] = uint32_t(body[i * 2]) << 8 | body[i * 2 + 1];
+				}
+			}
+		} else if (std::memcmp(type, "IDAT", 4) == 0) {
+			compressed.insert(compressed.end(), body, body + length);
+		} else if (std::memcmp(type, "IEND", 4) == 0) {
+			break;
+		}
+	}
+	if (!hasHeader || width == 0 || height == 0 || kMaxDimension < width ||
+	    kMaxDimension < height) {
+		return false;
+	}
+
+	// 色の種類ごとのサンプル数と、許されるビット深度
+	uint32_t channels = 0;
+	switch (colorType) {
+	case 0:
+		channels = 1;
+		break;
+	case 2:
+		channels = 3;
+		break;
+	case 3:
+		channels = 1;
+		break;
+	case 4:
+		channels = 2;
+		break;
+	case 6:
+		channels = 4;
+		break;
+	default:
+		return false;
+	}
+	bool lowDepth = bitDepth == 1 || bitDepth == 2 || bitDepth == 4;
+	bool validDepth = bitDepth == 8 || (bitDepth == 16 && colorType != 3) ||
+	                  (lowDepth && (colorType == 0 || colorType == 3));
+	if (!validDepth || (colorType == 3 && paletteSize == 0)) {
+		return false;
+	}
+
+	const size_t bitsPerPixel = size_t(channels) * bitDepth;
+	const size_t rowBytes = (size_t(width) * bitsPerPixel + 7) / 8;
+	const size_t bytesPerPixel = std::max<size_t>(1, bitsPerPixel / 8);
+
+	// 展開してフィルタを戻す
+	std::vector<uint8_t> raw;
+	raw.reserve((rowBytes + 1) * height);
+	if (!Inflate(compressed.data(), compressed.size(), raw) ||
+	    raw.size() < (rowBytes + 1) * height) {
+		return false;
+	}
+	if (!Unfilter(raw.data(), height, rowBytes, bytesPerPixel)) {
+		return false;
+	}
+
+	// RGBA8 にする
+	image->Allocate(width, height);
+	for (uint32_t y = 0; y < height; y++) {
+		const uint8_t* row = raw.data() + (rowBytes + 1) * y + 1;
+		uint8_t* dst = image->GetPixels(0) + image->GetRowPitch(0) * y;
+		if (colorType == 6 && bitDepth == 8) {
+			std::memcpy(dst, row, rowBytes);
+			continue;
+		}
+		for (uint32_t x = 0; x < width; x++, dst += 4) {
+			uint32_t samples[4] = {};
+			for (uint32_t c = 0; c < channels; c++) {
+				samples[c] = ReadSample(row, x * channels + c, bitDepth);
+			}
+			switch (colorType) {
+			case 0:
+				dst[0] = dst[1] = dst[2] = ToByte(samples[0], bitDepth);
+				dst[3] = hasColorKey && samples[0] == colorKey[0] ? 0 : 255;
+				break;
+			case 2:
+				for (int c = 0; c < 3; c++) {
+					dst[c] = ToByte(samples[c], bitDepth);
+				}
+				dst[3] = hasColorKey && samples[0] == colorKey[0] && samples[1] == colorKey[1] &&
+				                 samples[2] == colorKey[2]
+				             ? 0
+				             : 255;
+				break;
+			case 3:
+				if (paletteSize <= samples[0]) {
+					return false;
+				}
+				std::memcpy(dst, palette[samples[0]], 4);
+				break;
+			case 4:
+				dst[0] = dst[1] = dst[2] = ToByte(samples[0], bitDepth);
+				dst[3] = ToByte(samples[1], bitDepth);
+				break;
+			default:
+				for (int c = 0; c < 4; c++) {
+					dst[c] = ToByte(samples[c], bitDepth);
+				}
+				break;
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "TextureImage.h"
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// PNG の展開（WIC を使わないのでワーカースレッドや Windows 以外でも動く）
+/// 対応: 非インターレースでビット深度 1～16 のグレー・RGB・パレット・アルファ付き
+/// （すべて RGBA8 にする）
+/// CRC と Adler-32 は確かめない
+/// </summary>
+namespace PngDecoder {
+
+/// <summary>
+/// PNG か（シグネチャだけ見る）
+/// </summary>
+/// <param name="data">ファイルの中身</param>
+/// <param name="size">バイト数</param>
+bool IsPng(const uint8_t* data, size_t size);
+
+/// <summary>
+/// 展開
+/// </summary>
+/// <param name="data">ファイルの中身</param>
+/// <param name="size">バイト数</param>
+/// <param name="image">出力先（レベル0だけ）</param>
+/// <returns>成否（壊れているか対応していない形式なら false）</returns>
+bool Decode(const uint8_t* data, size_t size, TextureImage* image);
+
+} // namespace PngDecoder
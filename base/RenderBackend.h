@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+class Model;
+class Sprite;
+struct Vector4;
+struct ViewProjection;
+struct WorldTransform;
+
+/// <summary>
+/// 描画バックエンド
+/// ゲームシーンはこのインターフェース経由で描画するので、GPUの無い環境でも動かせる
+/// </summary>
+class RenderBackend {
+public: // サブクラス
+	/// <summary>
+	/// 統計
+	/// </summary>
+	struct Statistics {
+		// 描画フレーム数
+		uint64_t frameCount = 0;
+		// 描画パス数（スプライト・3Dオブジェクト）
+		uint64_t passCount = 0;
+		// 描画コール数
+		uint64_t drawCallCount = 0;
+		// 定数バッファ書き込み回数
+		uint64_t constantBufferWriteCount = 0;
+		// 定数バッファ書き込みバイト数
+		uint64_t constantBufferWriteBytes = 0;
+		// テクスチャ読み込み要求数
+		uint64_t textureLoadCount = 0;
+	};
+
+public: // メンバ関数
+	virtual ~RenderBackend() = default;
+
+	/// <summary>
+	/// GPUを使うか
+	/// </summary>
+	virtual bool IsHeadless() const = 0;
+
+	/// <summary>
+	/// 描画開始
+	/// </summary>
+	virtual void BeginFrame() = 0;
+
+	/// <summary>
+	/// 描画終了
+	/// </summary>
+	virtual void EndFrame() = 0;
+
+	/// <summary>
+	/// 深度バッファのクリア
+	/// </summary>
+	virtual void ClearDepthBuffer() = 0;
+
+	/// <summary>
+	/// スプライト描画パス開始
+	/// </summary>
+	virtual void BeginSpritePass() = 0;
+
+	/// <summary>
+	/// 3Dオブジェクト描画パス開始
+	/// </summary>
+	virtual void BeginModelPass() = 0;
+
+	/// <summary>
+	/// 描画パス終了
+	/// </summary>
+	virtual void EndPass() = 0;
+
+	/// <summary>
+	/// モデル描画
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	virtual void DrawModel(
+	    Model* model, const WorldTransform& worldTransform,
+	    const ViewProjection& viewProjection) = 0;
+
+	/// <summary>
+	/// モデル描画（テクスチャ差し替え）
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="worldTransform">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	virtual void DrawModel(
+	    Model* model, const WorldTransform& worldTransform, const ViewProjection& viewProjection,
+	    uint32_t textureHandle) = 0;
+
+	/// <summary>
+	/// モデルのインスタンス描画
+	/// </summary>
+	/// <param name="model">モデル</param>
+	/// <param name="worldTransforms">ワールドトランスフォーム</param>
+	/// <param name="viewProjection">ビュープロジェクション</param>
+	/// <param name="colors">色（空なら白、1つなら共通、それ以外はインスタンスと同数）</param>
+	virtual void DrawModelInstanced(
+	    Model* model, std::span<const WorldTransform* const> worldTransforms,
+	    const ViewProjection& viewProjection, std::span<const Vector4> colors = {}) = 0;
+
+	/// <summary>
+	/// スプライト描画
+	/// </summary>
+	/// <param name="sprite">スプライト</param>
+	virtual void DrawSprite(Sprite* sprite) = 0;
+
+	/// <summary>
+	/// 今フレーム用の定数バッファに書き込む
+	/// </summary>
+	/// <param name="data">書き込むデータ</param>
+	/// <param name="size">バイト数</param>
+	/// <returns>GPU仮想アドレス（確保できなければ 0）</returns>
+	virtual uint64_t WriteConstantBuffer(const void* data, size_t size) = 0;
+
+	/// <summary>
+	/// テクスチャ読み込み
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <returns>テクスチャハンドル</returns>
+	virtual uint32_t LoadTexture(const std::string& fileName) = 0;
+
+	/// <summary>
+	/// 統計の取得
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+	/// <summary>
+	/// 統計のリセット
+	/// </summary>
+	void ResetStatistics() { statistics_ = {}; }
+
+protected: // メンバ変数
+	// 統計
+	Statistics statistics_;
+};
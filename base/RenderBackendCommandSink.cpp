@@ -0,0 +1,66 @@
+#include "RenderBackendCommandSink.h"
+#include <cassert>
+
+void RenderBackendCommandSink::Initialize(RenderBackend* renderBackend) {
+	assert(renderBackend);
+	renderBackend_ = renderBackend;
+	isInPass_ = false;
+	layer_ = kNoLayer;
+}
+
+void RenderBackendCommandSink::BeginLayer(uint32_t layer) {
+	EndPass();
+	// 背景スプライトの深度で3Dオブジェクトが隠れないようにする
+	// （フレームの最初にもクリアされているので、背景が無ければクリアしない）
+	if (layer_ == static_cast<uint32_t>(RenderLayer::kBackground)) {
+		renderBackend_->ClearDepthBuffer();
+	}
+	layer_ = layer;
+}
+
+void RenderBackendCommandSink::SetPipeline(uint32_t pipeline) {
+	EndPass();
+	switch (static_cast<RenderCommand::Type>(pipeline)) {
+	case RenderCommand::Type::kSprite:
+		renderBackend_->BeginSpritePass();
+		break;
+	case RenderCommand::Type::kModel:
+		renderBackend_->BeginModelPass();
+		break;
+	default:
+		assert(false);
+		break;
+	}
+	isInPass_ = true;
+}
+
+void RenderBackendCommandSink::Draw(const RenderCommand& command) {
+	assert(isInPass_);
+	switch (command.type) {
+	case RenderCommand::Type::kSprite:
+		renderBackend_->DrawSprite(command.sprite);
+		break;
+	case RenderCommand::Type::kModel:
+		if (command.textureHandle == RenderCommand::kTextureNone) {
+			renderBackend_->DrawModel(
+			    command.model, *command.worldTransform, *command.viewProjection);
+		} else {
+			renderBackend_->DrawModel(
+			    command.model, *command.worldTransform, *command.viewProjection,
+			    command.textureHandle);
+		}
+		break;
+	}
+}
+
+void RenderBackendCommandSink::End() {
+	EndPass();
+	layer_ = kNoLayer;
+}
+
+void RenderBackendCommandSink::EndPass() {
+	if (isInPass_) {
+		renderBackend_->EndPass();
+		isInPass_ = false;
+	}
+}
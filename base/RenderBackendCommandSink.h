@@ -0,0 +1,46 @@
+#pragma once
+
+#include "RenderBackend.h"
+#include "RenderQueue.h"
+
+/// <summary>
+/// 描画キューの出力を描画バックエンドに流す
+/// パイプラインの切り替えを描画パスの切り替えにする。マテリアルとテクスチャは
+/// Model::Draw / Sprite::Draw が自分で設定するので、ここでは設定しない
+/// 深度バッファは従来の GameScene::Draw と同じく背景スプライトの後だけクリアする
+/// </summary>
+class RenderBackendCommandSink : public RenderCommandSink {
+public: // 定数
+	// レイヤーを始めていないとき
+	static constexpr uint32_t kNoLayer = UINT32_MAX;
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="renderBackend">描画バックエンド（借りてくる）</param>
+	void Initialize(RenderBackend* renderBackend);
+
+	void BeginLayer(uint32_t layer) override;
+	void SetPipeline(uint32_t pipeline) override;
+	void SetMaterial(uint32_t) override {}
+	void SetTexture(uint32_t) override {}
+	void Draw(const RenderCommand& command) override;
+	void End() override;
+	bool BindsMaterial() const override { return false; }
+	bool BindsTexture() const override { return false; }
+
+private: // メンバ関数
+	/// <summary>
+	/// 開いている描画パスを閉じる
+	/// </summary>
+	void EndPass();
+
+private: // メンバ変数
+	// 描画バックエンド
+	RenderBackend* renderBackend_ = nullptr;
+	// 描画パス中か
+	bool isInPass_ = false;
+	// 描画中のレイヤー
+	uint32_t layer_ = kNoLayer;
+};
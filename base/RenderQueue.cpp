@@ -0,0 +1,189 @@
+#include "RenderQueue.h"
+#include "MathUtility.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// 基数ソートの1桁のビット数
+constexpr uint32_t kRadixBits = 8;
+constexpr size_t kRadixSize = size_t(1) << kRadixBits;
+constexpr uint32_t kRadixPassCount = 64 / kRadixBits;
+
+// 前回と違うときだけ設定する。設定したら true
+bool Change(uint32_t& current, uint32_t next) {
+	if (current == next) {
+		return false;
+	}
+	current = next;
+	return true;
+}
+
+} // namespace
+
+uint64_t RenderQueue::MakeSortKey(
+    uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t texture, float depth) {
+	constexpr uint32_t kDepthMax = (1u << kDepthBits) - 1;
+	auto field = [](uint32_t value, uint32_t shift, uint32_t bits) {
+		return (uint64_t(value) & ((uint64_t(1) << bits) - 1)) << shift;
+	};
+	uint32_t quantizedDepth =
+	    static_cast<uint32_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(kDepthMax));
+	return field(layer, kLayerShift, kLayerBits) | field(pipeline, kPipelineShift, kPipelineBits) |
+	       field(material, kMaterialShift, kMaterialBits) |
+	       field(texture, kTextureShift, kTextureBits) |
+	       field(quantizedDepth, kDepthShift, kDepthBits);
+}
+
+void RenderQueue::Submit(uint64_t key, const RenderCommand& command) {
+	entries_.push_back(Entry{key, static_cast<uint32_t>(commands_.size())});
+	commands_.push_back(command);
+}
+
+void RenderQueue::SubmitModel(
+    RenderLayer layer, Model* model, const WorldTransform& worldTransform,
+    const ViewProjection& viewProjection, uint32_t textureHandle) {
+	assert(model);
+	// ワールド行列の平行移動成分をビュー座標に移した奥行きで並べる
+	Vector3 position{
+	    worldTransform.matWorld_.m[3][0], worldTransform.matWorld_.m[3][1],
+	    worldTransform.matWorld_.m[3][2]};
+	float viewZ = TransformPoint(position, viewProjection.matView).z;
+	float depth = (viewZ - viewProjection.nearZ) / (viewProjection.farZ - viewProjection.nearZ);
+
+	RenderCommand command;
+	command.type = RenderCommand::Type::kModel;
+	command.model = model;
+	command.worldTransform = &worldTransform;
+	command.viewProjection = &viewProjection;
+	command.textureHandle = textureHandle;
+	// テクスチャを差し替えないときはモデルのマテリアルが決めるので 0 にまとめる
+	uint32_t texture = textureHandle == RenderCommand::kTextureNone ? 0 : textureHandle + 1;
+	Submit(
+	    MakeSortKey(
+	        static_cast<uint32_t>(layer), static_cast<uint32_t>(command.type),
+	        GetMaterialId(model), texture, depth),
+	    command);
+}
+
+void RenderQueue::SubmitSprite(RenderLayer layer, Sprite* sprite) {
+	assert(sprite);
+	RenderCommand command;
+	command.type = RenderCommand::Type::kSprite;
+	command.sprite = sprite;
+	// 下位の欄を空けておけば安定ソートで積んだ順が保たれる
+	Submit(
+	    MakeSortKey(static_cast<uint32_t>(layer), static_cast<uint32_t>(command.type), 0, 0, 0.0f),
+	    command);
+}
+
+void RenderQueue::Flush(RenderCommandSink& sink) {
+	statistics_ = {};
+
+	auto start = std::chrono::steady_clock::now();
+	RadixSort(entries_, scratch_);
+	statistics_.sortMilliseconds =
+	    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+	        .count();
+
+	// 出力先が設定しない状態は、呼んでも何も省けないので比べない
+	const bool bindsMaterial = sink.BindsMaterial();
+	const bool bindsTexture = sink.BindsTexture();
+	constexpr uint32_t kInvalid = UINT32_MAX;
+	uint32_t layer = kInvalid;
+	uint32_t pipeline = kInvalid;
+	uint32_t material = kInvalid;
+	uint32_t texture = kInvalid;
+	for (const Entry& entry : entries_) {
+		if (Change(layer, GetLayer(entry.key))) {
+			sink.BeginLayer(layer);
+			statistics_.layerChangeCount++;
+			// レイヤーの境目では状態を引き継がない
+			pipeline = kInvalid;
+			material = kInvalid;
+			texture = kInvalid;
+		}
+		if (Change(pipeline, GetPipeline(entry.key))) {
+			sink.SetPipeline(pipeline);
+			statistics_.pipelineBindCount++;
+		} else {
+			statistics_.skippedBindCount++;
+		}
+		if (bindsMaterial) {
+			if (Change(material, GetMaterial(entry.key))) {
+				sink.SetMaterial(material);
+				statistics_.materialBindCount++;
+			} else {
+				statistics_.skippedBindCount++;
+			}
+		}
+		if (bindsTexture) {
+			if (Change(texture, GetTexture(entry.key))) {
+				sink.SetTexture(texture);
+				statistics_.textureBindCount++;
+			} else {
+				statistics_.skippedBindCount++;
+			}
+		}
+		sink.Draw(commands_[entry.index]);
+		statistics_.drawCount++;
+	}
+	sink.End();
+
+	// 容量は残して次のフレームで使い回す
+	entries_.clear();
+	commands_.clear();
+	materialIds_.clear();
+}
+
+void RenderQueue::RadixSort(std::vector<Entry>& entries, std::vector<Entry>& scratch) {
+	const size_t count = entries.size();
+	if (count <= 1) {
+		return;
+	}
+	scratch.resize(count);
+
+	// 全桁のヒストグラムを1回の走査で作る
+	std::vector<uint32_t> histograms(kRadixPassCount * kRadixSize, 0);
+	for (const Entry& entry : entries) {
+		for (uint32_t pass = 0; pass < kRadixPassCount; pass++) {
+			size_t digit = (entry.key >> (pass * kRadixBits)) & (kRadixSize - 1);
+			histograms[pass * kRadixSize + digit]++;
+		}
+	}
+
+	Entry* src = entries.data();
+	Entry* dst = scratch.data();
+	for (uint32_t pass = 0; pass < kRadixPassCount; pass++) {
+		uint32_t* histogram = &histograms[pass * kRadixSize];
+		// 全要素がこの桁で同じ値なら並びは変わらない
+		size_t firstDigit = (src[0].key >> (pass * kRadixBits)) & (kRadixSize - 1);
+		if (histogram[firstDigit] == count) {
+			continue;
+		}
+		// 各値の書き込み開始位置
+		uint32_t offset = 0;
+		for (size_t digit = 0; digit < kRadixSize; digit++) {
+			uint32_t digitCount = histogram[digit];
+			histogram[digit] = offset;
+			offset += digitCount;
+		}
+		for (size_t i = 0; i < count; i++) {
+			size_t digit = (src[i].key >> (pass * kRadixBits)) & (kRadixSize - 1);
+			dst[histogram[digit]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+	if (src != entries.data()) {
+		std::memcpy(entries.data(), src, sizeof(Entry) * count);
+	}
+}
+
+uint32_t RenderQueue::GetMaterialId(const Model* model) {
+	return materialIds_.try_emplace(model, static_cast<uint32_t>(materialIds_.size()))
+	    .first->second;
+}
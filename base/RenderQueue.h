@@ -0,0 +1,239 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class Model;
+class Sprite;
+struct ViewProjection;
+struct WorldTransform;
+
+/// <summary>
+/// 描画レイヤー（小さいほど先に描く）
+/// </summary>
+enum class RenderLayer : uint32_t {
+	kBackground, // 背景スプライト
+	kWorld,      // 3Dオブジェクト
+	kForeground, // 前景スプライト
+};
+
+/// <summary>
+/// 描画コマンド（描画キューに積む1回分の描画）
+/// </summary>
+struct RenderCommand {
+	/// <summary>
+	/// 種類（そのままパイプライン番号として使う）
+	/// </summary>
+	enum class Type : uint32_t {
+		kSprite, // スプライト
+		kModel,  // モデル
+	};
+
+	// テクスチャを差し替えないときのテクスチャハンドル
+	static constexpr uint32_t kTextureNone = UINT32_MAX;
+
+	Type type = Type::kModel;
+	// モデル（kModel のとき）
+	Model* model = nullptr;
+	// スプライト（kSprite のとき）
+	Sprite* sprite = nullptr;
+	// ワールドトランスフォーム（kModel のとき）
+	const WorldTransform* worldTransform = nullptr;
+	// ビュープロジェクション（kModel のとき）
+	const ViewProjection* viewProjection = nullptr;
+	// 差し替えるテクスチャハンドル
+	uint32_t textureHandle = kTextureNone;
+};
+
+/// <summary>
+/// 描画キューの出力先
+/// 状態が変わったときだけ Set 系が呼ばれる。テストでは呼ばれた順を記録するだけの実装にできる
+/// </summary>
+class RenderCommandSink {
+public:
+	virtual ~RenderCommandSink() = default;
+
+	/// <summary>
+	/// レイヤー開始（レイヤーが変わると以降の状態はすべて設定し直す）
+	/// </summary>
+	virtual void BeginLayer(uint32_t layer) = 0;
+
+	/// <summary>
+	/// パイプラインの設定
+	/// </summary>
+	virtual void SetPipeline(uint32_t pipeline) = 0;
+
+	/// <summary>
+	/// マテリアルの設定
+	/// </summary>
+	virtual void SetMaterial(uint32_t material) = 0;
+
+	/// <summary>
+	/// テクスチャの設定
+	/// </summary>
+	virtual void SetTexture(uint32_t texture) = 0;
+
+	/// <summary>
+	/// 描画
+	/// </summary>
+	virtual void Draw(const RenderCommand& command) = 0;
+
+	/// <summary>
+	/// 全コマンドの出力終了
+	/// </summary>
+	virtual void End() = 0;
+
+	/// <summary>
+	/// マテリアル・テクスチャを SetMaterial / SetTexture で設定するか
+	/// false の出力先には呼ばず、設定数にも省いた数にも数えない
+	/// </summary>
+	virtual bool BindsMaterial() const { return true; }
+	virtual bool BindsTexture() const { return true; }
+};
+
+/// <summary>
+/// 描画キュー
+/// 描画要求を64bitのソートキーと一緒に溜めておき、フレームの最後に基数ソートしてまとめて出力する
+/// キーは上位から レイヤー(4) パイプライン(4) マテリアル(16) テクスチャ(16) 深度(24) bit
+/// </summary>
+class RenderQueue {
+public: // 定数
+	static constexpr uint32_t kLayerBits = 4;
+	static constexpr uint32_t kPipelineBits = 4;
+	static constexpr uint32_t kMaterialBits = 16;
+	static constexpr uint32_t kTextureBits = 16;
+	static constexpr uint32_t kDepthBits = 24;
+
+	static constexpr uint32_t kDepthShift = 0;
+	static constexpr uint32_t kTextureShift = kDepthShift + kDepthBits;
+	static constexpr uint32_t kMaterialShift = kTextureShift + kTextureBits;
+	static constexpr uint32_t kPipelineShift = kMaterialShift + kMaterialBits;
+	static constexpr uint32_t kLayerShift = kPipelineShift + kPipelineBits;
+	static_assert(kLayerShift + kLayerBits == 64);
+
+public: // サブクラス
+	/// <summary>
+	/// 1回の Flush の統計
+	/// </summary>
+	struct Statistics {
+		// 描画数
+		uint32_t drawCount = 0;
+		// レイヤー切り替え数
+		uint32_t layerChangeCount = 0;
+		// パイプライン設定数
+		uint32_t pipelineBindCount = 0;
+		// マテリアル設定数
+		uint32_t materialBindCount = 0;
+		// テクスチャ設定数
+		uint32_t textureBindCount = 0;
+		// 直前と同じだったので省いた設定数（出力先が設定する状態だけ数える）
+		uint32_t skippedBindCount = 0;
+		// ソートにかかった時間（ミリ秒）
+		double sortMilliseconds = 0.0;
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// ソートキーを作る（各値は bit 幅に収まらない分を切り捨てる）
+	/// </summary>
+	/// <param name="layer">レイヤー</param>
+	/// <param name="pipeline">パイプライン番号</param>
+	/// <param name="material">マテリアル番号</param>
+	/// <param name="texture">テクスチャ番号</param>
+	/// <param name="depth">深度 [0, 1]（手前が0。奥から描きたいときは 1 - 深度 を渡す）</param>
+	static uint64_t MakeSortKey(
+	    uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t texture, float depth);
+
+	/// <summary>
+	/// ソートキーの各欄の取り出し
+	/// </summary>
+	static uint32_t GetLayer(uint64_t key) { return Extract(key, kLayerShift, kLayerBits); }
+	static uint32_t GetPipeline(uint64_t key) {
+		return Extract(key, kPipelineShift, kPipelineBits);
+	}
+	static uint32_t GetMaterial(uint64_t key) {
+		return Extract(key, kMaterialShift, kMaterialBits);
+	}
+	static uint32_t GetTexture(uint64_t key) { return Extract(key, kTextureShift, kTextureBits); }
+
+public: // メンバ関数
+	/// <summary>
+	/// 描画要求を積む
+	/// </summary>
+	/// <param name="key">ソートキー</param>
+	/// <param name="command">描画コマンド</param>
+	void Submit(uint64_t key, const RenderCommand& command);
+
+	/// <summary>
+	/// モデル描画を積む（同じモデル同士、手前から奥の順にまとまる）
+	/// </summary>
+	/// <param name="layer">レイヤー</param>
+	/// <param name="model">モデル</param>
+	/// <param name="worldTransform">ワールドトランスフォーム（描画まで生きていること）</param>
+	/// <param name="viewProjection">ビュープロジェクション（描画まで生きていること）</param>
+	/// <param name="textureHandle">差し替えるテクスチャハンドル</param>
+	void SubmitModel(
+	    RenderLayer layer, Model* model, const WorldTransform& worldTransform,
+	    const ViewProjection& viewProjection,
+	    uint32_t textureHandle = RenderCommand::kTextureNone);
+
+	/// <summary>
+	/// スプライト描画を積む（重なり順を崩さないよう、同じレイヤー内では積んだ順に描く）
+	/// </summary>
+	/// <param name="layer">レイヤー</param>
+	/// <param name="sprite">スプライト</param>
+	void SubmitSprite(RenderLayer layer, Sprite* sprite);
+
+	/// <summary>
+	/// ソートして出力し、キューを空にする
+	/// </summary>
+	/// <param name="sink">出力先</param>
+	void Flush(RenderCommandSink& sink);
+
+	/// <summary>
+	/// 積まれている描画数
+	/// </summary>
+	size_t GetCount() const { return entries_.size(); }
+
+	/// <summary>
+	/// 直前の Flush の統計
+	/// </summary>
+	const Statistics& GetStatistics() const { return statistics_; }
+
+private: // サブクラス
+	// ソート対象
+	struct Entry {
+		uint64_t key;
+		uint32_t index; // commands_ の添字
+	};
+
+private: // 静的メンバ関数
+	static uint32_t Extract(uint64_t key, uint32_t shift, uint32_t bits) {
+		return static_cast<uint32_t>((key >> shift) & ((uint64_t(1) << bits) - 1));
+	}
+
+	/// <summary>
+	/// キーの昇順に安定ソート（8bitずつの LSD 基数ソート。全要素で同じ桁は飛ばす）
+	/// </summary>
+	static void RadixSort(std::vector<Entry>& entries, std::vector<Entry>& scratch);
+
+private: // メンバ関数
+	/// <summary>
+	/// モデルをフレーム内で通し番号にする（ソートキーのマテリアル欄に使う）
+	/// </summary>
+	uint32_t GetMaterialId(const Model* model);
+
+private: // メンバ変数
+	// ソートキー
+	std::vector<Entry> entries_;
+	// ソートの作業領域
+	std::vector<Entry> scratch_;
+	// 描画コマンド
+	std::vector<RenderCommand> commands_;
+	// モデルの通し番号
+	std::unordered_map<const Model*, uint32_t> materialIds_;
+	// 統計
+	Statistics statistics_;
+};
@@ -0,0 +1,29 @@
+#include "ShaderCompiler.h"
+#include <Windows.h>
+#include <algorithm>
+#include <cassert>
+#include <d3dcompiler.h>
+#include <string>
+
+#pragma comment(lib, "d3dcompiler.lib")
+
+Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(const wchar_t* filePath, const char* target) {
+	Microsoft::WRL::ComPtr<ID3DBlob> shaderBlob;
+	Microsoft::WRL::ComPtr<ID3DBlob> errorBlob;
+	HRESULT result = D3DCompileFromFile(
+	    filePath, nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, "main", target,
+	    D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION, 0, &shaderBlob, &errorBlob);
+	if (FAILED(result)) {
+		// errorBlobからエラー内容をstring型にコピー
+		std::string errstr;
+		errstr.resize(errorBlob->GetBufferSize());
+		std::copy_n(
+		    static_cast<char*>(errorBlob->GetBufferPointer()), errorBlob->GetBufferSize(),
+		    errstr.begin());
+		errstr += "\n";
+		// エラー内容を出力ウィンドウに表示
+		OutputDebugStringA(errstr.c_str());
+		assert(false);
+	}
+	return shaderBlob;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <d3dcommon.h>
+#include <wrl.h>
+
+/// <summary>
+/// シェーダの読み込みとコンパイル（失敗したらエラー内容を出力ウィンドウに表示して止める）
+/// </summary>
+/// <param name="filePath">シェーダファイルパス</param>
+/// <param name="target">シェーダモデル</param>
+/// <returns>コンパイル結果</returns>
+Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(const wchar_t* filePath, const char* target);
@@ -0,0 +1,247 @@
+#include "TextureCache.h"
+#include "BlockCompressor.h"
+#include "ContentHash.h"
+#include "MappedFile.h"
+#include "MipGenerator.h"
+#include "PngDecoder.h"
+#include <cassert>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+bool TextureCache::ReadSource(const std::string& filePath, bool hashContent, Source* source) {
+	assert(source);
+	*source = {};
+
+	std::error_code error;
+	uint64_t size = std::filesystem::file_size(filePath, error);
+	if (error) {
+		return false;
+	}
+	int64_t time = static_cast<int64_t>(
+	    std::filesystem::last_write_time(filePath, error).time_since_epoch().count());
+	if (error) {
+		return false;
+	}
+	source->stamp = ContentHash::HashValue(size);
+	source->stamp = ContentHash::HashValue(time, source->stamp);
+
+	if (hashContent) {
+		MappedFile file;
+		if (!file.Open(filePath)) {
+			return false;
+		}
+		source->contentHash = ContentHash::Hash(file.GetData(), file.GetSize());
+	}
+	return true;
+}
+
+TextureFormat TextureCache::ChooseFormat(const TextureImage& image, Compression compression) {
+	// ブロック圧縮はレベル0が4の倍数でないと作れない
+	if (compression == Compression::kNone || image.GetWidth() % 4 != 0 ||
+	    image.GetHeight() % 4 != 0) {
+		return TextureFormat::kRGBA8;
+	}
+	switch (compression) {
+	case Compression::kBC1:
+		return TextureFormat::kBC1;
+	case Compression::kBC3:
+		return TextureFormat::kBC3;
+	case Compression::kBC7:
+		return TextureFormat::kBC7;
+	default:
+		break;
+	}
+	// 半透明のピクセルがあればアルファを残す
+	const uint8_t* pixels = image.GetPixels(0);
+	const size_t slicePitch = image.GetSlicePitch(0);
+	for (size_t i = 3; i < slicePitch; i += TextureImage::kBytesPerPixel) {
+		if (pixels[i] != 0xff) {
+			return TextureFormat::kBC7;
+		}
+	}
+	return TextureFormat::kBC1;
+}
+
+bool TextureCache::Cook(
+    const TextureImage& image, TextureFormat format, const std::string& filePath,
+    ThreadPool* threadPool) {
+	assert(!image.mips.empty());
+	const uint32_t mipCount = static_cast<uint32_t>(image.mips.size());
+	if (!IsBlockCompressed(format)) {
+		return DdsFile::Write(
+		    filePath, format, image.GetWidth(), image.GetHeight(), mipCount, image.pixels.data());
+	}
+
+	// レベル順に詰めて圧縮する
+	std::vector<uint8_t> data(
+	    DdsFile::GetDataSize(format, image.GetWidth(), image.GetHeight(), mipCount));
+	size_t offset = 0;
+	for (uint32_t mip = 0; mip < mipCount; mip++) {
+		const TextureImage::MipLevel& level = image.mips[mip];
+		BlockCompressor::CompressLevel(
+		    image.GetPixels(mip), level.width, level.height, format, data.data() + offset,
+		    threadPool);
+		offset += GetLevelSize(format, level.width, level.height);
+	}
+	return DdsFile::Write(
+	    filePath, format, image.GetWidth(), image.GetHeight(), mipCount, data.data());
+}
+
+void TextureCache::Initialize(
+    const std::string& cacheDirectory, Compression compression, ThreadPool* threadPool) {
+	assert(!cacheDirectory.empty());
+	std::lock_guard<std::mutex> lock(mutex_);
+	cacheDirectory_ = cacheDirectory;
+	compression_ = compression;
+	threadPool_ = threadPool;
+	ReadManifest();
+}
+
+bool TextureCache::Open(const std::string& name, const std::string& sourcePath, DdsFile* dds) {
+	assert(dds && IsEnabled());
+	Source current;
+	if (!ReadSource(sourcePath, false, &current)) {
+		return false;
+	}
+
+	Entry entry;
+	bool found = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = entries_.find(name);
+		if (it != entries_.end()) {
+			entry = it->second;
+			found = true;
+		}
+	}
+
+	if (found) {
+		// 大きさと更新時刻が同じなら中身は読まない
+		bool upToDate = current.stamp == entry.source.stamp;
+		if (!upToDate && ReadSource(sourcePath, true, &current) &&
+		    current.contentHash == entry.source.contentHash) {
+			// 更新時刻だけ変わったので目録を書き換える
+			std::lock_guard<std::mutex> lock(mutex_);
+			entries_[name].source = current;
+			WriteManifest();
+			upToDate = true;
+		}
+		if (upToDate && dds->Open(GetCachePath(name)) && dds->GetFormat() == entry.format) {
+			return true;
+		}
+		dds->Close();
+	}
+
+	return Rebuild(name, sourcePath, current) && dds->Open(GetCachePath(name));
+}
+
+std::string TextureCache::GetCachePath(const std::string& name) const {
+	// 名前にディレクトリや使えない文字が入っていてもよいようにハッシュをファイル名にする
+	char fileName[32];
+	std::snprintf(
+	    fileName, sizeof(fileName), "%016" PRIx64 ".dds",
+	    ContentHash::Hash(name.data(), name.size()));
+	return cacheDirectory_ + fileName;
+}
+
+void TextureCache::ReadManifest() {
+	entries_.clear();
+	std::ifstream file(cacheDirectory_ + kManifestFileName);
+	if (!file) {
+		return;
+	}
+	std::string line;
+	uint32_t version = 0;
+	int compression = 0;
+	if (!std::getline(file, line) ||
+	    std::sscanf(line.c_str(), "texturecache %u %d", &version, &compression) != 2 ||
+	    version != kVersion || compression != static_cast<int>(compression_)) {
+		return;
+	}
+
+	while (std::getline(file, line)) {
+		std::istringstream stream(line);
+		std::string key;
+		stream >> key;
+		if (key != "texture") {
+			continue;
+		}
+		Entry entry;
+		uint32_t format = 0;
+		stream >> std::hex >> entry.source.stamp >> entry.source.contentHash >> std::dec >>
+		    format;
+		if (!stream) {
+			continue;
+		}
+		entry.format = static_cast<TextureFormat>(format);
+		std::string name;
+		stream >> std::ws;
+		std::getline(stream, name);
+		if (!name.empty()) {
+			entries_[name] = entry;
+		}
+	}
+}
+
+bool TextureCache::WriteManifest() const {
+	// 書きかけのファイルを読まれないよう、別名で書いてから置き換える
+	const std::string filePath = cacheDirectory_ + kManifestFileName;
+	const std::string temporaryPath = filePath + ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+		file << "texturecache " << kVersion << " " << static_cast<int>(compression_) << "\n";
+		// 名前に空白があってもよいように行末に書く
+		for (const auto& [name, entry] : entries_) {
+			file << "texture " << std::hex << entry.source.stamp << " "
+			     << entry.source.contentHash << std::dec << " "
+			     << static_cast<uint32_t>(entry.format) << " " << name << "\n";
+		}
+		if (!file) {
+			return false;
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, filePath, error);
+	return !error;
+}
+
+bool TextureCache::Rebuild(const std::string& name, const std::string& sourcePath, Source source) {
+	MappedFile file;
+	if (!file.Open(sourcePath) || !PngDecoder::IsPng(file.GetData(), file.GetSize())) {
+		return false;
+	}
+	source.contentHash = ContentHash::Hash(file.GetData(), file.GetSize());
+
+	TextureImage image;
+	if (!PngDecoder::Decode(file.GetData(), file.GetSize(), &image)) {
+		return false;
+	}
+	file.Close();
+	MipGenerator::Generate(&image, MipGenerator::Filter::kBox, threadPool_);
+
+	// 書きかけの DDS を開かれないよう、別名で書いてから置き換える
+	std::error_code error;
+	std::filesystem::create_directories(cacheDirectory_, error);
+	const TextureFormat format = ChooseFormat(image, compression_);
+	const std::string cachePath = GetCachePath(name);
+	const std::string temporaryPath = cachePath + ".tmp";
+	if (!Cook(image, format, temporaryPath, threadPool_)) {
+		return false;
+	}
+	std::filesystem::rename(temporaryPath, cachePath, error);
+	if (error) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	entries_[name] = Entry{source, format};
+	WriteManifest();
+	return true;
+}
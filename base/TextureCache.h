@@ -0,0 +1,142 @@
+#pragma once
+
+#include "DdsFile.h"
+#include "TextureFormat.h"
+#include "TextureImage.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class ThreadPool;
+
+/// <summary>
+/// GPU へそのまま渡せるテクスチャのキャッシュ
+/// 元画像を展開・ミップマップ生成・ブロック圧縮して DDS に保存し、
+/// 次からは目録（元画像の大きさ・更新時刻・中身のハッシュ）で変わっていないことを確かめて
+/// DDS をメモリマップするだけにする。ワーカーからも呼べる（D3D には触らない）
+/// </summary>
+class TextureCache {
+public: // 定数
+	// 形式のバージョン（圧縮やミップマップの作り方を変えたら上げる）
+	static constexpr uint32_t kVersion = 2;
+	// 目録のファイル名
+	static constexpr const char* kManifestFileName = "texturecache.manifest";
+
+public: // サブクラス
+	/// <summary>
+	/// 圧縮形式の選び方
+	/// </summary>
+	enum class Compression {
+		kAuto, // 不透明なら BC1、アルファがあれば BC7
+		kBC1,
+		kBC3,
+		kBC7,
+		kNone, // 圧縮しない（RGBA8 のまま）
+	};
+
+	/// <summary>
+	/// 元ファイルの識別情報
+	/// </summary>
+	struct Source {
+		// 大きさと更新時刻から作るハッシュ（変化していなければ中身も変わっていないとみなす）
+		uint64_t stamp = 0;
+		// 中身のハッシュ
+		uint64_t contentHash = 0;
+	};
+
+public: // 静的メンバ関数
+	/// <summary>
+	/// 元ファイルの識別情報を取得
+	/// </summary>
+	/// <param name="filePath">元ファイルのパス</param>
+	/// <param name="hashContent">中身のハッシュも計算するか</param>
+	/// <param name="source">出力先</param>
+	/// <returns>成否（ファイルが無ければ false）</returns>
+	static bool ReadSource(const std::string& filePath, bool hashContent, Source* source);
+
+	/// <summary>
+	/// 圧縮形式を選ぶ（レベル0の幅・高さが4の倍数でなければ圧縮しない）
+	/// </summary>
+	/// <param name="image">画像</param>
+	/// <param name="compression">選び方</param>
+	static TextureFormat ChooseFormat(const TextureImage& image, Compression compression);
+
+	/// <summary>
+	/// ミップマップ付きの画像を圧縮して DDS に書き出す
+	/// </summary>
+	/// <param name="image">画像（ミップマップ付き）</param>
+	/// <param name="format">形式</param>
+	/// <param name="filePath">書き出し先</param>
+	/// <param name="threadPool">圧縮に使うスレッドプール（nullptr なら呼び出し元だけ）</param>
+	/// <returns>成否</returns>
+	static bool Cook(
+	    const TextureImage& image, TextureFormat format, const std::string& filePath,
+	    ThreadPool* threadPool = nullptr);
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化（目録を読み込む）
+	/// </summary>
+	/// <param name="cacheDirectory">キャッシュを置くディレクトリ（末尾は '/'）</param>
+	/// <param name="compression">圧縮形式の選び方</param>
+	/// <param name="threadPool">圧縮に使うスレッドプール</param>
+	void Initialize(
+	    const std::string& cacheDirectory, Compression compression = Compression::kAuto,
+	    ThreadPool* threadPool = nullptr);
+
+	/// <summary>
+	/// キャッシュを開く（無いか古ければ元画像から作り直す）
+	/// </summary>
+	/// <param name="name">名前（キャッシュの見出し）</param>
+	/// <param name="sourcePath">元画像のパス</param>
+	/// <param name="dds">出力先</param>
+	/// <returns>成否（元画像が無いか PNG 以外なら false）</returns>
+	bool Open(const std::string& name, const std::string& sourcePath, DdsFile* dds);
+
+	/// <summary>
+	/// 有効か（Initialize 済みか）
+	/// </summary>
+	bool IsEnabled() const { return !cacheDirectory_.empty(); }
+
+private: // サブクラス
+	/// <summary>
+	/// 目録の1項目
+	/// </summary>
+	struct Entry {
+		Source source;
+		TextureFormat format = TextureFormat::kRGBA8;
+	};
+
+private: // メンバ関数
+	/// <summary>
+	/// 名前に対応する DDS のパス
+	/// </summary>
+	std::string GetCachePath(const std::string& name) const;
+
+	/// <summary>
+	/// 目録の読み込み（バージョンか圧縮の選び方が違えば空にする）
+	/// </summary>
+	void ReadManifest();
+
+	/// <summary>
+	/// 目録の書き出し（mutex_ を持った状態で呼ぶ）
+	/// </summary>
+	bool WriteManifest() const;
+
+	/// <summary>
+	/// 元画像から作り直す
+	/// </summary>
+	bool Rebuild(const std::string& name, const std::string& sourcePath, Source source);
+
+private: // メンバ変数
+	// キャッシュを置くディレクトリ
+	std::string cacheDirectory_;
+	// 圧縮形式の選び方
+	Compression compression_ = Compression::kAuto;
+	// 圧縮に使うスレッドプール
+	ThreadPool* threadPool_ = nullptr;
+	std::mutex mutex_;
+	// 目録（名前 → 項目）
+	std::unordered_map<std::string, Entry> entries_;
+};
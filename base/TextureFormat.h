@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// テクスチャキャッシュで扱うピクセル形式（値は DXGI_FORMAT と同じ）
+/// </summary>
+enum class TextureFormat : uint32_t {
+	kRGBA8 = 28, // DXGI_FORMAT_R8G8B8A8_UNORM
+	kBC1 = 71,   // DXGI_FORMAT_BC1_UNORM（RGB 4bpp、アルファなし）
+	kBC3 = 77,   // DXGI_FORMAT_BC3_UNORM（RGBA 8bpp）
+	kBC7 = 98,   // DXGI_FORMAT_BC7_UNORM（RGBA 8bpp、高画質）
+};
+
+/// <summary>
+/// 4x4 ブロック圧縮か
+/// </summary>
+inline bool IsBlockCompressed(TextureFormat format) { return format != TextureFormat::kRGBA8; }
+
+/// <summary>
+/// 1ブロック（非圧縮なら1ピクセル）のバイト数
+/// </summary>
+inline size_t GetBlockBytes(TextureFormat format) {
+	switch (format) {
+	case TextureFormat::kBC1:
+		return 8;
+	case TextureFormat::kBC3:
+	case TextureFormat::kBC7:
+		return 16;
+	default:
+		return 4;
+	}
+}
+
+/// <summary>
+/// 1行（圧縮ならブロック1行）のバイト数
+/// </summary>
+inline size_t GetRowPitch(TextureFormat format, uint32_t width) {
+	if (!IsBlockCompressed(format)) {
+		return size_t(width) * 4;
+	}
+	return std::max<size_t>(1, (size_t(width) + 3) / 4) * GetBlockBytes(format);
+}
+
+/// <summary>
+/// 行（圧縮ならブロック行）の数
+/// </summary>
+inline uint32_t GetRowCount(TextureFormat format, uint32_t height) {
+	if (!IsBlockCompressed(format)) {
+		return height;
+	}
+	return std::max<uint32_t>(1, (height + 3) / 4);
+}
+
+/// <summary>
+/// 1レベル分のバイト数
+/// </summary>
+inline size_t GetLevelSize(TextureFormat format, uint32_t width, uint32_t height) {
+	return GetRowPitch(format, width) * GetRowCount(format, height);
+}
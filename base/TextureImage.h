@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// CPU 側のテクスチャ画像（RGBA8、ミップマップ付き）
+/// 各レベルの行は詰めて並べる（行ピッチ = 幅 × 4）
+/// </summary>
+struct TextureImage {
+	// 1ピクセルのバイト数
+	static constexpr size_t kBytesPerPixel = 4;
+
+	/// <summary>
+	/// ミップマップ1レベル分
+	/// </summary>
+	struct MipLevel {
+		uint32_t width = 0;
+		uint32_t height = 0;
+		// pixels 内の先頭位置
+		size_t offset = 0;
+	};
+
+	// 全レベルのピクセル
+	std::vector<uint8_t> pixels;
+	// レベル（0 が元の大きさ）
+	std::vector<MipLevel> mips;
+
+	/// <summary>
+	/// 1レベルだけの画像として確保する
+	/// </summary>
+	void Allocate(uint32_t width, uint32_t height) {
+		mips.assign(1, MipLevel{width, height, 0});
+		pixels.assign(size_t(width) * height * kBytesPerPixel, 0);
+	}
+
+	uint32_t GetWidth() const { return mips.empty() ? 0 : mips[0].width; }
+	uint32_t GetHeight() const { return mips.empty() ? 0 : mips[0].height; }
+
+	uint8_t* GetPixels(size_t mip) { return pixels.data() + mips[mip].offset; }
+	const uint8_t* GetPixels(size_t mip) const { return pixels.data() + mips[mip].offset; }
+
+	size_t GetRowPitch(size_t mip) const { return mips[mip].width * kBytesPerPixel; }
+	size_t GetSlicePitch(size_t mip) const { return GetRowPitch(mip) * mips[mip].height; }
+};
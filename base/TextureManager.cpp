@@ -1,13 +1,84 @@
 #include "TextureManager.h"
+#include "MipGenerator.h"
+#include "ThreadPool.h"
 #include <DirectXTex.h>
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <filesystem>
 
 using namespace DirectX;
 
+namespace {
+
+// アトラスの画像の間に空ける余白（線形補間と浅いミップのにじみ止め）
+constexpr uint32_t kAtlasPadding = 4;
+
+/// <summary>
+/// ユニコード文字列に変換
+/// </summary>
+std::wstring ConvertString(const std::string& str) {
+	int length = MultiByteToWideChar(CP_ACP, 0, str.c_str(), -1, nullptr, 0);
+	std::wstring wstr(size_t(std::max(length, 1)), L'\0');
+	MultiByteToWideChar(CP_ACP, 0, str.c_str(), -1, wstr.data(), length);
+	wstr.resize(wcslen(wstr.c_str()));
+	return wstr;
+}
+
+/// <summary>
+/// 画像の縁のピクセルを余白へ引き伸ばす（隣の画像や透明な余白を拾わないように）
+/// </summary>
+void ExtrudeEdges(const Image& page, const AtlasRect& rect, uint32_t extent) {
+	const size_t pixelSize = sizeof(uint32_t);
+	const uint32_t left = rect.x - extent;
+	const uint32_t right = rect.x + rect.width;
+	// 左右
+	for (uint32_t y = rect.y; y < rect.y + rect.height; y++) {
+		uint8_t* row = page.pixels + page.rowPitch * y;
+		for (uint32_t i = 0; i < extent; i++) {
+			std::memcpy(row + (left + i) * pixelSize, row + rect.x * pixelSize, pixelSize);
+			std::memcpy(row + (right + i) * pixelSize, row + (right - 1) * pixelSize, pixelSize);
+		}
+	}
+	// 上下（左右に伸ばした分も含めて行ごと写す）
+	const size_t rowBytes = (rect.width + extent * 2) * pixelSize;
+	const uint8_t* top = page.pixels + page.rowPitch * rect.y + left * pixelSize;
+	const uint8_t* bottom =
+	    page.pixels + page.rowPitch * (rect.y + rect.height - 1) + left * pixelSize;
+	for (uint32_t i = 1; i <= extent; i++) {
+		std::memcpy(page.pixels + page.rowPitch * (rect.y - i) + left * pixelSize, top, rowBytes);
+		std::memcpy(
+		    page.pixels + page.rowPitch * (rect.y + rect.height - 1 + i) + left * pixelSize,
+		    bottom, rowBytes);
+	}
+}
+
+} // namespace
+
 uint32_t TextureManager::Load(const std::string& fileName) {
 	return TextureManager::GetInstance()->LoadInternal(fileName);
 }
 
+uint32_t TextureManager::LoadAsync(const std::string& fileName) {
+	return TextureManager::GetInstance()->LoadAsyncInternal(fileName);
+}
+
+bool TextureManager::LoadAtlas(
+    const std::string& atlasName, const std::vector<std::string>& fileNames, uint32_t pageSize) {
+	return TextureManager::GetInstance()->LoadAtlasInternal(atlasName, fileNames, pageSize);
+}
+
+bool TextureManager::GetAtlasRect(const std::string& fileName, AtlasRect* rect) {
+	assert(rect);
+	TextureManager* instance = TextureManager::GetInstance();
+	auto it = instance->atlasEntries_.find(fileName);
+	if (it == instance->atlasEntries_.end()) {
+		return false;
+	}
+	*rect = it->second.rect;
+	return true;
+}
+
 bool TextureManager::Unload(uint32_t textureHandle) {
 	return TextureManager::GetInstance()->UnloadInternal(textureHandle);
 }
@@ -27,35 +98,59 @@ void TextureManager::Initialize(ID3D12Device* device, std::string directoryPath)
 	sDescriptorHandleIncrementSize_ =
 	    device_->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
+	// PNG は圧縮済みの DDS にしておき、次からはそれを転送する
+	textureCache_.Initialize(
+	    directoryPath_ + kCacheDirectoryName, TextureCache::Compression::kAuto,
+	    ThreadPool::GetInstance());
+
+	// 読み込みはスレッドプールで行う
+	asyncLoader_.Initialize(ThreadPool::GetInstance(), &textureCache_);
+
 	// 全テクスチャリセット
 	ResetAll();
 }
 
 void TextureManager::ResetAll() {
-	HRESULT result = S_FALSE;
+	// 読み込み中のものは終わるのを待って捨てる
+	asyncLoader_.Clear();
+
+	// 全テクスチャとデスクリプタヒープを解放
+	textures_.clear();
+	descriptorHeaps_.clear();
+	atlasEntries_.clear();
+	placeholderHandle_ = TextureRegistry::kInvalidHandle;
+	residency_.Reset();
+	registry_.Reset(
+	    static_cast<uint32_t>(kNumDescriptors), static_cast<uint32_t>(kNumReservedDescriptors));
+	GrowDescriptorHeaps();
+}
 
-	// デスクリプタヒープを生成
-	D3D12_DESCRIPTOR_HEAP_DESC descHeapDesc = {};
-	descHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	descHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE; // シェーダから見えるように
-	descHeapDesc.NumDescriptors = kNumDescriptors; // シェーダーリソースビュー1つ
-	result = device_->CreateDescriptorHeap(&descHeapDesc, IID_PPV_ARGS(&descriptorHeap_)); // 生成
-	assert(SUCCEEDED(result));
+void TextureManager::GrowDescriptorHeaps() {
+	HRESULT result = S_FALSE;
 
-	// 全テクスチャを初期化
-	for (size_t i = 0; i < kNumDescriptors; i++) {
-		textures_[i].resource.Reset();
-		textures_[i].cpuDescHandleSRV.ptr = 0;
-		textures_[i].gpuDescHandleSRV.ptr = 0;
-		textures_[i].name.clear();
+	while (descriptorHeaps_.size() < registry_.GetPageCount()) {
+		// デスクリプタヒープを生成
+		D3D12_DESCRIPTOR_HEAP_DESC descHeapDesc = {};
+		descHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+		descHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE; // シェーダから見えるように
+		descHeapDesc.NumDescriptors = kNumDescriptors;
+		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptorHeap;
+		result = device_->CreateDescriptorHeap(&descHeapDesc, IID_PPV_ARGS(&descriptorHeap));
+		assert(SUCCEEDED(result));
+		descriptorHeaps_.push_back(descriptorHeap);
 	}
-	useTable_.Reset();
+	textures_.resize(registry_.GetCapacity());
 }
 
 const D3D12_RESOURCE_DESC TextureManager::GetResoureDesc(uint32_t textureHandle) {
 
 	assert(textureHandle < textures_.size());
+	EnsureResident(textureHandle);
 	Texture& texture = textures_.at(textureHandle);
+	// 読み直しの間は仮のテクスチャを指しているので、覚えておいた設定を返す
+	if (texture.desc.Width != 0) {
+		return texture.desc;
+	}
 	return texture.resource->GetDesc();
 }
 
@@ -63,7 +158,8 @@ void TextureManager::SetGraphicsRootDescriptorTable(
     ID3D12GraphicsCommandList* commandList, UINT rootParamIndex,
     uint32_t textureHandle) { // デスクリプタヒープの配列
 	assert(textureHandle < textures_.size());
-	ID3D12DescriptorHeap* ppHeaps[] = {descriptorHeap_.Get()};
+	EnsureResident(textureHandle);
+	ID3D12DescriptorHeap* ppHeaps[] = {descriptorHeaps_[textureHandle / kNumDescriptors].Get()};
 	commandList->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
 
 	// シェーダリソースビューをセット
@@ -71,53 +167,189 @@ void TextureManager::SetGraphicsRootDescriptorTable(
 	    rootParamIndex, textures_[textureHandle].gpuDescHandleSRV);
 }
 
+std::string TextureManager::GetFullPath(const std::string& fileName) const {
+	bool currentRelative = false;
+	if (2 < fileName.size()) {
+		currentRelative = (fileName[0] == '.') && (fileName[1] == '/');
+	}
+	return currentRelative ? fileName : directoryPath_ + fileName;
+}
+
 uint32_t TextureManager::LoadInternal(const std::string& fileName) {
 
+	// アトラスに詰めた画像はページを返す
+	auto atlas = atlasEntries_.find(fileName);
+	if (atlas != atlasEntries_.end()) {
+		registry_.AddRef(atlas->second.textureHandle);
+		return atlas->second.textureHandle;
+	}
+
 	// 読み込み済みテクスチャを検索
-	auto it = std::find_if(textures_.begin(), textures_.end(), [&](const auto& texture) {
-		return texture.name == fileName;
-	});
-	if (it != textures_.end()) {
-		// 読み込み済みテクスチャの要素番号を取得
-		return static_cast<uint32_t>(std::distance(textures_.begin(), it));
+	uint32_t handle = registry_.Find(fileName);
+	if (handle != TextureRegistry::kInvalidHandle) {
+		registry_.AddRef(handle);
+		return handle;
 	}
 
-	// 書き込むテクスチャの参照
-	uint32_t handle = uint32_t(useTable_.FindFirst());
-	assert(handle < kNumDescriptors);
+	// 書き込むテクスチャの参照（空きが無ければヒープを増やす）
+	handle = registry_.Allocate(fileName);
+	GrowDescriptorHeaps();
+	textures_[handle].name = fileName;
 
-	Texture& texture = textures_.at(handle);
-	texture.name = fileName;
+	LoadTexture(handle);
 
-	// ディレクトリパスとファイル名を連結してフルパスを得る
-	bool currentRelative = false;
-	if (2 < fileName.size()) {
-		currentRelative = (fileName[0] == '.') && (fileName[1] == '/');
+	return handle;
+}
+
+uint32_t TextureManager::LoadAsyncInternal(const std::string& fileName) {
+
+	// アトラスと読み込み済み（読み込み中を含む）は同期版と同じ
+	if (atlasEntries_.contains(fileName) ||
+	    registry_.Find(fileName) != TextureRegistry::kInvalidHandle) {
+		return LoadInternal(fileName);
+	}
+
+	uint32_t handle = registry_.Allocate(fileName);
+	GrowDescriptorHeaps();
+	textures_[handle].name = fileName;
+
+	RequestLoadAsync(handle);
+	return handle;
+}
+
+void TextureManager::RequestLoadAsync(uint32_t handle) {
+	// 仮のテクスチャ（textures_ が伸びることがあるので参照を取る前に読む）
+	if (placeholderHandle_ == TextureRegistry::kInvalidHandle) {
+		placeholderHandle_ = LoadInternal(kPlaceholderFileName);
 	}
-	std::string fullPath = currentRelative ? fileName : directoryPath_ + fileName;
 
+	// 読み込みが終わるまでは仮のテクスチャを指しておく
+	Texture& texture = textures_[handle];
+	texture.resource = textures_[placeholderHandle_].resource;
+	texture.isLoading = true;
+	CreateShaderResourceView(handle);
+
+	asyncLoader_.Request(handle, texture.name, GetFullPath(texture.name));
+}
+
+void TextureManager::LoadTexture(uint32_t handle) {
+	const std::string fileName = textures_[handle].name;
+
+	// キャッシュの DDS があれば展開せずに転送する（PNG 以外は WIC で読む）
+	DdsFile dds;
+	if (textureCache_.Open(fileName, GetFullPath(fileName), &dds)) {
+		CreateTextureFromDds(handle, dds);
+	} else {
+		LoadWicTexture(handle, fileName);
+	}
+}
+
+void TextureManager::EnsureResident(uint32_t handle) {
+	// 描画の記録中に展開と転送をすると止まるので、読み直しはワーカーに任せて
+	// 終わるまでは仮のテクスチャで描く
+	if (textures_[handle].isEvicted && !textures_[handle].isLoading) {
+		RequestLoadAsync(handle);
+	}
+	residency_.Touch(handle, frame_);
+}
+
+void TextureManager::EvictTextures() {
+	std::vector<uint32_t> evicted;
+	residency_.CollectEvictions(frame_, &evicted);
+	for (uint32_t handle : evicted) {
+		// デスクリプタはそのまま残す（使う前に EnsureResident で作り直す）
+		Texture& texture = textures_[handle];
+		texture.resource.Reset();
+		texture.isEvicted = true;
+	}
+}
+
+void TextureManager::LoadWicTexture(uint32_t handle, const std::string& fileName) {
 	// ユニコード文字列に変換
-	wchar_t wfilePath[256];
-	MultiByteToWideChar(CP_ACP, 0, fullPath.c_str(), -1, wfilePath, _countof(wfilePath));
+	std::wstring wfilePath = ConvertString(GetFullPath(fileName));
 
 	HRESULT result;
 
-	TexMetadata metadata{};
 	ScratchImage scratchImg{};
 
 	// WICテクスチャのロード
-	result = LoadFromWICFile(wfilePath, WIC_FLAGS_NONE, &metadata, scratchImg);
+	result = LoadFromWICFile(wfilePath.c_str(), WIC_FLAGS_NONE, nullptr, scratchImg);
 	assert(SUCCEEDED(result));
 
-	ScratchImage mipChain{};
-	// ミップマップ生成
-	result = GenerateMipMaps(
-	    scratchImg.GetImages(), scratchImg.GetImageCount(), scratchImg.GetMetadata(),
-	    TEX_FILTER_DEFAULT, 0, mipChain);
-	if (SUCCEEDED(result)) {
-		scratchImg = std::move(mipChain);
-		metadata = scratchImg.GetMetadata();
+	// ミップマップは線形空間で作るので RGBA8 にそろえる
+	if (scratchImg.GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+		ScratchImage converted{};
+		result = Convert(
+		    *scratchImg.GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, TEX_FILTER_DEFAULT,
+		    TEX_THRESHOLD_DEFAULT, converted);
+		assert(SUCCEEDED(result));
+		scratchImg = std::move(converted);
+	}
+
+	// 行を詰めて写し、ミップマップ生成
+	const Image& source = *scratchImg.GetImage(0, 0, 0);
+	TextureImage image;
+	image.Allocate(static_cast<uint32_t>(source.width), static_cast<uint32_t>(source.height));
+	for (size_t y = 0; y < source.height; y++) {
+		std::memcpy(
+		    image.GetPixels(0) + image.GetRowPitch(0) * y, source.pixels + source.rowPitch * y,
+		    image.GetRowPitch(0));
 	}
+	MipGenerator::Generate(&image, MipGenerator::Filter::kBox, ThreadPool::GetInstance());
+
+	CreateTextureFromImage(handle, image);
+}
+
+void TextureManager::CreateTextureFromImage(uint32_t handle, const TextureImage& image) {
+	TexMetadata metadata{};
+	metadata.width = image.GetWidth();
+	metadata.height = image.GetHeight();
+	metadata.depth = 1;
+	metadata.arraySize = 1;
+	metadata.mipLevels = image.mips.size();
+	metadata.format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	metadata.dimension = TEX_DIMENSION_TEXTURE2D;
+	std::vector<Image> images(image.mips.size());
+	for (size_t mip = 0; mip < image.mips.size(); mip++) {
+		images[mip].width = image.mips[mip].width;
+		images[mip].height = image.mips[mip].height;
+		images[mip].format = metadata.format;
+		images[mip].rowPitch = image.GetRowPitch(mip);
+		images[mip].slicePitch = image.GetSlicePitch(mip);
+		images[mip].pixels = const_cast<uint8_t*>(image.GetPixels(mip));
+	}
+	CreateTexture(handle, metadata, images.data());
+}
+
+void TextureManager::CreateTextureFromDds(uint32_t handle, const DdsFile& dds) {
+	TexMetadata metadata{};
+	metadata.width = dds.GetWidth();
+	metadata.height = dds.GetHeight();
+	metadata.depth = 1;
+	metadata.arraySize = 1;
+	metadata.mipLevels = dds.GetMipCount();
+	// TextureFormat の値は DXGI_FORMAT と同じ
+	metadata.format = static_cast<DXGI_FORMAT>(dds.GetFormat());
+	metadata.dimension = TEX_DIMENSION_TEXTURE2D;
+
+	// マップしたファイルを直接指す
+	std::vector<Image> images(metadata.mipLevels);
+	for (uint32_t mip = 0; mip < dds.GetMipCount(); mip++) {
+		DdsFile::Level level = dds.GetLevel(mip);
+		images[mip].width = level.width;
+		images[mip].height = level.height;
+		images[mip].format = metadata.format;
+		images[mip].rowPitch = level.rowPitch;
+		images[mip].slicePitch = level.size;
+		images[mip].pixels = const_cast<uint8_t*>(level.data);
+	}
+	CreateTexture(handle, metadata, images.data());
+}
+
+void TextureManager::CreateTexture(
+    uint32_t handle, TexMetadata metadata, const DirectX::Image* images) {
+	HRESULT result;
+	Texture& texture = textures_.at(handle);
 
 	// 読み込んだディフューズテクスチャをSRGBとして扱う
 	metadata.format = MakeSRGB(metadata.format);
@@ -140,7 +372,7 @@ uint32_t TextureManager::LoadInternal(const std::string& fileName) {
 
 	// テクスチャバッファにデータ転送
 	for (size_t i = 0; i < metadata.mipLevels; i++) {
-		const Image* img = scratchImg.GetImage(i, 0, 0); // 生データ抽出
+		const Image* img = &images[i]; // 生データ抽出
 		result = texture.resource->WriteToSubresource(
 		    (UINT)i,
 		    nullptr,              // 全領域へコピー
@@ -151,12 +383,29 @@ uint32_t TextureManager::LoadInternal(const std::string& fileName) {
 		assert(SUCCEEDED(result));
 	}
 
+	texture.desc = texture.resource->GetDesc();
+	CreateShaderResourceView(handle);
+
+	// 使用量を記録する（仮のテクスチャは読み込み中のものと共有するので追い出さない）
+	texture.isEvicted = false;
+	if (texture.name != kPlaceholderFileName) {
+		D3D12_RESOURCE_ALLOCATION_INFO allocationInfo =
+		    device_->GetResourceAllocationInfo(0, 1, &texresDesc);
+		residency_.SetResident(handle, allocationInfo.SizeInBytes, frame_);
+	}
+}
+
+void TextureManager::CreateShaderResourceView(uint32_t handle) {
+	Texture& texture = textures_.at(handle);
+
 	// シェーダリソースビュー作成
+	ID3D12DescriptorHeap* descriptorHeap = descriptorHeaps_[handle / kNumDescriptors].Get();
+	INT descriptorIndex = static_cast<INT>(handle % kNumDescriptors);
 	texture.cpuDescHandleSRV = CD3DX12_CPU_DESCRIPTOR_HANDLE(
-	    descriptorHeap_->GetCPUDescriptorHandleForHeapStart(), handle,
+	    descriptorHeap->GetCPUDescriptorHandleForHeapStart(), descriptorIndex,
 	    sDescriptorHandleIncrementSize_);
 	texture.gpuDescHandleSRV = CD3DX12_GPU_DESCRIPTOR_HANDLE(
-	    descriptorHeap_->GetGPUDescriptorHandleForHeapStart(), handle,
+	    descriptorHeap->GetGPUDescriptorHandleForHeapStart(), descriptorIndex,
 	    sDescriptorHandleIncrementSize_);
 
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{}; // 設定構造体
@@ -165,77 +414,225 @@ uint32_t TextureManager::LoadInternal(const std::string& fileName) {
 	srvDesc.Format = resDesc.Format;
 	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D; // 2Dテクスチャ
-	srvDesc.Texture2D.MipLevels = (UINT)metadata.mipLevels;
+	srvDesc.Texture2D.MipLevels = resDesc.MipLevels;
 
 	device_->CreateShaderResourceView(
 	    texture.resource.Get(), //ビューと関連付けるバッファ
 	    &srvDesc,               //テクスチャ設定情報
 	    texture.cpuDescHandleSRV);
+}
+
+void TextureManager::SetMemoryBudget(size_t budgetBytes, uint32_t evictAfterFrames) {
+	// 前のフレームまでに使ったものだけを解放する（描画中のリソースは解放しない）
+	assert(1 <= evictAfterFrames);
+	residency_.SetBudget(budgetBytes, evictAfterFrames);
+}
 
-	useTable_.Set(handle);
+void TextureManager::Update() {
+	frame_++;
 
-	return handle;
+	std::vector<AsyncTextureLoader::Result> results;
+	asyncLoader_.TakeCompleted(kUploadBytesPerFrame, &results);
+
+	for (AsyncTextureLoader::Result& loaded : results) {
+		// 読み込み中に解放された（番号が別の画像に使われた）ものは捨てる
+		if (registry_.Find(loaded.name) != loaded.handle ||
+		    !textures_[loaded.handle].isLoading) {
+			continue;
+		}
+		textures_[loaded.handle].isLoading = false;
+
+		// キャッシュの DDS はそのまま転送する
+		if (loaded.dds.IsOpen()) {
+			CreateTextureFromDds(loaded.handle, loaded.dds);
+			continue;
+		}
+
+		// PNG 以外や展開できなかったものはここで WIC で読む
+		if (!loaded.decoded) {
+			LoadWicTexture(loaded.handle, loaded.name);
+			continue;
+		}
+
+		// 展開済みの画像をそのまま転送する（前のフレームの描画は終わっているので差し替えてよい）
+		CreateTextureFromImage(loaded.handle, loaded.image);
+	}
+
+	// 予算を越えていれば古いものから解放する
+	EvictTextures();
 }
 
-bool TextureManager::UnloadInternal(uint32_t textureHandle) {
-	// 範囲外
-	if (textures_.size() <= textureHandle) {
+bool TextureManager::IsLoading(uint32_t textureHandle) const {
+	return textureHandle < textures_.size() && textures_[textureHandle].isLoading;
+}
+
+bool TextureManager::LoadAtlasInternal(
+    const std::string& atlasName, const std::vector<std::string>& fileNames, uint32_t pageSize) {
+	AtlasTable table;
+	if (!ReadAtlasCache(atlasName, fileNames, &table)) {
+		if (!BuildAtlas(atlasName, fileNames, pageSize, &table)) {
+			return false;
+		}
+	}
+
+	// ページを普通のテクスチャとして読み込み、画像名からページと矩形を引けるようにする
+	std::vector<uint32_t> pageHandles;
+	for (const std::string& pageFile : table.pageFiles) {
+		pageHandles.push_back(LoadInternal(pageFile));
+	}
+	for (const AtlasTable::Entry& entry : table.entries) {
+		atlasEntries_[entry.name] = AtlasEntry{pageHandles[entry.page], entry.rect};
+	}
+	return true;
+}
+
+bool TextureManager::ReadAtlasCache(
+    const std::string& atlasName, const std::vector<std::string>& fileNames,
+    AtlasTable* table) const {
+	namespace fs = std::filesystem;
+	std::error_code error;
+
+	const std::string tablePath = GetFullPath(atlasName + ".atlas");
+	if (!ReadAtlasTable(tablePath, table)) {
 		return false;
 	}
 
-	auto& texture = textures_[textureHandle];
-	// 範囲内だけど読んでない場所
-	assert(!texture.name.empty());
+	// 同じ画像の組か
+	if (table->entries.size() != fileNames.size()) {
+		return false;
+	}
+	std::vector<std::string> names;
+	for (const AtlasTable::Entry& entry : table->entries) {
+		names.push_back(entry.name);
+	}
+	std::vector<std::string> sortedFileNames = fileNames;
+	std::sort(names.begin(), names.end());
+	std::sort(sortedFileNames.begin(), sortedFileNames.end());
+	if (names != sortedFileNames) {
+		return false;
+	}
 
-	// テクスチャ設定を解除
-	texture.resource.Reset();
-	texture.cpuDescHandleSRV.ptr = 0;
-	texture.gpuDescHandleSRV.ptr = 0;
-	texture.name.clear();
-	useTable_.Reset(textureHandle);
+	// どの元画像より新しく、ページが揃っているか
+	const fs::file_time_type tableTime = fs::last_write_time(tablePath, error);
+	if (error) {
+		return false;
+	}
+	for (const std::string& fileName : fileNames) {
+		fs::file_time_type sourceTime = fs::last_write_time(GetFullPath(fileName), error);
+		if (error || tableTime < sourceTime) {
+			return false;
+		}
+	}
+	for (const std::string& pageFile : table->pageFiles) {
+		if (!fs::exists(GetFullPath(pageFile), error)) {
+			return false;
+		}
+	}
 	return true;
 }
 
-template<size_t kNumberOfBits> TextureManager::Bitset<kNumberOfBits>::Bitset() { Reset(); }
+bool TextureManager::BuildAtlas(
+    const std::string& atlasName, const std::vector<std::string>& fileNames, uint32_t pageSize,
+    AtlasTable* table) const {
+	HRESULT result;
 
-template<size_t kNumberOfBits> size_t TextureManager::Bitset<kNumberOfBits>::FindFirst() const {
-	for (size_t wordIndex = 0; wordIndex < kCountOfWord; ++wordIndex) {
-		int firstZero = std::countr_one(words_[wordIndex]);
-		if (firstZero != kBitsPerWord) {
-			return wordIndex * kBitsPerWord + firstZero;
+	// 元画像を RGBA8 で読み込む
+	std::vector<ScratchImage> sources(fileNames.size());
+	std::vector<AtlasRect> sizes(fileNames.size());
+	for (size_t i = 0; i < fileNames.size(); i++) {
+		std::wstring wfilePath = ConvertString(GetFullPath(fileNames[i]));
+		result = LoadFromWICFile(wfilePath.c_str(), WIC_FLAGS_NONE, nullptr, sources[i]);
+		if (FAILED(result)) {
+			return false;
+		}
+		if (sources[i].GetMetadata().format != DXGI_FORMAT_R8G8B8A8_UNORM) {
+			ScratchImage converted;
+			result = Convert(
+			    *sources[i].GetImage(0, 0, 0), DXGI_FORMAT_R8G8B8A8_UNORM, TEX_FILTER_DEFAULT,
+			    TEX_THRESHOLD_DEFAULT, converted);
+			if (FAILED(result)) {
+				return false;
+			}
+			sources[i] = std::move(converted);
 		}
+		sizes[i].width = static_cast<uint32_t>(sources[i].GetMetadata().width);
+		sizes[i].height = static_cast<uint32_t>(sources[i].GetMetadata().height);
 	}
 
-	return kCountOfWord * kBitsPerWord;
-}
+	AtlasLayout layout;
+	if (!PackAtlas(sizes, pageSize, kAtlasPadding, &layout)) {
+		return false;
+	}
 
-template<size_t kNumberOfBits>
-void TextureManager::Bitset<kNumberOfBits>::Set(size_t bitIndex, bool value) {
-	assert(bitIndex < kNumberOfBits);
-	uint64_t& word = GetWord(bitIndex);
-	if (value) {
-		word |= (uint64_t(1) << (bitIndex & kBitsPerWordMask));
-	} else {
-		word &= ~(uint64_t(1) << (bitIndex & kBitsPerWordMask));
+	// ページに写す（余白の半分まで縁を引き伸ばし、残りは透明のまま）
+	std::vector<ScratchImage> pages(layout.pages.size());
+	for (size_t page = 0; page < pages.size(); page++) {
+		result = pages[page].Initialize2D(
+		    DXGI_FORMAT_R8G8B8A8_UNORM, layout.pages[page].width, layout.pages[page].height, 1, 1);
+		if (FAILED(result)) {
+			return false;
+		}
+		std::memset(pages[page].GetPixels(), 0, pages[page].GetPixelsSize());
+	}
+	for (size_t i = 0; i < fileNames.size(); i++) {
+		const AtlasLayout::Placement& placement = layout.placements[i];
+		const Image& page = *pages[placement.page].GetImage(0, 0, 0);
+		result = CopyRectangle(
+		    *sources[i].GetImage(0, 0, 0), Rect(0, 0, sizes[i].width, sizes[i].height), page,
+		    TEX_FILTER_DEFAULT, placement.rect.x, placement.rect.y);
+		if (FAILED(result)) {
+			return false;
+		}
+		ExtrudeEdges(page, placement.rect, kAtlasPadding / 2);
 	}
-}
 
-template<size_t kNumberOfBits> void TextureManager::Bitset<kNumberOfBits>::Reset() {
-	std::memset(words_, 0, sizeof(words_));
-	std::memset(words_, 0xff, sizeof(words_[0]) * 3);
+	// ページ画像と対応表を保存
+	table->pageFiles.clear();
+	table->entries.clear();
+	for (size_t page = 0; page < pages.size(); page++) {
+		std::string pageFile = atlasName + "_" + std::to_string(page) + ".png";
+		std::wstring wfilePath = ConvertString(GetFullPath(pageFile));
+		result = SaveToWICFile(
+		    *pages[page].GetImage(0, 0, 0), WIC_FLAGS_NONE, GetWICCodec(WIC_CODEC_PNG),
+		    wfilePath.c_str());
+		if (FAILED(result)) {
+			return false;
+		}
+		table->pageFiles.push_back(pageFile);
+	}
+	for (size_t i = 0; i < fileNames.size(); i++) {
+		table->entries.push_back(
+		    AtlasTable::Entry{fileNames[i], layout.placements[i].page, layout.placements[i].rect});
+	}
+	return WriteAtlasTable(GetFullPath(atlasName + ".atlas"), *table);
 }
 
-template<size_t kNumberOfBits> void TextureManager::Bitset<kNumberOfBits>::Reset(size_t bitIndex) {
-	Set(bitIndex, false);
-}
+bool TextureManager::UnloadInternal(uint32_t textureHandle) {
+	// 範囲外か読んでない場所
+	if (!registry_.IsValid(textureHandle)) {
+		return false;
+	}
+	// まだ他で使われている
+	if (0 < registry_.Release(textureHandle)) {
+		return true;
+	}
 
-template<size_t kNumberOfBits>
-bool TextureManager::Bitset<kNumberOfBits>::Test(size_t bitIndex) const {
-	assert(bitIndex < kNumberOfBits);
-	return (GetWord(bitIndex) & (uint64_t(1) << (bitIndex & kBitsPerWordMask))) != 0;
+	// テクスチャ設定を解除
+	auto& texture = textures_[textureHandle];
+	texture.resource.Reset();
+	texture.cpuDescHandleSRV.ptr = 0;
+	texture.gpuDescHandleSRV.ptr = 0;
+	texture.name.clear();
+	texture.desc = {};
+	texture.isLoading = false;
+	texture.isEvicted = false;
+	residency_.Remove(textureHandle);
+	if (textureHandle == placeholderHandle_) {
+		placeholderHandle_ = TextureRegistry::kInvalidHandle;
+	}
+	// このページに詰めた画像も引けなくする
+	std::erase_if(atlasEntries_, [&](const auto& entry) {
+		return entry.second.textureHandle == textureHandle;
+	});
+	return true;
 }
-
-template<size_t kNumberOfBits>
-uint64_t& TextureManager::Bitset<kNumberOfBits>::GetWord(size_t bitIndex) {
-	return words_[bitIndex >> kBitIndexToWordIndex];
-}
\ No newline at end of file
@@ -1,18 +1,38 @@
 #pragma once
 
-#include <array>
+#include "AsyncTextureLoader.h"
+#include "AtlasPacker.h"
+#include "TextureCache.h"
+#include "TextureRegistry.h"
+#include "TextureResidency.h"
 #include <d3dx12.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <wrl.h>
 
+namespace DirectX {
+struct TexMetadata;
+struct Image;
+} // namespace DirectX
+
 /// <summary>
 /// テクスチャマネージャ
 /// </summary>
 class TextureManager {
 public:
-	// デスクリプターの数
+	// デスクリプタヒープ1枚あたりのデスクリプターの数（足りなければヒープを増やす）
 	static const size_t kNumDescriptors = 256;
+	// 先頭の割り当てない番号の数（従来と同じハンドル番号にするため）
+	static const size_t kNumReservedDescriptors = 192;
+	// 非同期読み込みが終わるまで代わりに使うテクスチャ
+	static constexpr const char* kPlaceholderFileName = "white1x1.png";
+	// 圧縮済みテクスチャのキャッシュを置くディレクトリ（ディレクトリパスからの相対）
+	static constexpr const char* kCacheDirectoryName = "texturecache/";
+	// 非同期読み込みの1フレームあたりの転送量の目安（バイト）
+	static const size_t kUploadBytesPerFrame = 32 * 1024 * 1024;
+	// 最後に使われてから追い出せるようになるまでのフレーム数（既定値）
+	static const uint32_t kDefaultEvictAfterFrames = 60;
 
 	/// <summary>
 	/// テクスチャ
@@ -26,17 +46,64 @@ public:
 		CD3DX12_GPU_DESCRIPTOR_HANDLE gpuDescHandleSRV;
 		// 名前
 		std::string name;
+		// 最後に生成したリソースの設定（追い出して読み直す間も本来の大きさを返す）
+		D3D12_RESOURCE_DESC desc{};
+		// 非同期読み込み中（仮のテクスチャを指している）
+		bool isLoading = false;
+		// 予算を越えたので追い出した（次に使われたときに読み直す）
+		bool isEvicted = false;
+	};
+
+	/// <summary>
+	/// アトラスに詰めた画像1枚分
+	/// </summary>
+	struct AtlasEntry {
+		// ページのテクスチャハンドル
+		uint32_t textureHandle = 0;
+		// ページ内の矩形
+		AtlasRect rect;
 	};
 
 	/// <summary>
 	/// 読み込み
+	/// アトラスに詰めた画像はページのテクスチャハンドルを返す
 	/// </summary>
 	/// <param name="fileName">ファイル名</param>
 	/// <returns>テクスチャハンドル</returns>
 	static uint32_t Load(const std::string& fileName);
 
+	/// <summary>
+	/// 非同期読み込み
+	/// すぐにハンドルを返し、読み込みが終わるまでは仮のテクスチャ（白1x1）を指す
+	/// 展開とミップマップ生成はワーカーで行い、転送は後のフレームの Update で行う
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <returns>テクスチャハンドル</returns>
+	static uint32_t LoadAsync(const std::string& fileName);
+
+	/// <summary>
+	/// アトラスの読み込み
+	/// 対応表（atlasName.atlas）が元画像より新しければそれを使い、古いか無ければ作り直して保存する
+	/// </summary>
+	/// <param name="atlasName">アトラス名（拡張子なし）</param>
+	/// <param name="fileNames">詰め込む画像のファイル名</param>
+	/// <param name="pageSize">ページの最大の幅・高さ</param>
+	/// <returns>成否</returns>
+	static bool LoadAtlas(
+	    const std::string& atlasName, const std::vector<std::string>& fileNames,
+	    uint32_t pageSize = 2048);
+
+	/// <summary>
+	/// アトラス内の矩形の取得
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	/// <param name="rect">出力先</param>
+	/// <returns>アトラスに詰めた画像か</returns>
+	static bool GetAtlasRect(const std::string& fileName, AtlasRect* rect);
+
 	/// <summary>
 	/// 読み込み解除
+	/// Load と同じ回数呼ばれたところで解放する
 	/// </summary>
 	/// <param name="textureHandle">テクスチャハンドル</param>
 	static bool Unload(uint32_t textureHandle);
@@ -58,6 +125,32 @@ public:
 	/// </summary>
 	void ResetAll();
 
+	/// <summary>
+	/// 毎フレーム処理（描画の記録を始める前に呼ぶ）
+	/// 非同期読み込みが終わったテクスチャを転送して差し替える
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// テクスチャメモリの予算を設定する
+	/// 越えている間は、しばらく使われていないテクスチャを古い順に解放する
+	/// </summary>
+	/// <param name="budgetBytes">予算（バイト。TextureResidency::kUnlimited なら無制限）</param>
+	/// <param name="evictAfterFrames">最後に使われてから解放できるまでのフレーム数（1以上）</param>
+	void SetMemoryBudget(
+	    size_t budgetBytes, uint32_t evictAfterFrames = kDefaultEvictAfterFrames);
+
+	/// <summary>
+	/// 常駐しているテクスチャのメモリ使用量（バイト）
+	/// </summary>
+	size_t GetResidentBytes() const { return residency_.GetResidentBytes(); }
+
+	/// <summary>
+	/// 非同期読み込み中か
+	/// </summary>
+	/// <param name="textureHandle">テクスチャハンドル</param>
+	bool IsLoading(uint32_t textureHandle) const;
+
 	/// <summary>
 	/// リソース情報取得
 	/// </summary>
@@ -80,41 +173,41 @@ private:
 	TextureManager(const TextureManager&) = delete;
 	TextureManager& operator=(const TextureManager&) = delete;
 
-	// C++のbitsetが内部詳細にアクセスできないのでfindFirst用に自作
-	template<size_t kNumberOfBits> class Bitset {
-
-	public:
-		Bitset();
-		size_t FindFirst() const;
-		void Set(size_t bitIndex, bool value = true);
-		void Reset();
-		void Reset(size_t bitIndex);
-		bool Test(size_t bitIndex) const;
-
-	private:
-		uint64_t& GetWord(size_t bitIndex);
-
-	private:
-		static constexpr size_t kCountOfWord =
-		    (kNumberOfBits == 0 ? 1 : ((kNumberOfBits - 1) / (8 * sizeof(uint64_t)) + 1));
-		static constexpr size_t kBitsPerWord = 8 * sizeof(uint64_t);
-		static constexpr size_t kBitsPerWordMask = kBitsPerWord - 1;
-		static constexpr size_t kBitIndexToWordIndex = 6;
-
-		uint64_t words_[kCountOfWord];
-	};
-
 	// デバイス
 	ID3D12Device* device_;
 	// デスクリプタサイズ
 	UINT sDescriptorHandleIncrementSize_ = 0u;
 	// ディレクトリパス
 	std::string directoryPath_;
-	// デスクリプタヒープ
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptorHeap_;
-	// テクスチャコンテナ
-	std::array<Texture, kNumDescriptors> textures_;
-	Bitset<kNumDescriptors> useTable_;
+	// デスクリプタヒープ（kNumDescriptors 個ずつのページ）
+	std::vector<Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>> descriptorHeaps_;
+	// テクスチャコンテナ（ハンドルで引く）
+	std::vector<Texture> textures_;
+	// 名前の索引、参照カウント、空き番号
+	TextureRegistry registry_;
+	// アトラスに詰めた画像（ファイル名 → ページと矩形）
+	std::unordered_map<std::string, AtlasEntry> atlasEntries_;
+	// 圧縮済みテクスチャのキャッシュ
+	TextureCache textureCache_;
+	// 非同期読み込み
+	AsyncTextureLoader asyncLoader_;
+	// 仮のテクスチャのハンドル
+	uint32_t placeholderHandle_ = TextureRegistry::kInvalidHandle;
+	// 常駐管理（使用量と使われた順）
+	TextureResidency residency_;
+	// フレーム番号（Update で進める）
+	uint64_t frame_ = 0;
+
+	/// <summary>
+	/// ハンドルの総数に合わせてデスクリプタヒープを増やす
+	/// </summary>
+	void GrowDescriptorHeaps();
+
+	/// <summary>
+	/// ディレクトリパスとファイル名を連結してフルパスを得る
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	std::string GetFullPath(const std::string& fileName) const;
 
 	/// <summary>
 	/// 読み込み
@@ -122,6 +215,102 @@ private:
 	/// <param name="fileName">ファイル名</param>
 	uint32_t LoadInternal(const std::string& fileName);
 
+	/// <summary>
+	/// 非同期読み込み
+	/// </summary>
+	/// <param name="fileName">ファイル名</param>
+	uint32_t LoadAsyncInternal(const std::string& fileName);
+
+	/// <summary>
+	/// テクスチャの名前のファイルを読み込んで生成する（キャッシュの DDS か WIC）
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	void LoadTexture(uint32_t handle);
+
+	/// <summary>
+	/// 仮のテクスチャを指して、非同期読み込みを要求する（終わったら Update で差し替える）
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル（名前を設定済みのもの）</param>
+	void RequestLoadAsync(uint32_t handle);
+
+	/// <summary>
+	/// 使う前に呼ぶ（追い出されていれば非同期で読み直し、使われた順を更新する）
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	void EnsureResident(uint32_t handle);
+
+	/// <summary>
+	/// 予算を越えていれば、しばらく使われていないテクスチャを解放する
+	/// </summary>
+	void EvictTextures();
+
+	/// <summary>
+	/// WIC で読み込んでミップマップを作り、テクスチャを生成する（PNG 以外用）
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	/// <param name="fileName">ファイル名</param>
+	void LoadWicTexture(uint32_t handle, const std::string& fileName);
+
+	/// <summary>
+	/// ミップマップ付きの RGBA8 画像からテクスチャを生成する
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	/// <param name="image">画像</param>
+	void CreateTextureFromImage(uint32_t handle, const TextureImage& image);
+
+	/// <summary>
+	/// キャッシュの DDS からテクスチャを生成する（展開せずにそのまま転送する）
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	/// <param name="dds">開いた DDS</param>
+	void CreateTextureFromDds(uint32_t handle, const DdsFile& dds);
+
+	/// <summary>
+	/// テクスチャリソースを生成して画像を転送し、シェーダリソースビューを作る
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	/// <param name="metadata">画像情報</param>
+	/// <param name="images">ミップマップごとの画像</param>
+	void CreateTexture(
+	    uint32_t handle, DirectX::TexMetadata metadata, const DirectX::Image* images);
+
+	/// <summary>
+	/// テクスチャリソースを指すシェーダリソースビューを作る
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	void CreateShaderResourceView(uint32_t handle);
+
+	/// <summary>
+	/// アトラスの読み込み
+	/// </summary>
+	/// <param name="atlasName">アトラス名（拡張子なし）</param>
+	/// <param name="fileNames">詰め込む画像のファイル名</param>
+	/// <param name="pageSize">ページの最大の幅・高さ</param>
+	bool LoadAtlasInternal(
+	    const std::string& atlasName, const std::vector<std::string>& fileNames,
+	    uint32_t pageSize);
+
+	/// <summary>
+	/// 保存済みの対応表が使えるか（同じ画像の組で、どの元画像より新しいか）
+	/// </summary>
+	/// <param name="atlasName">アトラス名（拡張子なし）</param>
+	/// <param name="fileNames">詰め込む画像のファイル名</param>
+	/// <param name="table">読み込んだ対応表の出力先</param>
+	bool ReadAtlasCache(
+	    const std::string& atlasName, const std::vector<std::string>& fileNames,
+	    AtlasTable* table) const;
+
+	/// <summary>
+	/// アトラスのページ画像と対応表を作って保存する
+	/// </summary>
+	/// <param name="atlasName">アトラス名（拡張子なし）</param>
+	/// <param name="fileNames">詰め込む画像のファイル名</param>
+	/// <param name="pageSize">ページの最大の幅・高さ</param>
+	/// <param name="table">作った対応表の出力先</param>
+	bool BuildAtlas(
+	    const std::string& atlasName, const std::vector<std::string>& fileNames,
+	    uint32_t pageSize, AtlasTable* table) const;
+
 	/// <summary>
 	/// 読み込み解除
 	/// </summary>
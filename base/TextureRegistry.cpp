@@ -0,0 +1,71 @@
+#include "TextureRegistry.h"
+#include <cassert>
+
+void TextureRegistry::Reset(uint32_t descriptorsPerPage, uint32_t numReserved) {
+	assert(0 < descriptorsPerPage);
+	descriptorsPerPage_ = descriptorsPerPage;
+	numReserved_ = numReserved;
+	pageCount_ = 0;
+	nameToHandle_.clear();
+	names_.clear();
+	refCounts_.clear();
+	freeList_.clear();
+	AddPage();
+}
+
+uint32_t TextureRegistry::Find(const std::string& name) const {
+	auto it = nameToHandle_.find(name);
+	return it != nameToHandle_.end() ? it->second : kInvalidHandle;
+}
+
+uint32_t TextureRegistry::Allocate(const std::string& name) {
+	assert(nameToHandle_.find(name) == nameToHandle_.end());
+	while (freeList_.empty()) {
+		AddPage();
+	}
+	uint32_t handle = freeList_.back();
+	freeList_.pop_back();
+
+	names_[handle] = name;
+	refCounts_[handle] = 1;
+	nameToHandle_.emplace(name, handle);
+	return handle;
+}
+
+void TextureRegistry::AddRef(uint32_t handle) {
+	assert(IsValid(handle));
+	refCounts_[handle]++;
+}
+
+uint32_t TextureRegistry::Release(uint32_t handle) {
+	assert(IsValid(handle));
+	if (--refCounts_[handle] == 0) {
+		nameToHandle_.erase(names_[handle]);
+		names_[handle].clear();
+		freeList_.push_back(handle);
+	}
+	return refCounts_[handle];
+}
+
+bool TextureRegistry::IsValid(uint32_t handle) const {
+	return handle < refCounts_.size() && 0 < refCounts_[handle];
+}
+
+uint32_t TextureRegistry::GetRefCount(uint32_t handle) const {
+	return handle < refCounts_.size() ? refCounts_[handle] : 0;
+}
+
+void TextureRegistry::AddPage() {
+	uint32_t first = pageCount_ * descriptorsPerPage_;
+	pageCount_++;
+	uint32_t last = pageCount_ * descriptorsPerPage_;
+	names_.resize(last);
+	refCounts_.resize(last, 0);
+
+	// 小さい番号から使われるように逆順に積む
+	for (uint32_t handle = last; first < handle; handle--) {
+		if (numReserved_ <= handle - 1) {
+			freeList_.push_back(handle - 1);
+		}
+	}
+}
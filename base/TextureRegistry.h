@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// <summary>
+/// テクスチャハンドルの管理（名前 → ハンドルの索引、参照カウント、デスクリプタ番号の割り当て）
+/// ハンドルはそのままデスクリプタ番号で、ページ（デスクリプタヒープ1枚）単位で増える
+/// D3D には触らないので、リソースとヒープは呼び出し側が持つ
+/// </summary>
+class TextureRegistry {
+public: // 定数
+	// 無効なハンドル
+	static constexpr uint32_t kInvalidHandle = UINT32_MAX;
+
+public: // メンバ関数
+	/// <summary>
+	/// 全ハンドルを解放して最初のページだけにする
+	/// </summary>
+	/// <param name="descriptorsPerPage">1ページのデスクリプタ数</param>
+	/// <param name="numReserved">先頭の割り当てない番号の数</param>
+	void Reset(uint32_t descriptorsPerPage, uint32_t numReserved);
+
+	/// <summary>
+	/// 名前でハンドルを探す
+	/// </summary>
+	/// <param name="name">名前</param>
+	/// <returns>ハンドル（無ければ kInvalidHandle）</returns>
+	uint32_t Find(const std::string& name) const;
+
+	/// <summary>
+	/// 新しいハンドルを割り当てる（参照カウント1）
+	/// 空きが無ければページを1枚増やす
+	/// </summary>
+	/// <param name="name">名前（登録済みでないこと）</param>
+	/// <returns>ハンドル</returns>
+	uint32_t Allocate(const std::string& name);
+
+	/// <summary>
+	/// 参照カウントを増やす
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	void AddRef(uint32_t handle);
+
+	/// <summary>
+	/// 参照カウントを減らし、0になったらハンドルを空きに戻す
+	/// </summary>
+	/// <param name="handle">ハンドル</param>
+	/// <returns>残りの参照カウント</returns>
+	uint32_t Release(uint32_t handle);
+
+	/// <summary>
+	/// 割り当て中のハンドルか
+	/// </summary>
+	bool IsValid(uint32_t handle) const;
+
+	/// <summary>
+	/// 参照カウントの取得
+	/// </summary>
+	uint32_t GetRefCount(uint32_t handle) const;
+
+	/// <summary>
+	/// ページ数の取得
+	/// </summary>
+	uint32_t GetPageCount() const { return pageCount_; }
+
+	/// <summary>
+	/// 番号の総数（ページ数 × 1ページのデスクリプタ数）
+	/// </summary>
+	uint32_t GetCapacity() const { return static_cast<uint32_t>(refCounts_.size()); }
+
+	/// <summary>
+	/// 割り当て中のハンドル数
+	/// </summary>
+	size_t GetLiveCount() const { return nameToHandle_.size(); }
+
+private: // メンバ関数
+	/// <summary>
+	/// ページを1枚増やし、新しい番号を空きに積む
+	/// </summary>
+	void AddPage();
+
+private: // メンバ変数
+	// 1ページのデスクリプタ数
+	uint32_t descriptorsPerPage_ = 0;
+	// 先頭の割り当てない番号の数
+	uint32_t numReserved_ = 0;
+	// ページ数
+	uint32_t pageCount_ = 0;
+	// 名前 → ハンドル
+	std::unordered_map<std::string, uint32_t> nameToHandle_;
+	// ハンドルごとの名前
+	std::vector<std::string> names_;
+	// ハンドルごとの参照カウント（0 なら空き）
+	std::vector<uint32_t> refCounts_;
+	// 空き番号（末尾から使うので、小さい番号ほど後ろに積む）
+	std::vector<uint32_t> freeList_;
+};
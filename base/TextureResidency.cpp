@@ -0,0 +1,90 @@
+#include "TextureResidency.h"
+#include <cassert>
+
+void TextureResidency::Reset() {
+	entries_.clear();
+	head_ = kNone;
+	tail_ = kNone;
+	residentBytes_ = 0;
+	residentCount_ = 0;
+}
+
+void TextureResidency::SetBudget(size_t budgetBytes, uint32_t evictAfterFrames) {
+	budgetBytes_ = budgetBytes;
+	evictAfterFrames_ = evictAfterFrames;
+}
+
+void TextureResidency::SetResident(uint32_t handle, size_t sizeBytes, uint64_t frame) {
+	if (entries_.size() <= handle) {
+		entries_.resize(size_t(handle) + 1);
+	}
+	Entry& entry = entries_[handle];
+	// 作り直し（非同期読み込みの完了など）なら前の分を引く
+	if (entry.isResident) {
+		residentBytes_ -= entry.sizeBytes;
+		residentCount_--;
+	}
+	entry.sizeBytes = sizeBytes;
+	entry.isResident = true;
+	residentBytes_ += sizeBytes;
+	residentCount_++;
+	MoveToFront(handle, frame);
+}
+
+void TextureResidency::Remove(uint32_t handle) {
+	if (!IsResident(handle)) {
+		return;
+	}
+	Entry& entry = entries_[handle];
+	Unlink(handle);
+	residentBytes_ -= entry.sizeBytes;
+	residentCount_--;
+	entry = Entry{};
+}
+
+size_t TextureResidency::CollectEvictions(uint64_t frame, std::vector<uint32_t>* evicted) {
+	assert(evicted);
+	size_t count = 0;
+	// 古い側から見ていき、猶予内のものに当たったらそれより新しいものも追い出せない
+	while (budgetBytes_ < residentBytes_ && tail_ != kNone &&
+	       entries_[tail_].lastUsedFrame + evictAfterFrames_ <= frame) {
+		uint32_t handle = tail_;
+		Remove(handle);
+		evicted->push_back(handle);
+		count++;
+	}
+	return count;
+}
+
+void TextureResidency::Unlink(uint32_t handle) {
+	Entry& entry = entries_[handle];
+	if (entry.prev != kNone) {
+		entries_[entry.prev].next = entry.next;
+	} else if (head_ == handle) {
+		head_ = entry.next;
+	}
+	if (entry.next != kNone) {
+		entries_[entry.next].prev = entry.prev;
+	} else if (tail_ == handle) {
+		tail_ = entry.prev;
+	}
+	entry.prev = kNone;
+	entry.next = kNone;
+}
+
+void TextureResidency::MoveToFront(uint32_t handle, uint64_t frame) {
+	Entry& entry = entries_[handle];
+	entry.lastUsedFrame = frame;
+	if (!entry.isResident || head_ == handle) {
+		return;
+	}
+	Unlink(handle);
+	entry.next = head_;
+	if (head_ != kNone) {
+		entries_[head_].prev = handle;
+	}
+	head_ = handle;
+	if (tail_ == kNone) {
+		tail_ = handle;
+	}
+}
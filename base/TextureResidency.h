@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// テクスチャの常駐管理（使用量の集計と、予算を越えたときに追い出すものの選択）
+/// 使われた順のリスト（LRU）をハンドルで引ける配列の上に持つ
+/// D3D には触らないので、リソースの解放と読み直しは呼び出し側が行う
+/// </summary>
+class TextureResidency {
+public: // 定数
+	// 予算なし
+	static constexpr size_t kUnlimited = SIZE_MAX;
+
+public: // メンバ関数
+	/// <summary>
+	/// 全テクスチャを外す（予算と猶予フレーム数はそのまま）
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// 予算の設定
+	/// </summary>
+	/// <param name="budgetBytes">常駐させるバイト数の上限</param>
+	/// <param name="evictAfterFrames">最後に使われてから追い出せるまでのフレーム数</param>
+	void SetBudget(size_t budgetBytes, uint32_t evictAfterFrames);
+
+	/// <summary>
+	/// 常駐したことを記録する（使われたものとして扱う）
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	/// <param name="sizeBytes">メモリ使用量</param>
+	/// <param name="frame">現在のフレーム番号</param>
+	void SetResident(uint32_t handle, size_t sizeBytes, uint64_t frame);
+
+	/// <summary>
+	/// 管理から外す（解放したとき）
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	void Remove(uint32_t handle);
+
+	/// <summary>
+	/// 使われたことを記録する（同じフレームの2回目以降は何もしない）
+	/// </summary>
+	/// <param name="handle">テクスチャハンドル</param>
+	/// <param name="frame">現在のフレーム番号</param>
+	void Touch(uint32_t handle, uint64_t frame) {
+		if (handle < entries_.size() && entries_[handle].lastUsedFrame != frame) {
+			MoveToFront(handle, frame);
+		}
+	}
+
+	/// <summary>
+	/// 予算を越えていれば、しばらく使われていないものを古い順に選んで管理から外す
+	/// </summary>
+	/// <param name="frame">現在のフレーム番号</param>
+	/// <param name="evicted">追い出すハンドルの出力先（末尾に足す）</param>
+	/// <returns>追い出す数</returns>
+	size_t CollectEvictions(uint64_t frame, std::vector<uint32_t>* evicted);
+
+	/// <summary>
+	/// 常駐しているか
+	/// </summary>
+	bool IsResident(uint32_t handle) const {
+		return handle < entries_.size() && entries_[handle].isResident;
+	}
+
+	size_t GetBudget() const { return budgetBytes_; }
+	uint32_t GetEvictAfterFrames() const { return evictAfterFrames_; }
+	size_t GetResidentBytes() const { return residentBytes_; }
+	size_t GetResidentCount() const { return residentCount_; }
+	size_t GetSize(uint32_t handle) const {
+		return handle < entries_.size() ? entries_[handle].sizeBytes : 0;
+	}
+
+private: // サブクラス
+	/// <summary>
+	/// 1テクスチャ分
+	/// </summary>
+	struct Entry {
+		size_t sizeBytes = 0;
+		uint64_t lastUsedFrame = 0;
+		// 使われた順のリスト（prev が新しい側）
+		uint32_t prev = kNone;
+		uint32_t next = kNone;
+		bool isResident = false;
+	};
+
+	// リストの端
+	static constexpr uint32_t kNone = UINT32_MAX;
+
+private: // メンバ関数
+	/// <summary>
+	/// リストから外す
+	/// </summary>
+	void Unlink(uint32_t handle);
+
+	/// <summary>
+	/// リストの先頭（最も新しい側）に置く
+	/// </summary>
+	void MoveToFront(uint32_t handle, uint64_t frame);
+
+private: // メンバ変数
+	// 予算
+	size_t budgetBytes_ = kUnlimited;
+	// 追い出せるようになるまでのフレーム数
+	uint32_t evictAfterFrames_ = 0;
+	// ハンドルごとの情報
+	std::vector<Entry> entries_;
+	// リストの先頭（最も新しい）と末尾（最も古い）
+	uint32_t head_ = kNone;
+	uint32_t tail_ = kNone;
+	// 常駐しているバイト数と数
+	size_t residentBytes_ = 0;
+	size_t residentCount_ = 0;
+};
@@ -0,0 +1,110 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+
+ThreadPool* ThreadPool::GetInstance() {
+	static ThreadPool instance;
+	return &instance;
+}
+
+ThreadPool::~ThreadPool() { Finalize(); }
+
+void ThreadPool::Initialize(uint32_t threadCount) {
+	assert(threads_.empty());
+	if (threadCount == 0) {
+		uint32_t coreCount = std::thread::hardware_concurrency();
+		threadCount = coreCount > 1 ? coreCount - 1 : 0;
+	}
+
+	stopping_ = false;
+	threads_.reserve(threadCount);
+	for (uint32_t i = 0; i < threadCount; i++) {
+		threads_.emplace_back(&ThreadPool::WorkerMain, this);
+	}
+}
+
+void ThreadPool::Finalize() {
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		stopping_ = true;
+	}
+	condition_.notify_all();
+	for (std::thread& thread : threads_) {
+		thread.join();
+	}
+	threads_.clear();
+}
+
+void ThreadPool::Submit(std::function<void()> job) {
+	if (threads_.empty()) {
+		job();
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		jobs_.push_back(std::move(job));
+	}
+	condition_.notify_one();
+}
+
+void ThreadPool::ParallelFor(
+    size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& function) {
+	grainSize = std::max<size_t>(grainSize, 1);
+	size_t chunkCount = (count + grainSize - 1) / grainSize;
+	if (threads_.empty() || chunkCount <= 1) {
+		if (count != 0) {
+			function(0, count);
+		}
+		return;
+	}
+
+	// 遅れて動き出したワーカーが触っても大丈夫なように共有する
+	struct State {
+		std::atomic<size_t> next = 0;
+		std::atomic<size_t> done = 0;
+	};
+	auto state = std::make_shared<State>();
+	// 取った範囲が残っているうちは function も生きている
+	auto run = [state, count, grainSize, chunkCount, &function]() {
+		for (;;) {
+			size_t chunk = state->next.fetch_add(1);
+			if (chunk >= chunkCount) {
+				return;
+			}
+			size_t begin = chunk * grainSize;
+			function(begin, std::min(begin + grainSize, count));
+			if (state->done.fetch_add(1) + 1 == chunkCount) {
+				state->done.notify_all();
+			}
+		}
+	};
+
+	size_t helperCount = std::min<size_t>(threads_.size(), chunkCount - 1);
+	for (size_t i = 0; i < helperCount; i++) {
+		Submit(run);
+	}
+	run();
+
+	// 他のスレッドが処理中の範囲を待つ
+	for (size_t done = state->done.load(); done != chunkCount; done = state->done.load()) {
+		state->done.wait(done);
+	}
+}
+
+void ThreadPool::WorkerMain() {
+	for (;;) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			condition_.wait(lock, [this]() { return stopping_ || !jobs_.empty(); });
+			if (jobs_.empty()) {
+				return;
+			}
+			job = std::move(jobs_.front());
+			jobs_.pop_front();
+		}
+		job();
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// ワーカースレッドのプール
+/// 読み込みなどの重い処理を分けて並列に実行する
+/// </summary>
+class ThreadPool {
+public: // 静的メンバ関数
+	/// <summary>
+	/// シングルトンインスタンスの取得
+	/// </summary>
+	static ThreadPool* GetInstance();
+
+public: // メンバ関数
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="threadCount">ワーカー数（0 ならコア数-1）</param>
+	void Initialize(uint32_t threadCount = 0);
+
+	/// <summary>
+	/// 終了（積まれている仕事を終えてからワーカーを止める）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 仕事を積む（ワーカーが無ければその場で実行する）
+	/// </summary>
+	/// <param name="job">仕事</param>
+	void Submit(std::function<void()> job);
+
+	/// <summary>
+	/// 範囲を分けて並列に実行し、すべて終わるまで待つ
+	/// 呼び出したスレッドも処理に加わる
+	/// </summary>
+	/// <param name="count">要素数</param>
+	/// <param name="grainSize">1回に処理する要素数</param>
+	/// <param name="function">[begin, end) を処理する関数</param>
+	void ParallelFor(
+	    size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& function);
+
+	/// <summary>
+	/// ワーカー数
+	/// </summary>
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(threads_.size()); }
+
+private: // メンバ関数
+	ThreadPool() = default;
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	const ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// <summary>
+	/// ワーカーの処理
+	/// </summary>
+	void WorkerMain();
+
+private: // メンバ変数
+	// ワーカー
+	std::vector<std::thread> threads_;
+	// 積まれた仕事
+	std::deque<std::function<void()>> jobs_;
+	std::mutex mutex_;
+	std::condition_variable condition_;
+	// 終了要求
+	bool stopping_ = false;
+};
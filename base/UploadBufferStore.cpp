@@ -0,0 +1,39 @@
+#include "UploadBufferStore.h"
+#include <cassert>
+#include <d3dx12.h>
+
+void UploadBufferStore::Initialize(ID3D12Device* device) {
+	assert(device);
+	device_ = device;
+	buffers_.clear();
+}
+
+bool UploadBufferStore::CreatePage(size_t size, uint8_t** cpuAddress, uint64_t* gpuAddress) {
+	HRESULT result = S_FALSE;
+
+	// ヒーププロパティ
+	CD3DX12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+	// リソース設定
+	CD3DX12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+	// バッファ生成
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+	result = device_->CreateCommittedResource(
+	    &heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ,
+	    nullptr, IID_PPV_ARGS(&buffer));
+	if (FAILED(result)) {
+		return false;
+	}
+	buffer->SetName(L"ConstantBufferAllocator_Page");
+
+	// マッピング（CPUからは読まない）
+	CD3DX12_RANGE readRange(0, 0);
+	result = buffer->Map(0, &readRange, reinterpret_cast<void**>(cpuAddress));
+	if (FAILED(result)) {
+		return false;
+	}
+	*gpuAddress = buffer->GetGPUVirtualAddress();
+
+	buffers_.push_back(buffer);
+	return true;
+}
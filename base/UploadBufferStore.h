@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ConstantBufferAllocator.h"
+#include <d3d12.h>
+#include <vector>
+#include <wrl.h>
+
+/// <summary>
+/// アップロードヒープ上のページ供給元
+/// ページは生成時にマップし、破棄されるまでマップしたままにする
+/// </summary>
+class UploadBufferStore : public ConstantBufferAllocator::BackingStore {
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="device">デバイス</param>
+	void Initialize(ID3D12Device* device);
+
+	bool CreatePage(size_t size, uint8_t** cpuAddress, uint64_t* gpuAddress) override;
+
+private:
+	// デバイス
+	ID3D12Device* device_ = nullptr;
+	// 生成したバッファ
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>> buffers_;
+};
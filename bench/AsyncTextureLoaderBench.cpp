@@ -0,0 +1,130 @@
+#include "AsyncTextureLoader.h"
+#include "Benchmark.h"
+#include "MappedFile.h"
+#include "MipGenerator.h"
+#include "PngDecoder.h"
+#include "ThreadPool.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// テクスチャ読み込みのベンチマーク
+// PNG の展開とミップマップ生成をそれぞれ MPix/s で測り、呼び出し元で1枚ずつ展開する従来の
+// 読み込み（TextureManager::LoadInternal と同じ手順を写したもの）と AsyncTextureLoader を比べる
+// Resources を作業ディレクトリにして実行する
+
+namespace {
+
+// 読み込む画像（大きさの違うものを混ぜる）
+const std::vector<std::string> kFileNames = {
+    "sample.png", "uvChecker.png", "debugfont.png", "tex1.png", "white1x1.png"};
+
+// 1枚を展開してミップマップまで作る（従来の読み込みと同じ）
+bool LoadSync(const std::string& filePath, TextureImage* image) {
+	MappedFile file;
+	if (!file.Open(filePath) || !PngDecoder::Decode(file.GetData(), file.GetSize(), image)) {
+		return false;
+	}
+	MipGenerator::Generate(image, MipGenerator::Filter::kBox);
+	return true;
+}
+
+// 1秒あたりの画素数（百万単位）
+double ToMegaPixelsPerSecond(uint64_t pixelCount, double milliseconds) {
+	return static_cast<double>(pixelCount) / (milliseconds * 1000.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 10;
+	// 同じ画像を何回読み込むか（1回の計測での枚数 = 画像の数 x copies）
+	const uint32_t copies = quick ? 1 : 4;
+
+	// 展開（ファイルはあらかじめ開いておき、展開だけを測る）
+	std::vector<MappedFile> files(kFileNames.size());
+	uint64_t pixelCount = 0;
+	for (size_t i = 0; i < kFileNames.size(); i++) {
+		bench::Check(files[i].Open(kFileNames[i]), "open png");
+		TextureImage image;
+		bench::Check(
+		    PngDecoder::Decode(files[i].GetData(), files[i].GetSize(), &image), "decode png");
+		pixelCount += uint64_t(image.GetWidth()) * image.GetHeight();
+	}
+	std::vector<TextureImage> decoded(kFileNames.size());
+	double decodeTime = bench::Measure(repeat, [&] {
+		for (size_t i = 0; i < files.size(); i++) {
+			PngDecoder::Decode(files[i].GetData(), files[i].GetSize(), &decoded[i]);
+		}
+	});
+
+	// ミップマップ生成（レベル0の画素数あたり）
+	ThreadPool* threadPool = ThreadPool::GetInstance();
+	threadPool->Initialize();
+	std::vector<TextureImage> work = decoded;
+	double boxTime = bench::Measure(repeat, [&] {
+		for (TextureImage& image : work) {
+			MipGenerator::Generate(&image, MipGenerator::Filter::kBox);
+		}
+	});
+	double kaiserTime = bench::Measure(repeat, [&] {
+		for (TextureImage& image : work) {
+			MipGenerator::Generate(&image, MipGenerator::Filter::kKaiser);
+		}
+	});
+	double threadedTime = bench::Measure(repeat, [&] {
+		for (TextureImage& image : work) {
+			MipGenerator::Generate(&image, MipGenerator::Filter::kBox, threadPool);
+		}
+	});
+
+	// 従来の読み込み（呼び出し元で1枚ずつ開いて、展開して、ミップマップを作る）
+	std::vector<TextureImage> syncImages(kFileNames.size() * copies);
+	double syncTime = bench::Measure(repeat, [&] {
+		for (size_t i = 0; i < syncImages.size(); i++) {
+			bench::Check(LoadSync(kFileNames[i % kFileNames.size()], &syncImages[i]), "sync load");
+		}
+	});
+
+	// 非同期の読み込み（全部を要求して、終わるのを待って取り出す）
+	AsyncTextureLoader loader;
+	loader.Initialize(threadPool);
+	std::vector<AsyncTextureLoader::Result> results;
+	double asyncTime = bench::Measure(repeat, [&] {
+		results.clear();
+		for (size_t i = 0; i < syncImages.size(); i++) {
+			const std::string& name = kFileNames[i % kFileNames.size()];
+			loader.Request(static_cast<uint32_t>(i), name, name);
+		}
+		loader.WaitAll();
+		loader.TakeCompleted(SIZE_MAX, &results);
+	});
+
+	// どちらの読み込みも同じ画素になる
+	bench::Check(results.size() == syncImages.size(), "all requests completed");
+	for (const AsyncTextureLoader::Result& result : results) {
+		bench::Check(result.decoded, "async decoded");
+		bench::Check(result.image.pixels == syncImages[result.handle].pixels, "same pixels");
+	}
+	bench::Check(loader.GetInFlightCount() == 0, "nothing left in flight");
+	loader.Clear();
+	const uint32_t workerCount = threadPool->GetThreadCount();
+	threadPool->Finalize();
+
+	std::printf(
+	    "texture loading (%zu images, %.2f MPix, %u workers)\n"
+	    "  png decode        %8.3f ms  %7.1f MPix/s\n"
+	    "  mips box          %8.3f ms  %7.1f MPix/s\n"
+	    "  mips kaiser       %8.3f ms  %7.1f MPix/s\n"
+	    "  mips box threaded %8.3f ms  %7.1f MPix/s\n"
+	    "  load sync         %8.3f ms  (%u copies)\n"
+	    "  load async        %8.3f ms  x%.2f\n",
+	    kFileNames.size(), static_cast<double>(pixelCount) / 1e6,
+	    workerCount, decodeTime, ToMegaPixelsPerSecond(pixelCount, decodeTime),
+	    boxTime, ToMegaPixelsPerSecond(pixelCount, boxTime), kaiserTime,
+	    ToMegaPixelsPerSecond(pixelCount, kaiserTime), threadedTime,
+	    ToMegaPixelsPerSecond(pixelCount, threadedTime), syncTime, copies, asyncTime,
+	    syncTime / asyncTime);
+	return 0;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// ベンチマーク用の小さな道具（計測・結果の出力・最適化よけ）
+// 各ベンチマークは "--quick" を付けると回数を減らして正しさの確認だけを行う（ctest から呼ぶ）
+
+namespace bench {
+
+/// <summary>
+/// コマンドラインに "--quick" があるか
+/// </summary>
+inline bool IsQuick(int argc, char* argv[]) {
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "--quick") == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/// <summary>
+/// プロセスのCPU時間（ミリ秒、全スレッドの合計）
+/// </summary>
+inline double GetProcessCpuMilliseconds() {
+#ifdef _WIN32
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime);
+	// 100ナノ秒単位
+	unsigned long long kernel =
+	    (static_cast<unsigned long long>(kernelTime.dwHighDateTime) << 32) |
+	    kernelTime.dwLowDateTime;
+	unsigned long long user =
+	    (static_cast<unsigned long long>(userTime.dwHighDateTime) << 32) | userTime.dwLowDateTime;
+	return static_cast<double>(kernel + user) / 10000.0;
+#else
+	rusage usage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+	       static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+#endif
+}
+
+/// <summary>
+/// 処理を repeat 回実行し、1回あたりの最短時間（ミリ秒）を返す
+/// </summary>
+template<class Function> double Measure(int repeat, Function&& function) {
+	double best = 1e300;
+	for (int i = 0; i < repeat; i++) {
+		auto start = std::chrono::steady_clock::now();
+		function();
+		std::chrono::duration<double, std::milli> elapsed =
+		    std::chrono::steady_clock::now() - start;
+		if (elapsed.count() < best) {
+			best = elapsed.count();
+		}
+	}
+	return best;
+}
+
+/// <summary>
+/// 計算結果を使ったことにして、最適化で処理ごと消されないようにする
+/// </summary>
+template<class T> inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const T* sink;
+	sink = &value;
+#endif
+}
+
+/// <summary>
+/// 条件を確認し、外れていれば理由を出して終了する
+/// </summary>
+inline void Check(bool condition, const char* message) {
+	if (!condition) {
+		std::fprintf(stderr, "check failed: %s\n", message);
+		std::exit(EXIT_FAILURE);
+	}
+}
+
+} // namespace bench
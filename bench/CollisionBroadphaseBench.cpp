@@ -0,0 +1,93 @@
+#include "Benchmark.h"
+#include "CollisionBroadphase.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 当たり判定の広域判定のベンチマーク
+// 自弾と敵の総当たりと、空間ハッシュ・掃引を、弾の数を変えて比べる
+
+namespace {
+
+// 画面内に弾と敵をばらまく（STG らしく z は平ら）
+void Scatter(
+    CollisionBroadphase* broadphase, std::mt19937* random, uint32_t bulletCount,
+    uint32_t enemyCount, bool withBoss) {
+	std::uniform_real_distribution<float> x(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> y(-35.0f, 35.0f);
+	broadphase->Clear();
+	for (uint32_t i = 0; i < bulletCount; i++) {
+		broadphase->Add(
+		    CollisionBroadphase::Group::kA, i, Sphere{{x(*random), y(*random), 0.0f}, 0.3f});
+	}
+	for (uint32_t i = 0; i < enemyCount; i++) {
+		broadphase->Add(
+		    CollisionBroadphase::Group::kB, i, Sphere{{x(*random), y(*random), 0.0f}, 1.5f});
+	}
+	if (withBoss) {
+		// セルを何百個も跨ぐボス
+		broadphase->Add(
+		    CollisionBroadphase::Group::kB, enemyCount,
+		    AABB{{-20.0f, -15.0f, -10.0f}, {20.0f, 15.0f, 10.0f}});
+	}
+}
+
+// 総当たり
+uint32_t BruteForce(const CollisionBroadphase& broadphase) {
+	uint32_t count = 0;
+	for (const auto& a : broadphase.GetColliders(CollisionBroadphase::Group::kA)) {
+		for (const auto& b : broadphase.GetColliders(CollisionBroadphase::Group::kB)) {
+			count += CollisionBroadphase::TestShapes(a, b) ? 1 : 0;
+		}
+	}
+	return count;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 20;
+	const uint32_t enemyCount = 200;
+
+	std::printf("broadphase (%u enemies)\n", enemyCount);
+	for (bool withBoss : {false, true}) {
+		for (uint32_t bulletCount : quick ? std::vector<uint32_t>{500}
+		                                  : std::vector<uint32_t>{500, 2000, 10000}) {
+			CollisionBroadphase broadphase;
+			broadphase.Initialize();
+			std::mt19937 random(bulletCount);
+			Scatter(&broadphase, &random, bulletCount, enemyCount, withBoss);
+
+			uint32_t expected = 0;
+			double brute = bench::Measure(repeat, [&] {
+				expected = BruteForce(broadphase);
+				bench::DoNotOptimize(expected);
+			});
+
+			double times[2];
+			uint32_t tests[2];
+			int m = 0;
+			for (auto method : {
+			         CollisionBroadphase::Method::kSpatialHash,
+			         CollisionBroadphase::Method::kSweepAndPrune}) {
+				broadphase.SetMethod(method);
+				uint32_t found = 0;
+				times[m] = bench::Measure(repeat, [&] {
+					found = static_cast<uint32_t>(broadphase.FindPairs().size());
+					bench::DoNotOptimize(found);
+				});
+				bench::Check(found == expected, "same pairs as brute force");
+				tests[m] = broadphase.GetStatistics().testCount;
+				m++;
+			}
+
+			std::printf(
+			    "  %5u bullets%s: brute %7.3f ms  hash %7.3f ms (%u tests)  "
+			    "sweep %7.3f ms (%u tests)  %u pairs\n",
+			    bulletCount, withBoss ? " + boss" : "", brute, times[0], tests[0], times[1],
+			    tests[1], expected);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,209 @@
+#include "Benchmark.h"
+#include "FixedTimestep.h"
+#include "FramePacer.h"
+#include "GameScene.h"
+#include "MathUtility.h"
+#include "NullRenderBackend.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// ヘッドレス実行（ウィンドウ・GPUを使わずにゲームシーンの更新と描画要求だけを回す）
+// 使い方: headless [フレーム数] [-pace フレームレート] [-objects 物体数] [-sprites スプライト数]
+//   -pace を付けないときは待たずに回し、1フレームに1ステップ進める
+//   -pace を付けたときは実時間で固定ステップを進め、フレーム時間の分布とCPU使用率を出す
+// GameScene はひな形で何も描かないので、代表的な負荷として回転する物体とスプライトを足す
+// （物体は毎ステップ動かし、描画時に補間係数で前後のステップを補間して描画キューに積む）
+
+namespace {
+
+// デフォルトのフレーム数
+constexpr int kDefaultFrameCount = 10000;
+// デフォルトの物体数
+constexpr int kDefaultObjectCount = 2000;
+// デフォルトのスプライト数（半分を背景、半分を前景に置く）
+constexpr int kDefaultSpriteCount = 200;
+// 物体のモデルの種類数
+constexpr int kModelKindCount = 16;
+
+/// <summary>
+/// 代表的な描画負荷
+/// NullRenderBackend はモデル・スプライトの中身を読まないので、区別できる番地だけを使う
+/// </summary>
+class SyntheticLoad {
+public:
+	void Initialize(int objectCount, int spriteCount) {
+		std::mt19937 random(1);
+		std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+		objects_.resize(objectCount);
+		for (Object& object : objects_) {
+			object.model = static_cast<int>(random() % kModelKindCount);
+			object.worldTransform.translation_ = {
+			    value(random) * 40.0f, value(random) * 20.0f, value(random) * 40.0f};
+			object.angle = object.previousAngle = value(random) * 3.14159265f;
+			object.spin = value(random) * 3.0f;
+		}
+		spriteTags_.resize(spriteCount);
+		// カメラは z = -50 から原点を見る
+		viewProjection_.matView = MakeTranslateMatrix({0.0f, 0.0f, 50.0f});
+	}
+
+	// 1ステップ分動かす
+	void Update(float stepSeconds) {
+		for (Object& object : objects_) {
+			object.previousAngle = object.angle;
+			object.angle += object.spin * stepSeconds;
+		}
+	}
+
+	// 前後のステップを補間した姿勢で描画要求を積む
+	void Submit(RenderQueue& renderQueue, float alpha) {
+		for (size_t i = 0; i < spriteTags_.size(); i += 2) {
+			renderQueue.SubmitSprite(RenderLayer::kBackground, GetSprite(i));
+		}
+		for (Object& object : objects_) {
+			WorldTransform& worldTransform = object.worldTransform;
+			worldTransform.rotation_.y =
+			    object.previousAngle + (object.angle - object.previousAngle) * alpha;
+			worldTransform.matWorld_ = MakeAffineMatrix(
+			    worldTransform.scale_, worldTransform.rotation_, worldTransform.translation_);
+			renderQueue.SubmitModel(
+			    RenderLayer::kWorld, reinterpret_cast<Model*>(&modelTags_[object.model]),
+			    worldTransform, viewProjection_);
+		}
+		for (size_t i = 1; i < spriteTags_.size(); i += 2) {
+			renderQueue.SubmitSprite(RenderLayer::kForeground, GetSprite(i));
+		}
+	}
+
+	size_t GetObjectCount() const { return objects_.size(); }
+	size_t GetSpriteCount() const { return spriteTags_.size(); }
+
+private:
+	struct Object {
+		WorldTransform worldTransform;
+		int model = 0;
+		// 今回と前回のステップの回転角
+		float angle = 0.0f;
+		float previousAngle = 0.0f;
+		// 回転の速さ（ラジアン/秒）
+		float spin = 0.0f;
+	};
+
+	Sprite* GetSprite(size_t index) { return reinterpret_cast<Sprite*>(&spriteTags_[index]); }
+
+	std::vector<Object> objects_;
+	ViewProjection viewProjection_;
+	char modelTags_[kModelKindCount] = {};
+	std::vector<char> spriteTags_;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	int frameCount = kDefaultFrameCount;
+	double paceRate = 0.0;
+	int objectCount = kDefaultObjectCount;
+	int spriteCount = kDefaultSpriteCount;
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "-pace") == 0 && i + 1 < argc) {
+			paceRate = std::atof(argv[++i]);
+		} else if (std::strcmp(argv[i], "-objects") == 0 && i + 1 < argc) {
+			objectCount = std::max(0, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "-sprites") == 0 && i + 1 < argc) {
+			spriteCount = std::max(0, std::atoi(argv[++i]));
+		} else if (std::strcmp(argv[i], "--quick") == 0) {
+			frameCount = 100;
+		} else if (0 < std::atoi(argv[i])) {
+			frameCount = std::atoi(argv[i]);
+		}
+	}
+
+	NullRenderBackend renderBackend;
+	renderBackend.Initialize();
+
+	// フレームレート制御（描画の代わりに待ちの精度とCPU使用率を計測できる）
+	FramePacer framePacer;
+	framePacer.Initialize(paceRate);
+
+	// シミュレーション時間（待たないときは1フレーム1ステップ）
+	FixedTimestep fixedTimestep;
+	fixedTimestep.Initialize();
+	const auto stepDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+	    std::chrono::duration<double>(fixedTimestep.GetStepSeconds()));
+
+	// ゲームシーンの初期化（入力・音声は無し）
+	GameScene* gameScene = new GameScene();
+	gameScene->Initialize(&renderBackend);
+
+	// 代表的な負荷（シーンと同じ出力先の組み立てで、別の描画キューから流す）
+	SyntheticLoad load;
+	load.Initialize(objectCount, spriteCount);
+	RenderQueue loadQueue;
+	RenderBackendCommandSink loadSink;
+	loadSink.Initialize(&renderBackend);
+
+	double startCpuTime = bench::GetProcessCpuMilliseconds();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < frameCount; i++) {
+		uint32_t stepCount =
+		    0.0 < paceRate ? fixedTimestep.Tick() : fixedTimestep.Advance(stepDuration);
+		for (uint32_t step = 0; step < stepCount; step++) {
+			// ゲームシーンの毎ステップ処理
+			gameScene->Update();
+			load.Update(fixedTimestep.GetStepSeconds());
+		}
+		// ゲームシーンの描画
+		const float alpha = fixedTimestep.GetAlpha();
+		gameScene->SetInterpolationAlpha(alpha);
+		renderBackend.BeginFrame();
+		gameScene->Draw();
+		load.Submit(loadQueue, alpha);
+		loadQueue.Flush(loadSink);
+		renderBackend.EndFrame();
+		framePacer.Wait();
+	}
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	double cpuTime = bench::GetProcessCpuMilliseconds() - startCpuTime;
+
+	// 計測結果の出力
+	const RenderBackend::Statistics& statistics = renderBackend.GetStatistics();
+	double frames = static_cast<double>(statistics.frameCount);
+	std::printf(
+	    "headless: %d frames %.3f ms (%.4f ms/frame) steps %llu (dropped %llu) "
+	    "draw %.1f/frame cbuffer %.0f B/frame\n",
+	    frameCount, elapsed.count(), elapsed.count() / frames,
+	    static_cast<unsigned long long>(fixedTimestep.GetStepCount()),
+	    static_cast<unsigned long long>(fixedTimestep.GetDroppedStepCount()),
+	    static_cast<double>(statistics.drawCallCount) / frames,
+	    static_cast<double>(statistics.constantBufferWriteBytes) / frames);
+
+	// 描画コールは毎フレーム、負荷の物体とスプライトの数だけ出る
+	const uint64_t drawsPerFrame = load.GetObjectCount() + load.GetSpriteCount();
+	bench::Check(
+	    statistics.drawCallCount == drawsPerFrame * statistics.frameCount, "draws per frame");
+	bench::Check(
+	    statistics.constantBufferWriteBytes == sizeof(ConstBufferDataWorldTransform) *
+	                                               load.GetObjectCount() * statistics.frameCount,
+	    "world transform bytes");
+
+	const RenderQueue::Statistics& queue = loadQueue.GetStatistics();
+	std::printf(
+	    "render queue (last frame, %zu objects %zu sprites): draw %u bind %u (skipped %u) "
+	    "sort %.3f ms\n",
+	    load.GetObjectCount(), load.GetSpriteCount(), queue.drawCount,
+	    queue.pipelineBindCount + queue.materialBindCount + queue.textureBindCount,
+	    queue.skippedBindCount, queue.sortMilliseconds);
+
+	FramePacer::Statistics pacing = framePacer.GetStatistics();
+	std::printf(
+	    "frame time: p50 %u us p99 %u us max %u us cpu %.1f%%\n", pacing.p50, pacing.p99,
+	    pacing.max, cpuTime / elapsed.count() * 100.0);
+
+	SafeDelete(gameScene);
+	return 0;
+}
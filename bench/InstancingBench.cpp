@@ -0,0 +1,107 @@
+#include "Benchmark.h"
+#include "InstanceData.h"
+#include "MathUtility.h"
+#include "NullRenderBackend.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// インスタンス描画のベンチマーク（ヘッドレス）
+// 1体ごとにワールド行列を定数バッファへ書いて描く従来の描画（WorldTransform::TransferMatrix +
+// Model::Draw と同じ手順）と、DrawModelInstanced でまとめて描く場合を NullRenderBackend で比べる
+// GPUへの発行は行わないので、時間はCPU側の準備だけ。描画コール数の差は統計で見る
+
+namespace {
+
+// 1フレーム分の描画要求を出す
+template<class Function>
+RenderBackend::Statistics DrawFrame(NullRenderBackend* renderBackend, Function&& draw) {
+	renderBackend->ResetStatistics();
+	renderBackend->BeginFrame();
+	renderBackend->BeginModelPass();
+	draw();
+	renderBackend->EndPass();
+	renderBackend->EndFrame();
+	return renderBackend->GetStatistics();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 50;
+	const std::vector<size_t> counts =
+	    quick ? std::vector<size_t>{1000} : std::vector<size_t>{100, 1000, 10000, 50000};
+
+	std::printf("instancing (headless, per frame)\n");
+	for (size_t count : counts) {
+		std::vector<WorldTransform> worldTransforms(count);
+		std::vector<const WorldTransform*> pointers(count);
+		std::vector<Vector4> colors(count);
+		std::mt19937 random(static_cast<uint32_t>(count));
+		std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+		for (size_t i = 0; i < count; i++) {
+			WorldTransform& worldTransform = worldTransforms[i];
+			worldTransform.translation_ = {value(random) * 50.0f, value(random) * 50.0f, 0.0f};
+			worldTransform.rotation_ = {0.0f, 0.0f, value(random)};
+			worldTransform.matWorld_ = MakeAffineMatrix(
+			    worldTransform.scale_, worldTransform.rotation_, worldTransform.translation_);
+			pointers[i] = &worldTransform;
+			colors[i] = {value(random), value(random), value(random), 1.0f};
+		}
+		ViewProjection viewProjection;
+
+		NullRenderBackend renderBackend;
+		renderBackend.Initialize();
+
+		// 従来の描画（1体ごとに定数バッファへ書いて1コール。書き込みは DrawModel が行う）
+		auto drawEach = [&] {
+			for (const WorldTransform& worldTransform : worldTransforms) {
+				renderBackend.DrawModel(nullptr, worldTransform, viewProjection);
+			}
+		};
+		// インスタンス描画
+		auto drawInstanced = [&] {
+			renderBackend.DrawModelInstanced(nullptr, pointers, viewProjection, colors);
+		};
+
+		RenderBackend::Statistics each{};
+		double eachTime =
+		    bench::Measure(repeat, [&] { each = DrawFrame(&renderBackend, drawEach); });
+		RenderBackend::Statistics instanced{};
+		double instancedTime = bench::Measure(
+		    repeat, [&] { instanced = DrawFrame(&renderBackend, drawInstanced); });
+
+		// 描画コールは上限ごとのまとまりの数まで減り、詰めたデータは元の行列と色のまま
+		size_t batchCount = (count + kMaxInstancesPerDraw - 1) / kMaxInstancesPerDraw;
+		bench::Check(each.drawCallCount == count, "one draw per object");
+		bench::Check(
+		    each.constantBufferWriteBytes == sizeof(ConstBufferDataWorldTransform) * count,
+		    "world transform bytes");
+		bench::Check(instanced.drawCallCount == batchCount, "one draw per batch");
+		bench::Check(
+		    instanced.constantBufferWriteBytes == sizeof(InstanceData) * count, "instance bytes");
+		std::vector<InstanceData> packed(count);
+		PackInstances(pointers, colors, packed.data());
+		for (size_t i = 0; i < count; i++) {
+			bench::Check(
+			    std::memcmp(&packed[i].world, &worldTransforms[i].matWorld_, sizeof(Matrix4x4)) ==
+			            0 &&
+			        std::memcmp(&packed[i].color, &colors[i], sizeof(Vector4)) == 0,
+			    "packed instance data");
+		}
+
+		std::printf(
+		    "  %6zu objects: per object %8.3f ms (%6llu draws, %8llu bytes)  "
+		    "instanced %8.3f ms (%llu draws, %8llu bytes)  x%.1f\n",
+		    count, eachTime, static_cast<unsigned long long>(each.drawCallCount),
+		    static_cast<unsigned long long>(each.constantBufferWriteBytes), instancedTime,
+		    static_cast<unsigned long long>(instanced.drawCallCount),
+		    static_cast<unsigned long long>(instanced.constantBufferWriteBytes),
+		    eachTime / instancedTime);
+	}
+	return 0;
+}
@@ -0,0 +1,182 @@
+#include "Benchmark.h"
+#include "MathUtility.h"
+#include "SimdConfig.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 行列・ベクトル演算のベンチマーク
+// MathUtility の実装（SIMD、MATH_NO_SIMD ならスカラー）を、素直なスカラー実装と比べて
+// 結果が一致することを確かめ、速度を比べる
+
+namespace {
+
+#pragma region 比較用のスカラー実装
+Matrix4x4 ReferenceMultiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result{};
+	for (int row = 0; row < 4; row++) {
+		for (int column = 0; column < 4; column++) {
+			float sum = 0.0f;
+			for (int k = 0; k < 4; k++) {
+				sum += m1.m[row][k] * m2.m[k][column];
+			}
+			result.m[row][column] = sum;
+		}
+	}
+	return result;
+}
+
+Matrix4x4 ReferenceInverseAffine(const Matrix4x4& m) {
+	// 左上3x3の逆行列を余因子で求め、平行移動を逆向きにかける
+	float determinant = m.m[0][0] * (m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1]) -
+	                    m.m[0][1] * (m.m[1][0] * m.m[2][2] - m.m[1][2] * m.m[2][0]) +
+	                    m.m[0][2] * (m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0]);
+	float inv = 1.0f / determinant;
+	Matrix4x4 result{};
+	result.m[0][0] = (m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1]) * inv;
+	result.m[0][1] = (m.m[0][2] * m.m[2][1] - m.m[0][1] * m.m[2][2]) * inv;
+	result.m[0][2] = (m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1]) * inv;
+	result.m[1][0] = (m.m[1][2] * m.m[2][0] - m.m[1][0] * m.m[2][2]) * inv;
+	result.m[1][1] = (m.m[0][0] * m.m[2][2] - m.m[0][2] * m.m[2][0]) * inv;
+	result.m[1][2] = (m.m[0][2] * m.m[1][0] - m.m[0][0] * m.m[1][2]) * inv;
+	result.m[2][0] = (m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0]) * inv;
+	result.m[2][1] = (m.m[0][1] * m.m[2][0] - m.m[0][0] * m.m[2][1]) * inv;
+	result.m[2][2] = (m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0]) * inv;
+	for (int column = 0; column < 3; column++) {
+		result.m[3][column] = -(m.m[3][0] * result.m[0][column] + m.m[3][1] * result.m[1][column] +
+		                        m.m[3][2] * result.m[2][column]);
+	}
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+Vector3 ReferenceTransformPoint(const Vector3& p, const Matrix4x4& m) {
+	return {
+	    p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+	    p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+	    p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2]};
+}
+#pragma endregion
+
+// 許容誤差（FMA の有無で丸めが変わる分）
+constexpr float kTolerance = 1e-4f;
+
+bool NearlyEqual(float a, float b) {
+	return std::fabs(a - b) <= kTolerance * std::fmax(1.0f, std::fmax(std::fabs(a), std::fabs(b)));
+}
+
+bool NearlyEqual(const Matrix4x4& a, const Matrix4x4& b) {
+	for (int row = 0; row < 4; row++) {
+		for (int column = 0; column < 4; column++) {
+			if (!NearlyEqual(a.m[row][column], b.m[row][column])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool NearlyEqual(const Vector3& a, const Vector3& b) {
+	return NearlyEqual(a.x, b.x) && NearlyEqual(a.y, b.y) && NearlyEqual(a.z, b.z);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const size_t count = quick ? 1024 : 100000;
+	const int repeat = quick ? 1 : 20;
+
+#if defined(MATH_USE_AVX2)
+	const char* implementation = "AVX2";
+#elif defined(MATH_USE_SSE)
+	const char* implementation = "SSE";
+#else
+	const char* implementation = "scalar";
+#endif
+
+	// ランダムなアフィン変換と座標を用意する
+	std::mt19937 random(12345);
+	std::uniform_real_distribution<float> angle(-3.14159f, 3.14159f);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+	std::vector<Matrix4x4> matrices(count);
+	std::vector<Vector3> points(count);
+	for (size_t i = 0; i < count; i++) {
+		matrices[i] = MakeAffineMatrix(
+		    {scale(random), scale(random), scale(random)},
+		    {angle(random), angle(random), angle(random)},
+		    {position(random), position(random), position(random)});
+		points[i] = {position(random), position(random), position(random)};
+	}
+	const Matrix4x4 view = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.3f, -1.2f, 0.1f}, {5, -3, 20});
+
+	// 結果の一致を確認する
+	std::vector<Matrix4x4> products(count);
+	std::vector<Vector3> transformed(count);
+	MultiplyMatrices(matrices.data(), products.data(), count, view);
+	TransformPoints(points.data(), transformed.data(), count, view);
+	for (size_t i = 0; i < count; i++) {
+		bench::Check(
+		    NearlyEqual(Multiply(matrices[i], view), ReferenceMultiply(matrices[i], view)),
+		    "Multiply");
+		bench::Check(
+		    NearlyEqual(products[i], ReferenceMultiply(matrices[i], view)), "MultiplyMatrices");
+		bench::Check(
+		    NearlyEqual(InverseAffine(matrices[i]), ReferenceInverseAffine(matrices[i])),
+		    "InverseAffine");
+		bench::Check(
+		    NearlyEqual(TransformPoint(points[i], view), ReferenceTransformPoint(points[i], view)),
+		    "TransformPoint");
+		bench::Check(
+		    NearlyEqual(transformed[i], ReferenceTransformPoint(points[i], view)),
+		    "TransformPoints");
+	}
+
+	// 速度の比較
+	double referenceMultiply = bench::Measure(repeat, [&] {
+		for (size_t i = 0; i < count; i++) {
+			products[i] = ReferenceMultiply(matrices[i], view);
+		}
+		bench::DoNotOptimize(products[count - 1]);
+	});
+	double simdMultiply = bench::Measure(repeat, [&] {
+		MultiplyMatrices(matrices.data(), products.data(), count, view);
+		bench::DoNotOptimize(products[count - 1]);
+	});
+	double referenceInverse = bench::Measure(repeat, [&] {
+		for (size_t i = 0; i < count; i++) {
+			products[i] = ReferenceInverseAffine(matrices[i]);
+		}
+		bench::DoNotOptimize(products[count - 1]);
+	});
+	double simdInverse = bench::Measure(repeat, [&] {
+		for (size_t i = 0; i < count; i++) {
+			products[i] = InverseAffine(matrices[i]);
+		}
+		bench::DoNotOptimize(products[count - 1]);
+	});
+	double referenceTransform = bench::Measure(repeat, [&] {
+		for (size_t i = 0; i < count; i++) {
+			transformed[i] = ReferenceTransformPoint(points[i], view);
+		}
+		bench::DoNotOptimize(transformed[count - 1]);
+	});
+	double simdTransform = bench::Measure(repeat, [&] {
+		TransformPoints(points.data(), transformed.data(), count, view);
+		bench::DoNotOptimize(transformed[count - 1]);
+	});
+
+	std::printf("math (%s, %zu elements, best of %d)\n", implementation, count, repeat);
+	std::printf(
+	    "  Multiply        reference %8.3f ms  library %8.3f ms  x%.2f\n", referenceMultiply,
+	    simdMultiply, referenceMultiply / simdMultiply);
+	std::printf(
+	    "  InverseAffine   reference %8.3f ms  library %8.3f ms  x%.2f\n", referenceInverse,
+	    simdInverse, referenceInverse / simdInverse);
+	std::printf(
+	    "  TransformPoints reference %8.3f ms  library %8.3f ms  x%.2f\n", referenceTransform,
+	    simdTransform, referenceTransform / simdTransform);
+	return 0;
+}
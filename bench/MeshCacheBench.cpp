@@ -0,0 +1,117 @@
+#include "Benchmark.h"
+#include "MeshCache.h"
+#include "ObjLoader.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+// メッシュキャッシュのベンチマーク
+// OBJ を解析して読み込む場合と、書き出したキャッシュをメモリマップで開く場合を比べる
+
+namespace {
+
+// 格子状の地形を OBJ で書き出す（四角形の面、v/vt/vn 付き）
+void WriteGrid(const std::string& filePath, int size) {
+	std::ofstream file(filePath);
+	char line[128];
+	for (int z = 0; z <= size; z++) {
+		for (int x = 0; x <= size; x++) {
+			float height = static_cast<float>((x * 7 + z * 13) % 17) * 0.05f;
+			std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", x * 0.1f, height, z * 0.1f);
+			file << line;
+			std::snprintf(
+			    line, sizeof(line), "vt %.6f %.6f\n", static_cast<float>(x) / size,
+			    static_cast<float>(z) / size);
+			file << line;
+		}
+	}
+	file << "vn 0.000000 1.000000 0.000000\n";
+	for (int z = 0; z < size; z++) {
+		for (int x = 0; x < size; x++) {
+			int v = z * (size + 1) + x + 1;
+			int w = v + size + 1;
+			std::snprintf(
+			    line, sizeof(line), "f %d/%d/1 %d/%d/1 %d/%d/1 %d/%d/1\n", v, v, w, w, w + 1,
+			    w + 1, v + 1, v + 1);
+			file << line;
+		}
+	}
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 10;
+	const int gridSize = quick ? 64 : 700;
+
+	std::filesystem::path directory = std::filesystem::temp_directory_path();
+	std::string objPath = (directory / "MeshCacheBench.obj").string();
+	std::string cachePath = (directory / "MeshCacheBench.meshcache").string();
+	WriteGrid(objPath, gridSize);
+
+	// OBJ の解析
+	ModelData model;
+	double parseTime = bench::Measure(repeat, [&] {
+		bench::Check(ObjLoader::Load(objPath, &model), "ObjLoader::Load");
+	});
+
+	// キャッシュの書き出し（元ファイルの識別情報も含める）
+	MeshCache::Source source;
+	double sourceTime = bench::Measure(repeat, [&] {
+		bench::Check(MeshCache::ReadSource({objPath}, true, &source), "ReadSource");
+	});
+	double writeTime = bench::Measure(repeat, [&] {
+		bench::Check(MeshCache::Write(cachePath, model, source, 0), "Write");
+	});
+
+	// キャッシュを開いて中身を参照する（頂点は読み出すまでページインされないので、合計も取る）
+	uint32_t vertexCount = 0;
+	double openTime = bench::Measure(repeat, [&] {
+		MeshCache cache;
+		bench::Check(cache.Open(cachePath), "Open");
+		MeshCache::MeshView view = cache.GetMesh(0);
+		float sum = 0.0f;
+		for (uint32_t i = 0; i < view.vertexCount; i++) {
+			sum += view.vertices[i].pos.y;
+		}
+		vertexCount = view.vertexCount;
+		bench::DoNotOptimize(sum);
+	});
+
+	// 中身が同じか
+	MeshCache cache;
+	bench::Check(cache.Open(cachePath), "Open");
+	bench::Check(cache.GetMeshCount() == model.meshes.size(), "mesh count");
+	MeshCache::MeshView view = cache.GetMesh(0);
+	const MeshData& mesh = model.meshes[0];
+	bench::Check(view.vertexCount == mesh.vertices.size(), "vertex count");
+	bench::Check(
+	    std::memcmp(view.vertices, mesh.vertices.data(), sizeof(MeshVertex) * view.vertexCount) ==
+	        0,
+	    "vertices");
+	bench::Check(view.indexCount == mesh.indices.size(), "index count");
+	for (uint32_t i = 0; i < view.indexCount; i++) {
+		uint32_t index = view.indexSize == 2 ? static_cast<const uint16_t*>(view.indices)[i]
+		                                     : static_cast<const uint32_t*>(view.indices)[i];
+		bench::Check(index == mesh.indices[i], "indices");
+	}
+	bench::Check(cache.GetSource().contentHash == source.contentHash, "source");
+	cache.Close();
+
+	double megabytes =
+	    static_cast<double>(std::filesystem::file_size(cachePath)) / (1024.0 * 1024.0);
+	std::filesystem::remove(objPath);
+	std::filesystem::remove(cachePath);
+
+	std::printf(
+	    "mesh cache (%u vertices, %.1f MB cache)\n"
+	    "  parse OBJ         %8.3f ms\n"
+	    "  hash source       %8.3f ms\n"
+	    "  write cache       %8.3f ms\n"
+	    "  open cache + read %8.3f ms  x%.1f faster than parsing\n",
+	    vertexCount, megabytes, parseTime, sourceTime, writeTime, openTime, parseTime / openTime);
+	return 0;
+}
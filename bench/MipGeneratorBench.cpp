@@ -0,0 +1,199 @@
+#include "Benchmark.h"
+#include "MappedFile.h"
+#include "MipGenerator.h"
+#include "PngDecoder.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// ミップマップ生成のベンチマーク
+// sRGB の値のまま 2x2 を平均する従来の生成（TextureManager::LoadInternal の GenerateMipMaps
+// TEX_FILTER_DEFAULT と同じ手順を写したもの）と、線形に戻して縮める MipGenerator を比べる
+// 速さは MPix/s（レベル0の画素数あたり）、画質は倍精度で線形に平均した基準との PSNR
+// Resources を作業ディレクトリにして実行する
+
+namespace {
+
+double ToLinear(uint8_t value) {
+	double v = value / 255.0;
+	return v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4);
+}
+
+uint8_t ToSrgb(double linear) {
+	double v = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+	return static_cast<uint8_t>(std::clamp(v * 255.0 + 0.5, 0.0, 255.0));
+}
+
+// 従来の生成（sRGB の値のまま 2x2 を平均する）
+void GenerateGammaSpace(TextureImage* image) {
+	image->mips.resize(1);
+	size_t totalSize = image->GetSlicePitch(0);
+	while (image->mips.back().width != 1 || image->mips.back().height != 1) {
+		const TextureImage::MipLevel& last = image->mips.back();
+		TextureImage::MipLevel level{
+		    std::max(last.width / 2, 1u), std::max(last.height / 2, 1u), totalSize};
+		image->mips.push_back(level);
+		totalSize += image->GetSlicePitch(image->mips.size() - 1);
+	}
+	image->pixels.resize(totalSize);
+	for (size_t mip = 1; mip < image->mips.size(); mip++) {
+		const TextureImage::MipLevel& src = image->mips[mip - 1];
+		const TextureImage::MipLevel& dst = image->mips[mip];
+		const uint8_t* in = image->GetPixels(mip - 1);
+		uint8_t* out = image->GetPixels(mip);
+		for (uint32_t y = 0; y < dst.height; y++) {
+			uint32_t y0 = std::min(y * 2, src.height - 1);
+			uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+			for (uint32_t x = 0; x < dst.width; x++) {
+				uint32_t x0 = std::min(x * 2, src.width - 1);
+				uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+				for (uint32_t c = 0; c < 4; c++) {
+					uint32_t sum = in[(y0 * src.width + x0) * 4 + c] +
+					               in[(y0 * src.width + x1) * 4 + c] +
+					               in[(y1 * src.width + x0) * 4 + c] +
+					               in[(y1 * src.width + x1) * 4 + c];
+					out[(y * dst.width + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+				}
+			}
+		}
+	}
+}
+
+// 基準（レベル0の 2^n x 2^n を倍精度の線形で直接平均する。辺が2の累乗の画像だけ）
+TextureImage MakeReference(const TextureImage& source) {
+	TextureImage reference = source;
+	GenerateGammaSpace(&reference);
+	const uint8_t* in = source.GetPixels(0);
+	const uint32_t width = source.GetWidth();
+	for (size_t mip = 1; mip < reference.mips.size(); mip++) {
+		const TextureImage::MipLevel& dst = reference.mips[mip];
+		const uint32_t scaleX = width / dst.width;
+		const uint32_t scaleY = source.GetHeight() / dst.height;
+		uint8_t* out = reference.GetPixels(mip);
+		for (uint32_t y = 0; y < dst.height; y++) {
+			for (uint32_t x = 0; x < dst.width; x++) {
+				double sum[4] = {};
+				for (uint32_t sy = y * scaleY; sy < (y + 1) * scaleY; sy++) {
+					for (uint32_t sx = x * scaleX; sx < (x + 1) * scaleX; sx++) {
+						const uint8_t* pixel = in + (size_t(sy) * width + sx) * 4;
+						for (int c = 0; c < 3; c++) {
+							sum[c] += ToLinear(pixel[c]);
+						}
+						sum[3] += pixel[3] / 255.0;
+					}
+				}
+				const double count = double(scaleX) * scaleY;
+				uint8_t* pixel = out + (size_t(y) * dst.width + x) * 4;
+				for (int c = 0; c < 3; c++) {
+					pixel[c] = ToSrgb(sum[c] / count);
+				}
+				pixel[3] = static_cast<uint8_t>(sum[3] / count * 255.0 + 0.5);
+			}
+		}
+	}
+	return reference;
+}
+
+// レベル1以降の色の PSNR（dB）
+double ComputeMipPsnr(const TextureImage& image, const TextureImage& reference) {
+	double sum = 0.0;
+	size_t count = 0;
+	for (size_t mip = 1; mip < image.mips.size(); mip++) {
+		const uint8_t* a = image.GetPixels(mip);
+		const uint8_t* b = reference.GetPixels(mip);
+		for (size_t i = 0; i < image.GetSlicePitch(mip); i++) {
+			if (i % 4 != 3) {
+				double d = double(a[i]) - double(b[i]);
+				sum += d * d;
+				count++;
+			}
+		}
+	}
+	return sum == 0.0 ? INFINITY : 10.0 * std::log10(255.0 * 255.0 * count / sum);
+}
+
+double ToMegaPixelsPerSecond(uint64_t pixelCount, double milliseconds) {
+	return static_cast<double>(pixelCount) / (milliseconds * 1000.0);
+}
+
+// 白黒の細かい模様（ガンマ空間で平均すると暗くなるのが目立つ）
+TextureImage MakeHalftone(uint32_t size) {
+	TextureImage image;
+	image.Allocate(size, size);
+	std::mt19937 random(9);
+	for (uint32_t y = 0; y < size; y++) {
+		for (uint32_t x = 0; x < size; x++) {
+			// 左から右へ白の割合が増える
+			bool white = random() % size < x;
+			std::fill_n(image.pixels.begin() + (size_t(y) * size + x) * 4, 3, white ? 255 : 0);
+			image.pixels[(size_t(y) * size + x) * 4 + 3] = 255;
+		}
+	}
+	return image;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 10;
+
+	TextureImage photo;
+	MappedFile file;
+	bench::Check(file.Open("uvChecker.png"), "open png");
+	bench::Check(PngDecoder::Decode(file.GetData(), file.GetSize(), &photo), "decode png");
+	file.Close();
+	struct Source {
+		const char* name;
+		TextureImage image;
+	};
+	const Source sources[] = {
+	    {"uvChecker.png", photo},
+	    {"halftone", MakeHalftone(quick ? 256 : 1024)},
+	};
+
+	ThreadPool* threadPool = ThreadPool::GetInstance();
+	threadPool->Initialize();
+	const uint32_t workerCount = threadPool->GetThreadCount();
+
+	for (const Source& source : sources) {
+		const uint64_t pixelCount = uint64_t(source.image.GetWidth()) * source.image.GetHeight();
+		TextureImage gamma = source.image;
+		TextureImage box = source.image;
+		TextureImage kaiser = source.image;
+		TextureImage threaded = source.image;
+		double gammaTime = bench::Measure(repeat, [&] { GenerateGammaSpace(&gamma); });
+		double boxTime = bench::Measure(
+		    repeat, [&] { MipGenerator::Generate(&box, MipGenerator::Filter::kBox); });
+		double kaiserTime = bench::Measure(
+		    repeat, [&] { MipGenerator::Generate(&kaiser, MipGenerator::Filter::kKaiser); });
+		double threadedTime = bench::Measure(repeat, [&] {
+			MipGenerator::Generate(&threaded, MipGenerator::Filter::kBox, threadPool);
+		});
+
+		// 箱フィルタは基準との差が丸め程度で、ガンマ空間の平均より基準に近い
+		TextureImage reference = MakeReference(source.image);
+		const double gammaPsnr = ComputeMipPsnr(gamma, reference);
+		const double boxPsnr = ComputeMipPsnr(box, reference);
+		const double kaiserPsnr = ComputeMipPsnr(kaiser, reference);
+		bench::Check(boxPsnr > gammaPsnr, "linear box is closer to the reference than gamma");
+		bench::Check(threaded.pixels == box.pixels, "threaded matches single-threaded");
+
+		std::printf(
+		    "mip generation %s (%ux%u, %u workers)\n"
+		    "  gamma box    %8.3f ms  %7.1f MPix/s  PSNR %5.1f dB\n"
+		    "  linear box   %8.3f ms  %7.1f MPix/s  PSNR %5.1f dB\n"
+		    "  kaiser       %8.3f ms  %7.1f MPix/s  PSNR %5.1f dB\n"
+		    "  box threaded %8.3f ms  %7.1f MPix/s\n",
+		    source.name, source.image.GetWidth(), source.image.GetHeight(), workerCount,
+		    gammaTime, ToMegaPixelsPerSecond(pixelCount, gammaTime), gammaPsnr, boxTime,
+		    ToMegaPixelsPerSecond(pixelCount, boxTime), boxPsnr, kaiserTime,
+		    ToMegaPixelsPerSecond(pixelCount, kaiserTime), kaiserPsnr, threadedTime,
+		    ToMegaPixelsPerSecond(pixelCount, threadedTime));
+	}
+	threadPool->Finalize();
+	return 0;
+}
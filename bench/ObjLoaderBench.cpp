@@ -0,0 +1,166 @@
+#include "Benchmark.h"
+#include "ObjLoader.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// OBJ読み込みのベンチマーク
+// ifstream + getline + istringstream で1頂点ずつ追加する従来の読み込み（Model::LoadModel と
+// 同じ手順を写したもの）と、ObjLoader を比べる
+// 使い方: ObjLoaderBench [--quick] [-grid 1辺の四角形数]（三角形数は 2 x 1辺の2乗）
+
+namespace {
+
+// デフォルトの格子の大きさ（約240万三角形、140MB ほどの OBJ）
+constexpr int kDefaultGridSize = 1100;
+// --quick での格子の大きさ（正しさの確認だけ）
+constexpr int kQuickGridSize = 64;
+
+// 従来の読み込み（面の頂点ごとに新しい頂点を作る）
+bool LoadWithStreams(const std::string& filePath, MeshData* mesh) {
+	std::ifstream file(filePath);
+	if (file.fail()) {
+		return false;
+	}
+	std::vector<Vector3> positions;
+	std::vector<Vector3> normals;
+	std::vector<Vector2> texcoords;
+	std::string line;
+	while (std::getline(file, line)) {
+		std::istringstream lineStream(line);
+		std::string key;
+		std::getline(lineStream, key, ' ');
+		if (key == "v") {
+			Vector3 position{};
+			lineStream >> position.x >> position.y >> position.z;
+			positions.push_back(position);
+		} else if (key == "vt") {
+			Vector2 texcoord{};
+			lineStream >> texcoord.x >> texcoord.y;
+			texcoord.y = 1.0f - texcoord.y;
+			texcoords.push_back(texcoord);
+		} else if (key == "vn") {
+			Vector3 normal{};
+			lineStream >> normal.x >> normal.y >> normal.z;
+			normals.push_back(normal);
+		} else if (key == "f") {
+			std::vector<uint32_t> face;
+			std::string vertexDefinition;
+			while (std::getline(lineStream, vertexDefinition, ' ')) {
+				if (vertexDefinition.empty()) {
+					continue;
+				}
+				std::istringstream vertexStream(vertexDefinition);
+				std::string index;
+				MeshVertex vertex{};
+				std::getline(vertexStream, index, '/');
+				vertex.pos = positions[std::stoi(index) - 1];
+				std::getline(vertexStream, index, '/');
+				vertex.uv = texcoords[std::stoi(index) - 1];
+				std::getline(vertexStream, index, '/');
+				vertex.normal = normals[std::stoi(index) - 1];
+				face.push_back(static_cast<uint32_t>(mesh->vertices.size()));
+				mesh->vertices.push_back(vertex);
+			}
+			for (size_t i = 2; i < face.size(); i++) {
+				mesh->indices.push_back(face[0]);
+				mesh->indices.push_back(face[i - 1]);
+				mesh->indices.push_back(face[i]);
+			}
+		}
+	}
+	return true;
+}
+
+// 格子状の地形を OBJ で書き出す（四角形の面、v/vt/vn 付き）
+void WriteGrid(const std::string& filePath, int size) {
+	std::ofstream file(filePath);
+	char line[128];
+	for (int z = 0; z <= size; z++) {
+		for (int x = 0; x <= size; x++) {
+			float height = static_cast<float>((x * 7 + z * 13) % 17) * 0.05f;
+			std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", x * 0.1f, height, z * 0.1f);
+			file << line;
+			std::snprintf(
+			    line, sizeof(line), "vt %.6f %.6f\n", static_cast<float>(x) / size,
+			    static_cast<float>(z) / size);
+			file << line;
+		}
+	}
+	file << "vn 0.000000 1.000000 0.000000\n";
+	for (int z = 0; z < size; z++) {
+		for (int x = 0; x < size; x++) {
+			int v = z * (size + 1) + x + 1;
+			int w = v + size + 1;
+			std::snprintf(
+			    line, sizeof(line), "f %d/%d/1 %d/%d/1 %d/%d/1 %d/%d/1\n", v, v, w, w, w + 1,
+			    w + 1, v + 1, v + 1);
+			file << line;
+		}
+	}
+}
+
+// 三角形ごとの座標が一致するか
+bool SameTriangles(const MeshData& a, const MeshData& b) {
+	if (a.indices.size() != b.indices.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < a.indices.size(); i++) {
+		const MeshVertex& va = a.vertices[a.indices[i]];
+		const MeshVertex& vb = b.vertices[b.indices[i]];
+		if (va.pos.x != vb.pos.x || va.pos.y != vb.pos.y || va.pos.z != vb.pos.z ||
+		    va.uv.x != vb.uv.x || va.uv.y != vb.uv.y) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 3;
+	int gridSize = quick ? kQuickGridSize : kDefaultGridSize;
+	for (int i = 1; i + 1 < argc; i++) {
+		if (std::strcmp(argv[i], "-grid") == 0 && 0 < std::atoi(argv[i + 1])) {
+			gridSize = std::atoi(argv[++i]);
+		}
+	}
+
+	std::string filePath = (std::filesystem::temp_directory_path() / "ObjLoaderBench.obj").string();
+	WriteGrid(filePath, gridSize);
+	double megabytes =
+	    static_cast<double>(std::filesystem::file_size(filePath)) / (1024.0 * 1024.0);
+
+	MeshData streamMesh;
+	double streamTime = bench::Measure(repeat, [&] {
+		streamMesh = {};
+		bench::Check(LoadWithStreams(filePath, &streamMesh), "stream load");
+	});
+	ModelData model;
+	double fastTime = bench::Measure(repeat, [&] {
+		bench::Check(ObjLoader::Load(filePath, &model), "ObjLoader::Load");
+	});
+	std::filesystem::remove(filePath);
+
+	bench::Check(model.meshes.size() == 1, "one mesh");
+	bench::Check(SameTriangles(streamMesh, model.meshes[0]), "same triangles");
+	bench::Check(
+	    model.meshes[0].vertices.size() == static_cast<size_t>((gridSize + 1) * (gridSize + 1)),
+	    "shared vertices are deduplicated");
+
+	std::printf(
+	    "obj (%.1f MB, %zu triangles)\n"
+	    "  streams   %8.2f ms (%6.1f MB/s) %8zu vertices\n"
+	    "  ObjLoader %8.2f ms (%6.1f MB/s) %8zu vertices  x%.2f\n",
+	    megabytes, streamMesh.indices.size() / 3, streamTime, megabytes / streamTime * 1000.0,
+	    streamMesh.vertices.size(), fastTime, megabytes / fastTime * 1000.0,
+	    model.meshes[0].vertices.size(), streamTime / fastTime);
+	return 0;
+}
@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+#include "ObjectPool.h"
+#include <cstdio>
+#include <list>
+#include <memory>
+
+// 弾の生成・移動・破棄のベンチマーク
+// std::list<std::unique_ptr<T>> に new して remove_if で消す従来の書き方と、ObjectPool を比べる
+
+namespace {
+
+// 弾（PlayerBullet 程度の大きさ）
+struct Bullet {
+	float position[3];
+	float velocity[3];
+	float matWorld[16];
+	int32_t lifeTime;
+
+	Bullet(float x, float vx, int32_t life)
+	    : position{x, 0, 0}, velocity{vx, 0.5f, 1.0f}, matWorld{}, lifeTime(life) {}
+
+	void Update() {
+		for (int i = 0; i < 3; i++) {
+			position[i] += velocity[i];
+		}
+		matWorld[12] = position[0];
+		matWorld[13] = position[1];
+		matWorld[14] = position[2];
+		lifeTime--;
+	}
+
+	bool IsDead() const { return lifeTime <= 0; }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int frameCount = quick ? 200 : 5000;
+	const int repeat = quick ? 1 : 5;
+	// 1フレームに撃つ数と寿命（同時に 50 * 120 = 6000 発前後が生きている）
+	const int spawnPerFrame = 50;
+	const int lifeTime = 120;
+	const uint32_t capacity = spawnPerFrame * (lifeTime + 1);
+
+	// 寿命をずらして、破棄が配列のあちこちで起きるようにする
+	auto life = [lifeTime](int frame, int i) { return lifeTime - (frame * 7 + i * 13) % 40; };
+
+	size_t listLiveCount = 0;
+	double listTime = bench::Measure(repeat, [&] {
+		std::list<std::unique_ptr<Bullet>> bullets;
+		for (int frame = 0; frame < frameCount; frame++) {
+			for (int i = 0; i < spawnPerFrame; i++) {
+				bullets.push_back(std::make_unique<Bullet>(float(i), 0.1f, life(frame, i)));
+			}
+			for (auto& bullet : bullets) {
+				bullet->Update();
+			}
+			bullets.remove_if(
+			    [](const std::unique_ptr<Bullet>& bullet) { return bullet->IsDead(); });
+		}
+		listLiveCount = bullets.size();
+		bench::DoNotOptimize(listLiveCount);
+	});
+
+	size_t poolLiveCount = 0;
+	ObjectPool<Bullet> pool;
+	double poolTime = bench::Measure(repeat, [&] {
+		pool.Initialize(capacity);
+		for (int frame = 0; frame < frameCount; frame++) {
+			for (int i = 0; i < spawnPerFrame; i++) {
+				pool.Spawn(float(i), 0.1f, life(frame, i));
+			}
+			for (Bullet& bullet : pool) {
+				bullet.Update();
+			}
+			pool.DespawnIf([](const Bullet& bullet) { return bullet.IsDead(); });
+		}
+		poolLiveCount = pool.GetSize();
+		bench::DoNotOptimize(poolLiveCount);
+	});
+
+	bench::Check(listLiveCount == poolLiveCount, "same number of bullets alive");
+	std::printf(
+	    "object pool (%d frames, %d spawns/frame, %zu alive at end)\n"
+	    "  list<unique_ptr> %8.3f ms (%.2f us/frame)\n"
+	    "  ObjectPool       %8.3f ms (%.2f us/frame)  x%.2f\n",
+	    frameCount, spawnPerFrame, poolLiveCount, listTime, listTime * 1000.0 / frameCount,
+	    poolTime, poolTime * 1000.0 / frameCount, listTime / poolTime);
+	return 0;
+}
@@ -0,0 +1,135 @@
+#include "Benchmark.h"
+#include "MathUtility.h"
+#include "MeshUtility.h"
+#include "ThreadPool.h"
+#include <cmath>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+// 平滑化法線のベンチマーク
+// 座標ごとに頂点の一覧を unordered_map で持つ従来の平滑化（Mesh::AddSmoothData と同じ手順を
+// 写したもの）と、CalculateSmoothedNormals の各重み付け・スレッドプール使用時を比べる
+
+namespace {
+
+// 格子状の起伏のある面を三角形ごとに頂点を分けて作る（法線は面の法線）
+MeshData MakeFlatShadedGrid(uint32_t size) {
+	MeshData mesh;
+	auto position = [](uint32_t x, uint32_t z) {
+		float height =
+		    std::sin(static_cast<float>(x) * 0.3f) * std::cos(static_cast<float>(z) * 0.2f);
+		return Vector3{static_cast<float>(x), height, static_cast<float>(z)};
+	};
+	auto addTriangle = [&](uint32_t a, uint32_t b, uint32_t c) {
+		uint32_t corners[3] = {a, b, c};
+		Vector3 p[3];
+		for (int k = 0; k < 3; k++) {
+			p[k] = position(corners[k] % (size + 1), corners[k] / (size + 1));
+		}
+		Vector3 normal = Normalize(Cross(p[1] - p[0], p[2] - p[0]));
+		for (int k = 0; k < 3; k++) {
+			mesh.indices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+			mesh.vertices.push_back(MeshVertex{p[k], normal, {0.0f, 0.0f}});
+			mesh.positionIndices.push_back(corners[k]);
+		}
+	};
+	for (uint32_t z = 0; z < size; z++) {
+		for (uint32_t x = 0; x < size; x++) {
+			uint32_t v = z * (size + 1) + x;
+			uint32_t w = v + size + 1;
+			addTriangle(v, w, w + 1);
+			addTriangle(v, w + 1, v + 1);
+		}
+	}
+	return mesh;
+}
+
+// 従来の平滑化（座標ごとに頂点番号の配列を持ち、頂点が持つ法線を平均する）
+void SmoothWithMap(MeshData& mesh) {
+	std::unordered_map<uint32_t, std::vector<uint32_t>> smoothData;
+	for (size_t i = 0; i < mesh.vertices.size(); i++) {
+		smoothData[mesh.positionIndices[i]].push_back(static_cast<uint32_t>(i));
+	}
+	for (auto& [position, vertices] : smoothData) {
+		Vector3 sum{0.0f, 0.0f, 0.0f};
+		for (uint32_t index : vertices) {
+			sum += mesh.vertices[index].normal;
+		}
+		Vector3 normal = Normalize(sum);
+		for (uint32_t index : vertices) {
+			mesh.vertices[index].normal = normal;
+		}
+	}
+}
+
+// 法線が一致するか
+bool SameNormals(const MeshData& a, const MeshData& b, float tolerance) {
+	for (size_t i = 0; i < a.vertices.size(); i++) {
+		Vector3 difference = a.vertices[i].normal - b.vertices[i].normal;
+		if (Length(difference) > tolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 3;
+	const uint32_t gridSize = quick ? 64 : 700;
+	const uint32_t positionCount = (gridSize + 1) * (gridSize + 1);
+	const MeshData source = MakeFlatShadedGrid(gridSize);
+
+	ThreadPool* threadPool = ThreadPool::GetInstance();
+	threadPool->Initialize();
+
+	// 処理量は法線の値によらないので、コピーは計測の外で1回だけ行い同じデータにかけ直す
+	MeshData work = source;
+	double mapTime = bench::Measure(repeat, [&] { SmoothWithMap(work); });
+	MeshData reference = source;
+	SmoothWithMap(reference);
+
+	std::printf(
+	    "smoothed normals (%zu vertices, %zu triangles, %u threads)\n"
+	    "  unordered_map      %8.3f ms\n",
+	    source.vertices.size(), source.indices.size() / 3, threadPool->GetThreadCount() + 1,
+	    mapTime);
+
+	struct Case {
+		const char* name;
+		NormalWeight weight;
+	};
+	for (const Case& c : {
+	         Case{"uniform", NormalWeight::kUniform}, Case{"area", NormalWeight::kArea},
+	         Case{"angle", NormalWeight::kAngle}}) {
+		double singleTime = bench::Measure(repeat, [&] {
+			CalculateSmoothedNormals(work, positionCount, c.weight);
+		});
+		double threadedTime = bench::Measure(repeat, [&] {
+			CalculateSmoothedNormals(work, positionCount, c.weight, threadPool);
+		});
+
+		MeshData single = source;
+		CalculateSmoothedNormals(single, positionCount, c.weight);
+		MeshData threaded = source;
+		CalculateSmoothedNormals(threaded, positionCount, c.weight, threadPool);
+
+		// 座標ごとに独立して計算するので、並列にしても結果は変わらない
+		bench::Check(SameNormals(single, threaded, 0.0f), "threaded result matches");
+		if (c.weight == NormalWeight::kUniform) {
+			bench::Check(SameNormals(single, reference, 0.0f), "uniform matches the map average");
+		} else {
+			// なだらかな起伏なので、どの重み付けでも平均とほぼ同じ向きになる
+			bench::Check(SameNormals(single, reference, 0.2f), "weighted normals are close");
+		}
+
+		std::printf(
+		    "  %-8s single    %8.3f ms  threaded %8.3f ms\n", c.name, singleTime, threadedTime);
+	}
+
+	threadPool->Finalize();
+	return 0;
+}
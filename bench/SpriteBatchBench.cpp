@@ -0,0 +1,175 @@
+#include "Benchmark.h"
+#include "ConstantBufferAllocator.h"
+#include "MathUtility.h"
+#include "SpriteQuad.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// スプライト描画のベンチマーク（ヘッドレス）
+// 1枚ごとに頂点バッファと定数バッファへ書いて描く従来の描画（Sprite::Draw と同じ手順を写した
+// もの）と、SpriteQuad を並べ替えて1本の頂点バッファに書き出す SpriteBatch の手順を比べる
+// GPUへの発行は行わないので、時間はCPU側の準備だけ。描画コール数と状態変更の数は数えて出す
+
+namespace {
+
+// 1回に書き出す枚数（SpriteBatch::kMaxQuadsPerChunk と同じ。ページに収まる大きさ）
+constexpr size_t kMaxQuadsPerChunk = 8192;
+
+// Sprite と同じ頂点・定数バッファの並び
+struct VertexPosUv {
+	Vector3 pos;
+	Vector2 uv;
+};
+struct ConstBufferData {
+	Vector4 color;
+	Matrix4x4 mat;
+};
+
+// 描画コールと状態変更の数
+struct Counts {
+	size_t drawCallCount = 0;
+	size_t pipelineChangeCount = 0;
+	size_t textureChangeCount = 0;
+};
+
+// 状態が変わるたびに数える（SpriteBatch::End と同じく、同じ状態が続く間は1コール）
+Counts CountDraws(const std::vector<SpriteQuad>& quads, const std::vector<uint32_t>& order) {
+	Counts counts;
+	uint32_t blendMode = UINT32_MAX;
+	uint32_t textureHandle = UINT32_MAX;
+	for (uint32_t index : order) {
+		const SpriteQuad& quad = quads[index];
+		bool changed = false;
+		if (blendMode != quad.blendMode) {
+			blendMode = quad.blendMode;
+			counts.pipelineChangeCount++;
+			changed = true;
+		}
+		if (textureHandle != quad.textureHandle) {
+			textureHandle = quad.textureHandle;
+			counts.textureChangeCount++;
+			changed = true;
+		}
+		counts.drawCallCount += changed ? 1 : 0;
+	}
+	return counts;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 50;
+	const size_t spriteCount = quick ? 1000 : 20000;
+	const uint32_t textureCount = 8;
+	const uint32_t blendModeCount = 2;
+
+	// テクスチャとブレンドモードが入り混じった順に積む
+	std::vector<SpriteQuad> quads(spriteCount);
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> value(0.0f, 1.0f);
+	for (SpriteQuad& quad : quads) {
+		quad.textureHandle = static_cast<uint32_t>(random() % textureCount);
+		quad.blendMode = static_cast<uint32_t>(random() % blendModeCount);
+		quad.position = {value(random) * 1280.0f, value(random) * 720.0f};
+		quad.size = {16.0f + value(random) * 32.0f, 16.0f + value(random) * 32.0f};
+		quad.anchorPoint = {0.5f, 0.5f};
+		quad.rotation = random() % 4 == 0 ? value(random) * 6.28f : 0.0f;
+		quad.color = {value(random), value(random), value(random), 1.0f};
+	}
+
+	SystemMemoryBackingStore store;
+	ConstantBufferAllocator allocator;
+	allocator.Initialize(&store, 2);
+
+	// 従来の描画（1枚ごとに4頂点を書き換え、色と行列を定数バッファに書いて1コール）
+	std::vector<VertexPosUv> vertexBuffers(spriteCount * 4);
+	double eachTime = bench::Measure(repeat, [&] {
+		allocator.BeginFrame();
+		for (size_t i = 0; i < spriteCount; i++) {
+			const SpriteQuad& quad = quads[i];
+			float left = -quad.anchorPoint.x * quad.size.x;
+			float right = (1.0f - quad.anchorPoint.x) * quad.size.x;
+			float top = -quad.anchorPoint.y * quad.size.y;
+			float bottom = (1.0f - quad.anchorPoint.y) * quad.size.y;
+			VertexPosUv* vertices = &vertexBuffers[i * 4];
+			vertices[0] = {{left, bottom, 0.0f}, {quad.uvMin.x, quad.uvMax.y}};
+			vertices[1] = {{left, top, 0.0f}, {quad.uvMin.x, quad.uvMin.y}};
+			vertices[2] = {{right, bottom, 0.0f}, {quad.uvMax.x, quad.uvMax.y}};
+			vertices[3] = {{right, top, 0.0f}, {quad.uvMax.x, quad.uvMin.y}};
+
+			ConstBufferData data;
+			data.color = quad.color;
+			data.mat = Multiply(
+			    MakeRotateZMatrix(quad.rotation),
+			    MakeTranslateMatrix({quad.position.x, quad.position.y, 0.0f}));
+			bench::DoNotOptimize(allocator.Push(data));
+		}
+	});
+	std::vector<uint32_t> submitted(spriteCount);
+	for (size_t i = 0; i < spriteCount; i++) {
+		submitted[i] = static_cast<uint32_t>(i);
+	}
+
+	// バッチ描画（並べ替えてから、今フレームのページへ4頂点ずつ書き出す）
+	std::vector<uint32_t> order;
+	std::vector<uint32_t> scratch;
+	std::vector<SpriteVertex*> chunks;
+	double batchTime = bench::Measure(repeat, [&] {
+		allocator.BeginFrame();
+		SortSpriteQuads(quads, order, scratch);
+		chunks.clear();
+		for (size_t first = 0; first < spriteCount; first += kMaxQuadsPerChunk) {
+			size_t count = std::min(kMaxQuadsPerChunk, spriteCount - first);
+			ConstantBufferAllocator::Allocation allocation =
+			    allocator.Allocate(sizeof(SpriteVertex) * 4 * count);
+			bench::Check(allocation.cpuAddress != nullptr, "vertex allocation");
+			SpriteVertex* dst = static_cast<SpriteVertex*>(allocation.cpuAddress);
+			WriteSpriteVertices(quads, std::span<const uint32_t>(order).subspan(first, count), dst);
+			chunks.push_back(dst);
+		}
+	});
+	bench::Check(allocator.GetStatistics().failedAllocations == 0, "no failed allocations");
+	Counts batched = CountDraws(quads, order);
+	Counts unsorted = CountDraws(quads, submitted);
+
+	// 並べ替えると状態の組み合わせごとに1コールになる
+	bench::Check(
+	    batched.drawCallCount <= textureCount * blendModeCount, "one draw per texture and blend");
+	bench::Check(batched.pipelineChangeCount == blendModeCount, "one pipeline change per blend");
+	// 書き出した頂点は従来の描画で行列を掛けた位置と同じ
+	for (size_t i = 0; i < spriteCount; i++) {
+		const SpriteQuad& quad = quads[order[i]];
+		Matrix4x4 mat = Multiply(
+		    MakeRotateZMatrix(quad.rotation),
+		    MakeTranslateMatrix({quad.position.x, quad.position.y, 0.0f}));
+		for (size_t k = 0; k < 4; k++) {
+			Vector3 expected = TransformPoint(vertexBuffers[order[i] * 4 + k].pos, mat);
+			const SpriteVertex& vertex =
+			    chunks[i / kMaxQuadsPerChunk][(i % kMaxQuadsPerChunk) * 4 + k];
+			bench::Check(
+			    std::fabs(vertex.pos.x - expected.x) < 1e-3f &&
+			        std::fabs(vertex.pos.y - expected.y) < 1e-3f,
+			    "vertex position");
+			bench::Check(
+			    vertex.uv.x == vertexBuffers[order[i] * 4 + k].uv.x &&
+			        vertex.uv.y == vertexBuffers[order[i] * 4 + k].uv.y,
+			    "vertex uv");
+			bench::Check(vertex.color == PackSpriteColor(quad.color), "vertex color");
+		}
+	}
+
+	std::printf(
+	    "sprite batch (%zu sprites, %u textures, %u blend modes)\n"
+	    "  per sprite %8.3f ms  %6zu draws\n"
+	    "  unsorted   %8s     %6zu draws  %6zu pipeline  %6zu texture changes\n"
+	    "  batched    %8.3f ms  %6zu draws  %6zu pipeline  %6zu texture changes  x%.1f\n",
+	    spriteCount, textureCount, blendModeCount, eachTime, spriteCount, "",
+	    unsorted.drawCallCount, unsorted.pipelineChangeCount, unsorted.textureChangeCount,
+	    batchTime, batched.drawCallCount, batched.pipelineChangeCount,
+	    batched.textureChangeCount, eachTime / batchTime);
+	return 0;
+}
@@ -0,0 +1,131 @@
+#include "Benchmark.h"
+#include "TextureRegistry.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// テクスチャハンドル管理のベンチマーク
+// 全名前を find_if で比べてビット表から空きを探す従来の管理（TextureManager::LoadInternal と
+// 同じ手順を写したもの）と、TextureRegistry を比べる
+// 1サイクル = 読み込み（未登録）+ 読み込み済みの名前を2回引く + 解放
+
+namespace {
+
+// TextureManager と同じ1ページのデスクリプタ数と、先頭の予約数
+constexpr uint32_t kNumDescriptors = 256;
+constexpr uint32_t kNumReserved = 192;
+constexpr uint32_t kInvalid = UINT32_MAX;
+
+// 従来の管理（名前の配列と使用中のビット表）
+class LinearTable {
+public:
+	void Reset() {
+		for (std::string& name : names_) {
+			name.clear();
+		}
+		words_.fill(0);
+		// 予約の分のワードを埋める
+		for (uint32_t i = 0; i < kNumReserved / 64; i++) {
+			words_[i] = ~uint64_t(0);
+		}
+	}
+	uint32_t Find(const std::string& name) const {
+		auto it = std::find_if(names_.begin(), names_.end(), [&](const std::string& texture) {
+			return texture == name;
+		});
+		return it != names_.end() ? static_cast<uint32_t>(it - names_.begin()) : kInvalid;
+	}
+	uint32_t Allocate(const std::string& name) {
+		for (uint32_t word = 0; word < words_.size(); word++) {
+			if (words_[word] != ~uint64_t(0)) {
+				uint32_t handle = word * 64 + std::countr_one(words_[word]);
+				words_[word] |= uint64_t(1) << (handle % 64);
+				names_[handle] = name;
+				return handle;
+			}
+		}
+		return kInvalid;
+	}
+	void Release(uint32_t handle) {
+		names_[handle].clear();
+		words_[handle / 64] &= ~(uint64_t(1) << (handle % 64));
+	}
+
+private:
+	std::array<std::string, kNumDescriptors> names_;
+	std::array<uint64_t, kNumDescriptors / 64> words_{};
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 20;
+	const uint32_t cycleCount = quick ? 1000 : 10000;
+	const uint32_t residentCount = 60;
+
+	// 常駐するテクスチャと、読み込んではすぐ捨てるテクスチャの名前
+	std::vector<std::string> resident;
+	for (uint32_t i = 0; i < residentCount; i++) {
+		resident.push_back("Resources/textures/resident_" + std::to_string(i) + ".png");
+	}
+	std::vector<std::string> transient;
+	for (uint32_t i = 0; i < cycleCount; i++) {
+		transient.push_back("Resources/textures/transient_" + std::to_string(i) + ".png");
+	}
+
+	LinearTable linear;
+	uint64_t linearSum = 0;
+	double linearTime = bench::Measure(repeat, [&] {
+		linear.Reset();
+		for (const std::string& name : resident) {
+			linear.Allocate(name);
+		}
+		linearSum = 0;
+		for (uint32_t i = 0; i < cycleCount; i++) {
+			uint32_t handle = linear.Find(transient[i]);
+			if (handle == kInvalid) {
+				handle = linear.Allocate(transient[i]);
+			}
+			linearSum += linear.Find(resident[i % residentCount]);
+			linearSum += linear.Find(resident[(i * 7) % residentCount]);
+			linear.Release(handle);
+		}
+		bench::DoNotOptimize(linearSum);
+	});
+
+	TextureRegistry registry;
+	uint64_t registrySum = 0;
+	double registryTime = bench::Measure(repeat, [&] {
+		registry.Reset(kNumDescriptors, kNumReserved);
+		for (const std::string& name : resident) {
+			registry.Allocate(name);
+		}
+		registrySum = 0;
+		for (uint32_t i = 0; i < cycleCount; i++) {
+			uint32_t handle = registry.Find(transient[i]);
+			if (handle == TextureRegistry::kInvalidHandle) {
+				handle = registry.Allocate(transient[i]);
+			}
+			registrySum += registry.Find(resident[i % residentCount]);
+			registrySum += registry.Find(resident[(i * 7) % residentCount]);
+			registry.Release(handle);
+		}
+		bench::DoNotOptimize(registrySum);
+	});
+
+	// 同じ名前には同じハンドルが返り、捨てた分はすべて空きに戻る
+	bench::Check(linearSum == registrySum, "same handles for resident textures");
+	bench::Check(registry.GetLiveCount() == residentCount, "transient handles are released");
+	bench::Check(registry.GetPageCount() == 1, "no extra pages for a steady working set");
+
+	std::printf(
+	    "texture registry (%u resident, %u load/lookup/unload cycles)\n"
+	    "  find_if + bitset  %8.3f ms\n"
+	    "  TextureRegistry   %8.3f ms  x%.2f\n",
+	    residentCount, cycleCount, linearTime, registryTime, linearTime / registryTime);
+	return 0;
+}
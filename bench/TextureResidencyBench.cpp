@@ -0,0 +1,171 @@
+#include "Benchmark.h"
+#include "TextureResidency.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// テクスチャ常駐管理のベンチマーク（合成した使われ方）
+// 追い出すたびに全テクスチャから最も古いものを探す素朴な管理と、使われた順のリストを持つ
+// TextureResidency を比べる。毎フレーム、少しずつずれていく作業集合を使い、予算を越えた分を
+// 追い出して、追い出されたものが次に使われたら読み直す
+
+namespace {
+
+// 素朴な管理（使われた順の通し番号を持ち、追い出すときに全体から最小を探す）
+class ScanResidency {
+public:
+	void Reset(size_t handleCount, size_t budgetBytes, uint32_t evictAfterFrames) {
+		entries_.assign(handleCount, Entry{});
+		budgetBytes_ = budgetBytes;
+		evictAfterFrames_ = evictAfterFrames;
+		residentBytes_ = 0;
+		stamp_ = 0;
+	}
+	void SetResident(uint32_t handle, size_t sizeBytes, uint64_t frame) {
+		Entry& entry = entries_[handle];
+		entry = {sizeBytes, frame, ++stamp_, true};
+		residentBytes_ += sizeBytes;
+	}
+	void Touch(uint32_t handle, uint64_t frame) {
+		Entry& entry = entries_[handle];
+		if (entry.isResident && entry.lastUsedFrame != frame) {
+			entry.lastUsedFrame = frame;
+			entry.stamp = ++stamp_;
+		}
+	}
+	bool IsResident(uint32_t handle) const { return entries_[handle].isResident; }
+	void CollectEvictions(uint64_t frame, std::vector<uint32_t>* evicted) {
+		while (budgetBytes_ < residentBytes_) {
+			uint32_t oldest = UINT32_MAX;
+			for (uint32_t handle = 0; handle < entries_.size(); handle++) {
+				if (entries_[handle].isResident &&
+				    (oldest == UINT32_MAX || entries_[handle].stamp < entries_[oldest].stamp)) {
+					oldest = handle;
+				}
+			}
+			if (oldest == UINT32_MAX ||
+			    frame < entries_[oldest].lastUsedFrame + evictAfterFrames_) {
+				return;
+			}
+			residentBytes_ -= entries_[oldest].sizeBytes;
+			entries_[oldest] = Entry{};
+			evicted->push_back(oldest);
+		}
+	}
+	size_t GetResidentBytes() const { return residentBytes_; }
+
+private:
+	struct Entry {
+		size_t sizeBytes = 0;
+		uint64_t lastUsedFrame = 0;
+		uint64_t stamp = 0;
+		bool isResident = false;
+	};
+	std::vector<Entry> entries_;
+	size_t budgetBytes_ = 0;
+	uint32_t evictAfterFrames_ = 0;
+	size_t residentBytes_ = 0;
+	uint64_t stamp_ = 0;
+};
+
+// 1フレームで使うテクスチャ（作業集合の中から、偏りをつけて選ぶ）
+struct Frame {
+	std::vector<uint32_t> handles;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 5;
+	const uint32_t textureCount = 2048;
+	const uint32_t frameCount = quick ? 200 : 2000;
+	const uint32_t workingSetSize = 256;
+	const uint32_t drawsPerFrame = 1500;
+	const uint32_t evictAfterFrames = 2;
+
+	// 大きさは 64KB～4MB（ミップマップ付きの 128x128～1024x1024 相当）
+	std::mt19937 random(17);
+	std::vector<size_t> sizes(textureCount);
+	for (size_t& size : sizes) {
+		size = size_t(64 * 1024) << (random() % 7);
+	}
+	size_t totalBytes = 0;
+	for (size_t size : sizes) {
+		totalBytes += size;
+	}
+	// 作業集合の半分程度しか載らない予算
+	const size_t budgetBytes = totalBytes / textureCount * workingSetSize / 2;
+
+	// 作業集合は毎フレーム少しずつずれ、その中でも手前のものほどよく使う
+	std::vector<Frame> frames(frameCount);
+	for (uint32_t frame = 0; frame < frameCount; frame++) {
+		const uint32_t first = frame / 4;
+		std::geometric_distribution<uint32_t> pick(8.0 / workingSetSize);
+		for (uint32_t draw = 0; draw < drawsPerFrame; draw++) {
+			uint32_t offset = std::min(pick(random), workingSetSize - 1);
+			frames[frame].handles.push_back((first + offset) % textureCount);
+		}
+	}
+
+	// 1フレーム = 使う前の確認（追い出されていれば読み直す）+ 追い出し
+	std::vector<uint32_t> evicted;
+	size_t scanReloads = 0;
+	size_t scanEvictions = 0;
+	ScanResidency scan;
+	double scanTime = bench::Measure(repeat, [&] {
+		scan.Reset(textureCount, budgetBytes, evictAfterFrames);
+		scanReloads = 0;
+		scanEvictions = 0;
+		for (uint32_t frame = 0; frame < frameCount; frame++) {
+			for (uint32_t handle : frames[frame].handles) {
+				if (!scan.IsResident(handle)) {
+					scan.SetResident(handle, sizes[handle], frame);
+					scanReloads++;
+				}
+				scan.Touch(handle, frame);
+			}
+			evicted.clear();
+			scan.CollectEvictions(frame, &evicted);
+			scanEvictions += evicted.size();
+		}
+	});
+
+	size_t lruReloads = 0;
+	size_t lruEvictions = 0;
+	TextureResidency residency;
+	double lruTime = bench::Measure(repeat, [&] {
+		residency.Reset();
+		residency.SetBudget(budgetBytes, evictAfterFrames);
+		lruReloads = 0;
+		lruEvictions = 0;
+		for (uint32_t frame = 0; frame < frameCount; frame++) {
+			for (uint32_t handle : frames[frame].handles) {
+				if (!residency.IsResident(handle)) {
+					residency.SetResident(handle, sizes[handle], frame);
+					lruReloads++;
+				}
+				residency.Touch(handle, frame);
+			}
+			evicted.clear();
+			lruEvictions += residency.CollectEvictions(frame, &evicted);
+		}
+	});
+
+	// どちらも同じ順に追い出すので、読み直しと追い出しの数も、最後の使用量も同じ
+	bench::Check(scanReloads == lruReloads, "same reloads");
+	bench::Check(scanEvictions == lruEvictions, "same evictions");
+	bench::Check(scan.GetResidentBytes() == residency.GetResidentBytes(), "same resident bytes");
+	bench::Check(0 < lruEvictions, "budget forces evictions");
+
+	std::printf(
+	    "texture residency (%u textures, %u frames, %u draws/frame, budget %.1f MB)\n"
+	    "  reloads %zu  evictions %zu  resident %.1f MB\n"
+	    "  full scan        %8.3f ms\n"
+	    "  LRU list         %8.3f ms  x%.1f\n",
+	    textureCount, frameCount, drawsPerFrame, budgetBytes / (1024.0 * 1024.0), lruReloads,
+	    lruEvictions, residency.GetResidentBytes() / (1024.0 * 1024.0), scanTime, lruTime,
+	    scanTime / lruTime);
+	return 0;
+}
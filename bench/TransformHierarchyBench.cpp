@@ -0,0 +1,125 @@
+#include "Benchmark.h"
+#include "MathUtility.h"
+#include "TransformHierarchy.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// 親子関係付きワールド行列更新のベンチマーク
+// 毎フレーム全ノードを再計算する従来の更新（WorldTransform::parent_ をたどる形）と、
+// TransformHierarchy のダーティ伝播による更新を、動くノードの割合を変えて比べる
+
+namespace {
+
+// 1体分のデータ（WorldTransform と同じ並び）
+struct Object {
+	Vector3 scale;
+	Vector3 rotation;
+	Vector3 translation;
+	Matrix4x4 matWorld;
+	const Object* parent;
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 20;
+	// 根1つにつき 1 + 4 + 4*4 ノード（3段）
+	const size_t rootCount = quick ? 50 : 2000;
+	const size_t childCount = 4;
+
+	// 同じ形の木を両方に作る
+	std::vector<Object> objects;
+	TransformHierarchy hierarchy;
+	std::vector<uint32_t> nodes;
+	std::vector<size_t> roots;
+	objects.reserve(rootCount * 21);
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+	auto add = [&](size_t parent) {
+		Object object{};
+		object.scale = {1.0f, 1.0f, 1.0f};
+		object.rotation = {value(random), value(random), value(random)};
+		object.translation = {value(random) * 10.0f, value(random) * 10.0f, value(random)};
+		object.parent = parent == SIZE_MAX ? nullptr : &objects[parent];
+		objects.push_back(object);
+		uint32_t node = hierarchy.CreateNode(
+		    parent == SIZE_MAX ? TransformHierarchy::kInvalidNode : nodes[parent]);
+		hierarchy.SetRotation(node, object.rotation);
+		hierarchy.SetTranslation(node, object.translation);
+		nodes.push_back(node);
+		return objects.size() - 1;
+	};
+	for (size_t r = 0; r < rootCount; r++) {
+		size_t root = add(SIZE_MAX);
+		roots.push_back(root);
+		for (size_t c = 0; c < childCount; c++) {
+			size_t child = add(root);
+			for (size_t g = 0; g < childCount; g++) {
+				add(child);
+			}
+		}
+	}
+	hierarchy.UpdateMatrices();
+
+	// 従来の更新（親が先に並んでいるので前から順に計算すればよい）
+	auto updateAll = [&] {
+		for (Object& object : objects) {
+			object.matWorld = MakeAffineMatrix(object.scale, object.rotation, object.translation);
+			if (object.parent) {
+				object.matWorld = Multiply(object.matWorld, object.parent->matWorld);
+			}
+		}
+	};
+
+	std::printf("hierarchy (%zu nodes, %zu roots)\n", objects.size(), rootCount);
+	float time = 0.0f;
+	for (double movingRatio : {1.0, 0.1, 0.01}) {
+		size_t movingCount = std::max<size_t>(1, static_cast<size_t>(rootCount * movingRatio));
+		// 根を動かす（子孫はついてくる）
+		auto move = [&] {
+			time += 0.01f;
+			for (size_t i = 0; i < movingCount; i++) {
+				size_t root = roots[i];
+				objects[root].translation.x = std::sin(time + static_cast<float>(i));
+				hierarchy.SetTranslation(nodes[root], objects[root].translation);
+			}
+		};
+
+		double all = bench::Measure(repeat, [&] {
+			move();
+			updateAll();
+			bench::DoNotOptimize(objects.back().matWorld);
+		});
+		double dirty = bench::Measure(repeat, [&] {
+			move();
+			hierarchy.UpdateMatrices();
+			bench::DoNotOptimize(hierarchy.GetWorldMatrix(nodes.back()));
+		});
+
+		// 結果の一致を確認する
+		move();
+		updateAll();
+		hierarchy.UpdateMatrices();
+		bench::Check(
+		    hierarchy.GetUpdatedCount() == movingCount * 21, "only moved subtrees are updated");
+		for (size_t i = 0; i < objects.size(); i++) {
+			const Matrix4x4& expected = objects[i].matWorld;
+			const Matrix4x4& actual = hierarchy.GetWorldMatrix(nodes[i]);
+			for (int row = 0; row < 4; row++) {
+				for (int column = 0; column < 4; column++) {
+					bench::Check(
+					    std::fabs(expected.m[row][column] - actual.m[row][column]) < 1e-3f,
+					    "world matrix");
+				}
+			}
+		}
+
+		std::printf(
+		    "  moving %5.1f%%: update all %7.3f ms  dirty propagation %7.3f ms (%zu updated)\n",
+		    movingRatio * 100.0, all, dirty, hierarchy.GetUpdatedCount());
+	}
+	return 0;
+}
@@ -0,0 +1,101 @@
+#include "Benchmark.h"
+#include "MathUtility.h"
+#include "TransformSystem.h"
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+// ワールド行列更新のベンチマーク
+// 1体ずつ MakeAffineMatrix する従来の更新(AoS)と、TransformSystem の一括更新(SoA)を比べる
+
+namespace {
+
+// 定数バッファ1個分の間隔（TransformSystem::UpdateMatrices(dst, stride) の書き込み先）
+constexpr size_t kConstantBufferStride = 256;
+
+// 1体分のデータ（WorldTransform と同じ並び）
+struct Object {
+	Vector3 scale;
+	Vector3 rotation;
+	Vector3 translation;
+	Matrix4x4 matWorld;
+};
+
+bool NearlyEqual(const Matrix4x4& a, const Matrix4x4& b) {
+	for (int row = 0; row < 4; row++) {
+		for (int column = 0; column < 4; column++) {
+			float tolerance = 1e-4f * std::fmax(1.0f, std::fabs(a.m[row][column]));
+			if (tolerance < std::fabs(a.m[row][column] - b.m[row][column])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	const bool quick = bench::IsQuick(argc, argv);
+	const int repeat = quick ? 1 : 20;
+
+	std::mt19937 random(2023);
+	std::uniform_real_distribution<float> angle(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+	// 速い側の端数処理も通るよう、確認用は4の倍数にしない
+	const std::vector<size_t> counts =
+	    quick ? std::vector<size_t>{1003} : std::vector<size_t>{1000, 10000, 100000};
+	for (size_t count : counts) {
+		std::vector<Object> objects(count);
+		TransformSystem system;
+		system.Reserve(count);
+		for (Object& object : objects) {
+			object.scale = {scale(random), scale(random), scale(random)};
+			object.rotation = {angle(random), angle(random), angle(random)};
+			object.translation = {position(random), position(random), position(random)};
+			system.Add(object.scale, object.rotation, object.translation);
+		}
+		std::vector<uint8_t> constantBuffers(count * kConstantBufferStride);
+
+		// 1体ずつの更新
+		double aos = bench::Measure(repeat, [&] {
+			for (Object& object : objects) {
+				object.matWorld =
+				    MakeAffineMatrix(object.scale, object.rotation, object.translation);
+			}
+			bench::DoNotOptimize(objects[count - 1].matWorld);
+		});
+		// 一括更新
+		double soa = bench::Measure(repeat, [&] {
+			system.UpdateMatrices();
+			bench::DoNotOptimize(system.GetMatrix(static_cast<uint32_t>(count - 1)));
+		});
+		// 一括更新して定数バッファの並びへ直接書き込む
+		double soaStream = bench::Measure(repeat, [&] {
+			system.UpdateMatrices(constantBuffers.data(), kConstantBufferStride);
+			bench::DoNotOptimize(constantBuffers[0]);
+		});
+
+		// 結果の一致を確認する（SoA 側は sin/cos を多項式近似している）
+		for (size_t i = 0; i < count; i++) {
+			const Matrix4x4* streamed =
+			    reinterpret_cast<const Matrix4x4*>(&constantBuffers[i * kConstantBufferStride]);
+			bench::Check(
+			    NearlyEqual(objects[i].matWorld, system.GetMatrix(static_cast<uint32_t>(i))),
+			    "UpdateMatrices");
+			bench::Check(NearlyEqual(objects[i].matWorld, *streamed), "UpdateMatrices(dst)");
+		}
+
+		auto rate = [count](double milliseconds) {
+			return static_cast<double>(count) / milliseconds / 1000.0;
+		};
+		std::printf(
+		    "transform %6zu: AoS %7.3f ms (%6.1f M/s)  SoA %7.3f ms (%6.1f M/s)  "
+		    "SoA->cbuffer %7.3f ms (%6.1f M/s)\n",
+		    count, aos, rate(aos), soa, rate(soa), soaStream, rate(soaStream));
+	}
+	return 0;
+}
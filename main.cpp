@@ -1,13 +1,21 @@
 #include "Audio.h"
 #include "AxisIndicator.h"
 #include "DirectXCommon.h"
+#include "DirectXRenderBackend.h"
+#include "FixedTimestep.h"
 #include "GameScene.h"
 #include "ImGuiManager.h"
+#include "Input.h"
+#include "Model.h"
 #include "PrimitiveDrawer.h"
+#include "Sprite.h"
+#include "StreamingAudio.h"
 #include "TextureManager.h"
+#include "ThreadPool.h"
 #include "WinApp.h"
 
 // Windowsアプリでのエントリーポイント(main関数)
+// （ウィンドウ・GPUを使わない実行は bench/HeadlessMain.cpp）
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	WinApp* win = nullptr;
 	DirectXCommon* dxCommon = nullptr;
@@ -38,6 +46,10 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	// オーディオの初期化
 	audio = Audio::GetInstance();
 	audio->Initialize();
+	StreamingAudio::GetInstance()->Initialize(audio->GetXAudio2());
+
+	// スレッドプールの初期化（読み込み処理の並列化に使う）
+	ThreadPool::GetInstance()->Initialize();
 
 	// テクスチャマネージャの初期化
 	TextureManager::GetInstance()->Initialize(dxCommon->GetDevice());
@@ -57,9 +69,17 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 	primitiveDrawer->Initialize();
 #pragma endregion
 
+	// 描画バックエンドの初期化
+	DirectXRenderBackend renderBackend;
+	renderBackend.Initialize(dxCommon);
+
 	// ゲームシーンの初期化
 	gameScene = new GameScene();
-	gameScene->Initialize();
+	gameScene->Initialize(&renderBackend, input, audio);
+
+	// シミュレーション時間の初期化
+	FixedTimestep fixedTimestep;
+	fixedTimestep.Initialize();
 
 	// メインループ
 	while (true) {
@@ -70,17 +90,28 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 
 		// ImGui受付開始
 		imguiManager->Begin();
-		// 入力関連の毎フレーム処理
+		// 入力関連の毎フレーム処理（ステップ数に関わらず1回だけ読む）
 		input->Update();
-		// ゲームシーンの毎フレーム処理
-		gameScene->Update();
+		// 描画のレートに関わらず、シミュレーションは固定ステップで進める
+		uint32_t stepCount = fixedTimestep.Tick();
+		for (uint32_t i = 0; i < stepCount; i++) {
+			// ゲームシーンの毎ステップ処理
+			gameScene->Update();
+		}
 		// 軸表示の更新
 		axisIndicator->Update();
 		// ImGui受付終了
 		imguiManager->End();
+		// 次のステップまでの進み具合を描画に渡す
+		gameScene->SetInterpolationAlpha(fixedTimestep.GetAlpha());
+
+		// 非同期読み込みが終わったテクスチャの転送（前のフレームの描画は完了している）
+		TextureManager::GetInstance()->Update();
+		// ストリーミング再生の読み込みと、再生し終えたボイスの破棄
+		StreamingAudio::GetInstance()->Update();
 
 		// 描画開始
-		dxCommon->PreDraw();
+		renderBackend.BeginFrame();
 		// ゲームシーンの描画
 		gameScene->Draw();
 		// 軸表示の描画
@@ -90,11 +121,13 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 		// ImGui描画
 		imguiManager->Draw();
 		// 描画終了
-		dxCommon->PostDraw();
+		renderBackend.EndFrame();
 	}
 
 	// 各種解放
 	SafeDelete(gameScene);
+	ThreadPool::GetInstance()->Finalize();
+	StreamingAudio::GetInstance()->Finalize();
 	audio->Finalize();
 	// ImGui解放
 	imguiManager->Finalize();
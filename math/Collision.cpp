@@ -0,0 +1,36 @@
+#include "Collision.h"
+#include <algorithm>
+
+AABB MakeAABB(const Sphere& sphere) {
+	const Vector3& c = sphere.center;
+	float r = sphere.radius;
+	AABB aabb;
+	aabb.min = {c.x - r, c.y - r, c.z - r};
+	aabb.max = {c.x + r, c.y + r, c.z + r};
+	return aabb;
+}
+
+bool IsCollision(const Sphere& s1, const Sphere& s2) {
+	// 平方根を取らずに距離の2乗で比べる
+	float dx = s2.center.x - s1.center.x;
+	float dy = s2.center.y - s1.center.y;
+	float dz = s2.center.z - s1.center.z;
+	float r = s1.radius + s2.radius;
+	return dx * dx + dy * dy + dz * dz <= r * r;
+}
+
+bool IsCollision(const AABB& a1, const AABB& a2) {
+	return a1.min.x <= a2.max.x && a2.min.x <= a1.max.x && a1.min.y <= a2.max.y &&
+	       a2.min.y <= a1.max.y && a1.min.z <= a2.max.z && a2.min.z <= a1.max.z;
+}
+
+bool IsCollision(const Sphere& sphere, const AABB& aabb) {
+	// 球の中心に最も近いAABB上の点との距離で判定
+	const Vector3& c = sphere.center;
+	float dx = c.x - std::clamp(c.x, aabb.min.x, aabb.max.x);
+	float dy = c.y - std::clamp(c.y, aabb.min.y, aabb.max.y);
+	float dz = c.z - std::clamp(c.z, aabb.min.z, aabb.max.z);
+	return dx * dx + dy * dy + dz * dz <= sphere.radius * sphere.radius;
+}
+
+bool IsCollision(const AABB& aabb, const Sphere& sphere) { return IsCollision(sphere, aabb); }
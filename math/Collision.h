@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Vector3.h"
+
+/// <summary>
+/// 球
+/// </summary>
+struct Sphere final {
+	Vector3 center;
+	float radius;
+};
+
+/// <summary>
+/// 軸平行境界箱
+/// </summary>
+struct AABB final {
+	Vector3 min;
+	Vector3 max;
+};
+
+/// <summary>
+/// 球を囲むAABB
+/// </summary>
+AABB MakeAABB(const Sphere& sphere);
+
+/// <summary>
+/// 球と球の当たり判定
+/// </summary>
+bool IsCollision(const Sphere& s1, const Sphere& s2);
+
+/// <summary>
+/// AABBとAABBの当たり判定
+/// </summary>
+bool IsCollision(const AABB& a1, const AABB& a2);
+
+/// <summary>
+/// 球とAABBの当たり判定
+/// </summary>
+bool IsCollision(const Sphere& sphere, const AABB& aabb);
+bool IsCollision(const AABB& aabb, const Sphere& sphere);
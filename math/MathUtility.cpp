@@ -0,0 +1,367 @@
+#include "MathUtility.h"
+#include "SimdConfig.h"
+#include <cmath>
+
+#pragma region ベクトル演算
+Vector3 operator+(const Vector3& v1, const Vector3& v2) {
+	return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z};
+}
+
+Vector3 operator-(const Vector3& v1, const Vector3& v2) {
+	return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z};
+}
+
+Vector3 operator-(const Vector3& v) { return {-v.x, -v.y, -v.z}; }
+
+Vector3 operator*(const Vector3& v, float s) { return {v.x * s, v.y * s, v.z * s}; }
+
+Vector3 operator*(float s, const Vector3& v) { return v * s; }
+
+Vector3& operator+=(Vector3& v1, const Vector3& v2) { return v1 = v1 + v2; }
+
+Vector3& operator-=(Vector3& v1, const Vector3& v2) { return v1 = v1 - v2; }
+
+Vector3& operator*=(Vector3& v, float s) { return v = v * s; }
+
+float Dot(const Vector3& v1, const Vector3& v2) { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+
+Vector3 Cross(const Vector3& v1, const Vector3& v2) {
+	return {v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x};
+}
+
+float Length(const Vector3& v) { return std::sqrt(Dot(v, v)); }
+
+Vector3 Normalize(const Vector3& v) {
+	float length = Length(v);
+	if (length == 0.0f) {
+		return v;
+	}
+	return v * (1.0f / length);
+}
+#pragma endregion
+
+#pragma region 行列生成
+Matrix4x4 MakeIdentityMatrix() {
+	return {
+	    1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+	    0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+	};
+}
+
+Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
+	return {
+	    scale.x, 0.0f, 0.0f, 0.0f, 0.0f, scale.y, 0.0f, 0.0f,
+	    0.0f, 0.0f, scale.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+	};
+}
+
+Matrix4x4 MakeRotateXMatrix(float radian) {
+	float s = std::sin(radian);
+	float c = std::cos(radian);
+	return {
+	    1.0f, 0.0f, 0.0f, 0.0f, 0.0f, c, s, 0.0f, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+	};
+}
+
+Matrix4x4 MakeRotateYMatrix(float radian) {
+	float s = std::sin(radian);
+	float c = std::cos(radian);
+	return {
+	    c, 0.0f, -s, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, s, 0.0f, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+	};
+}
+
+Matrix4x4 MakeRotateZMatrix(float radian) {
+	float s = std::sin(radian);
+	float c = std::cos(radian);
+	return {
+	    c, s, 0.0f, 0.0f, -s, c, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+	};
+}
+
+Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
+	return {
+	    1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f,
+	    0.0f, 0.0f, 1.0f, 0.0f, translate.x, translate.y, translate.z, 1.0f,
+	};
+}
+
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	// S * Rx * Ry * Rz * T を展開した式
+	float sx = std::sin(rotate.x), cx = std::cos(rotate.x);
+	float sy = std::sin(rotate.y), cy = std::cos(rotate.y);
+	float sz = std::sin(rotate.z), cz = std::cos(rotate.z);
+
+	Matrix4x4 result;
+	result.m[0][0] = scale.x * (cy * cz);
+	result.m[0][1] = scale.x * (cy * sz);
+	result.m[0][2] = scale.x * (-sy);
+	result.m[0][3] = 0.0f;
+	result.m[1][0] = scale.y * (sx * sy * cz - cx * sz);
+	result.m[1][1] = scale.y * (sx * sy * sz + cx * cz);
+	result.m[1][2] = scale.y * (sx * cy);
+	result.m[1][3] = 0.0f;
+	result.m[2][0] = scale.z * (cx * sy * cz + sx * sz);
+	result.m[2][1] = scale.z * (cx * sy * sz - sx * cz);
+	result.m[2][2] = scale.z * (cx * cy);
+	result.m[2][3] = 0.0f;
+	result.m[3][0] = translate.x;
+	result.m[3][1] = translate.y;
+	result.m[3][2] = translate.z;
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip) {
+	float yScale = 1.0f / std::tan(fovY * 0.5f);
+	float xScale = yScale / aspectRatio;
+	float zRange = farClip / (farClip - nearClip);
+	return {
+	    xScale, 0.0f, 0.0f, 0.0f, 0.0f, yScale, 0.0f, 0.0f,
+	    0.0f, 0.0f, zRange, 1.0f, 0.0f, 0.0f, -nearClip * zRange, 0.0f,
+	};
+}
+#pragma endregion
+
+#pragma region 行列演算
+Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result;
+#if defined(MATH_USE_AVX2)
+	// 2行ずつ処理する。m2の各行を上下128bitに複製しておく
+	__m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[0]));
+	__m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[1]));
+	__m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[2]));
+	__m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[3]));
+	for (int i = 0; i < 4; i += 2) {
+		__m256 a = _mm256_loadu_ps(m1.m[i]);
+		__m256 r = _mm256_mul_ps(_mm256_permute_ps(a, 0x00), b0);
+		r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(a, 0x55), b1));
+		r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(a, 0xaa), b2));
+		r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(a, 0xff), b3));
+		_mm256_storeu_ps(result.m[i], r);
+	}
+#elif defined(MATH_USE_SSE)
+	__m128 b0 = _mm_loadu_ps(m2.m[0]);
+	__m128 b1 = _mm_loadu_ps(m2.m[1]);
+	__m128 b2 = _mm_loadu_ps(m2.m[2]);
+	__m128 b3 = _mm_loadu_ps(m2.m[3]);
+	for (int i = 0; i < 4; ++i) {
+		__m128 r = _mm_mul_ps(_mm_set1_ps(m1.m[i][0]), b0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][1]), b1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][2]), b2));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1.m[i][3]), b3));
+		_mm_storeu_ps(result.m[i], r);
+	}
+#else
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] +
+			                 m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+		}
+	}
+#endif
+	return result;
+}
+
+Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2) { return Multiply(m1, m2); }
+
+Matrix4x4& operator*=(Matrix4x4& m1, const Matrix4x4& m2) { return m1 = Multiply(m1, m2); }
+
+Matrix4x4 Transpose(const Matrix4x4& m) {
+	Matrix4x4 result;
+#if defined(MATH_USE_SSE)
+	__m128 r0 = _mm_loadu_ps(m.m[0]);
+	__m128 r1 = _mm_loadu_ps(m.m[1]);
+	__m128 r2 = _mm_loadu_ps(m.m[2]);
+	__m128 r3 = _mm_loadu_ps(m.m[3]);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	_mm_storeu_ps(result.m[0], r0);
+	_mm_storeu_ps(result.m[1], r1);
+	_mm_storeu_ps(result.m[2], r2);
+	_mm_storeu_ps(result.m[3], r3);
+#else
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m.m[j][i];
+		}
+	}
+#endif
+	return result;
+}
+
+Matrix4x4 InverseAffine(const Matrix4x4& m) {
+	// 上3x3の行を r0,r1,r2 とすると、逆行列の列は (r1×r2, r2×r0, r0×r1) / det になる
+	Matrix4x4 result;
+#if defined(MATH_USE_SSE)
+	const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	__m128 r0 = _mm_and_ps(_mm_loadu_ps(m.m[0]), mask);
+	__m128 r1 = _mm_and_ps(_mm_loadu_ps(m.m[1]), mask);
+	__m128 r2 = _mm_and_ps(_mm_loadu_ps(m.m[2]), mask);
+	__m128 t = _mm_and_ps(_mm_loadu_ps(m.m[3]), mask);
+
+	auto cross = [](__m128 a, __m128 b) {
+		__m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+		return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+	};
+	__m128 c0 = cross(r1, r2);
+	__m128 c1 = cross(r2, r0);
+	__m128 c2 = cross(r0, r1);
+
+	// det = r0・(r1×r2)
+	__m128 d = _mm_mul_ps(r0, c0);
+	d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+	d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+	__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), d);
+	c0 = _mm_mul_ps(c0, invDet);
+	c1 = _mm_mul_ps(c1, invDet);
+	c2 = _mm_mul_ps(c2, invDet);
+
+	// 列として並べた c0,c1,c2 を行に直す
+	__m128 c3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+	// 平行移動成分 -t * A^-1
+	__m128 it = _mm_mul_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0)), c0);
+	it = _mm_add_ps(it, _mm_mul_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)), c1));
+	it = _mm_add_ps(it, _mm_mul_ps(_mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)), c2));
+	it = _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), _mm_and_ps(it, mask));
+
+	_mm_storeu_ps(result.m[0], c0);
+	_mm_storeu_ps(result.m[1], c1);
+	_mm_storeu_ps(result.m[2], c2);
+	_mm_storeu_ps(result.m[3], it);
+#else
+	Vector3 r0 = {m.m[0][0], m.m[0][1], m.m[0][2]};
+	Vector3 r1 = {m.m[1][0], m.m[1][1], m.m[1][2]};
+	Vector3 r2 = {m.m[2][0], m.m[2][1], m.m[2][2]};
+	Vector3 c[3] = {Cross(r1, r2), Cross(r2, r0), Cross(r0, r1)};
+	float invDet = 1.0f / Dot(r0, c[0]);
+	for (int j = 0; j < 3; ++j) {
+		result.m[0][j] = c[j].x * invDet;
+		result.m[1][j] = c[j].y * invDet;
+		result.m[2][j] = c[j].z * invDet;
+		result.m[j][3] = 0.0f;
+	}
+	for (int j = 0; j < 3; ++j) {
+		result.m[3][j] = -(m.m[3][0] * result.m[0][j] + m.m[3][1] * result.m[1][j] +
+		                   m.m[3][2] * result.m[2][j]);
+	}
+	result.m[3][3] = 1.0f;
+#endif
+	return result;
+}
+
+Vector3 TransformPoint(const Vector3& point, const Matrix4x4& m) {
+	return {
+	    point.x * m.m[0][0] + point.y * m.m[1][0] + point.z * m.m[2][0] + m.m[3][0],
+	    point.x * m.m[0][1] + point.y * m.m[1][1] + point.z * m.m[2][1] + m.m[3][1],
+	    point.x * m.m[0][2] + point.y * m.m[1][2] + point.z * m.m[2][2] + m.m[3][2],
+	};
+}
+
+Vector3 TransformVector(const Vector3& vector, const Matrix4x4& m) {
+	return {
+	    vector.x * m.m[0][0] + vector.y * m.m[1][0] + vector.z * m.m[2][0],
+	    vector.x * m.m[0][1] + vector.y * m.m[1][1] + vector.z * m.m[2][1],
+	    vector.x * m.m[0][2] + vector.y * m.m[1][2] + vector.z * m.m[2][2],
+	};
+}
+
+Vector4 Transform(const Vector4& v, const Matrix4x4& m) {
+	Vector4 result;
+#if defined(MATH_USE_SSE)
+	__m128 r = _mm_mul_ps(_mm_set1_ps(v.x), _mm_loadu_ps(m.m[0]));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.y), _mm_loadu_ps(m.m[1])));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.z), _mm_loadu_ps(m.m[2])));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.w), _mm_loadu_ps(m.m[3])));
+	_mm_storeu_ps(&result.x, r);
+#else
+	result.x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + v.w * m.m[3][0];
+	result.y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + v.w * m.m[3][1];
+	result.z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + v.w * m.m[3][2];
+	result.w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + v.w * m.m[3][3];
+#endif
+	return result;
+}
+#pragma endregion
+
+#pragma region 配列一括処理
+namespace {
+
+#if defined(MATH_USE_SSE)
+// Vector3 (12byte) を読み書きする。隣の要素を踏まないように分割してアクセス
+inline void StoreVector3(Vector3* dst, __m128 v) {
+	_mm_storel_pi(reinterpret_cast<__m64*>(&dst->x), v);
+	_mm_store_ss(&dst->z, _mm_movehl_ps(v, v));
+}
+#endif
+
+// 座標・ベクトル共通の一括変換。w に 1 か 0 を指定する
+template<bool kHasTranslation>
+void TransformArray(const Vector3* src, Vector3* dst, size_t count, const Matrix4x4& m) {
+	size_t i = 0;
+#if defined(MATH_USE_AVX2)
+	// 2要素ずつ処理する
+	__m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.m[0]));
+	__m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.m[1]));
+	__m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.m[2]));
+	__m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m.m[3]));
+	for (; i + 2 <= count; i += 2) {
+		const Vector3& a = src[i];
+		const Vector3& b = src[i + 1];
+		__m256 x = _mm256_insertf128_ps(
+		    _mm256_castps128_ps256(_mm_set1_ps(a.x)), _mm_set1_ps(b.x), 1);
+		__m256 y = _mm256_insertf128_ps(
+		    _mm256_castps128_ps256(_mm_set1_ps(a.y)), _mm_set1_ps(b.y), 1);
+		__m256 z = _mm256_insertf128_ps(
+		    _mm256_castps128_ps256(_mm_set1_ps(a.z)), _mm_set1_ps(b.z), 1);
+		__m256 r = _mm256_mul_ps(x, r0);
+		r = _mm256_add_ps(r, _mm256_mul_ps(y, r1));
+		r = _mm256_add_ps(r, _mm256_mul_ps(z, r2));
+		if constexpr (kHasTranslation) {
+			r = _mm256_add_ps(r, r3);
+		}
+		StoreVector3(&dst[i], _mm256_castps256_ps128(r));
+		StoreVector3(&dst[i + 1], _mm256_extractf128_ps(r, 1));
+	}
+#endif
+#if defined(MATH_USE_SSE)
+	__m128 s0 = _mm_loadu_ps(m.m[0]);
+	__m128 s1 = _mm_loadu_ps(m.m[1]);
+	__m128 s2 = _mm_loadu_ps(m.m[2]);
+	__m128 s3 = _mm_loadu_ps(m.m[3]);
+	for (; i < count; ++i) {
+		const Vector3& v = src[i];
+		__m128 r = _mm_mul_ps(_mm_set1_ps(v.x), s0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.y), s1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.z), s2));
+		if constexpr (kHasTranslation) {
+			r = _mm_add_ps(r, s3);
+		}
+		StoreVector3(&dst[i], r);
+	}
+#else
+	for (; i < count; ++i) {
+		dst[i] = kHasTranslation ? TransformPoint(src[i], m) : TransformVector(src[i], m);
+	}
+#endif
+}
+
+} // namespace
+
+void TransformPoints(const Vector3* src, Vector3* dst, size_t count, const Matrix4x4& m) {
+	TransformArray<true>(src, dst, count, m);
+}
+
+void TransformVectors(const Vector3* src, Vector3* dst, size_t count, const Matrix4x4& m) {
+	TransformArray<false>(src, dst, count, m);
+}
+
+void MultiplyMatrices(const Matrix4x4* src, Matrix4x4* dst, size_t count, const Matrix4x4& m) {
+	for (size_t i = 0; i < count; ++i) {
+		dst[i] = Multiply(src[i], m);
+	}
+}
+#pragma endregion
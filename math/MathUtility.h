@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Matrix4x4.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include <cstddef>
+#include <type_traits>
+
+// シェーダー側の row_major 行列とそのまま一致するレイアウトであること
+static_assert(sizeof(Vector3) == sizeof(float) * 3);
+static_assert(sizeof(Vector4) == sizeof(float) * 4);
+static_assert(sizeof(Matrix4x4) == sizeof(float) * 16);
+static_assert(std::is_standard_layout_v<Matrix4x4> && std::is_trivially_copyable_v<Matrix4x4>);
+
+// 行列はすべて行ベクトル方式 (v' = v * M)。HLSLの mul(pos, world) と同じ並び
+
+#pragma region ベクトル演算
+Vector3 operator+(const Vector3& v1, const Vector3& v2);
+Vector3 operator-(const Vector3& v1, const Vector3& v2);
+Vector3 operator-(const Vector3& v);
+Vector3 operator*(const Vector3& v, float s);
+Vector3 operator*(float s, const Vector3& v);
+Vector3& operator+=(Vector3& v1, const Vector3& v2);
+Vector3& operator-=(Vector3& v1, const Vector3& v2);
+Vector3& operator*=(Vector3& v, float s);
+
+/// <summary>
+/// 内積
+/// </summary>
+float Dot(const Vector3& v1, const Vector3& v2);
+
+/// <summary>
+/// クロス積
+/// </summary>
+Vector3 Cross(const Vector3& v1, const Vector3& v2);
+
+/// <summary>
+/// 長さ
+/// </summary>
+float Length(const Vector3& v);
+
+/// <summary>
+/// 正規化（長さ0ならそのまま返す）
+/// </summary>
+Vector3 Normalize(const Vector3& v);
+#pragma endregion
+
+#pragma region 行列生成
+/// <summary>
+/// 単位行列
+/// </summary>
+Matrix4x4 MakeIdentityMatrix();
+
+/// <summary>
+/// 拡大縮小行列
+/// </summary>
+Matrix4x4 MakeScaleMatrix(const Vector3& scale);
+
+/// <summary>
+/// X軸回転行列
+/// </summary>
+Matrix4x4 MakeRotateXMatrix(float radian);
+
+/// <summary>
+/// Y軸回転行列
+/// </summary>
+Matrix4x4 MakeRotateYMatrix(float radian);
+
+/// <summary>
+/// Z軸回転行列
+/// </summary>
+Matrix4x4 MakeRotateZMatrix(float radian);
+
+/// <summary>
+/// 平行移動行列
+/// </summary>
+Matrix4x4 MakeTranslateMatrix(const Vector3& translate);
+
+/// <summary>
+/// アフィン変換行列（スケール → X,Y,Z回転 → 平行移動）
+/// </summary>
+/// <param name="scale">スケール</param>
+/// <param name="rotate">X,Y,Z軸回りの回転角</param>
+/// <param name="translate">平行移動</param>
+Matrix4x4 MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate);
+
+/// <summary>
+/// 透視投影行列（左手座標系、深度0～1）
+/// </summary>
+Matrix4x4 MakePerspectiveFovMatrix(float fovY, float aspectRatio, float nearClip, float farClip);
+#pragma endregion
+
+#pragma region 行列演算
+/// <summary>
+/// 行列の積
+/// </summary>
+Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
+Matrix4x4 operator*(const Matrix4x4& m1, const Matrix4x4& m2);
+Matrix4x4& operator*=(Matrix4x4& m1, const Matrix4x4& m2);
+
+/// <summary>
+/// 転置行列
+/// </summary>
+Matrix4x4 Transpose(const Matrix4x4& m);
+
+/// <summary>
+/// アフィン変換行列の逆行列（4列目が (0,0,0,1) であること）
+/// </summary>
+Matrix4x4 InverseAffine(const Matrix4x4& m);
+
+/// <summary>
+/// 座標変換（w=1として扱う。アフィン変換専用で同次除算はしない）
+/// </summary>
+Vector3 TransformPoint(const Vector3& point, const Matrix4x4& m);
+
+/// <summary>
+/// ベクトル変換（w=0として扱う。平行移動は無視される）
+/// </summary>
+Vector3 TransformVector(const Vector3& vector, const Matrix4x4& m);
+
+/// <summary>
+/// 同次座標変換
+/// </summary>
+Vector4 Transform(const Vector4& v, const Matrix4x4& m);
+#pragma endregion
+
+#pragma region 配列一括処理
+/// <summary>
+/// 座標配列の一括変換（src と dst は同じ配列でもよい）
+/// </summary>
+void TransformPoints(const Vector3* src, Vector3* dst, size_t count, const Matrix4x4& m);
+
+/// <summary>
+/// ベクトル配列の一括変換（src と dst は同じ配列でもよい）
+/// </summary>
+void TransformVectors(const Vector3* src, Vector3* dst, size_t count, const Matrix4x4& m);
+
+/// <summary>
+/// 行列配列に同じ行列を右から掛ける (dst[i] = src[i] * m)
+/// </summary>
+void MultiplyMatrices(const Matrix4x4* src, Matrix4x4* dst, size_t count, const Matrix4x4& m);
+#pragma endregion
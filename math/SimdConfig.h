@@ -0,0 +1,16 @@
+#pragma once
+
+// SIMD命令の使用設定
+// MATH_NO_SIMD を定義するとスカラー実装に切り替わる
+#if !defined(MATH_NO_SIMD) && (defined(_M_X64) || defined(__SSE2__))
+#define MATH_USE_SSE 1
+#endif
+
+// AVX2は /arch:AVX2 (MSVC) か -mavx2 (GCC/Clang) を指定した時のみ有効
+#if defined(MATH_USE_SSE) && defined(__AVX2__)
+#define MATH_USE_AVX2 1
+#endif
+
+#if defined(MATH_USE_SSE)
+#include <immintrin.h>
+#endif
@@ -1,61 +1,48 @@
 #include "GameScene.h"
-#include "TextureManager.h"
 #include <cassert>
 
 GameScene::GameScene() {}
 
 GameScene::~GameScene() {}
 
-void GameScene::Initialize() {
+void GameScene::Initialize(RenderBackend* renderBackend, Input* input, Audio* audio) {
+	assert(renderBackend);
 
-	dxCommon_ = DirectXCommon::GetInstance();
-	input_ = Input::GetInstance();
-	audio_ = Audio::GetInstance();
+	input_ = input;
+	audio_ = audio;
+	renderBackend_ = renderBackend;
+	renderSink_.Initialize(renderBackend_);
 }
 
 void GameScene::Update() {}
 
 void GameScene::Draw() {
 
-	// コマンドリストの取得
-	ID3D12GraphicsCommandList* commandList = dxCommon_->GetCommandList();
+	// 描画要求は renderQueue_ に積み、最後にソートしてまとめて描く
+	// （描画パスの切り替えと深度バッファのクリアはキューの出力時に行う）
 
 #pragma region 背景スプライト描画
-	// 背景スプライト描画前処理
-	Sprite::PreDraw(commandList);
-
 	/// <summary>
 	/// ここに背景スプライトの描画処理を追加できる
+	/// renderQueue_.SubmitSprite(RenderLayer::kBackground, sprite);
 	/// </summary>
-
-	// スプライト描画後処理
-	Sprite::PostDraw();
-	// 深度バッファクリア
-	dxCommon_->ClearDepthBuffer();
 #pragma endregion
 
 #pragma region 3Dオブジェクト描画
-	// 3Dオブジェクト描画前処理
-	Model::PreDraw(commandList);
-
 	/// <summary>
 	/// ここに3Dオブジェクトの描画処理を追加できる
+	/// 動く物体は前回と今回のステップの状態を interpolationAlpha_ で補間した位置に描く
+	/// renderQueue_.SubmitModel(RenderLayer::kWorld, model, worldTransform, viewProjection);
 	/// </summary>
-
-	// 3Dオブジェクト描画後処理
-	Model::PostDraw();
 #pragma endregion
 
 #pragma region 前景スプライト描画
-	// 前景スプライト描画前処理
-	Sprite::PreDraw(commandList);
-
 	/// <summary>
 	/// ここに前景スプライトの描画処理を追加できる
+	/// renderQueue_.SubmitSprite(RenderLayer::kForeground, sprite);
 	/// </summary>
-
-	// スプライト描画後処理
-	Sprite::PostDraw();
-
 #pragma endregion
+
+	// ソートして描画（renderBackend_ 経由なのでGPUの無い実行でもそのまま動く）
+	renderQueue_.Flush(renderSink_);
 }
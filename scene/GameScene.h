@@ -1,14 +1,19 @@
 #pragma once
 
-#include "Audio.h"
-#include "DirectXCommon.h"
-#include "Input.h"
-#include "Model.h"
+#include "RenderBackend.h"
+#include "RenderBackendCommandSink.h"
+#include "RenderQueue.h"
 #include "SafeDelete.h"
-#include "Sprite.h"
 #include "ViewProjection.h"
 #include "WorldTransform.h"
 
+// GPU・ウィンドウを使わない実行（ヘッドレス）でもビルドできるよう、
+// DirectX に依存するクラスは前方宣言に留める
+class Audio;
+class Input;
+class Model;
+class Sprite;
+
 /// <summary>
 /// ゲームシーン
 /// </summary>
@@ -28,7 +33,10 @@ public: // メンバ関数
 	/// <summary>
 	/// 初期化
 	/// </summary>
-	void Initialize();
+	/// <param name="renderBackend">描画バックエンド（借りてくる）</param>
+	/// <param name="input">入力（借りてくる。ヘッドレス実行では nullptr）</param>
+	/// <param name="audio">オーディオ（借りてくる。ヘッドレス実行では nullptr）</param>
+	void Initialize(RenderBackend* renderBackend, Input* input = nullptr, Audio* audio = nullptr);
 
 	/// <summary>
 	/// 毎フレーム処理
@@ -40,10 +48,28 @@ public: // メンバ関数
 	/// </summary>
 	void Draw();
 
+	/// <summary>
+	/// 描画用の補間係数の設定
+	/// 固定ステップの間を描画するときに前回と今回の状態を補間するのに使う
+	/// </summary>
+	/// <param name="alpha">前回のステップから次のステップまでの進み具合 [0, 1)</param>
+	void SetInterpolationAlpha(float alpha) { interpolationAlpha_ = alpha; }
+
+	/// <summary>
+	/// 描画キューの取得（直前のフレームの描画・状態設定・ソート時間の統計を見るのに使う）
+	/// </summary>
+	const RenderQueue& GetRenderQueue() const { return renderQueue_; }
+
 private: // メンバ変数
-	DirectXCommon* dxCommon_ = nullptr;
 	Input* input_ = nullptr;
 	Audio* audio_ = nullptr;
+	RenderBackend* renderBackend_ = nullptr;
+	// 描画キュー（描画要求をソートしてまとめて出す）
+	RenderQueue renderQueue_;
+	// 描画キューの出力先
+	RenderBackendCommandSink renderSink_;
+	// 描画用の補間係数
+	float interpolationAlpha_ = 0.0f;
 
 	/// <summary>
 	/// ゲームシーン用
@@ -0,0 +1,127 @@
+#include "AsyncTextureLoader.h"
+#include "MappedFile.h"
+#include "MipGenerator.h"
+#include "PngDecoder.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// Resources を作業ディレクトリにして実行する（test/CMakeLists.txt を参照）
+
+namespace {
+
+class AsyncTextureLoaderTest : public testing::Test {
+protected:
+	void SetUp() override {
+		threadPool_ = ThreadPool::GetInstance();
+		threadPool_->Initialize(2);
+		loader_.Initialize(threadPool_);
+	}
+	void TearDown() override {
+		loader_.Clear();
+		threadPool_->Finalize();
+	}
+
+	// 全部終わるのを待って結果を取り出す
+	std::vector<AsyncTextureLoader::Result> WaitResults() {
+		loader_.WaitAll();
+		std::vector<AsyncTextureLoader::Result> results;
+		loader_.TakeCompleted(SIZE_MAX, &results);
+		return results;
+	}
+
+	ThreadPool* threadPool_ = nullptr;
+	AsyncTextureLoader loader_;
+};
+
+} // namespace
+
+TEST_F(AsyncTextureLoaderTest, DecodesPngWithFullMipChain) {
+	loader_.Request(200, "uvChecker.png", "uvChecker.png");
+	std::vector<AsyncTextureLoader::Result> results = WaitResults();
+	ASSERT_EQ(results.size(), 1u);
+	const AsyncTextureLoader::Result& result = results[0];
+	EXPECT_EQ(result.handle, 200u);
+	EXPECT_EQ(result.name, "uvChecker.png");
+	ASSERT_TRUE(result.decoded);
+	EXPECT_FALSE(result.dds.IsOpen());
+
+	// 1x1 までのミップマップが続けて並ぶ
+	const TextureImage& image = result.image;
+	ASSERT_FALSE(image.mips.empty());
+	EXPECT_EQ(image.mips.back().width, 1u);
+	EXPECT_EQ(image.mips.back().height, 1u);
+	size_t offset = 0;
+	for (size_t mip = 0; mip < image.mips.size(); mip++) {
+		EXPECT_EQ(image.mips[mip].offset, offset);
+		if (0 < mip) {
+			EXPECT_EQ(image.mips[mip].width, std::max(1u, image.mips[mip - 1].width / 2));
+			EXPECT_EQ(image.mips[mip].height, std::max(1u, image.mips[mip - 1].height / 2));
+		}
+		offset += image.GetSlicePitch(mip);
+	}
+	EXPECT_EQ(image.pixels.size(), offset);
+}
+
+TEST_F(AsyncTextureLoaderTest, MatchesSynchronousDecode) {
+	const std::vector<std::string> names = {"uvChecker.png", "sample.png", "tex1.png"};
+	for (uint32_t i = 0; i < names.size(); i++) {
+		loader_.Request(i, names[i], names[i]);
+	}
+	std::vector<AsyncTextureLoader::Result> results = WaitResults();
+	ASSERT_EQ(results.size(), names.size());
+
+	// 終わった順に並ぶので、ハンドルで元の要求を引く
+	for (const AsyncTextureLoader::Result& result : results) {
+		ASSERT_LT(result.handle, names.size());
+		EXPECT_EQ(result.name, names[result.handle]);
+		ASSERT_TRUE(result.decoded);
+
+		MappedFile file;
+		ASSERT_TRUE(file.Open(names[result.handle]));
+		TextureImage expected;
+		ASSERT_TRUE(PngDecoder::Decode(file.GetData(), file.GetSize(), &expected));
+		MipGenerator::Generate(&expected, MipGenerator::Filter::kBox);
+		EXPECT_EQ(result.image.pixels, expected.pixels) << result.name;
+	}
+}
+
+TEST_F(AsyncTextureLoaderTest, UnsupportedOrMissingFilesAreNotDecoded) {
+	loader_.Request(1, "fanfare.wav", "fanfare.wav");
+	loader_.Request(2, "missing.png", "missing.png");
+	std::vector<AsyncTextureLoader::Result> results = WaitResults();
+	ASSERT_EQ(results.size(), 2u);
+	for (const AsyncTextureLoader::Result& result : results) {
+		// 呼び出し側が別の方法で読み直せるよう、結果は返ってくる
+		EXPECT_FALSE(result.decoded) << result.name;
+		EXPECT_TRUE(result.image.pixels.empty()) << result.name;
+	}
+}
+
+TEST_F(AsyncTextureLoaderTest, ByteBudgetSpreadsResultsOverFrames) {
+	loader_.Request(1, "uvChecker.png", "uvChecker.png");
+	loader_.Request(2, "sample.png", "sample.png");
+	loader_.Request(3, "white1x1.png", "white1x1.png");
+	loader_.WaitAll();
+	EXPECT_EQ(loader_.GetInFlightCount(), 0u);
+
+	// 上限が小さくても1件ずつは取り出せる
+	std::vector<AsyncTextureLoader::Result> results;
+	EXPECT_EQ(loader_.TakeCompleted(1, &results), 1u);
+	EXPECT_EQ(loader_.TakeCompleted(1, &results), 1u);
+	EXPECT_EQ(loader_.TakeCompleted(1, &results), 1u);
+	EXPECT_EQ(loader_.TakeCompleted(1, &results), 0u);
+	EXPECT_EQ(results.size(), 3u);
+}
+
+TEST_F(AsyncTextureLoaderTest, ClearDropsCompletedResults) {
+	loader_.Request(1, "uvChecker.png", "uvChecker.png");
+	loader_.Request(2, "sample.png", "sample.png");
+	loader_.Clear();
+	EXPECT_EQ(loader_.GetInFlightCount(), 0u);
+	std::vector<AsyncTextureLoader::Result> results;
+	EXPECT_EQ(loader_.TakeCompleted(SIZE_MAX, &results), 0u);
+}
@@ -0,0 +1,187 @@
+#include "AtlasPacker.h"
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 2つの矩形の間が gap 以上空いているか
+bool IsSeparated(const AtlasRect& a, const AtlasRect& b, uint32_t gap) {
+	return a.x + a.width + gap <= b.x || b.x + b.width + gap <= a.x ||
+	       a.y + a.height + gap <= b.y || b.y + b.height + gap <= a.y;
+}
+
+// 大きさがまちまちな画像の一覧
+std::vector<AtlasRect> MakeSizes(uint32_t count, uint32_t seed) {
+	std::mt19937 random(seed);
+	std::uniform_int_distribution<uint32_t> size(4, 120);
+	std::vector<AtlasRect> sizes(count);
+	for (AtlasRect& rect : sizes) {
+		rect.width = size(random);
+		rect.height = size(random);
+	}
+	return sizes;
+}
+
+} // namespace
+
+TEST(AtlasPackerTest, MaxRectsFillsPageExactly) {
+	MaxRectsPacker packer;
+	packer.Initialize(128, 128);
+	std::vector<AtlasRect> rects(4);
+	for (AtlasRect& rect : rects) {
+		ASSERT_TRUE(packer.Insert(64, 64, &rect));
+	}
+	for (size_t i = 0; i < rects.size(); i++) {
+		for (size_t j = i + 1; j < rects.size(); j++) {
+			EXPECT_TRUE(IsSeparated(rects[i], rects[j], 0));
+		}
+	}
+	EXPECT_EQ(packer.GetUsedArea(), 128u * 128u);
+	EXPECT_EQ(packer.GetUsedWidth(), 128u);
+	EXPECT_EQ(packer.GetUsedHeight(), 128u);
+
+	// 満杯なら1ピクセルも入らない
+	AtlasRect rect;
+	EXPECT_FALSE(packer.Insert(1, 1, &rect));
+}
+
+TEST(AtlasPackerTest, MaxRectsRejectsOversizedRect) {
+	MaxRectsPacker packer;
+	packer.Initialize(64, 32);
+	AtlasRect rect;
+	EXPECT_FALSE(packer.Insert(65, 1, &rect));
+	EXPECT_FALSE(packer.Insert(1, 33, &rect));
+	EXPECT_TRUE(packer.Insert(64, 32, &rect));
+	EXPECT_EQ(rect.x, 0u);
+	EXPECT_EQ(rect.y, 0u);
+}
+
+TEST(AtlasPackerTest, PackedImagesStayInsidePagesAndApart) {
+	constexpr uint32_t kPageSize = 512;
+	constexpr uint32_t kPadding = 2;
+	std::vector<AtlasRect> sizes = MakeSizes(200, 3);
+	AtlasLayout layout;
+	ASSERT_TRUE(PackAtlas(sizes, kPageSize, kPadding, &layout));
+	ASSERT_EQ(layout.placements.size(), sizes.size());
+	ASSERT_FALSE(layout.pages.empty());
+
+	uint64_t imageArea = 0;
+	for (size_t i = 0; i < sizes.size(); i++) {
+		const AtlasLayout::Placement& placement = layout.placements[i];
+		ASSERT_LT(placement.page, layout.pages.size());
+		const AtlasLayout::Page& page = layout.pages[placement.page];
+		// 大きさは入力のまま、周囲にも余白を残してページ内に収まる
+		EXPECT_EQ(placement.rect.width, sizes[i].width);
+		EXPECT_EQ(placement.rect.height, sizes[i].height);
+		EXPECT_GE(placement.rect.x, kPadding);
+		EXPECT_GE(placement.rect.y, kPadding);
+		EXPECT_LE(placement.rect.x + placement.rect.width + kPadding, page.width);
+		EXPECT_LE(placement.rect.y + placement.rect.height + kPadding, page.height);
+		imageArea += uint64_t(sizes[i].width) * sizes[i].height;
+
+		// 同じページの画像とは余白以上離れている
+		for (size_t j = i + 1; j < sizes.size(); j++) {
+			if (layout.placements[j].page == placement.page) {
+				EXPECT_TRUE(IsSeparated(placement.rect, layout.placements[j].rect, kPadding))
+				    << i << " and " << j;
+			}
+		}
+	}
+
+	// ページは2の累乗で、最大の大きさを超えない
+	uint64_t pageArea = 0;
+	for (const AtlasLayout::Page& page : layout.pages) {
+		EXPECT_TRUE(std::has_single_bit(page.width));
+		EXPECT_TRUE(std::has_single_bit(page.height));
+		EXPECT_LE(page.width, kPageSize);
+		EXPECT_LE(page.height, kPageSize);
+		pageArea += uint64_t(page.width) * page.height;
+	}
+	// 詰め込みの効率（余白込みでも半分以上は画像で埋まる）
+	EXPECT_GT(static_cast<double>(imageArea) / static_cast<double>(pageArea), 0.5);
+}
+
+TEST(AtlasPackerTest, SmallSetShrinksToOnePowerOfTwoPage) {
+	std::vector<AtlasRect> sizes = {{0, 0, 30, 20}, {0, 0, 10, 10}, {0, 0, 16, 8}};
+	AtlasLayout layout;
+	ASSERT_TRUE(PackAtlas(sizes, 1024, 1, &layout));
+	ASSERT_EQ(layout.pages.size(), 1u);
+	EXPECT_LE(layout.pages[0].width, 64u);
+	EXPECT_LE(layout.pages[0].height, 64u);
+}
+
+TEST(AtlasPackerTest, OversizedImageFailsButOthersArePlaced) {
+	std::vector<AtlasRect> sizes = {{0, 0, 32, 32}, {0, 0, 300, 10}, {0, 0, 16, 16}};
+	AtlasLayout layout;
+	EXPECT_FALSE(PackAtlas(sizes, 256, 1, &layout));
+	ASSERT_EQ(layout.placements.size(), 3u);
+	// 置けなかった画像は大きさ0のまま、他は置かれる
+	EXPECT_EQ(layout.placements[1].rect.width, 0u);
+	EXPECT_EQ(layout.placements[0].rect.width, 32u);
+	EXPECT_EQ(layout.placements[2].rect.width, 16u);
+	EXPECT_TRUE(IsSeparated(layout.placements[0].rect, layout.placements[2].rect, 1));
+}
+
+TEST(AtlasPackerTest, OverflowStartsNewPage) {
+	// 1ページに4枚しか入らない大きさを5枚
+	std::vector<AtlasRect> sizes(5, AtlasRect{0, 0, 60, 60});
+	AtlasLayout layout;
+	ASSERT_TRUE(PackAtlas(sizes, 128, 2, &layout));
+	ASSERT_EQ(layout.pages.size(), 2u);
+	uint32_t secondPageCount = 0;
+	for (const AtlasLayout::Placement& placement : layout.placements) {
+		secondPageCount += placement.page == 1 ? 1 : 0;
+	}
+	EXPECT_EQ(secondPageCount, 1u);
+}
+
+TEST(AtlasPackerTest, TableRoundTrip) {
+	AtlasTable table;
+	table.pageFiles = {"atlas_0.png", "atlas 1.png"};
+	table.entries = {
+	    {"player.png", 0, {2, 2, 64, 64}},
+	    {"enemy boss.png", 1, {68, 2, 128, 96}},
+	};
+	std::string filePath =
+	    (std::filesystem::temp_directory_path() / "AtlasPackerTest.atlas").string();
+	ASSERT_TRUE(WriteAtlasTable(filePath, table));
+
+	AtlasTable loaded;
+	ASSERT_TRUE(ReadAtlasTable(filePath, &loaded));
+	EXPECT_EQ(loaded.pageFiles, table.pageFiles);
+	ASSERT_EQ(loaded.entries.size(), table.entries.size());
+	for (size_t i = 0; i < table.entries.size(); i++) {
+		// 空白を含む名前もそのまま戻る
+		EXPECT_EQ(loaded.entries[i].name, table.entries[i].name);
+		EXPECT_EQ(loaded.entries[i].page, table.entries[i].page);
+		EXPECT_EQ(loaded.entries[i].rect.x, table.entries[i].rect.x);
+		EXPECT_EQ(loaded.entries[i].rect.y, table.entries[i].rect.y);
+		EXPECT_EQ(loaded.entries[i].rect.width, table.entries[i].rect.width);
+		EXPECT_EQ(loaded.entries[i].rect.height, table.entries[i].rect.height);
+	}
+	std::filesystem::remove(filePath);
+}
+
+TEST(AtlasPackerTest, TableRejectsBrokenFiles) {
+	std::string filePath =
+	    (std::filesystem::temp_directory_path() / "AtlasPackerTestBroken.atlas").string();
+	AtlasTable table;
+
+	// 形式の名前が違う
+	std::ofstream(filePath) << "sheet 1\n";
+	EXPECT_FALSE(ReadAtlasTable(filePath, &table));
+
+	// 無いページを参照している
+	AtlasTable valid;
+	valid.pageFiles = {"atlas_0.png"};
+	ASSERT_TRUE(WriteAtlasTable(filePath, valid));
+	std::ofstream(filePath, std::ios::app) << "image 3 0 0 8 8 missing.png\n";
+	EXPECT_FALSE(ReadAtlasTable(filePath, &table));
+
+	std::filesystem::remove(filePath);
+	EXPECT_FALSE(ReadAtlasTable(filePath, &table));
+}
@@ -0,0 +1,202 @@
+#include "BlockCompressor.h"
+#include "MappedFile.h"
+#include "PngDecoder.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+// Resources を作業ディレクトリにして実行する（test/CMakeLists.txt を参照）
+
+namespace {
+
+// 圧縮して戻す
+std::vector<uint8_t> RoundTrip(
+    const uint8_t* pixels, uint32_t width, uint32_t height, TextureFormat format) {
+	std::vector<uint8_t> blocks(GetLevelSize(format, width, height));
+	BlockCompressor::CompressLevel(pixels, width, height, format, blocks.data());
+	std::vector<uint8_t> decoded(size_t(width) * height * 4);
+	EXPECT_TRUE(
+	    BlockCompressor::DecompressLevel(blocks.data(), width, height, format, decoded.data()));
+	return decoded;
+}
+
+// PSNR（channels 個の要素だけ比べる。dB）
+double ComputePsnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, int channels) {
+	double sum = 0.0;
+	size_t count = 0;
+	for (size_t i = 0; i < a.size(); i += 4) {
+		for (int c = 0; c < channels; c++) {
+			double d = double(a[i + c]) - double(b[i + c]);
+			sum += d * d;
+			count++;
+		}
+	}
+	return sum == 0.0 ? INFINITY : 10.0 * std::log10(255.0 * 255.0 * count / sum);
+}
+
+// 1色で塗った 4x4
+std::vector<uint8_t> MakeSolidBlock(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+	std::vector<uint8_t> block(16 * 4);
+	for (size_t i = 0; i < block.size(); i += 4) {
+		block[i + 0] = r;
+		block[i + 1] = g;
+		block[i + 2] = b;
+		block[i + 3] = a;
+	}
+	return block;
+}
+
+// 要素ごとの差の最大
+int MaxDifference(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b) {
+	int difference = 0;
+	for (size_t i = 0; i < a.size(); i++) {
+		difference = std::max(difference, std::abs(int(a[i]) - int(b[i])));
+	}
+	return difference;
+}
+
+TextureImage LoadPng(const char* filePath) {
+	TextureImage image;
+	MappedFile file;
+	EXPECT_TRUE(file.Open(filePath));
+	EXPECT_TRUE(PngDecoder::Decode(file.GetData(), file.GetSize(), &image));
+	return image;
+}
+
+} // namespace
+
+TEST(BlockCompressorTest, SolidBlocksRoundTrip) {
+	// BC7 の pビットは1つの端点の全要素で共通なので、偶奇の揃った色ならそのまま戻り、
+	// 揃っていなくても1しかずれない
+	std::vector<uint8_t> block = MakeSolidBlock(13, 201, 77, 129);
+	EXPECT_EQ(RoundTrip(block.data(), 4, 4, TextureFormat::kBC7), block);
+	block = MakeSolidBlock(13, 200, 77, 129);
+	EXPECT_LE(MaxDifference(RoundTrip(block.data(), 4, 4, TextureFormat::kBC7), block), 1);
+
+	// BC1/BC3 の色は 565 で表せる値なら戻る（アルファは BC3 なら2値まで保つ）
+	block = MakeSolidBlock(255, 0, 132, 255);
+	EXPECT_EQ(RoundTrip(block.data(), 4, 4, TextureFormat::kBC1), block);
+	block = MakeSolidBlock(0, 255, 8, 40);
+	for (size_t i = 3; i < block.size(); i += 8) {
+		block[i] = 220;
+	}
+	EXPECT_EQ(RoundTrip(block.data(), 4, 4, TextureFormat::kBC3), block);
+}
+
+TEST(BlockCompressorTest, TwoColorBlockKeepsEndpoints) {
+	// 2色だけのブロックは端点にそのまま載る
+	std::vector<uint8_t> block = MakeSolidBlock(0, 0, 0, 255);
+	for (size_t i = 0; i < block.size(); i += 8) {
+		block[i + 0] = 255;
+		block[i + 1] = 255;
+		block[i + 2] = 255;
+	}
+	EXPECT_EQ(RoundTrip(block.data(), 4, 4, TextureFormat::kBC1), block);
+	EXPECT_EQ(RoundTrip(block.data(), 4, 4, TextureFormat::kBC3), block);
+	// 黒（偶数）と不透明（奇数）は pビットを揃えられないので、BC7 は1ずれてよい
+	EXPECT_LE(MaxDifference(RoundTrip(block.data(), 4, 4, TextureFormat::kBC7), block), 1);
+}
+
+TEST(BlockCompressorTest, QualityOnPhotoTexture) {
+	// 色数の多い写真風の画像で、形式ごとの画質の下限を確かめる
+	TextureImage image = LoadPng("uvChecker.png");
+	const uint32_t width = image.GetWidth();
+	const uint32_t height = image.GetHeight();
+	std::vector<uint8_t> source(image.GetPixels(0), image.GetPixels(0) + image.GetSlicePitch(0));
+
+	std::vector<uint8_t> bc1 = RoundTrip(source.data(), width, height, TextureFormat::kBC1);
+	std::vector<uint8_t> bc7 = RoundTrip(source.data(), width, height, TextureFormat::kBC7);
+	const double bc1Psnr = ComputePsnr(source, bc1, 3);
+	const double bc7Psnr = ComputePsnr(source, bc7, 3);
+	EXPECT_GT(bc1Psnr, 32.0);
+	EXPECT_GT(bc7Psnr, 36.0);
+	// BC7 は BC1 より画質が良い
+	EXPECT_GT(bc7Psnr, bc1Psnr);
+}
+
+TEST(BlockCompressorTest, AlphaQualityOnRandomGradient) {
+	// アルファが滑らかに変わる画像
+	constexpr uint32_t kSize = 64;
+	std::vector<uint8_t> source(kSize * kSize * 4);
+	std::mt19937 random(5);
+	for (uint32_t y = 0; y < kSize; y++) {
+		for (uint32_t x = 0; x < kSize; x++) {
+			uint8_t* pixel = &source[(y * kSize + x) * 4];
+			pixel[0] = static_cast<uint8_t>(x * 4);
+			pixel[1] = static_cast<uint8_t>(y * 4);
+			pixel[2] = static_cast<uint8_t>(random() % 16 + 100);
+			pixel[3] = static_cast<uint8_t>((x + y) * 2);
+		}
+	}
+	std::vector<uint8_t> bc3 = RoundTrip(source.data(), kSize, kSize, TextureFormat::kBC3);
+	std::vector<uint8_t> bc7 = RoundTrip(source.data(), kSize, kSize, TextureFormat::kBC7);
+	// アルファだけを比べる
+	std::vector<uint8_t> alpha = source;
+	for (std::vector<uint8_t>* decoded : {&alpha, &bc3, &bc7}) {
+		for (size_t i = 0; i < decoded->size(); i += 4) {
+			(*decoded)[i] = (*decoded)[i + 3];
+		}
+	}
+	EXPECT_GT(ComputePsnr(alpha, bc3, 1), 40.0);
+	EXPECT_GT(ComputePsnr(alpha, bc7, 1), 36.0);
+	// BC1 はアルファを捨てて不透明になる
+	std::vector<uint8_t> bc1 = RoundTrip(source.data(), kSize, kSize, TextureFormat::kBC1);
+	for (size_t i = 3; i < bc1.size(); i += 4) {
+		ASSERT_EQ(bc1[i], 255u);
+	}
+}
+
+TEST(BlockCompressorTest, PartialBlocksRepeatEdges) {
+	// 6x3 は 2x1 ブロック。はみ出した分は端のピクセルで埋めて圧縮する
+	constexpr uint32_t kWidth = 6;
+	constexpr uint32_t kHeight = 3;
+	std::vector<uint8_t> source(kWidth * kHeight * 4, 0);
+	for (uint32_t y = 0; y < kHeight; y++) {
+		for (uint32_t x = 0; x < kWidth; x++) {
+			// 左のブロックは黒、右のブロックは白
+			uint8_t value = x < 4 ? 0 : 255;
+			std::memset(&source[(y * kWidth + x) * 4], value, 3);
+			source[(y * kWidth + x) * 4 + 3] = 255;
+		}
+	}
+	EXPECT_EQ(GetLevelSize(TextureFormat::kBC7, kWidth, kHeight), 2u * 16u);
+	EXPECT_EQ(RoundTrip(source.data(), kWidth, kHeight, TextureFormat::kBC1), source);
+	EXPECT_LE(
+	    MaxDifference(RoundTrip(source.data(), kWidth, kHeight, TextureFormat::kBC7), source), 1);
+
+	// 4x4 未満のレベルも1ブロック
+	std::vector<uint8_t> tiny = {10, 20, 30, 128};
+	EXPECT_EQ(RoundTrip(tiny.data(), 1, 1, TextureFormat::kBC7), tiny);
+}
+
+TEST(BlockCompressorTest, ThreadedMatchesSingleThreaded) {
+	TextureImage image = LoadPng("sample.png");
+	ThreadPool* threadPool = ThreadPool::GetInstance();
+	threadPool->Initialize(2);
+	for (TextureFormat format : {TextureFormat::kBC1, TextureFormat::kBC3, TextureFormat::kBC7}) {
+		const size_t size = GetLevelSize(format, image.GetWidth(), image.GetHeight());
+		std::vector<uint8_t> single(size);
+		std::vector<uint8_t> threaded(size);
+		BlockCompressor::CompressLevel(
+		    image.GetPixels(0), image.GetWidth(), image.GetHeight(), format, single.data());
+		BlockCompressor::CompressLevel(
+		    image.GetPixels(0), image.GetWidth(), image.GetHeight(), format, threaded.data(),
+		    threadPool);
+		EXPECT_EQ(single, threaded) << static_cast<int>(format);
+	}
+	threadPool->Finalize();
+}
+
+TEST(BlockCompressorTest, RejectsUnknownBC7Mode) {
+	// モード6以外（先頭がモード0のビット）は読めない
+	std::vector<uint8_t> blocks(16, 0);
+	blocks[0] = 1;
+	std::vector<uint8_t> decoded(16 * 4);
+	EXPECT_FALSE(
+	    BlockCompressor::DecompressLevel(blocks.data(), 4, 4, TextureFormat::kBC7, decoded.data()));
+}
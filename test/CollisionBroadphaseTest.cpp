@@ -0,0 +1,96 @@
+#include "CollisionBroadphase.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using PairList = std::vector<std::pair<uint32_t, uint32_t>>;
+
+// 見つかった組を並べ替えて比べられる形にする
+PairList Sorted(const std::vector<CollisionBroadphase::Pair>& pairs) {
+	PairList result;
+	for (const CollisionBroadphase::Pair& pair : pairs) {
+		result.emplace_back(pair.idA, pair.idB);
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+// 総当たりの結果
+PairList BruteForce(const CollisionBroadphase& broadphase) {
+	using Group = CollisionBroadphase::Group;
+	PairList result;
+	for (const auto& a : broadphase.GetColliders(Group::kA)) {
+		for (const auto& b : broadphase.GetColliders(Group::kB)) {
+			if (CollisionBroadphase::TestShapes(a, b)) {
+				result.emplace_back(a.id, b.id);
+			}
+		}
+	}
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+// 弾と敵をばらまく
+void Scatter(CollisionBroadphase* broadphase, uint32_t bulletCount, uint32_t enemyCount) {
+	std::mt19937 random(42);
+	std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+	for (uint32_t i = 0; i < bulletCount; i++) {
+		broadphase->Add(
+		    CollisionBroadphase::Group::kA, i,
+		    Sphere{{position(random), position(random), 0.0f}, 0.5f});
+	}
+	for (uint32_t i = 0; i < enemyCount; i++) {
+		Vector3 center{position(random), position(random), 0.0f};
+		AABB aabb{
+		    {center.x - 1.5f, center.y - 1.5f, -1.5f}, {center.x + 1.5f, center.y + 1.5f, 1.5f}};
+		broadphase->Add(CollisionBroadphase::Group::kB, i, aabb);
+	}
+}
+
+} // namespace
+
+TEST(CollisionBroadphaseTest, MethodsMatchBruteForce) {
+	for (auto method :
+	     {CollisionBroadphase::Method::kSpatialHash, CollisionBroadphase::Method::kSweepAndPrune}) {
+		CollisionBroadphase broadphase;
+		broadphase.Initialize(method);
+		Scatter(&broadphase, 1000, 100);
+		PairList expected = BruteForce(broadphase);
+		ASSERT_FALSE(expected.empty());
+		EXPECT_EQ(Sorted(broadphase.FindPairs()), expected);
+		// 総当たりよりずっと少ない組だけを調べる
+		EXPECT_LT(broadphase.GetStatistics().testCount, 1000u * 100u / 10u);
+	}
+}
+
+TEST(CollisionBroadphaseTest, LargeCollidersGoToSweep) {
+	CollisionBroadphase broadphase;
+	broadphase.Initialize(CollisionBroadphase::Method::kSpatialHash, 1.0f);
+	Scatter(&broadphase, 500, 50);
+	// セル数万個分の大きさのボス（グリッド側）とレーザー（問い合わせ側）
+	AABB boss{{-40.0f, -40.0f, -40.0f}, {40.0f, 40.0f, 40.0f}};
+	AABB laser{{-1000.0f, -0.5f, -0.5f}, {1000.0f, 0.5f, 0.5f}};
+	broadphase.Add(CollisionBroadphase::Group::kB, 1000, boss);
+	broadphase.Add(CollisionBroadphase::Group::kA, 2000, laser);
+
+	EXPECT_EQ(Sorted(broadphase.FindPairs()), BruteForce(broadphase));
+	EXPECT_EQ(broadphase.GetStatistics().largeColliderCount, 2u);
+}
+
+TEST(CollisionBroadphaseTest, HugeCoordinatesDoNotOverflow) {
+	CollisionBroadphase broadphase;
+	broadphase.Initialize(CollisionBroadphase::Method::kSpatialHash, 0.01f);
+	// int32 に収まらないセル座標と、全域を覆う箱
+	broadphase.Add(CollisionBroadphase::Group::kA, 0, Sphere{{1e30f, 0.0f, 0.0f}, 1.0f});
+	broadphase.Add(CollisionBroadphase::Group::kA, 1, Sphere{{-1e30f, 0.0f, 0.0f}, 1.0f});
+	broadphase.Add(CollisionBroadphase::Group::kA, 2, Sphere{{0.0f, 0.0f, 0.0f}, 1.0f});
+	broadphase.Add(
+	    CollisionBroadphase::Group::kB, 0, AABB{{-3e38f, -3e38f, -3e38f}, {3e38f, 3e38f, 3e38f}});
+	broadphase.Add(CollisionBroadphase::Group::kB, 1, Sphere{{1e30f, 0.0f, 0.0f}, 1.0f});
+
+	EXPECT_EQ(Sorted(broadphase.FindPairs()), BruteForce(broadphase));
+}
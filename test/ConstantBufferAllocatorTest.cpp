@@ -0,0 +1,201 @@
+#include "ConstantBufferAllocator.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace {
+
+// ページの作成を記録し、指定した数を越えたら失敗する供給元
+// GPU仮想アドレスは 1MB ごとの見分けやすい値にする
+class MockBackingStore : public ConstantBufferAllocator::BackingStore {
+public:
+	bool CreatePage(size_t size, uint8_t** cpuAddress, uint64_t* gpuAddress) override {
+		createCount++;
+		if (maxPageCount <= pages.size()) {
+			return false;
+		}
+		pages.push_back(std::make_unique<uint8_t[]>(size));
+		*cpuAddress = pages.back().get();
+		*gpuAddress = kGpuBase * pages.size();
+		return true;
+	}
+
+	static constexpr uint64_t kGpuBase = 0x100000;
+	// 作れるページ数
+	size_t maxPageCount = SIZE_MAX;
+	// CreatePage が呼ばれた回数（失敗も含む）
+	uint32_t createCount = 0;
+	std::vector<std::unique_ptr<uint8_t[]>> pages;
+};
+
+// GPU仮想アドレスからページ番号を求める（MockBackingStore 用）
+uint64_t PageOf(const ConstantBufferAllocator::Allocation& allocation) {
+	return allocation.gpuAddress / MockBackingStore::kGpuBase;
+}
+
+} // namespace
+
+TEST(ConstantBufferAllocatorTest, AllocationsAreAlignedTo256Bytes) {
+	SystemMemoryBackingStore store;
+	ConstantBufferAllocator allocator;
+	allocator.Initialize(&store, 2);
+	allocator.BeginFrame();
+
+	size_t expectedBytes = 0;
+	uintptr_t end = 0;
+	for (size_t size : {1, 16, 255, 256, 257, 1000, 4096}) {
+		ConstantBufferAllocator::Allocation allocation = allocator.Allocate(size);
+		ASSERT_NE(allocation.cpuAddress, nullptr);
+		EXPECT_EQ(allocation.size, ConstantBufferAllocator::AlignUp(size));
+		EXPECT_EQ(allocation.size % 256, 0u);
+		EXPECT_GE(allocation.size, size);
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation.cpuAddress) % 256, 0u) << size;
+		EXPECT_EQ(allocation.gpuAddress % 256, 0u) << size;
+		// 前の領域の直後から詰めていく
+		if (end != 0) {
+			EXPECT_EQ(reinterpret_cast<uintptr_t>(allocation.cpuAddress), end);
+		}
+		end = reinterpret_cast<uintptr_t>(allocation.cpuAddress) + allocation.size;
+		expectedBytes += allocation.size;
+	}
+	EXPECT_EQ(allocator.GetCurrentFrameBytes(), expectedBytes);
+	EXPECT_EQ(store.GetPageCount(), 1u);
+
+	// Push は書き込んだ先のアドレスを返す
+	struct Data {
+		float values[5];
+	};
+	const Data data = {{1.0f, 2.0f, 3.0f, 4.0f, 5.0f}};
+	uint64_t address = allocator.Push(data);
+	ASSERT_NE(address, 0u);
+	EXPECT_EQ(address % 256, 0u);
+	EXPECT_EQ(reinterpret_cast<const Data*>(address)->values[4], 5.0f);
+}
+
+TEST(ConstantBufferAllocatorTest, RollsOverToNewPageWhenFull) {
+	MockBackingStore store;
+	ConstantBufferAllocator allocator;
+	allocator.Initialize(&store, 2, 1024);
+	allocator.BeginFrame();
+	// 最初の確保まではページを作らない
+	EXPECT_EQ(store.createCount, 0u);
+
+	ConstantBufferAllocator::Allocation allocations[4];
+	for (int i = 0; i < 3; i++) {
+		allocations[i] = allocator.Allocate(256);
+		EXPECT_EQ(allocations[i].gpuAddress, MockBackingStore::kGpuBase + 256 * i);
+	}
+	// 残り 256 バイトに 512 バイトは入らないので、次のページの先頭から
+	allocations[3] = allocator.Allocate(300);
+	EXPECT_EQ(allocations[3].gpuAddress, MockBackingStore::kGpuBase * 2);
+	EXPECT_EQ(allocations[3].size, 512u);
+	EXPECT_EQ(allocator.GetStatistics().pageCount, 2u);
+	EXPECT_EQ(store.pages.size(), 2u);
+	// 飛ばした残りは使用量に含めない
+	EXPECT_EQ(allocator.GetCurrentFrameBytes(), 3 * 256u + 512u);
+
+	// ちょうど埋まるまでは同じページを使う
+	EXPECT_EQ(PageOf(allocator.Allocate(512)), 2u);
+	EXPECT_EQ(PageOf(allocator.Allocate(1)), 3u);
+}
+
+TEST(ConstantBufferAllocatorTest, PagesAreReusedAfterFrameCountFrames) {
+	constexpr uint32_t kFrameCount = 3;
+	MockBackingStore store;
+	ConstantBufferAllocator allocator;
+	allocator.Initialize(&store, kFrameCount, 1024);
+
+	// 毎フレーム2ページずつ使う
+	std::vector<std::set<uint64_t>> framePages;
+	for (uint32_t frame = 0; frame < 12; frame++) {
+		allocator.BeginFrame();
+		std::set<uint64_t>& pages = framePages.emplace_back();
+		for (int i = 0; i < 8; i++) {
+			pages.insert(PageOf(allocator.Allocate(256)));
+		}
+		ASSERT_EQ(pages.size(), 2u);
+
+		// 直前の frameCount - 1 フレームのページはGPUが使っているかもしれないので使わない
+		for (uint32_t back = 1; back < kFrameCount && back <= frame; back++) {
+			for (uint64_t page : framePages[frame - back]) {
+				EXPECT_EQ(pages.count(page), 0u) << "frame " << frame << " back " << back;
+			}
+		}
+	}
+	// ページは frameCount フレーム分だけ作り、あとは使い回す
+	EXPECT_EQ(store.pages.size(), 2u * kFrameCount);
+	EXPECT_EQ(store.createCount, 2u * kFrameCount);
+	EXPECT_EQ(allocator.GetStatistics().pageCount, 2u * kFrameCount);
+	// frameCount フレーム前と同じページの組に戻る
+	EXPECT_EQ(framePages[kFrameCount], framePages[0]);
+}
+
+TEST(ConstantBufferAllocatorTest, StatisticsTrackLastFrameAndHighWaterMark) {
+	MockBackingStore store;
+	ConstantBufferAllocator allocator;
+	allocator.Initialize(&store, 2, 4096);
+
+	const uint32_t allocationCounts[] = {3, 10, 1, 0, 4};
+	uint32_t peak = 0;
+	for (uint32_t count : allocationCounts) {
+		allocator.BeginFrame();
+		for (uint32_t i = 0; i < count; i++) {
+			allocator.Allocate(100);
+		}
+		EXPECT_EQ(allocator.GetCurrentFrameBytes(), count * 256u);
+		peak = std::max(peak, count);
+	}
+	// 統計は次の BeginFrame で確定する
+	const ConstantBufferAllocator::Statistics& statistics = allocator.GetStatistics();
+	EXPECT_EQ(statistics.lastFrameAllocations, 0u);
+	EXPECT_EQ(statistics.highWaterMarkBytes, 10u * 256u);
+	allocator.BeginFrame();
+	EXPECT_EQ(statistics.lastFrameBytes, 4u * 256u);
+	EXPECT_EQ(statistics.lastFrameAllocations, 4u);
+	EXPECT_EQ(statistics.highWaterMarkBytes, peak * 256u);
+	EXPECT_EQ(statistics.failedAllocations, 0u);
+	EXPECT_EQ(allocator.GetCurrentFrameBytes(), 0u);
+}
+
+TEST(ConstantBufferAllocatorTest, FailedPageCreationReturnsEmptyAllocation) {
+	MockBackingStore store;
+	store.maxPageCount = 1;
+	ConstantBufferAllocator allocator;
+	allocator.Initialize(&store, 1, 1024);
+	allocator.BeginFrame();
+
+	// 1ページ目は埋まるまで使える
+	for (int i = 0; i < 4; i++) {
+		ASSERT_NE(allocator.Allocate(256).cpuAddress, nullptr);
+	}
+	// 2ページ目が作れなければ空の領域を返す
+	ConstantBufferAllocator::Allocation allocation = allocator.Allocate(16);
+	EXPECT_EQ(allocation.cpuAddress, nullptr);
+	EXPECT_EQ(allocation.gpuAddress, 0u);
+	EXPECT_EQ(allocation.size, 0u);
+	EXPECT_EQ(allocator.Push(1.0f), 0u);
+	EXPECT_EQ(allocator.GetStatistics().failedAllocations, 2u);
+	// 失敗した分は使用量に含めない
+	EXPECT_EQ(allocator.GetCurrentFrameBytes(), 1024u);
+	EXPECT_EQ(allocator.GetStatistics().pageCount, 1u);
+
+	// 次のフレームでは返ってきたページを使うので、供給元には頼らない
+	const uint32_t createCount = store.createCount;
+	allocator.BeginFrame();
+	allocation = allocator.Allocate(16);
+	ASSERT_NE(allocation.cpuAddress, nullptr);
+	EXPECT_EQ(PageOf(allocation), 1u);
+	EXPECT_EQ(store.createCount, createCount);
+	EXPECT_EQ(allocator.GetStatistics().failedAllocations, 2u);
+
+	// 供給元が回復すれば新しいページで続けられる
+	for (int i = 0; i < 3; i++) {
+		allocator.Allocate(256);
+	}
+	store.maxPageCount = 2;
+	allocation = allocator.Allocate(16);
+	ASSERT_NE(allocation.cpuAddress, nullptr);
+	EXPECT_EQ(PageOf(allocation), 2u);
+}
@@ -0,0 +1,96 @@
+#include "FixedTimestep.h"
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <vector>
+
+// 実時間は使わず Advance に決まった経過時間を渡すので、結果はいつも同じになる
+
+namespace {
+
+// 描画のフレームレートごとに、各フレームで進めたステップ数を記録する
+std::vector<uint32_t> RunFrames(FixedTimestep& timestep, double frameRate, int frameCount) {
+	const std::chrono::nanoseconds frameDuration(static_cast<int64_t>(1e9 / frameRate));
+	std::vector<uint32_t> steps;
+	for (int i = 0; i < frameCount; i++) {
+		steps.push_back(timestep.Advance(frameDuration));
+		EXPECT_GE(timestep.GetAlpha(), 0.0f);
+		EXPECT_LT(timestep.GetAlpha(), 1.0f);
+	}
+	return steps;
+}
+
+} // namespace
+
+TEST(FixedTimestepTest, StepCountsAreDeterministicAcrossFrameRates) {
+	// 10秒分回す（60Hz のステップで600回前後）
+	struct Case {
+		double frameRate;
+		int frameCount;
+		// 1フレームあたりのステップ数の範囲
+		uint32_t minSteps;
+		uint32_t maxSteps;
+	};
+	const Case cases[] = {{30.0, 300, 2, 2}, {60.0, 600, 1, 1}, {144.0, 1440, 0, 1}};
+	for (const Case& c : cases) {
+		SCOPED_TRACE(c.frameRate);
+		FixedTimestep timestep;
+		timestep.Initialize();
+		std::vector<uint32_t> steps = RunFrames(timestep, c.frameRate, c.frameCount);
+
+		// 同じ経過時間の列からは同じステップ数の列が出る
+		FixedTimestep again;
+		again.Initialize();
+		EXPECT_EQ(RunFrames(again, c.frameRate, c.frameCount), steps);
+
+		uint64_t total = 0;
+		for (uint32_t count : steps) {
+			EXPECT_GE(count, c.minSteps);
+			EXPECT_LE(count, c.maxSteps);
+			total += count;
+		}
+		EXPECT_EQ(timestep.GetStepCount(), total);
+		EXPECT_EQ(timestep.GetDroppedStepCount(), 0u);
+		// 描画のレートに関わらず、進めたステップは経過時間をステップの長さで割った数
+		// （1フレームの長さは整数のナノ秒に切り捨てるので、600 より1少ないことがある）
+		const auto frameDuration =
+		    std::chrono::nanoseconds(static_cast<int64_t>(1e9 / c.frameRate));
+		const auto stepDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		    std::chrono::duration<double>(FixedTimestep::kDefaultStepSeconds));
+		EXPECT_EQ(total, static_cast<uint64_t>(frameDuration * c.frameCount / stepDuration));
+		EXPECT_GE(total, 599u);
+		EXPECT_LE(total, 600u);
+	}
+}
+
+TEST(FixedTimestepTest, StepsBeyondMaxPerFrameAreDropped) {
+	FixedTimestep timestep;
+	timestep.Initialize(1.0 / 60.0, 8);
+
+	// 1秒止まった後のフレームは上限の8ステップだけ進め、残りの52ステップは捨てる
+	EXPECT_EQ(timestep.Advance(std::chrono::seconds(1)), 8u);
+	EXPECT_EQ(timestep.GetStepCount(), 8u);
+	EXPECT_EQ(timestep.GetDroppedStepCount(), 52u);
+	// ステップに満たない端数は捨てずに次へ持ち越す
+	const float alpha = timestep.GetAlpha();
+	EXPECT_GT(alpha, 0.0f);
+	EXPECT_LT(alpha, 1.0f);
+	// 溜め込んでいないので、次の1フレーム分では1ステップだけ進む
+	EXPECT_EQ(timestep.Advance(std::chrono::nanoseconds(16666667)), 1u);
+	EXPECT_EQ(timestep.GetDroppedStepCount(), 52u);
+
+	// 30Hz の描画で上限を1にすると、毎フレーム1ステップ進めて1ステップ捨てる
+	timestep.Initialize(1.0 / 60.0, 1);
+	std::vector<uint32_t> steps = RunFrames(timestep, 30.0, 30);
+	for (uint32_t count : steps) {
+		EXPECT_EQ(count, 1u);
+	}
+	EXPECT_EQ(timestep.GetStepCount(), 30u);
+	EXPECT_EQ(timestep.GetDroppedStepCount(), 30u);
+
+	// リセットで累計も戻る
+	timestep.Reset();
+	EXPECT_EQ(timestep.GetStepCount(), 0u);
+	EXPECT_EQ(timestep.GetDroppedStepCount(), 0u);
+	EXPECT_EQ(timestep.GetAlpha(), 0.0f);
+}
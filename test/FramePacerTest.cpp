@@ -0,0 +1,99 @@
+#include "Benchmark.h"
+#include "FramePacer.h"
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+// 実時間で待つので、ctest では他のテストと並べて走らせない（test/CMakeLists.txt を参照）
+// 合否は目標時刻からのずれの中央値と、早く戻らないことだけで決める
+// 仮想マシンでは数msの割り込みが起きるので、裾（99パーセンタイル）は記録に残すだけにする
+
+TEST(FramePacerTest, PacedFrameTimesStayOnTarget) {
+	constexpr double kTargetRate = 100.0;
+	constexpr uint32_t kPeriodMicroseconds = 10000;
+	// 目標時刻からの遅れの中央値の許容幅（スピンで合わせるので数十マイクロ秒で収まる）
+	constexpr int64_t kToleranceMicroseconds = 200;
+	constexpr int kFrameCount = 300;
+
+	FramePacer framePacer;
+	framePacer.Initialize(kTargetRate);
+	std::vector<int64_t> errors;
+	errors.reserve(kFrameCount);
+	double startCpuTime = bench::GetProcessCpuMilliseconds();
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < kFrameCount; i++) {
+		std::chrono::steady_clock::time_point deadline = framePacer.GetDeadline();
+		framePacer.Wait();
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		// 目標時刻より前には戻らない
+		ASSERT_GE(now, deadline) << "frame " << i;
+		errors.push_back(
+		    std::chrono::duration_cast<std::chrono::microseconds>(now - deadline).count());
+	}
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	double cpuTime = bench::GetProcessCpuMilliseconds() - startCpuTime;
+
+	std::sort(errors.begin(), errors.end());
+	const int64_t p50Error = errors[errors.size() / 2];
+	const int64_t p99Error = errors[errors.size() * 99 / 100];
+	EXPECT_LE(p50Error, kToleranceMicroseconds);
+	RecordProperty("p50ErrorMicroseconds", static_cast<int>(p50Error));
+	RecordProperty("p99ErrorMicroseconds", static_cast<int>(p99Error));
+	RecordProperty("maxErrorMicroseconds", static_cast<int>(errors.back()));
+
+	FramePacer::Statistics statistics = framePacer.GetStatistics();
+	EXPECT_EQ(statistics.frameCount, static_cast<uint64_t>(kFrameCount));
+	// 中央値は目標から区間1つ分以内
+	EXPECT_GE(statistics.p50, kPeriodMicroseconds - FramePacer::kBucketWidthMicroseconds);
+	EXPECT_LE(statistics.p50, kPeriodMicroseconds + FramePacer::kBucketWidthMicroseconds);
+	EXPECT_LE(statistics.p50, statistics.p99);
+	EXPECT_LE(statistics.p99, statistics.max);
+	// 大半は sleep で待つので、スピンし続けるよりずっと少ないCPU時間で済む
+	EXPECT_LT(cpuTime, elapsed.count() * 0.5);
+}
+
+TEST(FramePacerTest, LateFrameIsNotDelayed) {
+	constexpr double kTargetRate = 100.0;
+	const std::chrono::microseconds period(10000);
+
+	FramePacer framePacer;
+	framePacer.Initialize(kTargetRate);
+	framePacer.Wait();
+	// 目標 + 2fps の間隔（約9.8ms）を超えた重いフレーム
+	std::this_thread::sleep_for(std::chrono::milliseconds(12));
+	auto start = std::chrono::steady_clock::now();
+	framePacer.Wait();
+	auto now = std::chrono::steady_clock::now();
+	// 待たずに戻り、次の開始時刻は今から1フレーム後に置き直す（詰めて取り返さない）
+	EXPECT_LT(now - start, std::chrono::milliseconds(1));
+	EXPECT_GE(framePacer.GetDeadline(), start + period);
+	EXPECT_LE(framePacer.GetDeadline(), now + period);
+	EXPECT_EQ(framePacer.GetStatistics().frameCount, 2u);
+}
+
+TEST(FramePacerTest, UnpacedDoesNotWait) {
+	FramePacer framePacer;
+	framePacer.Initialize(0.0);
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < 1000; i++) {
+		framePacer.Wait();
+	}
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+
+	FramePacer::Statistics statistics = framePacer.GetStatistics();
+	EXPECT_EQ(statistics.frameCount, 1000u);
+	EXPECT_LE(statistics.p50, 100u);
+}
+
+TEST(FramePacerTest, ResetHistogramClearsStatistics) {
+	FramePacer framePacer;
+	framePacer.Initialize(0.0);
+	framePacer.Wait();
+	framePacer.ResetHistogram();
+	FramePacer::Statistics statistics = framePacer.GetStatistics();
+	EXPECT_EQ(statistics.frameCount, 0u);
+	EXPECT_EQ(statistics.p50, 0u);
+	EXPECT_EQ(statistics.p99, 0u);
+}
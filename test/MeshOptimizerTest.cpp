@@ -0,0 +1,227 @@
+#include "MeshOptimizer.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float kPi = 3.14159265f;
+
+// 最適化後の ACMR の上限（キャッシュ16で格子・球とも0.63前後。ばらばらの並びは3に近い）
+constexpr float kMaxOptimizedAcmr = 0.7f;
+
+using Triangle = std::array<uint32_t, 3>;
+
+// xz 平面の格子（positionIndices は頂点番号と同じ）
+MeshData MakeGrid(uint32_t size) {
+	MeshData mesh;
+	for (uint32_t z = 0; z < size; z++) {
+		for (uint32_t x = 0; x < size; x++) {
+			mesh.positionIndices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+			mesh.vertices.push_back(
+			    MeshVertex{{float(x), 0.0f, float(z)}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}});
+		}
+	}
+	for (uint32_t z = 0; z + 1 < size; z++) {
+		for (uint32_t x = 0; x + 1 < size; x++) {
+			uint32_t i = z * size + x;
+			mesh.indices.insert(mesh.indices.end(), {i, i + size, i + 1});
+			mesh.indices.insert(mesh.indices.end(), {i + 1, i + size, i + size + 1});
+		}
+	}
+	return mesh;
+}
+
+// 継ぎ目の無い球（経度方向は頂点を共有し、極は1頂点）
+MeshData MakeSphere(uint32_t slices, uint32_t stacks) {
+	MeshData mesh;
+	auto addVertex = [&](const Vector3& normal) {
+		mesh.positionIndices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+		mesh.vertices.push_back(MeshVertex{normal, normal, {0.0f, 0.0f}});
+	};
+	addVertex({0.0f, 1.0f, 0.0f});
+	for (uint32_t i = 1; i < stacks; i++) {
+		float theta = kPi * static_cast<float>(i) / static_cast<float>(stacks);
+		for (uint32_t j = 0; j < slices; j++) {
+			float phi = 2.0f * kPi * static_cast<float>(j) / static_cast<float>(slices);
+			addVertex(
+			    {std::sin(theta) * std::cos(phi), std::cos(theta),
+			     std::sin(theta) * std::sin(phi)});
+		}
+	}
+	addVertex({0.0f, -1.0f, 0.0f});
+
+	const uint32_t bottom = static_cast<uint32_t>(mesh.vertices.size() - 1);
+	auto ring = [slices](uint32_t i, uint32_t j) { return 1 + (i - 1) * slices + j % slices; };
+	for (uint32_t j = 0; j < slices; j++) {
+		mesh.indices.insert(mesh.indices.end(), {0, ring(1, j + 1), ring(1, j)});
+		mesh.indices.insert(
+		    mesh.indices.end(), {bottom, ring(stacks - 1, j), ring(stacks - 1, j + 1)});
+	}
+	for (uint32_t i = 1; i + 1 < stacks; i++) {
+		for (uint32_t j = 0; j < slices; j++) {
+			uint32_t a = ring(i, j);
+			uint32_t b = ring(i, j + 1);
+			uint32_t c = ring(i + 1, j);
+			uint32_t d = ring(i + 1, j + 1);
+			mesh.indices.insert(mesh.indices.end(), {a, b, d, a, d, c});
+		}
+	}
+	return mesh;
+}
+
+// 三角形の順番と頂点の並びをばらばらにする
+void Shuffle(MeshData& mesh, uint32_t seed) {
+	std::mt19937 random(seed);
+	std::vector<Triangle> triangles(mesh.indices.size() / 3);
+	std::memcpy(triangles.data(), mesh.indices.data(), sizeof(uint32_t) * mesh.indices.size());
+	std::shuffle(triangles.begin(), triangles.end(), random);
+	std::memcpy(mesh.indices.data(), triangles.data(), sizeof(uint32_t) * mesh.indices.size());
+
+	std::vector<uint32_t> remap(mesh.vertices.size());
+	std::iota(remap.begin(), remap.end(), 0u);
+	std::shuffle(remap.begin(), remap.end(), random);
+	std::vector<MeshVertex> vertices(mesh.vertices.size());
+	std::vector<uint32_t> positionIndices(mesh.vertices.size());
+	for (size_t v = 0; v < mesh.vertices.size(); v++) {
+		vertices[remap[v]] = mesh.vertices[v];
+		positionIndices[remap[v]] = mesh.positionIndices[v];
+	}
+	mesh.vertices = std::move(vertices);
+	mesh.positionIndices = std::move(positionIndices);
+	for (uint32_t& index : mesh.indices) {
+		index = remap[index];
+	}
+}
+
+// 元の頂点番号で表した三角形の集合
+// 最小の番号が先頭に来るよう回すので、向きは保ったまま比べられる
+std::vector<Triangle> SortedTriangles(const MeshData& mesh) {
+	std::vector<Triangle> triangles(mesh.indices.size() / 3);
+	for (size_t t = 0; t < triangles.size(); t++) {
+		Triangle& triangle = triangles[t];
+		for (size_t k = 0; k < 3; k++) {
+			triangle[k] = mesh.positionIndices[mesh.indices[t * 3 + k]];
+		}
+		std::rotate(
+		    triangle.begin(), std::min_element(triangle.begin(), triangle.end()),
+		    triangle.end());
+	}
+	std::sort(triangles.begin(), triangles.end());
+	return triangles;
+}
+
+// すべての頂点がどれかの三角形から参照され、範囲外を指さない
+void ExpectAllVerticesReferenced(const MeshData& mesh) {
+	std::vector<bool> referenced(mesh.vertices.size(), false);
+	for (uint32_t index : mesh.indices) {
+		ASSERT_LT(index, mesh.vertices.size());
+		referenced[index] = true;
+	}
+	EXPECT_EQ(std::count(referenced.begin(), referenced.end(), false), 0);
+}
+
+// 段階ごとに最適化し、三角形と頂点の参照が保たれるか確かめる
+void ExpectOptimizes(MeshData mesh, const char* name) {
+	SCOPED_TRACE(name);
+	const std::vector<Triangle> expected = SortedTriangles(mesh);
+	const std::vector<MeshVertex> sourceVertices = mesh.vertices;
+	const std::vector<uint32_t> sourcePositionIndices = mesh.positionIndices;
+	const VertexCacheStatistics before = AnalyzeVertexCache(mesh);
+	// ばらばらの並びはほぼ毎回頂点シェーダが走る
+	EXPECT_GT(before.acmr, 2.5f);
+
+	const std::vector<uint32_t> clusters = OptimizeVertexCache(mesh);
+	const size_t triangleCount = mesh.indices.size() / 3;
+	ASSERT_FALSE(clusters.empty());
+	EXPECT_EQ(clusters.front(), 0u);
+	for (size_t c = 1; c < clusters.size(); c++) {
+		EXPECT_LT(clusters[c - 1], clusters[c]);
+		EXPECT_LT(clusters[c], triangleCount);
+	}
+	EXPECT_TRUE(SortedTriangles(mesh) == expected);
+	ExpectAllVerticesReferenced(mesh);
+	const VertexCacheStatistics optimized = AnalyzeVertexCache(mesh);
+	EXPECT_LT(optimized.acmr, kMaxOptimizedAcmr);
+
+	// 重ね描きの並べ替えはクラスタ単位で動かすだけなので、ACMR はほとんど変わらない
+	OptimizeOverdraw(mesh, clusters);
+	EXPECT_TRUE(SortedTriangles(mesh) == expected);
+	ExpectAllVerticesReferenced(mesh);
+	const VertexCacheStatistics overdraw = AnalyzeVertexCache(mesh);
+	EXPECT_LT(overdraw.acmr, kMaxOptimizedAcmr);
+
+	// 頂点の並べ替えでは頂点の数も中身も変わらず、最初に参照される順に番号が振られる
+	OptimizeVertexFetch(mesh);
+	EXPECT_TRUE(SortedTriangles(mesh) == expected);
+	ASSERT_EQ(mesh.vertices.size(), sourceVertices.size());
+	ExpectAllVerticesReferenced(mesh);
+	uint32_t next = 0;
+	for (uint32_t index : mesh.indices) {
+		ASSERT_LE(index, next);
+		if (index == next) {
+			next++;
+		}
+	}
+	// positionIndices は元の頂点番号なので、元の頂点を引ける
+	std::vector<uint32_t> sourceOf(sourceVertices.size());
+	for (size_t v = 0; v < sourceVertices.size(); v++) {
+		sourceOf[sourcePositionIndices[v]] = static_cast<uint32_t>(v);
+	}
+	for (size_t v = 0; v < mesh.vertices.size(); v++) {
+		const MeshVertex& source = sourceVertices[sourceOf[mesh.positionIndices[v]]];
+		ASSERT_EQ(std::memcmp(&mesh.vertices[v], &source, sizeof(MeshVertex)), 0) << v;
+	}
+	const VertexCacheStatistics fetch = AnalyzeVertexCache(mesh);
+	// 変換後キャッシュのふるまいは頂点の番号によらない
+	EXPECT_FLOAT_EQ(fetch.acmr, overdraw.acmr);
+	EXPECT_LT(fetch.overfetch, overdraw.overfetch);
+	EXPECT_LT(fetch.overfetch, 1.5f);
+}
+
+} // namespace
+
+TEST(MeshOptimizerTest, ShuffledGrid) {
+	MeshData mesh = MakeGrid(64);
+	Shuffle(mesh, 1);
+	ExpectOptimizes(mesh, "grid");
+}
+
+TEST(MeshOptimizerTest, ShuffledSphere) {
+	MeshData mesh = MakeSphere(64, 32);
+	Shuffle(mesh, 2);
+	ExpectOptimizes(mesh, "sphere");
+}
+
+TEST(MeshOptimizerTest, OptimizeMeshKeepsTriangles) {
+	MeshData mesh = MakeSphere(48, 24);
+	Shuffle(mesh, 3);
+	const std::vector<Triangle> expected = SortedTriangles(mesh);
+	OptimizeMesh(mesh);
+	EXPECT_TRUE(SortedTriangles(mesh) == expected);
+	ExpectAllVerticesReferenced(mesh);
+	EXPECT_LT(AnalyzeVertexCache(mesh).acmr, kMaxOptimizedAcmr);
+}
+
+TEST(MeshOptimizerTest, UnreferencedVerticesMoveToEnd) {
+	MeshData mesh = MakeGrid(4);
+	// 三角形から参照されない頂点を先頭に足す
+	mesh.vertices.insert(
+	    mesh.vertices.begin(), MeshVertex{{9.0f, 9.0f, 9.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f}});
+	mesh.positionIndices.insert(mesh.positionIndices.begin(), 100u);
+	for (uint32_t& index : mesh.indices) {
+		index++;
+	}
+	const std::vector<Triangle> expected = SortedTriangles(mesh);
+	OptimizeMesh(mesh);
+	EXPECT_TRUE(SortedTriangles(mesh) == expected);
+	ASSERT_EQ(mesh.vertices.size(), 17u);
+	EXPECT_EQ(mesh.positionIndices.back(), 100u);
+	EXPECT_EQ(mesh.vertices.back().pos.x, 9.0f);
+	EXPECT_EQ(*std::max_element(mesh.indices.begin(), mesh.indices.end()), 15u);
+}
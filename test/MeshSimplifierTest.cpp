@@ -0,0 +1,184 @@
+#include "MathUtility.h"
+#include "MeshSimplifier.h"
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+namespace {
+
+constexpr float kPi = 3.14159265f;
+constexpr uint32_t kLevelCount = 5;
+// 半径1の球でレベルごとに許すずれ（レベル4 は60三角形ほどの多面体になる）
+constexpr float kMaxErrors[kLevelCount] = {0.0f, 0.06f, 0.15f, 0.3f, 0.5f};
+
+// 継ぎ目の無い球（経度方向は頂点を共有し、極は1頂点）
+MeshData MakeSphere(uint32_t slices, uint32_t stacks, float radius) {
+	MeshData mesh;
+	auto addVertex = [&](const Vector3& normal) {
+		mesh.vertices.push_back(MeshVertex{normal * radius, normal, {0.0f, 0.0f}});
+		mesh.positionIndices.push_back(static_cast<uint32_t>(mesh.positionIndices.size()));
+	};
+	addVertex({0.0f, 1.0f, 0.0f});
+	for (uint32_t i = 1; i < stacks; i++) {
+		float theta = kPi * static_cast<float>(i) / static_cast<float>(stacks);
+		for (uint32_t j = 0; j < slices; j++) {
+			float phi = 2.0f * kPi * static_cast<float>(j) / static_cast<float>(slices);
+			addVertex(
+			    {std::sin(theta) * std::cos(phi), std::cos(theta),
+			     std::sin(theta) * std::sin(phi)});
+		}
+	}
+	addVertex({0.0f, -1.0f, 0.0f});
+
+	const uint32_t bottom = static_cast<uint32_t>(mesh.vertices.size() - 1);
+	auto ring = [slices](uint32_t i, uint32_t j) { return 1 + (i - 1) * slices + j % slices; };
+	for (uint32_t j = 0; j < slices; j++) {
+		mesh.indices.insert(mesh.indices.end(), {0, ring(1, j + 1), ring(1, j)});
+		mesh.indices.insert(
+		    mesh.indices.end(), {bottom, ring(stacks - 1, j), ring(stacks - 1, j + 1)});
+	}
+	for (uint32_t i = 1; i + 1 < stacks; i++) {
+		for (uint32_t j = 0; j < slices; j++) {
+			uint32_t a = ring(i, j);
+			uint32_t b = ring(i, j + 1);
+			uint32_t c = ring(i + 1, j);
+			uint32_t d = ring(i + 1, j + 1);
+			mesh.indices.insert(mesh.indices.end(), {a, b, d, a, d, c});
+		}
+	}
+	return mesh;
+}
+
+// 点から三角形までの距離
+float DistanceToTriangle(const Vector3& p, const Vector3& a, const Vector3& b, const Vector3& c) {
+	Vector3 ab = b - a;
+	Vector3 ac = c - a;
+	Vector3 ap = p - a;
+	float d1 = Dot(ab, ap);
+	float d2 = Dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f) {
+		return Length(ap);
+	}
+	Vector3 bp = p - b;
+	float d3 = Dot(ab, bp);
+	float d4 = Dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3) {
+		return Length(bp);
+	}
+	float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+		return Length(ap - ab * (d1 / (d1 - d3)));
+	}
+	Vector3 cp = p - c;
+	float d5 = Dot(ab, cp);
+	float d6 = Dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6) {
+		return Length(cp);
+	}
+	float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+		return Length(ap - ac * (d2 / (d2 - d6)));
+	}
+	float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+		return Length(bp - (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+	}
+	float denominator = 1.0f / (va + vb + vc);
+	return Length(ap - ab * (vb * denominator) - ac * (vc * denominator));
+}
+
+// 点からメッシュの面までの最短距離
+float DistanceToMesh(const Vector3& p, const MeshData& mesh) {
+	float best = std::numeric_limits<float>::max();
+	for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+		best = std::min(
+		    best, DistanceToTriangle(
+		              p, mesh.vertices[mesh.indices[i + 0]].pos,
+		              mesh.vertices[mesh.indices[i + 1]].pos,
+		              mesh.vertices[mesh.indices[i + 2]].pos));
+	}
+	return best;
+}
+
+ModelData MakeSphereModel() {
+	ModelData model;
+	model.meshes.push_back(MakeSphere(32, 16, 1.0f));
+	model.positionCount = static_cast<uint32_t>(model.meshes[0].vertices.size());
+	return model;
+}
+
+} // namespace
+
+TEST(MeshSimplifierTest, ChainHalvesTrianglesPerLevel) {
+	ModelData model = MakeSphereModel();
+	const size_t sourceCount = model.meshes[0].indices.size() / 3;
+	std::vector<float> errors;
+	std::vector<ModelData> levels = SimplifyModelChain(model, kLevelCount, &errors);
+	ASSERT_EQ(levels.size(), kLevelCount);
+	ASSERT_EQ(errors.size(), kLevelCount);
+
+	// レベル0 は元の形そのまま
+	EXPECT_EQ(levels[0].meshes[0].indices, model.meshes[0].indices);
+	EXPECT_EQ(errors[0], 0.0f);
+
+	// 閉じた球なので、どのレベルも目標（元の 1/2^n）まで減らせる
+	for (uint32_t level = 1; level < kLevelCount; level++) {
+		size_t count = levels[level].meshes[0].indices.size() / 3;
+		size_t target = sourceCount >> level;
+		EXPECT_LE(count, target) << "level " << level;
+		EXPECT_GE(count, target * 9 / 10) << "level " << level;
+	}
+}
+
+TEST(MeshSimplifierTest, ChainErrorBoundsDeviation) {
+	ModelData model = MakeSphereModel();
+	const MeshData& source = model.meshes[0];
+	std::vector<float> errors;
+	std::vector<ModelData> levels = SimplifyModelChain(model, kLevelCount, &errors);
+
+	for (uint32_t level = 1; level < kLevelCount; level++) {
+		const MeshData& mesh = levels[level].meshes[0];
+		// 粗くするほどずれは増えるが、レベルごとの上限は超えない
+		EXPECT_GT(errors[level], errors[level - 1]) << "level " << level;
+		EXPECT_LT(errors[level], kMaxErrors[level]) << "level " << level;
+
+		// 元の頂点はどれも、報告されたずれの範囲内で簡略化した面に載っている
+		float deviation = 0.0f;
+		for (const MeshVertex& vertex : source.vertices) {
+			deviation = std::max(deviation, DistanceToMesh(vertex.pos, mesh));
+		}
+		EXPECT_LE(deviation, errors[level] + 1.0e-4f) << "level " << level;
+	}
+}
+
+TEST(MeshSimplifierTest, ChainKeepsVerticesOfPreviousLevel) {
+	ModelData model = MakeSphereModel();
+	std::vector<ModelData> levels = SimplifyModelChain(model, kLevelCount);
+
+	// 頂点は隣へ寄せるだけなので、粗いレベルの頂点は1つ細かいレベルの頂点のどれかと同じ
+	for (uint32_t level = 1; level < kLevelCount; level++) {
+		const MeshData& finer = levels[level - 1].meshes[0];
+		for (const MeshVertex& vertex : levels[level].meshes[0].vertices) {
+			bool found = std::any_of(
+			    finer.vertices.begin(), finer.vertices.end(), [&](const MeshVertex& other) {
+				    return other.pos.x == vertex.pos.x && other.pos.y == vertex.pos.y &&
+				           other.pos.z == vertex.pos.z;
+			    });
+			EXPECT_TRUE(found) << "level " << level;
+		}
+	}
+}
+
+TEST(MeshSimplifierTest, ChainMatchesSingleStepAtFirstLevel) {
+	ModelData model = MakeSphereModel();
+	float error = 0.0f;
+	ModelData single = SimplifyModel(model, 0.5f, &error);
+	std::vector<float> errors;
+	std::vector<ModelData> levels = SimplifyModelChain(model, 2, &errors);
+
+	// レベル1 は元の形から1回簡略化するのと同じ
+	EXPECT_EQ(levels[1].meshes[0].indices, single.meshes[0].indices);
+	EXPECT_EQ(errors[1], error);
+}
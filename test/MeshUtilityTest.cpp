@@ -0,0 +1,175 @@
+#include "MeshUtility.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// 1辺の頂点数（1001x1001 = 100万頂点、200万三角形）
+constexpr uint32_t kGridSize = 1001;
+
+using Triangle = std::array<uint32_t, 3>;
+
+// xz 平面の格子（頂点ごとに座標が違うので、positionIndices は頂点番号と同じ）
+MeshData MakeGrid(uint32_t size) {
+	MeshData mesh;
+	mesh.name = "grid";
+	mesh.materialName = "ground";
+	mesh.vertices.reserve(size_t(size) * size);
+	for (uint32_t z = 0; z < size; z++) {
+		for (uint32_t x = 0; x < size; x++) {
+			MeshVertex vertex{};
+			vertex.pos = {float(x), 0.0f, float(z)};
+			vertex.normal = {0.0f, 1.0f, 0.0f};
+			vertex.uv = {float(x) / (size - 1), float(z) / (size - 1)};
+			mesh.positionIndices.push_back(static_cast<uint32_t>(mesh.vertices.size()));
+			mesh.vertices.push_back(vertex);
+		}
+	}
+	for (uint32_t z = 0; z + 1 < size; z++) {
+		for (uint32_t x = 0; x + 1 < size; x++) {
+			uint32_t i = z * size + x;
+			mesh.indices.insert(mesh.indices.end(), {i, i + size, i + 1});
+			mesh.indices.insert(mesh.indices.end(), {i + 1, i + size, i + size + 1});
+		}
+	}
+	return mesh;
+}
+
+// 三角形の順番をばらばらにする
+void ShuffleTriangles(MeshData& mesh, uint32_t seed) {
+	std::vector<Triangle> triangles(mesh.indices.size() / 3);
+	std::memcpy(triangles.data(), mesh.indices.data(), sizeof(uint32_t) * mesh.indices.size());
+	std::shuffle(triangles.begin(), triangles.end(), std::mt19937(seed));
+	std::memcpy(mesh.indices.data(), triangles.data(), sizeof(uint32_t) * mesh.indices.size());
+}
+
+// 最小の番号が先頭に来るよう回す（回しても面の向きは変わらない）
+Triangle Canonical(Triangle triangle) {
+	std::rotate(
+	    triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+	return triangle;
+}
+
+// 元の頂点番号で表した三角形（分割前と比べる）
+std::vector<Triangle> CollectTriangles(const std::vector<MeshData>& chunks) {
+	std::vector<Triangle> triangles;
+	for (const MeshData& chunk : chunks) {
+		for (size_t i = 0; i < chunk.indices.size(); i += 3) {
+			triangles.push_back({
+			    chunk.positionIndices[chunk.indices[i + 0]],
+			    chunk.positionIndices[chunk.indices[i + 1]],
+			    chunk.positionIndices[chunk.indices[i + 2]],
+			});
+		}
+	}
+	return triangles;
+}
+
+// 分割の結果を確かめる
+void ExpectValidSplit(const MeshData& mesh, const std::vector<MeshData>& chunks) {
+	ASSERT_GT(chunks.size(), 1u);
+	size_t vertexCount = 0;
+	size_t indexCount = 0;
+	size_t splitSize = 0;
+	for (const MeshData& chunk : chunks) {
+		// 16bit インデックスで参照でき、範囲外を指さない
+		ASSERT_LE(chunk.vertices.size(), kMaxVertexCount16);
+		ASSERT_EQ(chunk.positionIndices.size(), chunk.vertices.size());
+		ASSERT_EQ(chunk.indices.size() % 3, 0u);
+		for (uint32_t index : chunk.indices) {
+			ASSERT_LT(index, chunk.vertices.size());
+		}
+		// 頂点の中身は元の頂点のコピー
+		for (size_t v = 0; v < chunk.vertices.size(); v++) {
+			const MeshVertex& source = mesh.vertices[chunk.positionIndices[v]];
+			ASSERT_EQ(chunk.vertices[v].pos.x, source.pos.x);
+			ASSERT_EQ(chunk.vertices[v].pos.z, source.pos.z);
+			ASSERT_EQ(chunk.vertices[v].uv.x, source.uv.x);
+		}
+		EXPECT_EQ(chunk.name, mesh.name);
+		EXPECT_EQ(chunk.materialName, mesh.materialName);
+		vertexCount += chunk.vertices.size();
+		indexCount += chunk.indices.size();
+		splitSize += CalculateGeometrySize(chunk, sizeof(uint16_t));
+	}
+
+	// 三角形の集合と向きが変わらない
+	std::vector<Triangle> expected(mesh.indices.size() / 3);
+	for (size_t t = 0; t < expected.size(); t++) {
+		expected[t] =
+		    Canonical({mesh.indices[t * 3], mesh.indices[t * 3 + 1], mesh.indices[t * 3 + 2]});
+	}
+	std::vector<Triangle> actual = CollectTriangles(chunks);
+	for (Triangle& triangle : actual) {
+		triangle = Canonical(triangle);
+	}
+	std::sort(expected.begin(), expected.end());
+	std::sort(actual.begin(), actual.end());
+	EXPECT_TRUE(actual == expected);
+
+	// 大きさは頂点と 16bit インデックスの合計で、境界で増える頂点は 2% 未満
+	EXPECT_EQ(indexCount, mesh.indices.size());
+	EXPECT_EQ(splitSize, sizeof(MeshVertex) * vertexCount + sizeof(uint16_t) * indexCount);
+	EXPECT_LT(vertexCount, mesh.vertices.size() + mesh.vertices.size() / 50);
+	// 32bit インデックスのまま1つで持つより小さい
+	const size_t singleSize = CalculateGeometrySize(mesh, sizeof(uint32_t));
+	EXPECT_EQ(singleSize, sizeof(MeshVertex) * mesh.vertices.size() + 4 * mesh.indices.size());
+	EXPECT_LT(splitSize, singleSize * 85 / 100);
+}
+
+} // namespace
+
+TEST(MeshUtilityTest, SplitKeepsTrianglesOfMillionVertexGrid) {
+	const MeshData mesh = MakeGrid(kGridSize);
+	ASSERT_GE(mesh.vertices.size(), 1000000u);
+	std::vector<MeshData> chunks = SplitMesh(mesh);
+	ExpectValidSplit(mesh, chunks);
+
+	// 並びのよいメッシュは元の順番のまま分ける
+	std::vector<Triangle> triangles = CollectTriangles(chunks);
+	ASSERT_EQ(triangles.size(), mesh.indices.size() / 3);
+	for (size_t t = 0; t < triangles.size(); t++) {
+		ASSERT_EQ(triangles[t][0], mesh.indices[t * 3 + 0]) << "triangle " << t;
+		ASSERT_EQ(triangles[t][1], mesh.indices[t * 3 + 1]) << "triangle " << t;
+		ASSERT_EQ(triangles[t][2], mesh.indices[t * 3 + 2]) << "triangle " << t;
+	}
+}
+
+TEST(MeshUtilityTest, SplitShuffledGridStaysCompact) {
+	// 順番がばらばらだと空間的に近い順に並べ直すので、境界の頂点は増えすぎない
+	MeshData mesh = MakeGrid(kGridSize);
+	ShuffleTriangles(mesh, 3);
+	ExpectValidSplit(mesh, SplitMesh(mesh));
+}
+
+TEST(MeshUtilityTest, SmallMeshIsNotSplit) {
+	const MeshData mesh = MakeGrid(256);
+	ASSERT_EQ(mesh.vertices.size(), kMaxVertexCount16);
+	std::vector<MeshData> chunks = SplitMesh(mesh);
+	ASSERT_EQ(chunks.size(), 1u);
+	EXPECT_EQ(chunks[0].indices, mesh.indices);
+	EXPECT_EQ(chunks[0].vertices.size(), mesh.vertices.size());
+}
+
+TEST(MeshUtilityTest, SplitLargeMeshesOnlyTouchesLargeMeshes) {
+	ModelData model;
+	model.meshes.push_back(MakeGrid(16));
+	model.meshes.push_back(MakeGrid(300));
+	model.meshes.push_back(MakeGrid(8));
+	model.meshes[2].name = "last";
+	ASSERT_TRUE(SplitLargeMeshes(model));
+
+	// 小さいメッシュはそのまま、大きいメッシュは元の位置に分割したものが並ぶ
+	ASSERT_GE(model.meshes.size(), 4u);
+	EXPECT_EQ(model.meshes.front().vertices.size(), 16u * 16u);
+	EXPECT_EQ(model.meshes.back().name, "last");
+	EXPECT_EQ(model.meshes.back().vertices.size(), 8u * 8u);
+	for (const MeshData& mesh : model.meshes) {
+		EXPECT_LE(mesh.vertices.size(), kMaxVertexCount16);
+	}
+	EXPECT_FALSE(SplitLargeMeshes(model));
+}
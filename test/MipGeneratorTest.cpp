@@ -0,0 +1,180 @@
+#include "MappedFile.h"
+#include "MipGenerator.h"
+#include "PngDecoder.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <random>
+#include <vector>
+
+// Resources を作業ディレクトリにして実行する（test/CMakeLists.txt を参照）
+
+namespace {
+
+double ToLinear(uint8_t value) {
+	double v = value / 255.0;
+	return v <= 0.04045 ? v / 12.92 : std::pow((v + 0.055) / 1.055, 2.4);
+}
+
+uint8_t ToSrgb(double linear) {
+	double v = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+	return static_cast<uint8_t>(std::clamp(v * 255.0 + 0.5, 0.0, 255.0));
+}
+
+// 1色で塗った画像
+TextureImage MakeSolid(uint32_t width, uint32_t height, const uint8_t color[4]) {
+	TextureImage image;
+	image.Allocate(width, height);
+	for (size_t i = 0; i < image.pixels.size(); i++) {
+		image.pixels[i] = color[i % 4];
+	}
+	return image;
+}
+
+// 乱数で塗った画像
+TextureImage MakeNoise(uint32_t width, uint32_t height, uint32_t seed) {
+	TextureImage image;
+	image.Allocate(width, height);
+	std::mt19937 random(seed);
+	for (uint8_t& value : image.pixels) {
+		value = static_cast<uint8_t>(random());
+	}
+	return image;
+}
+
+} // namespace
+
+TEST(MipGeneratorTest, ChainReachesOnePixel) {
+	// 奇数の辺は切り捨てて 1 で止まる
+	TextureImage image = MakeNoise(13, 5, 1);
+	MipGenerator::Generate(&image);
+	const uint32_t expected[][2] = {{13, 5}, {6, 2}, {3, 1}, {1, 1}};
+	ASSERT_EQ(image.mips.size(), std::size(expected));
+	size_t offset = 0;
+	for (size_t mip = 0; mip < image.mips.size(); mip++) {
+		EXPECT_EQ(image.mips[mip].width, expected[mip][0]);
+		EXPECT_EQ(image.mips[mip].height, expected[mip][1]);
+		EXPECT_EQ(image.mips[mip].offset, offset);
+		offset += image.GetSlicePitch(mip);
+	}
+	EXPECT_EQ(image.pixels.size(), offset);
+
+	// 作り直してもレベルは増えない
+	MipGenerator::Generate(&image);
+	EXPECT_EQ(image.mips.size(), std::size(expected));
+}
+
+TEST(MipGeneratorTest, AveragesColorInLinearLight) {
+	// 黒と白の市松模様は、sRGB の中間の 128 ではなく線形の半分（188）になる
+	TextureImage image;
+	image.Allocate(2, 2);
+	for (size_t i = 0; i < 4; i++) {
+		uint8_t value = (i == 0 || i == 3) ? 255 : 0;
+		std::fill_n(image.pixels.begin() + i * 4, 3, value);
+		// アルファはそのまま線形に平均する
+		image.pixels[i * 4 + 3] = value;
+	}
+	MipGenerator::Generate(&image, MipGenerator::Filter::kBox);
+	ASSERT_EQ(image.mips.size(), 2u);
+	const uint8_t* pixel = image.GetPixels(1);
+	EXPECT_EQ(pixel[0], ToSrgb(0.5));
+	EXPECT_EQ(pixel[0], 188u);
+	EXPECT_EQ(pixel[1], 188u);
+	EXPECT_EQ(pixel[2], 188u);
+	EXPECT_EQ(pixel[3], 128u);
+}
+
+TEST(MipGeneratorTest, BoxMatchesDoublePrecisionReference) {
+	TextureImage image = MakeNoise(64, 32, 2);
+	MipGenerator::Generate(&image, MipGenerator::Filter::kBox);
+
+	// 倍精度で線形に戻して平均したものと、表の丸め分（1）しか違わない
+	int maxDifference = 0;
+	const uint8_t* src = image.GetPixels(0);
+	const uint8_t* dst = image.GetPixels(1);
+	for (uint32_t y = 0; y < 16; y++) {
+		for (uint32_t x = 0; x < 32; x++) {
+			for (int c = 0; c < 4; c++) {
+				double sum = 0.0;
+				for (uint32_t k = 0; k < 4; k++) {
+					uint8_t value = src[((y * 2 + k / 2) * 64 + x * 2 + k % 2) * 4 + c];
+					sum += c == 3 ? value / 255.0 : ToLinear(value);
+				}
+				uint8_t expected =
+				    c == 3 ? static_cast<uint8_t>(sum / 4.0 * 255.0 + 0.5) : ToSrgb(sum / 4.0);
+				maxDifference =
+				    std::max(maxDifference, std::abs(int(dst[(y * 32 + x) * 4 + c]) - expected));
+			}
+		}
+	}
+	EXPECT_LE(maxDifference, 1);
+}
+
+TEST(MipGeneratorTest, SolidColorStaysSolid) {
+	// 重みの合計は1なので、どのフィルタでも色は変わらない（端を繰り返すので縁も同じ）
+	const uint8_t color[4] = {30, 140, 250, 77};
+	for (MipGenerator::Filter filter :
+	     {MipGenerator::Filter::kBox, MipGenerator::Filter::kKaiser}) {
+		TextureImage image = MakeSolid(37, 20, color);
+		MipGenerator::Generate(&image, filter);
+		for (size_t mip = 1; mip < image.mips.size(); mip++) {
+			const uint8_t* pixels = image.GetPixels(mip);
+			for (size_t i = 0; i < image.GetSlicePitch(mip); i++) {
+				ASSERT_LE(std::abs(int(pixels[i]) - int(color[i % 4])), 1)
+				    << "filter " << static_cast<int>(filter) << " mip " << mip;
+			}
+		}
+	}
+}
+
+TEST(MipGeneratorTest, KaiserSuppressesAliasing) {
+	// 3ピクセル周期の縞は縮めた後の解像度では表せないので、一様な灰色に近いほどよい
+	// 箱フィルタはこの周波数を半分しか落とさず、うなりが残る
+	TextureImage image;
+	image.Allocate(96, 4);
+	for (uint32_t y = 0; y < 4; y++) {
+		for (uint32_t x = 0; x < 96; x++) {
+			uint8_t value = x % 3 == 0 ? 255 : 0;
+			std::fill_n(image.pixels.begin() + (y * 96 + x) * 4, 4, value);
+		}
+	}
+	auto ripple = [&](MipGenerator::Filter filter) {
+		TextureImage mipped = image;
+		MipGenerator::Generate(&mipped, filter);
+		const uint8_t* pixels = mipped.GetPixels(1);
+		double minValue = 1.0;
+		double maxValue = 0.0;
+		// 縁の影響を避けて内側だけ見る
+		for (uint32_t x = 4; x < 44; x++) {
+			minValue = std::min(minValue, ToLinear(pixels[x * 4]));
+			maxValue = std::max(maxValue, ToLinear(pixels[x * 4]));
+		}
+		return maxValue - minValue;
+	};
+	const double box = ripple(MipGenerator::Filter::kBox);
+	const double kaiser = ripple(MipGenerator::Filter::kKaiser);
+	EXPECT_NEAR(box, 0.5, 0.01);
+	EXPECT_LT(kaiser, box * 0.5);
+}
+
+TEST(MipGeneratorTest, ThreadedMatchesSingleThreaded) {
+	TextureImage source;
+	MappedFile file;
+	ASSERT_TRUE(file.Open("sample.png"));
+	ASSERT_TRUE(PngDecoder::Decode(file.GetData(), file.GetSize(), &source));
+
+	ThreadPool* threadPool = ThreadPool::GetInstance();
+	threadPool->Initialize(2);
+	for (MipGenerator::Filter filter :
+	     {MipGenerator::Filter::kBox, MipGenerator::Filter::kKaiser}) {
+		TextureImage single = source;
+		TextureImage threaded = source;
+		MipGenerator::Generate(&single, filter);
+		MipGenerator::Generate(&threaded, filter, threadPool);
+		EXPECT_EQ(single.pixels, threaded.pixels) << static_cast<int>(filter);
+	}
+	threadPool->Finalize();
+}
@@ -0,0 +1,88 @@
+#include "ObjectPool.h"
+#include <gtest/gtest.h>
+
+namespace {
+
+struct Bullet {
+	int id = 0;
+};
+
+} // namespace
+
+TEST(ObjectPoolTest, DespawnInvalidatesHandleAndReusesSlot) {
+	ObjectPool<Bullet> pool;
+	pool.Initialize(2);
+	PoolHandle a = pool.Spawn(Bullet{1});
+	PoolHandle b = pool.Spawn(Bullet{2});
+	EXPECT_TRUE(pool.IsFull());
+	EXPECT_FALSE(pool.IsAlive(pool.Spawn(Bullet{3})));
+
+	EXPECT_TRUE(pool.Despawn(a));
+	EXPECT_FALSE(pool.Despawn(a));
+	EXPECT_EQ(pool.Get(a), nullptr);
+	ASSERT_NE(pool.Get(b), nullptr);
+	EXPECT_EQ(pool.Get(b)->id, 2);
+
+	// 同じスロットを再利用しても古いハンドルは無効のまま
+	PoolHandle c = pool.Spawn(Bullet{4});
+	EXPECT_EQ(c.index, a.index);
+	EXPECT_FALSE(pool.IsAlive(a));
+	EXPECT_EQ(pool.Get(c)->id, 4);
+}
+
+TEST(ObjectPoolTest, ReinitializeInvalidatesOldHandles) {
+	ObjectPool<Bullet> pool;
+	pool.Initialize(4);
+	PoolHandle alive = pool.Spawn(Bullet{1});
+	PoolHandle despawned = pool.Spawn(Bullet{2});
+	pool.Despawn(despawned);
+
+	pool.Initialize(4);
+	EXPECT_FALSE(pool.IsAlive(alive));
+	EXPECT_FALSE(pool.IsAlive(despawned));
+	EXPECT_EQ(pool.GetSize(), 0u);
+
+	// 同じスロットに新しく生成しても、前のハンドルでは取れない
+	PoolHandle fresh = pool.Spawn(Bullet{3});
+	EXPECT_EQ(fresh.index, alive.index);
+	EXPECT_FALSE(pool.IsAlive(alive));
+	EXPECT_EQ(pool.Get(alive), nullptr);
+	EXPECT_EQ(pool.Get(fresh)->id, 3);
+}
+
+TEST(ObjectPoolTest, ShrinkThenGrowDoesNotRevive) {
+	ObjectPool<Bullet> pool;
+	pool.Initialize(8);
+	PoolHandle handles[8];
+	for (PoolHandle& handle : handles) {
+		handle = pool.Spawn(Bullet{});
+	}
+
+	pool.Initialize(2);
+	pool.Initialize(8);
+	for (int i = 0; i < 8; i++) {
+		pool.Spawn(Bullet{});
+	}
+	for (const PoolHandle& handle : handles) {
+		EXPECT_FALSE(pool.IsAlive(handle));
+	}
+}
+
+TEST(ObjectPoolTest, DespawnIfKeepsSurvivorsPacked) {
+	ObjectPool<Bullet> pool;
+	pool.Initialize(16);
+	PoolHandle handles[10];
+	for (int i = 0; i < 10; i++) {
+		handles[i] = pool.Spawn(Bullet{i});
+	}
+
+	EXPECT_EQ(pool.DespawnIf([](const Bullet& bullet) { return bullet.id % 2 == 0; }), 5u);
+	EXPECT_EQ(pool.GetSize(), 5u);
+	for (int i = 0; i < 10; i++) {
+		EXPECT_EQ(pool.IsAlive(handles[i]), i % 2 == 1);
+	}
+	// 詰めた配列とハンドルが対応している
+	for (uint32_t position = 0; position < pool.GetSize(); position++) {
+		EXPECT_EQ(pool.Get(pool.GetHandle(position)), pool.begin() + position);
+	}
+}
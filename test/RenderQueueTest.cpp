@@ -0,0 +1,311 @@
+#include "MathUtility.h"
+#include "NullRenderBackend.h"
+#include "RenderBackendCommandSink.h"
+#include "RenderQueue.h"
+#include "ViewProjection.h"
+#include "WorldTransform.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// 呼ばれた順に記録するだけの出力先
+class RecordingSink : public RenderCommandSink {
+public:
+	void BeginLayer(uint32_t layer) override { Record("layer", layer); }
+	void SetPipeline(uint32_t pipeline) override { Record("pipeline", pipeline); }
+	void SetMaterial(uint32_t material) override { Record("material", material); }
+	void SetTexture(uint32_t texture) override { Record("texture", texture); }
+	void Draw(const RenderCommand& command) override {
+		draws.push_back(command);
+		Record("draw", command.textureHandle);
+	}
+	void End() override { Record("end", 0); }
+	bool BindsMaterial() const override { return bindsMaterial; }
+	bool BindsTexture() const override { return bindsTexture; }
+
+	// 呼び出しの記録（"名前 値"）
+	std::vector<std::string> calls;
+	// 描画されたコマンド
+	std::vector<RenderCommand> draws;
+	bool bindsMaterial = true;
+	bool bindsTexture = true;
+
+private:
+	void Record(const char* name, uint32_t value) {
+		calls.push_back(std::string(name) + " " + std::to_string(value));
+	}
+};
+
+// 描画コマンドの目印に textureHandle を使う（Submit では見ない）
+RenderCommand MakeCommand(uint32_t id) {
+	RenderCommand command;
+	command.type = RenderCommand::Type::kModel;
+	command.textureHandle = id;
+	return command;
+}
+
+// キューは中身に触れないので、ポインタは区別できればよい
+Model* FakeModel(size_t i) { return reinterpret_cast<Model*>(uintptr_t(0x1000 + i * 16)); }
+Sprite* FakeSprite(size_t i) { return reinterpret_cast<Sprite*>(uintptr_t(0x9000 + i * 16)); }
+
+std::vector<std::string> Calls(std::initializer_list<const char*> calls) {
+	return std::vector<std::string>(calls.begin(), calls.end());
+}
+
+// ClearDepthBuffer の回数を数えるバックエンド
+class DepthCountingBackend : public NullRenderBackend {
+public:
+	void ClearDepthBuffer() override { clearCount++; }
+	uint32_t clearCount = 0;
+};
+
+} // namespace
+
+TEST(RenderQueueTest, SortKeyFieldsArePackedByPriority) {
+	const uint64_t key = RenderQueue::MakeSortKey(3, 1, 1234, 567, 0.5f);
+	EXPECT_EQ(RenderQueue::GetLayer(key), 3u);
+	EXPECT_EQ(RenderQueue::GetPipeline(key), 1u);
+	EXPECT_EQ(RenderQueue::GetMaterial(key), 1234u);
+	EXPECT_EQ(RenderQueue::GetTexture(key), 567u);
+
+	// 上位の欄の差は、下位の欄がどれだけ大きくても優先される
+	const uint32_t kMax = UINT32_MAX;
+	EXPECT_LT(RenderQueue::MakeSortKey(0, kMax, kMax, kMax, 1.0f),
+	          RenderQueue::MakeSortKey(1, 0, 0, 0, 0.0f));
+	EXPECT_LT(RenderQueue::MakeSortKey(0, 0, kMax, kMax, 1.0f),
+	          RenderQueue::MakeSortKey(0, 1, 0, 0, 0.0f));
+	EXPECT_LT(RenderQueue::MakeSortKey(0, 0, 0, kMax, 1.0f),
+	          RenderQueue::MakeSortKey(0, 0, 1, 0, 0.0f));
+	EXPECT_LT(RenderQueue::MakeSortKey(0, 0, 0, 0, 1.0f),
+	          RenderQueue::MakeSortKey(0, 0, 0, 1, 0.0f));
+	EXPECT_LT(RenderQueue::MakeSortKey(0, 0, 0, 0, 0.25f),
+	          RenderQueue::MakeSortKey(0, 0, 0, 0, 0.75f));
+	// 範囲外の深度は端に寄せ、欄に収まらない値は切り捨てる
+	EXPECT_EQ(RenderQueue::MakeSortKey(0, 0, 0, 0, -1.0f), 0u);
+	EXPECT_EQ(RenderQueue::GetLayer(RenderQueue::MakeSortKey(17, 0, 0, 0, 0.0f)), 1u);
+}
+
+TEST(RenderQueueTest, FlushDrawsInKeyOrder) {
+	// レイヤー・パイプライン・マテリアル・テクスチャ・深度のそれぞれで順番が決まる組
+	const uint64_t keys[] = {
+	    RenderQueue::MakeSortKey(0, 0, 0, 0, 0.0f), RenderQueue::MakeSortKey(0, 0, 0, 0, 0.5f),
+	    RenderQueue::MakeSortKey(0, 0, 0, 1, 0.0f), RenderQueue::MakeSortKey(0, 0, 2, 0, 0.0f),
+	    RenderQueue::MakeSortKey(0, 1, 0, 0, 0.0f), RenderQueue::MakeSortKey(1, 0, 0, 0, 0.0f),
+	    RenderQueue::MakeSortKey(1, 0, 0, 0, 0.9f), RenderQueue::MakeSortKey(2, 1, 3, 3, 0.1f),
+	};
+	std::vector<uint32_t> order = {5, 2, 7, 0, 3, 6, 1, 4};
+	RenderQueue queue;
+	for (uint32_t i : order) {
+		queue.Submit(keys[i], MakeCommand(i));
+	}
+	EXPECT_EQ(queue.GetCount(), order.size());
+
+	RecordingSink sink;
+	queue.Flush(sink);
+	ASSERT_EQ(sink.draws.size(), order.size());
+	for (uint32_t i = 0; i < sink.draws.size(); i++) {
+		EXPECT_EQ(sink.draws[i].textureHandle, i);
+	}
+	// 出力したらキューは空になる
+	EXPECT_EQ(queue.GetCount(), 0u);
+	RecordingSink empty;
+	queue.Flush(empty);
+	EXPECT_EQ(empty.calls, Calls({"end 0"}));
+}
+
+TEST(RenderQueueTest, RadixSortMatchesStableSort) {
+	// 乱数のキーでも std::stable_sort と同じ順（同じキーは積んだ順）になる
+	std::mt19937 random(5);
+	std::vector<uint64_t> keys(5000);
+	for (uint64_t& key : keys) {
+		key = RenderQueue::MakeSortKey(
+		    random() % 3, random() % 2, random() % 40, random() % 8, float(random() % 16) / 16.0f);
+	}
+	RenderQueue queue;
+	for (uint32_t i = 0; i < keys.size(); i++) {
+		queue.Submit(keys[i], MakeCommand(i));
+	}
+	std::vector<uint32_t> expected(keys.size());
+	for (uint32_t i = 0; i < expected.size(); i++) {
+		expected[i] = i;
+	}
+	std::stable_sort(expected.begin(), expected.end(), [&keys](uint32_t a, uint32_t b) {
+		return keys[a] < keys[b];
+	});
+
+	RecordingSink sink;
+	queue.Flush(sink);
+	ASSERT_EQ(sink.draws.size(), expected.size());
+	for (size_t i = 0; i < expected.size(); i++) {
+		ASSERT_EQ(sink.draws[i].textureHandle, expected[i]) << "draw " << i;
+	}
+}
+
+TEST(RenderQueueTest, RedundantBindsAreSkipped) {
+	RenderQueue queue;
+	// 同じ状態の描画3つと、テクスチャだけ違う描画1つ
+	for (uint32_t i = 0; i < 3; i++) {
+		queue.Submit(RenderQueue::MakeSortKey(1, 1, 4, 2, 0.1f * i), MakeCommand(i));
+	}
+	queue.Submit(RenderQueue::MakeSortKey(1, 1, 4, 3, 0.0f), MakeCommand(3));
+
+	RecordingSink sink;
+	queue.Flush(sink);
+	EXPECT_EQ(
+	    sink.calls, Calls({"layer 1", "pipeline 1", "material 4", "texture 2", "draw 0", "draw 1",
+	                       "draw 2", "texture 3", "draw 3", "end 0"}));
+
+	const RenderQueue::Statistics& statistics = queue.GetStatistics();
+	EXPECT_EQ(statistics.drawCount, 4u);
+	EXPECT_EQ(statistics.layerChangeCount, 1u);
+	EXPECT_EQ(statistics.pipelineBindCount, 1u);
+	EXPECT_EQ(statistics.materialBindCount, 1u);
+	EXPECT_EQ(statistics.textureBindCount, 2u);
+	// 1つ目以外はパイプライン・マテリアルを、2・3つ目はテクスチャも省いた
+	EXPECT_EQ(statistics.skippedBindCount, 3u + 3u + 2u);
+	EXPECT_GE(statistics.sortMilliseconds, 0.0);
+}
+
+TEST(RenderQueueTest, LayerBoundaryResetsState) {
+	// 状態が同じでも、レイヤーが変わればすべて設定し直す
+	RenderQueue queue;
+	queue.Submit(RenderQueue::MakeSortKey(2, 1, 5, 6, 0.0f), MakeCommand(1));
+	queue.Submit(RenderQueue::MakeSortKey(0, 1, 5, 6, 0.0f), MakeCommand(0));
+
+	RecordingSink sink;
+	queue.Flush(sink);
+	EXPECT_EQ(
+	    sink.calls, Calls({"layer 0", "pipeline 1", "material 5", "texture 6", "draw 0", "layer 2",
+	                       "pipeline 1", "material 5", "texture 6", "draw 1", "end 0"}));
+	const RenderQueue::Statistics& statistics = queue.GetStatistics();
+	EXPECT_EQ(statistics.layerChangeCount, 2u);
+	EXPECT_EQ(statistics.pipelineBindCount, 2u);
+	EXPECT_EQ(statistics.skippedBindCount, 0u);
+}
+
+TEST(RenderQueueTest, SinkWithoutMaterialBindsIsNotCountedAsSkipping) {
+	RenderQueue queue;
+	for (uint32_t i = 0; i < 4; i++) {
+		queue.Submit(RenderQueue::MakeSortKey(0, 1, 7, 8, 0.0f), MakeCommand(i));
+	}
+	RecordingSink sink;
+	sink.bindsMaterial = false;
+	sink.bindsTexture = false;
+	queue.Flush(sink);
+	// 設定しない状態は呼ばず、省いた数にも入れない
+	EXPECT_EQ(
+	    sink.calls,
+	    Calls({"layer 0", "pipeline 1", "draw 0", "draw 1", "draw 2", "draw 3", "end 0"}));
+	const RenderQueue::Statistics& statistics = queue.GetStatistics();
+	EXPECT_EQ(statistics.materialBindCount, 0u);
+	EXPECT_EQ(statistics.textureBindCount, 0u);
+	EXPECT_EQ(statistics.skippedBindCount, 3u);
+}
+
+TEST(RenderQueueTest, SpritesKeepSubmissionOrder) {
+	// 同じレイヤーのスプライトは、モデルを挟んでも積んだ順に描く
+	ViewProjection viewProjection;
+	viewProjection.matView = MakeIdentityMatrix();
+	WorldTransform worldTransform;
+	worldTransform.matWorld_ = MakeTranslateMatrix({0.0f, 0.0f, 10.0f});
+
+	RenderQueue queue;
+	constexpr size_t kSpriteCount = 300;
+	for (size_t i = 0; i < kSpriteCount; i++) {
+		RenderLayer layer = i % 2 == 0 ? RenderLayer::kForeground : RenderLayer::kBackground;
+		queue.SubmitSprite(layer, FakeSprite(i));
+		if (i % 7 == 0) {
+			queue.SubmitModel(
+			    RenderLayer::kWorld, FakeModel(i % 3), worldTransform, viewProjection);
+		}
+	}
+
+	RecordingSink sink;
+	queue.Flush(sink);
+	// 背景（奇数番目）を積んだ順に描いてから、前景（偶数番目）を積んだ順に描く
+	std::vector<Sprite*> expected;
+	for (size_t i = 1; i < kSpriteCount; i += 2) {
+		expected.push_back(FakeSprite(i));
+	}
+	for (size_t i = 0; i < kSpriteCount; i += 2) {
+		expected.push_back(FakeSprite(i));
+	}
+	std::vector<Sprite*> sprites;
+	for (const RenderCommand& command : sink.draws) {
+		if (command.type == RenderCommand::Type::kSprite) {
+			sprites.push_back(command.sprite);
+		}
+	}
+	EXPECT_EQ(sprites, expected);
+	// スプライトはパイプラインもマテリアルも同じなので、レイヤーごとに1回ずつしか設定しない
+	EXPECT_EQ(queue.GetStatistics().layerChangeCount, 3u);
+	EXPECT_EQ(queue.GetStatistics().pipelineBindCount, 3u);
+}
+
+TEST(RenderQueueTest, ModelsGroupByModelThenFrontToBack) {
+	ViewProjection viewProjection;
+	viewProjection.matView = MakeIdentityMatrix();
+	viewProjection.nearZ = 1.0f;
+	viewProjection.farZ = 101.0f;
+	const float depths[] = {50.0f, 10.0f, 90.0f, 30.0f};
+	std::vector<WorldTransform> worldTransforms(std::size(depths) * 2);
+	RenderQueue queue;
+	for (size_t i = 0; i < worldTransforms.size(); i++) {
+		worldTransforms[i].matWorld_ = MakeTranslateMatrix({0.0f, 0.0f, depths[i % 4]});
+		// 先に積んだモデルほど小さい番号になる
+		queue.SubmitModel(
+		    RenderLayer::kWorld, FakeModel(i / 4), worldTransforms[i], viewProjection);
+	}
+
+	RecordingSink sink;
+	queue.Flush(sink);
+	ASSERT_EQ(sink.draws.size(), worldTransforms.size());
+	for (size_t i = 0; i < sink.draws.size(); i++) {
+		EXPECT_EQ(sink.draws[i].model, FakeModel(i / 4));
+		EXPECT_EQ(sink.draws[i].viewProjection, &viewProjection);
+		if (i % 4 != 0) {
+			// 同じモデルの中では手前から
+			EXPECT_LT(sink.draws[i - 1].worldTransform->matWorld_.m[3][2],
+			          sink.draws[i].worldTransform->matWorld_.m[3][2]);
+		}
+	}
+	EXPECT_EQ(queue.GetStatistics().materialBindCount, 2u);
+}
+
+TEST(RenderQueueTest, BackendSinkClearsDepthAfterBackgroundOnly) {
+	DepthCountingBackend backend;
+	backend.Initialize();
+	RenderBackendCommandSink sink;
+	sink.Initialize(&backend);
+	ViewProjection viewProjection;
+	viewProjection.matView = MakeIdentityMatrix();
+	WorldTransform worldTransform;
+	worldTransform.matWorld_ = MakeIdentityMatrix();
+
+	// 背景・3D・前景のときは、背景の後の1回だけ（従来の GameScene::Draw と同じ）
+	RenderQueue queue;
+	queue.SubmitSprite(RenderLayer::kForeground, FakeSprite(0));
+	queue.SubmitModel(RenderLayer::kWorld, FakeModel(0), worldTransform, viewProjection);
+	queue.SubmitSprite(RenderLayer::kBackground, FakeSprite(1));
+	backend.BeginFrame();
+	queue.Flush(sink);
+	backend.EndFrame();
+	EXPECT_EQ(backend.clearCount, 1u);
+	EXPECT_EQ(backend.GetStatistics().passCount, 3u);
+	EXPECT_EQ(backend.GetStatistics().drawCallCount, 3u);
+	// マテリアルとテクスチャはモデル・スプライトが設定するので、省いた数に入らない
+	EXPECT_EQ(queue.GetStatistics().skippedBindCount, 0u);
+
+	// 背景が無ければフレーム最初のクリアで足りる
+	backend.clearCount = 0;
+	queue.SubmitModel(RenderLayer::kWorld, FakeModel(0), worldTransform, viewProjection);
+	queue.SubmitSprite(RenderLayer::kForeground, FakeSprite(0));
+	backend.BeginFrame();
+	queue.Flush(sink);
+	backend.EndFrame();
+	EXPECT_EQ(backend.clearCount, 0u);
+}
@@ -0,0 +1,149 @@
+#include "MappedFile.h"
+#include "SoundBank.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Resources を作業ディレクトリにして実行する（test/CMakeLists.txt を参照）
+
+namespace {
+
+// テストごとに空の一時ディレクトリを用意する
+class SoundBankTest : public testing::Test {
+protected:
+	void SetUp() override {
+		root_ = std::filesystem::temp_directory_path() /
+		        ("SoundBankTest_" +
+		         std::string(testing::UnitTest::GetInstance()->current_test_info()->name()));
+		std::filesystem::remove_all(root_);
+		std::filesystem::create_directories(root_);
+		bankPath_ = (root_ / "sounds.bank").string();
+	}
+	void TearDown() override { std::filesystem::remove_all(root_); }
+
+	// ファイルの中身を書き換えたコピーを作る
+	std::string WriteCopy(const std::vector<char>& bytes, const char* name) const {
+		std::string filePath = (root_ / name).string();
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		return filePath;
+	}
+
+	std::vector<char> ReadBytes(const std::string& filePath) const {
+		std::ifstream file(filePath, std::ios::binary);
+		return std::vector<char>(std::istreambuf_iterator<char>(file), {});
+	}
+
+	std::filesystem::path root_;
+	std::string bankPath_;
+};
+
+// 元の WAV と同じ形式・波形データか
+void ExpectSameAsWave(const SoundBank::SoundView& sound, const std::string& filePath) {
+	MappedFile file;
+	WaveInfo info;
+	ASSERT_TRUE(file.Open(filePath));
+	ASSERT_TRUE(WaveFile::Parse(file.GetData(), file.GetSize(), &info));
+	ASSERT_NE(sound.format, nullptr);
+	EXPECT_EQ(std::memcmp(sound.format, &info.format, sizeof(WaveFormat)), 0) << filePath;
+	ASSERT_EQ(sound.size, info.dataSize) << filePath;
+	EXPECT_EQ(std::memcmp(sound.data, file.GetData() + info.dataOffset, sound.size), 0)
+	    << filePath;
+}
+
+} // namespace
+
+TEST_F(SoundBankTest, WriteAndOpenRoundTrip) {
+	// 名前順でない並びで渡しても、名前で引ける
+	const std::vector<SoundBank::Source> sources = {
+	    {"se/mokugyo", "mokugyo.wav"},
+	    {"bgm/fanfare", "fanfare.wav"},
+	};
+	ASSERT_TRUE(SoundBank::Write(bankPath_, sources));
+	// 書きかけの一時ファイルは残らない
+	EXPECT_FALSE(std::filesystem::exists(bankPath_ + ".tmp"));
+
+	SoundBank bank;
+	ASSERT_TRUE(bank.Open(bankPath_));
+	EXPECT_TRUE(bank.IsOpen());
+	ASSERT_EQ(bank.GetSoundCount(), sources.size());
+	for (const SoundBank::Source& source : sources) {
+		uint32_t index = bank.Find(source.name);
+		ASSERT_NE(index, SoundBank::kInvalidIndex) << source.name;
+		SoundBank::SoundView sound = bank.GetSound(index);
+		EXPECT_EQ(sound.name, source.name);
+		// 波形データはそのまま再生に渡せるよう揃えてある
+		EXPECT_EQ(reinterpret_cast<uintptr_t>(sound.data) % 16, 0u) << source.name;
+		ExpectSameAsWave(sound, source.filePath);
+	}
+	// 名前順に並んでいる
+	EXPECT_EQ(bank.GetSound(0).name, "bgm/fanfare");
+	EXPECT_EQ(bank.GetSound(1).name, "se/mokugyo");
+
+	EXPECT_EQ(bank.Find("missing"), SoundBank::kInvalidIndex);
+	EXPECT_EQ(bank.Find("se"), SoundBank::kInvalidIndex);
+	EXPECT_EQ(bank.Find("se/mokugyo2"), SoundBank::kInvalidIndex);
+
+	bank.Close();
+	EXPECT_FALSE(bank.IsOpen());
+	EXPECT_EQ(bank.GetSoundCount(), 0u);
+}
+
+TEST_F(SoundBankTest, EmptyBankHasNoSounds) {
+	ASSERT_TRUE(SoundBank::Write(bankPath_, {}));
+	SoundBank bank;
+	ASSERT_TRUE(bank.Open(bankPath_));
+	EXPECT_EQ(bank.GetSoundCount(), 0u);
+	EXPECT_EQ(bank.Find("anything"), SoundBank::kInvalidIndex);
+}
+
+TEST_F(SoundBankTest, RewriteReplacesBank) {
+	ASSERT_TRUE(SoundBank::Write(bankPath_, {{"a", "fanfare.wav"}, {"b", "mokugyo.wav"}}));
+	ASSERT_TRUE(SoundBank::Write(bankPath_, {{"c", "mokugyo.wav"}}));
+	SoundBank bank;
+	ASSERT_TRUE(bank.Open(bankPath_));
+	ASSERT_EQ(bank.GetSoundCount(), 1u);
+	EXPECT_EQ(bank.Find("a"), SoundBank::kInvalidIndex);
+	ASSERT_EQ(bank.Find("c"), 0u);
+	ExpectSameAsWave(bank.GetSound(0), "mokugyo.wav");
+}
+
+TEST_F(SoundBankTest, WriteFailsOnUnreadableWave) {
+	// 読めない WAV が1つでもあれば、バンクを作らない
+	EXPECT_FALSE(SoundBank::Write(bankPath_, {{"a", "fanfare.wav"}, {"b", "missing.wav"}}));
+	EXPECT_FALSE(SoundBank::Write(bankPath_, {{"a", "uvChecker.png"}}));
+	EXPECT_FALSE(std::filesystem::exists(bankPath_));
+}
+
+TEST_F(SoundBankTest, OpenRejectsBrokenBanks) {
+	SoundBank bank;
+	EXPECT_FALSE(bank.Open((root_ / "missing.bank").string()));
+	EXPECT_FALSE(bank.Open("fanfare.wav"));
+
+	ASSERT_TRUE(SoundBank::Write(bankPath_, {{"se/mokugyo", "mokugyo.wav"}}));
+	const std::vector<char> bytes = ReadBytes(bankPath_);
+	ASSERT_TRUE(bank.Open(WriteCopy(bytes, "copy.bank")));
+
+	// 識別子が違う
+	std::vector<char> broken = bytes;
+	broken[0] = 'X';
+	EXPECT_FALSE(bank.Open(WriteCopy(broken, "magic.bank")));
+	EXPECT_FALSE(bank.IsOpen());
+
+	// バージョンが違う（識別子の直後）
+	broken = bytes;
+	const uint32_t version = SoundBank::kVersion + 1;
+	std::memcpy(broken.data() + 4, &version, sizeof(version));
+	EXPECT_FALSE(bank.Open(WriteCopy(broken, "version.bank")));
+
+	// 途中で切れている
+	broken.assign(bytes.begin(), bytes.end() - 1);
+	EXPECT_FALSE(bank.Open(WriteCopy(broken, "truncated.bank")));
+	broken.assign(bytes.begin(), bytes.begin() + 8);
+	EXPECT_FALSE(bank.Open(WriteCopy(broken, "header.bank")));
+}
@@ -0,0 +1,235 @@
+#include "BlockCompressor.h"
+#include "DdsFile.h"
+#include "MappedFile.h"
+#include "MipGenerator.h"
+#include "PngDecoder.h"
+#include "TextureCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// Resources を作業ディレクトリにして実行する（test/CMakeLists.txt を参照）
+
+namespace {
+
+// テストごとに空のキャッシュディレクトリと、書き換えてよい元画像を用意する
+class TextureCacheTest : public testing::Test {
+protected:
+	void SetUp() override {
+		root_ = std::filesystem::temp_directory_path() /
+		        ("TextureCacheTest_" +
+		         std::string(testing::UnitTest::GetInstance()->current_test_info()->name()));
+		std::filesystem::remove_all(root_);
+		std::filesystem::create_directories(root_);
+		cacheDirectory_ = (root_ / "cache").string() + "/";
+		sourcePath_ = (root_ / "source.png").string();
+		std::filesystem::copy_file("uvChecker.png", sourcePath_);
+	}
+	void TearDown() override { std::filesystem::remove_all(root_); }
+
+	// キャッシュの DDS（ディレクトリにある唯一の .dds。無ければ空）
+	std::filesystem::path FindCacheFile() const {
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(cacheDirectory_, error)) {
+			if (entry.path().extension() == ".dds") {
+				return entry.path();
+			}
+		}
+		return {};
+	}
+
+	// 元画像の更新時刻をずらす
+	void Touch(const std::string& filePath) const {
+		std::filesystem::last_write_time(
+		    filePath, std::filesystem::last_write_time(filePath) + std::chrono::seconds(10));
+	}
+
+	std::filesystem::path root_;
+	std::string cacheDirectory_;
+	std::string sourcePath_;
+};
+
+// 元画像を展開してミップマップを作る（キャッシュが作るのと同じ手順）
+TextureImage DecodeWithMips(const std::string& filePath) {
+	TextureImage image;
+	MappedFile file;
+	EXPECT_TRUE(file.Open(filePath));
+	EXPECT_TRUE(PngDecoder::Decode(file.GetData(), file.GetSize(), &image));
+	MipGenerator::Generate(&image, MipGenerator::Filter::kBox);
+	return image;
+}
+
+} // namespace
+
+TEST(TextureCacheFormatTest, DdsRoundTrip) {
+	const std::string filePath =
+	    (std::filesystem::temp_directory_path() / "TextureCacheTest.dds").string();
+	constexpr uint32_t kWidth = 8;
+	constexpr uint32_t kHeight = 4;
+	constexpr uint32_t kMipCount = 4;
+	const size_t dataSize = DdsFile::GetDataSize(TextureFormat::kBC7, kWidth, kHeight, kMipCount);
+	// 8x4 → 4x2 → 2x1 → 1x1。4x4 未満のレベルも1ブロックを使う
+	EXPECT_EQ(dataSize, (2 + 1 + 1 + 1) * 16u);
+	std::vector<uint8_t> data(dataSize);
+	for (size_t i = 0; i < data.size(); i++) {
+		data[i] = static_cast<uint8_t>(i * 7);
+	}
+	ASSERT_TRUE(
+	    DdsFile::Write(filePath, TextureFormat::kBC7, kWidth, kHeight, kMipCount, data.data()));
+
+	DdsFile dds;
+	ASSERT_TRUE(dds.Open(filePath));
+	EXPECT_EQ(dds.GetFormat(), TextureFormat::kBC7);
+	EXPECT_EQ(dds.GetWidth(), kWidth);
+	EXPECT_EQ(dds.GetHeight(), kHeight);
+	ASSERT_EQ(dds.GetMipCount(), kMipCount);
+	size_t offset = 0;
+	for (uint32_t mip = 0; mip < kMipCount; mip++) {
+		DdsFile::Level level = dds.GetLevel(mip);
+		EXPECT_EQ(level.width, std::max(1u, kWidth >> mip));
+		EXPECT_EQ(level.height, std::max(1u, kHeight >> mip));
+		ASSERT_LE(offset + level.size, data.size());
+		EXPECT_EQ(std::memcmp(level.data, data.data() + offset, level.size), 0) << mip;
+		offset += level.size;
+	}
+	EXPECT_EQ(offset, data.size());
+	dds.Close();
+
+	// 途中で切れたファイルは開かない
+	std::filesystem::resize_file(filePath, std::filesystem::file_size(filePath) - 1);
+	EXPECT_FALSE(dds.Open(filePath));
+	std::filesystem::remove(filePath);
+	EXPECT_FALSE(dds.Open(filePath));
+}
+
+TEST(TextureCacheFormatTest, ChooseFormatFollowsAlphaAndSize) {
+	TextureImage image;
+	image.Allocate(8, 8);
+	std::fill(image.pixels.begin(), image.pixels.end(), uint8_t(0xff));
+	using Compression = TextureCache::Compression;
+	EXPECT_EQ(TextureCache::ChooseFormat(image, Compression::kAuto), TextureFormat::kBC1);
+	EXPECT_EQ(TextureCache::ChooseFormat(image, Compression::kBC3), TextureFormat::kBC3);
+	EXPECT_EQ(TextureCache::ChooseFormat(image, Compression::kNone), TextureFormat::kRGBA8);
+
+	// 1ピクセルでも半透明ならアルファを残す
+	image.pixels[5 * TextureImage::kBytesPerPixel + 3] = 0x80;
+	EXPECT_EQ(TextureCache::ChooseFormat(image, Compression::kAuto), TextureFormat::kBC7);
+
+	// 4の倍数でなければ指定があっても圧縮しない
+	TextureImage odd;
+	odd.Allocate(6, 8);
+	EXPECT_EQ(TextureCache::ChooseFormat(odd, Compression::kBC7), TextureFormat::kRGBA8);
+}
+
+TEST_F(TextureCacheTest, FirstOpenCooksCompressedMipChain) {
+	TextureCache cache;
+	cache.Initialize(cacheDirectory_, TextureCache::Compression::kBC7);
+	ASSERT_TRUE(cache.IsEnabled());
+	DdsFile dds;
+	ASSERT_TRUE(cache.Open("uvChecker", sourcePath_, &dds));
+	EXPECT_TRUE(std::filesystem::exists(cacheDirectory_ + TextureCache::kManifestFileName));
+
+	// 同じ手順で圧縮したものと同じバイト列になる
+	TextureImage image = DecodeWithMips(sourcePath_);
+	EXPECT_EQ(dds.GetFormat(), TextureFormat::kBC7);
+	EXPECT_EQ(dds.GetWidth(), image.GetWidth());
+	EXPECT_EQ(dds.GetHeight(), image.GetHeight());
+	ASSERT_EQ(dds.GetMipCount(), image.mips.size());
+	for (uint32_t mip = 0; mip < dds.GetMipCount(); mip++) {
+		const TextureImage::MipLevel& mipLevel = image.mips[mip];
+		std::vector<uint8_t> expected(
+		    GetLevelSize(TextureFormat::kBC7, mipLevel.width, mipLevel.height));
+		BlockCompressor::CompressLevel(
+		    image.GetPixels(mip), mipLevel.width, mipLevel.height, TextureFormat::kBC7,
+		    expected.data());
+		DdsFile::Level level = dds.GetLevel(mip);
+		ASSERT_EQ(level.size, expected.size());
+		EXPECT_EQ(std::memcmp(level.data, expected.data(), expected.size()), 0) << mip;
+	}
+
+	// BC7 は RGBA8 の1/4（ヘッダーと 4x4 未満のレベルの分だけ多い）
+	EXPECT_LT(std::filesystem::file_size(FindCacheFile()), image.pixels.size() / 3);
+}
+
+TEST_F(TextureCacheTest, SecondOpenReusesCacheAcrossInstances) {
+	{
+		TextureCache cache;
+		cache.Initialize(cacheDirectory_);
+		DdsFile dds;
+		ASSERT_TRUE(cache.Open("uvChecker", sourcePath_, &dds));
+	}
+	const std::filesystem::path cacheFile = FindCacheFile();
+	ASSERT_FALSE(cacheFile.empty());
+	// 書き直されたら分かるように、中身を残したまま更新時刻を戻しておく
+	const auto cookedTime = std::filesystem::last_write_time(cacheFile) - std::chrono::hours(1);
+	std::filesystem::last_write_time(cacheFile, cookedTime);
+
+	// 目録を読み直した別のキャッシュでも、作り直さずに開く
+	TextureCache cache;
+	cache.Initialize(cacheDirectory_);
+	DdsFile dds;
+	ASSERT_TRUE(cache.Open("uvChecker", sourcePath_, &dds));
+	EXPECT_EQ(dds.GetFormat(), TextureFormat::kBC1);
+	EXPECT_EQ(std::filesystem::last_write_time(cacheFile), cookedTime);
+
+	// 更新時刻だけ変わったときは中身のハッシュで確かめて、作り直さない
+	dds.Close();
+	Touch(sourcePath_);
+	ASSERT_TRUE(cache.Open("uvChecker", sourcePath_, &dds));
+	EXPECT_EQ(std::filesystem::last_write_time(cacheFile), cookedTime);
+}
+
+TEST_F(TextureCacheTest, ChangedSourceIsRebuilt) {
+	TextureCache cache;
+	cache.Initialize(cacheDirectory_);
+	DdsFile dds;
+	ASSERT_TRUE(cache.Open("texture", sourcePath_, &dds));
+	EXPECT_EQ(dds.GetWidth(), 512u);
+	dds.Close();
+
+	// 同じ名前のまま別の画像に差し替える
+	std::filesystem::copy_file(
+	    "debugfont.png", sourcePath_, std::filesystem::copy_options::overwrite_existing);
+	Touch(sourcePath_);
+	ASSERT_TRUE(cache.Open("texture", sourcePath_, &dds));
+	EXPECT_EQ(dds.GetWidth(), 128u);
+	EXPECT_EQ(dds.GetHeight(), 128u);
+	// debugfont.png は半透明を含むので BC7 になる
+	EXPECT_EQ(dds.GetFormat(), TextureFormat::kBC7);
+}
+
+TEST_F(TextureCacheTest, DifferentCompressionDiscardsManifest) {
+	{
+		TextureCache cache;
+		cache.Initialize(cacheDirectory_, TextureCache::Compression::kBC1);
+		DdsFile dds;
+		ASSERT_TRUE(cache.Open("uvChecker", sourcePath_, &dds));
+		EXPECT_EQ(dds.GetFormat(), TextureFormat::kBC1);
+	}
+	// 選び方が変わったら前の目録は使わない
+	TextureCache cache;
+	cache.Initialize(cacheDirectory_, TextureCache::Compression::kNone);
+	DdsFile dds;
+	ASSERT_TRUE(cache.Open("uvChecker", sourcePath_, &dds));
+	EXPECT_EQ(dds.GetFormat(), TextureFormat::kRGBA8);
+	TextureImage image = DecodeWithMips(sourcePath_);
+	DdsFile::Level level = dds.GetLevel(0);
+	ASSERT_EQ(level.size, image.GetSlicePitch(0));
+	EXPECT_EQ(std::memcmp(level.data, image.GetPixels(0), level.size), 0);
+}
+
+TEST_F(TextureCacheTest, MissingOrNonPngSourceFails) {
+	TextureCache cache;
+	cache.Initialize(cacheDirectory_);
+	DdsFile dds;
+	EXPECT_FALSE(cache.Open("missing", (root_ / "missing.png").string(), &dds));
+	const std::string wavePath = (root_ / "sound.wav").string();
+	std::filesystem::copy_file("mokugyo.wav", wavePath);
+	EXPECT_FALSE(cache.Open("sound", wavePath, &dds));
+	EXPECT_FALSE(dds.IsOpen());
+	EXPECT_TRUE(FindCacheFile().empty());
+}
@@ -0,0 +1,118 @@
+#include "TextureRegistry.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+// TextureManager と同じ1ページのデスクリプタ数と、先頭の予約数
+constexpr uint32_t kNumDescriptors = 256;
+constexpr uint32_t kNumReserved = 192;
+
+} // namespace
+
+TEST(TextureRegistryTest, FirstHandleSkipsReservedDescriptors) {
+	TextureRegistry registry;
+	registry.Reset(kNumDescriptors, kNumReserved);
+	EXPECT_EQ(registry.GetPageCount(), 1u);
+	EXPECT_EQ(registry.GetCapacity(), kNumDescriptors);
+
+	// 予約の直後から小さい順に割り当てる
+	EXPECT_EQ(registry.Allocate("a.png"), kNumReserved);
+	EXPECT_EQ(registry.Allocate("b.png"), kNumReserved + 1);
+	EXPECT_EQ(registry.Find("a.png"), kNumReserved);
+	EXPECT_EQ(registry.Find("missing.png"), TextureRegistry::kInvalidHandle);
+	EXPECT_FALSE(registry.IsValid(0));
+}
+
+TEST(TextureRegistryTest, RefCountKeepsHandleUntilLastRelease) {
+	TextureRegistry registry;
+	registry.Reset(kNumDescriptors, kNumReserved);
+	uint32_t handle = registry.Allocate("player.png");
+	registry.AddRef(handle);
+	registry.AddRef(handle);
+	EXPECT_EQ(registry.GetRefCount(handle), 3u);
+
+	EXPECT_EQ(registry.Release(handle), 2u);
+	EXPECT_EQ(registry.Release(handle), 1u);
+	EXPECT_TRUE(registry.IsValid(handle));
+	EXPECT_EQ(registry.Find("player.png"), handle);
+
+	// 最後の解放で名前も消える
+	EXPECT_EQ(registry.Release(handle), 0u);
+	EXPECT_FALSE(registry.IsValid(handle));
+	EXPECT_EQ(registry.Find("player.png"), TextureRegistry::kInvalidHandle);
+	EXPECT_EQ(registry.GetLiveCount(), 0u);
+}
+
+TEST(TextureRegistryTest, ReleasedHandleIsReusedFirst) {
+	TextureRegistry registry;
+	registry.Reset(kNumDescriptors, kNumReserved);
+	uint32_t a = registry.Allocate("a.png");
+	uint32_t b = registry.Allocate("b.png");
+	uint32_t c = registry.Allocate("c.png");
+
+	// 空いた番号から使い、ページは増えない
+	registry.Release(b);
+	EXPECT_EQ(registry.Allocate("d.png"), b);
+	registry.Release(a);
+	registry.Release(c);
+	uint32_t e = registry.Allocate("e.png");
+	EXPECT_TRUE(e == a || e == c);
+	EXPECT_EQ(registry.GetPageCount(), 1u);
+
+	// 同じ名前を解放後に読み直しても別のテクスチャとして扱える
+	registry.Release(registry.Find("d.png"));
+	uint32_t again = registry.Allocate("b.png");
+	EXPECT_EQ(registry.Find("b.png"), again);
+	EXPECT_EQ(registry.GetRefCount(again), 1u);
+}
+
+TEST(TextureRegistryTest, GrowsPagesPastOneHeap) {
+	TextureRegistry registry;
+	registry.Reset(kNumDescriptors, kNumReserved);
+	// 1ページ目の空き（256 - 192）を超えて、3ページ目まで使う
+	const uint32_t count = (kNumDescriptors - kNumReserved) + kNumDescriptors + 10;
+	std::vector<uint32_t> handles;
+	for (uint32_t i = 0; i < count; i++) {
+		handles.push_back(registry.Allocate("texture" + std::to_string(i) + ".png"));
+	}
+	EXPECT_EQ(registry.GetPageCount(), 3u);
+	EXPECT_EQ(registry.GetCapacity(), kNumDescriptors * 3);
+	EXPECT_EQ(registry.GetLiveCount(), count);
+
+	// 番号は重ならず、増えたページの番号は予約されない（2ページ目の先頭から使う）
+	EXPECT_EQ(handles[kNumDescriptors - kNumReserved], kNumDescriptors);
+	std::vector<bool> used(registry.GetCapacity(), false);
+	for (uint32_t i = 0; i < count; i++) {
+		ASSERT_LT(handles[i], registry.GetCapacity());
+		EXPECT_GE(handles[i], kNumReserved);
+		EXPECT_FALSE(used[handles[i]]);
+		used[handles[i]] = true;
+		EXPECT_EQ(registry.Find("texture" + std::to_string(i) + ".png"), handles[i]);
+	}
+
+	// 解放してから同じ数を割り当て直しても、ページは増えない
+	for (uint32_t handle : handles) {
+		registry.Release(handle);
+	}
+	EXPECT_EQ(registry.GetLiveCount(), 0u);
+	for (uint32_t i = 0; i < count; i++) {
+		registry.Allocate("again" + std::to_string(i) + ".png");
+	}
+	EXPECT_EQ(registry.GetPageCount(), 3u);
+}
+
+TEST(TextureRegistryTest, ResetReturnsToOnePage) {
+	TextureRegistry registry;
+	registry.Reset(kNumDescriptors, kNumReserved);
+	for (uint32_t i = 0; i < kNumDescriptors; i++) {
+		registry.Allocate(std::to_string(i));
+	}
+	ASSERT_EQ(registry.GetPageCount(), 2u);
+	registry.Reset(kNumDescriptors, kNumReserved);
+	EXPECT_EQ(registry.GetPageCount(), 1u);
+	EXPECT_EQ(registry.GetLiveCount(), 0u);
+	EXPECT_EQ(registry.Find("0"), TextureRegistry::kInvalidHandle);
+	EXPECT_EQ(registry.Allocate("0"), kNumReserved);
+}
@@ -0,0 +1,139 @@
+#include "TextureResidency.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+
+// 予算を越えたら1フレーム使われていないものから追い出す設定
+constexpr uint32_t kEvictAfterFrames = 1;
+
+std::vector<uint32_t> Collect(TextureResidency& residency, uint64_t frame) {
+	std::vector<uint32_t> evicted;
+	residency.CollectEvictions(frame, &evicted);
+	return evicted;
+}
+
+} // namespace
+
+TEST(TextureResidencyTest, TracksResidentBytes) {
+	TextureResidency residency;
+	EXPECT_EQ(residency.GetBudget(), TextureResidency::kUnlimited);
+	residency.SetResident(3, 100, 0);
+	residency.SetResident(7, 250, 0);
+	EXPECT_EQ(residency.GetResidentBytes(), 350u);
+	EXPECT_EQ(residency.GetResidentCount(), 2u);
+	EXPECT_TRUE(residency.IsResident(3));
+	EXPECT_FALSE(residency.IsResident(4));
+	EXPECT_FALSE(residency.IsResident(1000));
+
+	// 作り直したときは前の大きさと置き換わる
+	residency.SetResident(3, 40, 1);
+	EXPECT_EQ(residency.GetResidentBytes(), 290u);
+	EXPECT_EQ(residency.GetResidentCount(), 2u);
+	EXPECT_EQ(residency.GetSize(3), 40u);
+
+	residency.Remove(7);
+	residency.Remove(7);
+	EXPECT_EQ(residency.GetResidentBytes(), 40u);
+	EXPECT_EQ(residency.GetResidentCount(), 1u);
+
+	// 予算が無ければ何も追い出さない
+	EXPECT_TRUE(Collect(residency, 100).empty());
+}
+
+TEST(TextureResidencyTest, EvictsLeastRecentlyUsedFirst) {
+	TextureResidency residency;
+	residency.SetBudget(300, kEvictAfterFrames);
+	for (uint32_t handle = 0; handle < 4; handle++) {
+		residency.SetResident(handle, 100, 0);
+	}
+	// 0 と 2 を後から使う（使われた順は古い方から 1, 3, 0, 2）
+	residency.Touch(0, 1);
+	residency.Touch(2, 2);
+
+	// 400 > 300 なので一番古い 1 だけを追い出す
+	EXPECT_EQ(Collect(residency, 3), (std::vector<uint32_t>{1}));
+	EXPECT_EQ(residency.GetResidentBytes(), 300u);
+
+	// 予算を下げると、古い順に収まるまで追い出す
+	residency.SetBudget(100, kEvictAfterFrames);
+	EXPECT_EQ(Collect(residency, 3), (std::vector<uint32_t>{3, 0}));
+	EXPECT_TRUE(residency.IsResident(2));
+	EXPECT_FALSE(residency.IsResident(0));
+	EXPECT_EQ(residency.GetResidentCount(), 1u);
+}
+
+TEST(TextureResidencyTest, TouchInSameFrameKeepsOrder) {
+	TextureResidency residency;
+	residency.SetBudget(100, kEvictAfterFrames);
+	residency.SetResident(0, 100, 5);
+	residency.SetResident(1, 100, 5);
+	// 同じフレームで使っても順番は変わらない（0 の方が古いまま）
+	residency.Touch(0, 5);
+	EXPECT_EQ(Collect(residency, 6), (std::vector<uint32_t>{0}));
+
+	// 管理していないハンドルを使っても何も起きない
+	residency.Touch(50, 6);
+	EXPECT_FALSE(residency.IsResident(50));
+	EXPECT_EQ(residency.GetResidentCount(), 1u);
+}
+
+TEST(TextureResidencyTest, RecentlyUsedTexturesSurviveOverBudget) {
+	TextureResidency residency;
+	constexpr uint32_t kGraceFrames = 3;
+	residency.SetBudget(100, kGraceFrames);
+	residency.SetResident(0, 100, 10);
+	residency.SetResident(1, 100, 11);
+	residency.SetResident(2, 100, 12);
+
+	// 最後に使ってから3フレーム経つまでは、予算を越えていても追い出さない
+	EXPECT_TRUE(Collect(residency, 12).empty());
+	EXPECT_EQ(Collect(residency, 13), (std::vector<uint32_t>{0}));
+	// 古い側から見て、猶予内のものに当たったらそこで止める
+	residency.Touch(1, 14);
+	EXPECT_TRUE(Collect(residency, 14).empty());
+	EXPECT_EQ(Collect(residency, 15), (std::vector<uint32_t>{2}));
+	EXPECT_EQ(residency.GetResidentBytes(), 100u);
+	EXPECT_TRUE(residency.IsResident(1));
+
+	// 予算以下になれば古くても残す
+	EXPECT_TRUE(Collect(residency, 100).empty());
+}
+
+TEST(TextureResidencyTest, EvictedTextureCanBecomeResidentAgain) {
+	TextureResidency residency;
+	residency.SetBudget(200, kEvictAfterFrames);
+	residency.SetResident(0, 100, 0);
+	residency.SetResident(1, 100, 0);
+	residency.SetResident(2, 100, 1);
+	EXPECT_EQ(Collect(residency, 2), (std::vector<uint32_t>{0}));
+
+	// 読み直したものは一番新しい側に入る
+	residency.SetResident(0, 100, 2);
+	EXPECT_EQ(Collect(residency, 3), (std::vector<uint32_t>{1}));
+	residency.SetResident(1, 100, 3);
+	EXPECT_EQ(Collect(residency, 4), (std::vector<uint32_t>{2}));
+	EXPECT_EQ(residency.GetResidentCount(), 2u);
+}
+
+TEST(TextureResidencyTest, RemoveKeepsListConsistent) {
+	TextureResidency residency;
+	residency.SetBudget(0, kEvictAfterFrames);
+	for (uint32_t handle = 0; handle < 5; handle++) {
+		residency.SetResident(handle, 10, handle);
+	}
+	// 先頭・途中・末尾を外しても、残りは使われた順に追い出せる
+	residency.Remove(4);
+	residency.Remove(2);
+	residency.Remove(0);
+	EXPECT_EQ(Collect(residency, 10), (std::vector<uint32_t>{1, 3}));
+	EXPECT_EQ(residency.GetResidentBytes(), 0u);
+
+	// Reset しても予算はそのまま
+	residency.SetResident(9, 10, 10);
+	residency.Reset();
+	EXPECT_EQ(residency.GetResidentCount(), 0u);
+	EXPECT_EQ(residency.GetBudget(), 0u);
+	EXPECT_EQ(residency.GetEvictAfterFrames(), kEvictAfterFrames);
+	EXPECT_FALSE(residency.IsResident(9));
+}
@@ -0,0 +1,39 @@
+#include "MathUtility.h"
+#include "TransformHierarchy.h"
+#include <gtest/gtest.h>
+
+TEST(TransformHierarchyTest, RejectsParentingToDescendant) {
+	TransformHierarchy hierarchy;
+	uint32_t root = hierarchy.CreateNode();
+	uint32_t child = hierarchy.CreateNode(root);
+	uint32_t grandChild = hierarchy.CreateNode(child);
+
+	EXPECT_FALSE(hierarchy.SetParent(root, grandChild));
+	EXPECT_FALSE(hierarchy.SetParent(child, child));
+	// 失敗したときは元の親のまま
+	EXPECT_EQ(hierarchy.GetParent(root), TransformHierarchy::kInvalidNode);
+	EXPECT_EQ(hierarchy.GetParent(child), root);
+
+	// 循環しなければ更新は終わる
+	hierarchy.UpdateMatrices();
+	EXPECT_EQ(hierarchy.GetUpdatedCount(), 3u);
+}
+
+TEST(TransformHierarchyTest, ReparentToLaterNodeKeepsParentFirst) {
+	TransformHierarchy hierarchy;
+	uint32_t a = hierarchy.CreateNode();
+	uint32_t b = hierarchy.CreateNode();
+	hierarchy.SetTranslation(b, {10.0f, 0.0f, 0.0f});
+	hierarchy.SetTranslation(a, {1.0f, 0.0f, 0.0f});
+
+	// 後ろにいるノードを親にする（並べ直しが必要）
+	ASSERT_TRUE(hierarchy.SetParent(a, b));
+	hierarchy.UpdateMatrices();
+	EXPECT_FLOAT_EQ(hierarchy.GetWorldMatrix(a).m[3][0], 11.0f);
+
+	// 親だけ動かすと子も追従する
+	hierarchy.SetTranslation(b, {20.0f, 0.0f, 0.0f});
+	hierarchy.UpdateMatrices();
+	EXPECT_EQ(hierarchy.GetUpdatedCount(), 2u);
+	EXPECT_FLOAT_EQ(hierarchy.GetWorldMatrix(a).m[3][0], 21.0f);
+}
@@ -0,0 +1,207 @@
+#include "MappedFile.h"
+#include "WaveStream.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// Resources を作業ディレクトリにして実行する（test/CMakeLists.txt を参照）
+// fanfare.wav は 16bit ステレオ（4 バイト/ブロック）、mokugyo.wav は 24bit ステレオ
+// （6 バイト/ブロック）で fmt と data の間に別のチャンクがある
+
+namespace {
+
+// WAV の波形データ全体（比べる基準）
+std::vector<uint8_t> ReadWaveData(const std::string& filePath, WaveInfo* info) {
+	MappedFile file;
+	EXPECT_TRUE(file.Open(filePath));
+	EXPECT_TRUE(WaveFile::Parse(file.GetData(), file.GetSize(), info));
+	const uint8_t* data = file.GetData() + info->dataOffset;
+	return std::vector<uint8_t>(data, data + info->dataSize);
+}
+
+// 受け取った塊の記録
+struct Played {
+	std::vector<uint8_t> bytes;
+	std::vector<uint32_t> chunkSizes;
+	bool endOfStream = false;
+};
+
+// 再生キューの代わり（読み込んで取り出し、すぐに返すのを繰り返す）
+// 終端に着くか maxBytes を越えたら止める
+Played Drain(WaveStream& stream, size_t maxBytes) {
+	Played played;
+	while (!played.endOfStream && played.bytes.size() < maxBytes) {
+		if (stream.Fill() == 0 && stream.IsFinished()) {
+			break;
+		}
+		WaveStream::Chunk chunk;
+		uint32_t acquiredCount = 0;
+		while (stream.Acquire(&chunk)) {
+			played.bytes.insert(played.bytes.end(), chunk.data, chunk.data + chunk.size);
+			played.chunkSizes.push_back(chunk.size);
+			played.endOfStream = chunk.endOfStream;
+			stream.Release(chunk.index);
+			acquiredCount++;
+		}
+		if (acquiredCount == 0) {
+			ADD_FAILURE() << "stream stalled";
+			break;
+		}
+	}
+	return played;
+}
+
+} // namespace
+
+TEST(WaveStreamTest, OpenAlignsBufferToBlocks) {
+	for (const char* fileName : {"fanfare.wav", "mokugyo.wav"}) {
+		WaveInfo info;
+		ASSERT_TRUE(WaveFile::ReadHeader(fileName, &info)) << fileName;
+		WaveStream stream;
+		ASSERT_TRUE(stream.Open(fileName, 0.07f)) << fileName;
+		EXPECT_TRUE(stream.IsOpen());
+		EXPECT_EQ(stream.GetFormat().blockAlign, info.format.blockAlign);
+		EXPECT_EQ(stream.GetFormat().samplesPerSec, info.format.samplesPerSec);
+		// 0.07 秒分のブロック数（四捨五入）にブロックの大きさを掛けたもの
+		const uint32_t blocks = uint32_t(info.format.samplesPerSec * 0.07f + 0.5f);
+		EXPECT_EQ(stream.GetBufferSize(), blocks * info.format.blockAlign) << fileName;
+
+		// ファイルより長いバッファは波形データの大きさで止める
+		ASSERT_TRUE(stream.Open(fileName, 60.0f));
+		EXPECT_EQ(stream.GetBufferSize(), info.dataSize) << fileName;
+		stream.Close();
+		EXPECT_FALSE(stream.IsOpen());
+	}
+}
+
+TEST(WaveStreamTest, OpenRejectsMissingOrNonWaveFiles) {
+	WaveStream stream;
+	EXPECT_FALSE(stream.Open("missing.wav"));
+	EXPECT_FALSE(stream.Open("uvChecker.png"));
+	EXPECT_FALSE(stream.IsOpen());
+	// 開いていなければ何も読まない
+	EXPECT_EQ(stream.Fill(), 0u);
+	WaveStream::Chunk chunk;
+	EXPECT_FALSE(stream.Acquire(&chunk));
+}
+
+TEST(WaveStreamTest, StreamsWholeFileWithBlockAlignedTail) {
+	for (const char* fileName : {"fanfare.wav", "mokugyo.wav"}) {
+		WaveInfo info;
+		const std::vector<uint8_t> expected = ReadWaveData(fileName, &info);
+		WaveStream stream;
+		ASSERT_TRUE(stream.Open(fileName, 0.07f));
+		const uint32_t bufferSize = stream.GetBufferSize();
+		// どちらのファイルもバッファの倍数ではないので、最後だけ短い
+		ASSERT_NE(info.dataSize % bufferSize, 0u) << fileName;
+
+		Played played = Drain(stream, SIZE_MAX);
+		EXPECT_TRUE(played.endOfStream);
+		EXPECT_TRUE(stream.IsFinished());
+		EXPECT_TRUE(played.bytes == expected) << fileName;
+		ASSERT_EQ(played.chunkSizes.size(), info.dataSize / bufferSize + 1);
+		for (size_t i = 0; i + 1 < played.chunkSizes.size(); i++) {
+			EXPECT_EQ(played.chunkSizes[i], bufferSize);
+		}
+		EXPECT_EQ(played.chunkSizes.back(), info.dataSize % bufferSize);
+		EXPECT_EQ(played.chunkSizes.back() % info.format.blockAlign, 0u);
+
+		// 終わった後は何も読まない
+		EXPECT_EQ(stream.Fill(), 0u);
+	}
+}
+
+TEST(WaveStreamTest, FillStopsWhenAllBuffersAreQueued) {
+	WaveStream stream;
+	ASSERT_TRUE(stream.Open("fanfare.wav", 0.1f));
+	EXPECT_EQ(stream.Fill(), WaveStream::kBufferCount);
+	EXPECT_EQ(stream.Fill(), 0u);
+
+	// 取り出しはバッファ番号の順
+	WaveStream::Chunk chunks[WaveStream::kBufferCount];
+	for (uint32_t i = 0; i < WaveStream::kBufferCount; i++) {
+		ASSERT_TRUE(stream.Acquire(&chunks[i]));
+		EXPECT_EQ(chunks[i].index, i);
+		EXPECT_EQ(chunks[i].size, stream.GetBufferSize());
+		EXPECT_FALSE(chunks[i].endOfStream);
+	}
+	WaveStream::Chunk chunk;
+	EXPECT_FALSE(stream.Acquire(&chunk));
+	// 再生中のバッファには書き込まない
+	EXPECT_EQ(stream.Fill(), 0u);
+	EXPECT_FALSE(stream.IsFinished());
+
+	// 返ってきた分だけ続きを読む（次は先頭のバッファ）
+	stream.Release(chunks[0].index);
+	EXPECT_EQ(stream.Fill(), 1u);
+	ASSERT_TRUE(stream.Acquire(&chunk));
+	EXPECT_EQ(chunk.index, 0u);
+	EXPECT_EQ(chunk.data, chunks[0].data);
+
+	stream.Release(chunk.index);
+	stream.Release(chunks[1].index);
+	stream.Close();
+}
+
+TEST(WaveStreamTest, LoopingWrapsToStart) {
+	WaveInfo info;
+	const std::vector<uint8_t> expected = ReadWaveData("mokugyo.wav", &info);
+	WaveStream stream;
+	ASSERT_TRUE(stream.Open("mokugyo.wav", 0.07f));
+	stream.SetLooping(true);
+
+	// 2周半流しても終わらず、末尾の次は先頭に戻る
+	const size_t totalBytes = expected.size() * 5 / 2;
+	Played played = Drain(stream, totalBytes);
+	EXPECT_FALSE(played.endOfStream);
+	EXPECT_FALSE(stream.IsFinished());
+	ASSERT_GE(played.bytes.size(), totalBytes);
+	for (size_t i = 0; i < played.bytes.size(); i++) {
+		ASSERT_EQ(played.bytes[i], expected[i % expected.size()]) << "byte " << i;
+	}
+	// 1周の最後の塊は短く、ブロック境界で終わる
+	const uint32_t bufferSize = stream.GetBufferSize();
+	const uint32_t chunksPerLoop = info.dataSize / bufferSize + 1;
+	EXPECT_EQ(played.chunkSizes[chunksPerLoop - 1], info.dataSize % bufferSize);
+	EXPECT_EQ(played.chunkSizes[chunksPerLoop], bufferSize);
+
+	// ループをやめると、今の周の終わりで止まる
+	stream.SetLooping(false);
+	Played rest = Drain(stream, SIZE_MAX);
+	EXPECT_TRUE(rest.endOfStream);
+	EXPECT_TRUE(stream.IsFinished());
+	EXPECT_EQ((played.bytes.size() + rest.bytes.size()) % expected.size(), 0u);
+}
+
+TEST(WaveStreamTest, TruncatedFileEndsOnBlockBoundary) {
+	// 開いた後でファイルが切り詰められても、読めた分をブロック境界で切って終わる
+	const std::filesystem::path filePath =
+	    std::filesystem::temp_directory_path() / "WaveStreamTest_truncated.wav";
+	std::filesystem::remove(filePath);
+	std::filesystem::copy_file("mokugyo.wav", filePath);
+
+	WaveInfo info;
+	const std::vector<uint8_t> expected = ReadWaveData("mokugyo.wav", &info);
+	WaveStream stream;
+	ASSERT_TRUE(stream.Open(filePath.string(), 0.07f));
+	// ブロックの途中で切る
+	const uint32_t keptSize = info.dataSize / 2 + 1;
+	ASSERT_NE(keptSize % info.format.blockAlign, 0u);
+	std::filesystem::resize_file(filePath, info.dataOffset + keptSize);
+
+	Played played = Drain(stream, SIZE_MAX);
+	EXPECT_TRUE(played.endOfStream);
+	EXPECT_TRUE(stream.IsFinished());
+	const size_t alignedSize = keptSize - keptSize % info.format.blockAlign;
+	ASSERT_EQ(played.bytes.size(), alignedSize);
+	EXPECT_TRUE(std::equal(played.bytes.begin(), played.bytes.end(), expected.begin()));
+	for (uint32_t size : played.chunkSizes) {
+		EXPECT_EQ(size % info.format.blockAlign, 0u);
+	}
+
+	stream.Close();
+	std::filesystem::remove(filePath);
+}